@@ -0,0 +1,35 @@
+#/usr/bin/env python
+
+# Renders inside a stream transaction. The render request must not reach the
+# server before the property changes queued by the transaction, hence the
+# queued streams must be flushed by the render itself.
+
+from paraview.simple import *
+from paraview import servermanager
+
+sphere = Sphere()
+rep = Show(sphere)
+view = GetRenderView()
+# Render on the server whenever connected to one.
+view.RemoteRenderThreshold = 0
+Render()
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+cid = servermanager.ActiveConnection.ID
+connection = pm.GetConnectionFromID(cid)
+
+pm.BeginStreamTransaction(cid)
+# A change that does not need the pipeline to update, so the render itself
+# has to send it.
+rep.DiffuseColor = [1, 0, 0]
+flushes = connection.GetNumberOfStreamFlushes()
+Render()
+flushed = connection.GetNumberOfStreamFlushes() - flushes
+pm.EndStreamTransaction(cid)
+
+if connection.IsA("vtkServerConnection") and flushed == 0:
+    import exceptions
+    raise exceptions.RuntimeError, \
+      "The render was sent before the streams queued in the transaction."
+else:
+    print "Render in stream transaction -- Test passed."
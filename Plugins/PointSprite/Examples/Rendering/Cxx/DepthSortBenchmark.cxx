@@ -0,0 +1,131 @@
+/*=========================================================================
+
+ Program:   Visualization Toolkit
+ Module:    DepthSortBenchmark.cxx
+
+ Copyright (c) Ken Martin, Will Schroeder, Bill Lorensen
+ All rights reserved.
+ See Copyright.txt or http://www.kitware.com/Copyright.htm for details.
+
+ This software is distributed WITHOUT ANY WARRANTY; without even
+ the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ PURPOSE.  See the above copyright notice for more information.
+
+ =========================================================================*/
+
+// .NAME Benchmark of the depth sort of vtkDepthSortPainter
+// .SECTION Description
+// Reports the time taken to depth sort an increasing number of particles
+// with vtkDepthSortPolyData and with the threaded radix sort of
+// vtkDepthSortPainter, for a full sort and for the small/large camera
+// motions that reuse the order of the previous frame.
+//
+// Usage: DepthSortBenchmark [max number of particles] [number of threads]
+
+#include "vtkCamera.h"
+#include "vtkCellArray.h"
+#include "vtkDepthSortPainter.h"
+#include "vtkDepthSortPolyData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+
+#include <stdlib.h>
+
+#define VTK_CREATE(type, name) \
+  vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
+
+// One vertex cell per particle, uniformly spread in the unit cube.
+static void CreateParticles(vtkPolyData* particles, vtkIdType count)
+{
+  VTK_CREATE(vtkPoints, points);
+  points->SetNumberOfPoints(count);
+  VTK_CREATE(vtkIdTypeArray, connectivity);
+  connectivity->SetNumberOfTuples(2 * count);
+  vtkIdType* cells = connectivity->GetPointer(0);
+  for (vtkIdType i = 0; i < count; i++)
+    {
+    points->SetPoint(i, vtkMath::Random(), vtkMath::Random(),
+                     vtkMath::Random());
+    cells[2*i] = 1;
+    cells[2*i+1] = i;
+    }
+  VTK_CREATE(vtkCellArray, verts);
+  verts->SetCells(count, connectivity);
+  particles->SetPoints(points);
+  particles->SetVerts(verts);
+}
+
+int main(int argc, char *argv[])
+{
+  vtkIdType maxCount = argc > 1 ? atoi(argv[1]) : 16000000;
+  int numThreads = argc > 2 ? atoi(argv[2]) : 0;
+
+  VTK_CREATE(vtkCamera, camera);
+  VTK_CREATE(vtkTimerLog, timer);
+
+  cout << "particles  vtkDepthSortPolyData  radix  small motion  "
+       << "large motion  (seconds)" << endl;
+
+  for (vtkIdType count = 100000; count <= maxCount; count *= 4)
+    {
+    VTK_CREATE(vtkPolyData, particles);
+    CreateParticles(particles, count);
+    camera->SetFocalPoint(0.5, 0.5, 0.5);
+    camera->SetPosition(0.5, 0.5, 4.0);
+    camera->SetViewUp(0.0, 1.0, 0.0);
+
+    // The reference: vtkDepthSortPolyData is too slow past a few million.
+    double reference = -1.0;
+    if (count <= 4000000)
+      {
+      VTK_CREATE(vtkDepthSortPolyData, depthSort);
+      depthSort->SetInput(particles);
+      depthSort->SetCamera(camera);
+      depthSort->SetDirectionToBackToFront();
+      timer->StartTimer();
+      depthSort->Update();
+      timer->StopTimer();
+      reference = timer->GetElapsedTime();
+      }
+
+    VTK_CREATE(vtkDepthSortPainter, painter);
+    painter->SetNumberOfThreads(numThreads);
+    VTK_CREATE(vtkPolyData, sorted);
+
+    timer->StartTimer();
+    painter->SortPolyData(sorted, particles, camera, NULL);
+    timer->StopTimer();
+    double full = timer->GetElapsedTime();
+
+    camera->Azimuth(0.5);
+    timer->StartTimer();
+    painter->SortPolyData(sorted, particles, camera, NULL);
+    timer->StopTimer();
+    double small = timer->GetElapsedTime();
+
+    camera->Azimuth(90.0);
+    timer->StartTimer();
+    painter->SortPolyData(sorted, particles, camera, NULL);
+    timer->StopTimer();
+    double large = timer->GetElapsedTime();
+
+    cout << count << "  ";
+    if (reference < 0.0)
+      {
+      cout << "-";
+      }
+    else
+      {
+      cout << reference;
+      }
+    cout << "  " << full << "  " << small << "  " << large
+         << "  (orders reused: " << painter->GetLastSortReusedOrders() << ")"
+         << endl;
+    }
+
+  return 0;
+}
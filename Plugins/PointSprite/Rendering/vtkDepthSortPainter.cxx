@@ -48,7 +48,12 @@
 #include "vtkProperty.h"
 #include "vtkDepthSortPolyData.h"
 #include "vtkScalarsToColors.h"
+#include "vtkMultiThreader.h"
+#include "vtkTimerLog.h"
+#include "vtkIdList.h"
+#include "vtkProp3D.h"
 
+#include <vtkstd/map>
 #include <vtkstd/vector>
 #include <vtkstd/algorithm>
 #include <functional>
@@ -60,6 +65,236 @@
 #include "vtkCellData.h"
 #include "vtkPolyData.h"
 
+// Below this number of cells, the sort is done by the calling thread only.
+static const vtkIdType VTK_DEPTH_SORT_SERIAL_SIZE = 65536;
+// Number of element moves per cell after which fixing up the order of the
+// previous frame is abandoned for a full radix sort.
+static const vtkIdType VTK_DEPTH_SORT_FIXUP_MOVES = 2;
+
+//-----------------------------------------------------------------------------
+// Sort state of one cell array (verts, lines, polys or strips) of an input.
+struct vtkDepthSortOrder
+{
+  // Location of each cell in the connectivity array.
+  vtkstd::vector<vtkIdType> Offsets;
+  // Cells from back to front after the last sort.
+  vtkstd::vector<vtkIdType> Order;
+};
+
+struct vtkDepthSortCache
+{
+  vtkDepthSortCache() : InputMTime(0), Used(false) {}
+  unsigned long InputMTime;
+  bool Used;
+  vtkDepthSortOrder Arrays[4];
+};
+
+class vtkDepthSortPainter::vtkInternals
+{
+public:
+  vtkInternals()
+    {
+    this->Threader = vtkMultiThreader::New();
+    }
+  ~vtkInternals()
+    {
+    this->Threader->Delete();
+    }
+
+  vtkMultiThreader* Threader;
+  vtkstd::map<vtkPolyData*, vtkDepthSortCache> Caches;
+};
+
+//-----------------------------------------------------------------------------
+// Work shared by the threads of one pass of the sort. Each thread handles a
+// contiguous range of the cells.
+struct vtkDepthSortJob
+{
+  enum { DEPTHS, KEYS, HISTOGRAM, SCATTER };
+  int Pass;
+  vtkIdType NumberOfCells;
+
+  // DEPTHS: depth of each cell, and range of the depths for each thread.
+  const vtkIdType* Connectivity;
+  const vtkIdType* Offsets;
+  vtkPoints* Points;
+  int Mode;
+  double Origin[3];
+  double Direction[3];
+  double* Depths;
+  vtkstd::vector<double> MinDepths;
+  vtkstd::vector<double> MaxDepths;
+
+  // KEYS: quantized depth of the cells of the starting order, back to front
+  // being increasing keys.
+  const vtkIdType* StartOrder;
+  double MaxDepth;
+  double Scale;
+
+  // HISTOGRAM, SCATTER: one radix pass on the byte at Shift.
+  unsigned int* KeysIn;
+  vtkIdType* IdsIn;
+  unsigned int* KeysOut;
+  vtkIdType* IdsOut;
+  int Shift;
+  vtkstd::vector<vtkIdType> Counts;
+};
+
+//-----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkDepthSortThread(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkDepthSortJob* job = static_cast<vtkDepthSortJob*>(info->UserData);
+  int tid = info->ThreadID;
+  vtkIdType begin = job->NumberOfCells * tid / info->NumberOfThreads;
+  vtkIdType end = job->NumberOfCells * (tid + 1) / info->NumberOfThreads;
+
+  switch (job->Pass)
+    {
+    case vtkDepthSortJob::DEPTHS:
+      {
+      double minDepth = VTK_DOUBLE_MAX;
+      double maxDepth = -VTK_DOUBLE_MAX;
+      double x[3], center[3];
+      for (vtkIdType i = begin; i < end; i++)
+        {
+        const vtkIdType* cell = job->Connectivity + job->Offsets[i];
+        vtkIdType npts = cell[0];
+        if (npts <= 0)
+          {
+          center[0] = job->Origin[0];
+          center[1] = job->Origin[1];
+          center[2] = job->Origin[2];
+          }
+        else if (job->Mode == VTK_SORT_FIRST_POINT || npts == 1)
+          {
+          job->Points->GetPoint(cell[1], center);
+          }
+        else if (job->Mode == VTK_SORT_BOUNDS_CENTER)
+          {
+          double bounds[6];
+          job->Points->GetPoint(cell[1], x);
+          bounds[0] = bounds[1] = x[0];
+          bounds[2] = bounds[3] = x[1];
+          bounds[4] = bounds[5] = x[2];
+          for (vtkIdType j = 2; j <= npts; j++)
+            {
+            job->Points->GetPoint(cell[j], x);
+            for (int k = 0; k < 3; k++)
+              {
+              bounds[2*k] = (x[k] < bounds[2*k])? x[k] : bounds[2*k];
+              bounds[2*k+1] = (x[k] > bounds[2*k+1])? x[k] : bounds[2*k+1];
+              }
+            }
+          center[0] = 0.5 * (bounds[0] + bounds[1]);
+          center[1] = 0.5 * (bounds[2] + bounds[3]);
+          center[2] = 0.5 * (bounds[4] + bounds[5]);
+          }
+        else
+          {
+          center[0] = center[1] = center[2] = 0.0;
+          for (vtkIdType j = 1; j <= npts; j++)
+            {
+            job->Points->GetPoint(cell[j], x);
+            center[0] += x[0];
+            center[1] += x[1];
+            center[2] += x[2];
+            }
+          center[0] /= npts;
+          center[1] /= npts;
+          center[2] /= npts;
+          }
+        double depth =
+          (center[0] - job->Origin[0]) * job->Direction[0] +
+          (center[1] - job->Origin[1]) * job->Direction[1] +
+          (center[2] - job->Origin[2]) * job->Direction[2];
+        job->Depths[i] = depth;
+        minDepth = (depth < minDepth)? depth : minDepth;
+        maxDepth = (depth > maxDepth)? depth : maxDepth;
+        }
+      job->MinDepths[tid] = minDepth;
+      job->MaxDepths[tid] = maxDepth;
+      }
+      break;
+
+    case vtkDepthSortJob::KEYS:
+      for (vtkIdType i = begin; i < end; i++)
+        {
+        vtkIdType cellId = job->StartOrder[i];
+        double key = (job->MaxDepth - job->Depths[cellId]) * job->Scale;
+        job->KeysIn[i] = key < 0.0? 0 :
+          (key >= 4294967295.0? 4294967295u : static_cast<unsigned int>(key));
+        job->IdsIn[i] = cellId;
+        }
+      break;
+
+    case vtkDepthSortJob::HISTOGRAM:
+      {
+      vtkIdType* counts = &job->Counts[tid * 256];
+      for (int d = 0; d < 256; d++)
+        {
+        counts[d] = 0;
+        }
+      for (vtkIdType i = begin; i < end; i++)
+        {
+        counts[(job->KeysIn[i] >> job->Shift) & 0xff]++;
+        }
+      }
+      break;
+
+    case vtkDepthSortJob::SCATTER:
+      {
+      // Counts now holds where each thread writes its cells of each digit.
+      vtkIdType* positions = &job->Counts[tid * 256];
+      for (vtkIdType i = begin; i < end; i++)
+        {
+        unsigned int key = job->KeysIn[i];
+        vtkIdType pos = positions[(key >> job->Shift) & 0xff]++;
+        job->KeysOut[pos] = key;
+        job->IdsOut[pos] = job->IdsIn[i];
+        }
+      }
+      break;
+    }
+
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//-----------------------------------------------------------------------------
+// Insertion sort of a nearly sorted sequence. Gives up (leaving a valid
+// permutation) when more than maxMoves elements had to be moved.
+static bool vtkDepthSortFixup(unsigned int* keys, vtkIdType* ids,
+                              vtkIdType n, vtkIdType maxMoves)
+{
+  vtkIdType moves = 0;
+  for (vtkIdType i = 1; i < n; i++)
+    {
+    unsigned int key = keys[i];
+    if (keys[i-1] <= key)
+      {
+      continue;
+      }
+    vtkIdType id = ids[i];
+    vtkIdType j = i;
+    do
+      {
+      keys[j] = keys[j-1];
+      ids[j] = ids[j-1];
+      j--;
+      moves++;
+      }
+    while (j > 0 && keys[j-1] > key);
+    keys[j] = key;
+    ids[j] = id;
+    if (moves > maxMoves)
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkDepthSortPainter)
 //-----------------------------------------------------------------------------
@@ -75,17 +310,29 @@ vtkDepthSortPainter::vtkDepthSortPainter()
   this->CachedIsColorSemiTranslucent = 1;
   this->DepthSortPolyData = vtkDepthSortPolyData::New();
   this->OutputData = NULL;
+  this->UseThreadedSort = 1;
+  this->NumberOfThreads = 0;
+  this->LastSortTime = 0.0;
+  this->LastSortReusedOrders = 0;
+  this->Internals = new vtkInternals;
 }
 //-----------------------------------------------------------------------------
 vtkDepthSortPainter::~vtkDepthSortPainter()
 {
   this->SetDepthSortPolyData(NULL);
   this->SetOutputData(NULL);
+  delete this->Internals;
 }
 //-----------------------------------------------------------------------------
 void vtkDepthSortPainter::PrintSelf(ostream &os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DepthSortEnableMode: " << this->DepthSortEnableMode << endl;
+  os << indent << "UseThreadedSort: " << this->UseThreadedSort << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+  os << indent << "LastSortTime: " << this->LastSortTime << endl;
+  os << indent << "LastSortReusedOrders: " << this->LastSortReusedOrders
+     << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -120,6 +367,15 @@ void vtkDepthSortPainter::PrepareForRendering(vtkRenderer* renderer,
 
   if (this->DepthSortPolyData != NULL && this->NeedSorting(renderer, actor))
     {
+    this->LastSortTime = 0.0;
+    this->LastSortReusedOrders = 0;
+    vtkstd::map<vtkPolyData*, vtkDepthSortCache>::iterator cacheIter;
+    for (cacheIter = this->Internals->Caches.begin();
+         cacheIter != this->Internals->Caches.end(); ++cacheIter)
+      {
+      cacheIter->second.Used = false;
+      }
+
     if (input->IsA("vtkCompositeDataSet"))
       {
       vtkCompositeDataSet* cdInput = vtkCompositeDataSet::SafeDownCast(input);
@@ -132,6 +388,14 @@ void vtkDepthSortPainter::PrepareForRendering(vtkRenderer* renderer,
             iter->GetCurrentDataObject());
         vtkDataSet* pdOutput = vtkDataSet::SafeDownCast(cdOutput->GetDataSet(
             iter));
+        if (pdInput && pdOutput == pdInput)
+          {
+          // The shallow copy shares the blocks, do not sort the input.
+          pdOutput = pdInput->NewInstance();
+          pdOutput->ShallowCopy(pdInput);
+          cdOutput->SetDataSet(iter, pdOutput);
+          pdOutput->Delete();
+          }
         if (pdInput && pdOutput)
           {
           this->Sort(pdOutput, pdInput, renderer, actor);
@@ -145,15 +409,40 @@ void vtkDepthSortPainter::PrepareForRendering(vtkRenderer* renderer,
       this->Sort(vtkDataSet::SafeDownCast(this->OutputData),
           vtkDataSet::SafeDownCast(input), renderer, actor);
       }
+
+    // Forget the orders of the blocks that are gone.
+    cacheIter = this->Internals->Caches.begin();
+    while (cacheIter != this->Internals->Caches.end())
+      {
+      if (cacheIter->second.Used)
+        {
+        ++cacheIter;
+        }
+      else
+        {
+        this->Internals->Caches.erase(cacheIter++);
+        }
+      }
     this->SortTime.Modified();
     }
 }
 
 void vtkDepthSortPainter::Sort(vtkDataSet* output,
     vtkDataSet* input,
-    vtkRenderer* vtkNotUsed(renderer),
-    vtkActor* vtkNotUsed(actor))
+    vtkRenderer* renderer,
+    vtkActor* actor)
 {
+  vtkPolyData* pdInput = vtkPolyData::SafeDownCast(input);
+  vtkPolyData* pdOutput = vtkPolyData::SafeDownCast(output);
+  if (this->UseThreadedSort && pdInput && pdOutput && renderer &&
+      this->DepthSortPolyData->GetDirection() != VTK_DIRECTION_SPECIFIED_VECTOR)
+    {
+    double start = vtkTimerLog::GetUniversalTime();
+    this->SortPolyData(pdOutput, pdInput, renderer->GetActiveCamera(), actor);
+    this->LastSortTime += vtkTimerLog::GetUniversalTime() - start;
+    return;
+    }
+
   this->DepthSortPolyData->SetInput(input);
 
   this->DepthSortPolyData->Update();
@@ -163,6 +452,264 @@ void vtkDepthSortPainter::Sort(vtkDataSet* output,
   output->ShallowCopy(polyData);
 }
 
+//-----------------------------------------------------------------------------
+void vtkDepthSortPainter::SortPolyData(vtkPolyData* output,
+    vtkPolyData* input, vtkCamera* camera, vtkProp3D* prop)
+{
+  if (output != input)
+    {
+    output->ShallowCopy(input);
+    }
+  if (!camera || !input->GetPoints())
+    {
+    return;
+    }
+
+  vtkDepthSortCache& cache = this->Internals->Caches[input];
+  cache.Used = true;
+  if (cache.InputMTime != input->GetMTime())
+    {
+    // New topology, the offsets and previous orders are useless.
+    for (int i = 0; i < 4; i++)
+      {
+      cache.Arrays[i].Offsets.clear();
+      cache.Arrays[i].Order.clear();
+      }
+    cache.InputMTime = input->GetMTime();
+    }
+
+  // The view direction in the coordinates of the data.
+  double origin[4], focal[4];
+  camera->GetPosition(origin);
+  camera->GetFocalPoint(focal);
+  origin[3] = focal[3] = 1.0;
+  if (prop)
+    {
+    vtkMatrix4x4* matrix = vtkMatrix4x4::New();
+    matrix->DeepCopy(prop->GetMatrix());
+    matrix->Invert();
+    matrix->MultiplyPoint(origin, origin);
+    matrix->MultiplyPoint(focal, focal);
+    matrix->Delete();
+    for (int i = 0; i < 3; i++)
+      {
+      origin[i] /= (origin[3] != 0.0? origin[3] : 1.0);
+      focal[i] /= (focal[3] != 0.0? focal[3] : 1.0);
+      }
+    }
+
+  vtkDepthSortJob job;
+  job.Points = input->GetPoints();
+  job.Mode = this->DepthSortPolyData->GetDepthSortMode();
+  for (int i = 0; i < 3; i++)
+    {
+    job.Origin[i] = origin[i];
+    job.Direction[i] = focal[i] - origin[i];
+    }
+
+  int numThreads = this->NumberOfThreads > 0 ? this->NumberOfThreads :
+    vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  vtkMultiThreader* threader = this->Internals->Threader;
+
+  vtkCellArray* inCells[4] = { input->GetVerts(), input->GetLines(),
+                               input->GetPolys(), input->GetStrips() };
+  vtkIdType firstCellId[4];
+  vtkIdType totalCells = 0;
+  for (int t = 0; t < 4; t++)
+    {
+    firstCellId[t] = totalCells;
+    totalCells += inCells[t]? inCells[t]->GetNumberOfCells() : 0;
+    }
+
+  // Where each output cell comes from, to reorder the cell data.
+  bool hasCellData = (input->GetCellData()->GetNumberOfArrays() > 0);
+  vtkIdList* cellMap = NULL;
+  if (hasCellData)
+    {
+    cellMap = vtkIdList::New();
+    cellMap->SetNumberOfIds(totalCells);
+    }
+
+  vtkstd::vector<double> depths;
+  vtkstd::vector<unsigned int> keys[2];
+  vtkstd::vector<vtkIdType> ids[2];
+  vtkCellArray* outCells[4] = { NULL, NULL, NULL, NULL };
+  for (int t = 0; t < 4; t++)
+    {
+    vtkIdType numCells = inCells[t]? inCells[t]->GetNumberOfCells() : 0;
+    if (numCells < 2)
+      {
+      if (cellMap)
+        {
+        for (vtkIdType i = 0; i < numCells; i++)
+          {
+          cellMap->SetId(firstCellId[t] + i, firstCellId[t] + i);
+          }
+        }
+      continue;
+      }
+
+    vtkDepthSortOrder& order = cache.Arrays[t];
+    const vtkIdType* connectivity = inCells[t]->GetPointer();
+    if (static_cast<vtkIdType>(order.Offsets.size()) != numCells)
+      {
+      order.Offsets.resize(numCells);
+      order.Order.clear();
+      vtkIdType offset = 0;
+      for (vtkIdType i = 0; i < numCells; i++)
+        {
+        order.Offsets[i] = offset;
+        offset += connectivity[offset] + 1;
+        }
+      }
+    bool reuseOrder =
+      (static_cast<vtkIdType>(order.Order.size()) == numCells);
+    if (!reuseOrder)
+      {
+      order.Order.resize(numCells);
+      for (vtkIdType i = 0; i < numCells; i++)
+        {
+        order.Order[i] = i;
+        }
+      }
+
+    threader->SetNumberOfThreads(
+      numCells < VTK_DEPTH_SORT_SERIAL_SIZE ? 1 : numThreads);
+    int jobThreads = threader->GetNumberOfThreads();
+    threader->SetSingleMethod(vtkDepthSortThread, &job);
+    job.NumberOfCells = numCells;
+
+    // Depth of every cell.
+    depths.resize(numCells);
+    job.Connectivity = connectivity;
+    job.Offsets = &order.Offsets[0];
+    job.Depths = &depths[0];
+    job.MinDepths.assign(jobThreads, VTK_DOUBLE_MAX);
+    job.MaxDepths.assign(jobThreads, -VTK_DOUBLE_MAX);
+    job.Pass = vtkDepthSortJob::DEPTHS;
+    threader->SingleMethodExecute();
+    double minDepth = *vtkstd::min_element(job.MinDepths.begin(),
+                                           job.MinDepths.end());
+    double maxDepth = *vtkstd::max_element(job.MaxDepths.begin(),
+                                           job.MaxDepths.end());
+
+    // Keys of the cells in the order of the last frame.
+    for (int b = 0; b < 2; b++)
+      {
+      keys[b].resize(numCells);
+      ids[b].resize(numCells);
+      }
+    job.StartOrder = &order.Order[0];
+    job.MaxDepth = maxDepth;
+    job.Scale = (maxDepth > minDepth)? 4294967295.0 / (maxDepth - minDepth)
+                                     : 0.0;
+    job.KeysIn = &keys[0][0];
+    job.IdsIn = &ids[0][0];
+    job.Pass = vtkDepthSortJob::KEYS;
+    threader->SingleMethodExecute();
+
+    // Small camera motions barely change the order: try fixing it up first.
+    int current = 0;
+    if (reuseOrder && vtkDepthSortFixup(&keys[0][0], &ids[0][0], numCells,
+                               VTK_DEPTH_SORT_FIXUP_MOVES * numCells))
+      {
+      this->LastSortReusedOrders++;
+      }
+    else
+      {
+      job.Counts.resize(jobThreads * 256);
+      for (int shift = 0; shift < 32; shift += 8)
+        {
+        job.KeysIn = &keys[current][0];
+        job.IdsIn = &ids[current][0];
+        job.KeysOut = &keys[1 - current][0];
+        job.IdsOut = &ids[1 - current][0];
+        job.Shift = shift;
+        job.Pass = vtkDepthSortJob::HISTOGRAM;
+        threader->SingleMethodExecute();
+
+        // Turn the counts into the first position of each digit for each
+        // thread. Skip the pass if all keys have the same digit.
+        vtkIdType position = 0;
+        bool trivial = false;
+        for (int d = 0; d < 256 && !trivial; d++)
+          {
+          vtkIdType digitCount = 0;
+          for (int tid = 0; tid < jobThreads; tid++)
+            {
+            vtkIdType count = job.Counts[tid * 256 + d];
+            job.Counts[tid * 256 + d] = position;
+            position += count;
+            digitCount += count;
+            }
+          trivial = (digitCount == numCells);
+          }
+        if (trivial)
+          {
+          continue;
+          }
+        job.Pass = vtkDepthSortJob::SCATTER;
+        threader->SingleMethodExecute();
+        current = 1 - current;
+        }
+      }
+    vtkstd::copy(ids[current].begin(), ids[current].end(),
+                 order.Order.begin());
+
+    // Copy the cells in back to front order.
+    vtkIdTypeArray* outConnectivity = vtkIdTypeArray::New();
+    outConnectivity->SetNumberOfTuples(
+      inCells[t]->GetNumberOfConnectivityEntries());
+    vtkIdType* outPtr = outConnectivity->GetPointer(0);
+    for (vtkIdType i = 0; i < numCells; i++)
+      {
+      vtkIdType cellId = order.Order[i];
+      const vtkIdType* cell = connectivity + order.Offsets[cellId];
+      for (vtkIdType j = 0; j <= cell[0]; j++)
+        {
+        *outPtr++ = cell[j];
+        }
+      if (cellMap)
+        {
+        cellMap->SetId(firstCellId[t] + i, firstCellId[t] + cellId);
+        }
+      }
+    outCells[t] = vtkCellArray::New();
+    outCells[t]->SetCells(numCells, outConnectivity);
+    outConnectivity->Delete();
+    }
+
+  if (outCells[0]) { output->SetVerts(outCells[0]); outCells[0]->Delete(); }
+  if (outCells[1]) { output->SetLines(outCells[1]); outCells[1]->Delete(); }
+  if (outCells[2]) { output->SetPolys(outCells[2]); outCells[2]->Delete(); }
+  if (outCells[3]) { output->SetStrips(outCells[3]); outCells[3]->Delete(); }
+
+  if (cellMap)
+    {
+    vtkCellData* inCD = input->GetCellData();
+    vtkCellData* outCD = vtkCellData::New();
+    for (int i = 0; i < inCD->GetNumberOfArrays(); i++)
+      {
+      vtkAbstractArray* inArray = inCD->GetAbstractArray(i);
+      vtkAbstractArray* outArray = inArray->NewInstance();
+      outArray->SetName(inArray->GetName());
+      outArray->SetNumberOfComponents(inArray->GetNumberOfComponents());
+      inArray->GetTuples(cellMap, outArray);
+      int index = outCD->AddArray(outArray);
+      outArray->Delete();
+      int attribute = inCD->IsArrayAnAttribute(i);
+      if (attribute >= 0)
+        {
+        outCD->SetActiveAttribute(index, attribute);
+        }
+      }
+    output->GetCellData()->ShallowCopy(outCD);
+    outCD->Delete();
+    cellMap->Delete();
+    }
+}
+
+//-----------------------------------------------------------------------------
 int vtkDepthSortPainter::NeedSorting(vtkRenderer* renderer, vtkActor* actor)
 {
   if (!actor || !renderer)
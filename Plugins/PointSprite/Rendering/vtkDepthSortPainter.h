@@ -32,6 +32,10 @@
 // painter does nothing.
 // This painter is useful with the point sprite painter
 // to sort points when depth peeling is disabled.
+// vtkPolyData inputs are sorted, by default, with a multithreaded radix sort
+// on the quantized depth of the cells. The order of the previous frame is
+// used as the starting point, so that small camera motions only need an
+// insertion sort pass.
 
 #ifndef __vtkDepthSortPainter_h
 #define __vtkDepthSortPainter_h
@@ -45,6 +49,8 @@ class vtkIdTypeArray;
 class vtkMatrix4x4;
 class vtkCamera;
 class vtkPoints;
+class vtkPolyData;
+class vtkProp3D;
 class vtkDataObject;
 class vtkTexture;
 class vtkDepthSortPolyData;
@@ -101,6 +107,36 @@ public:
   virtual void  SetDepthSortPolyData(vtkDepthSortPolyData*);
   vtkGetObjectMacro(DepthSortPolyData, vtkDepthSortPolyData);
 
+  // Description:
+  // When on (the default), vtkPolyData inputs are sorted with the threaded
+  // radix sort instead of the internal vtkDepthSortPolyData. The DepthSortMode
+  // of the vtkDepthSortPolyData is still honored (parametric center is
+  // approximated by the average of the cell points).
+  vtkSetMacro(UseThreadedSort, int);
+  vtkGetMacro(UseThreadedSort, int);
+  vtkBooleanMacro(UseThreadedSort, int);
+
+  // Description:
+  // Number of threads used by the threaded sort. 0 (the default) uses the
+  // vtkMultiThreader global default.
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_LARGE_INTEGER);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // Time taken by the last sort in seconds, and the number of cell arrays
+  // (verts, lines, polys and strips of each block) that were sorted by fixing
+  // up the order of the previous frame rather than by a full radix sort.
+  vtkGetMacro(LastSortTime, double);
+  vtkGetMacro(LastSortReusedOrders, int);
+
+  // Description:
+  // Sorts the cells of input back to front as seen from the camera into
+  // output, using the threaded radix sort. prop may be NULL. This is what
+  // Sort() uses for vtkPolyData inputs and may be called directly, e.g. for
+  // benchmarking.
+  virtual void SortPolyData(vtkPolyData* output, vtkPolyData* input,
+                            vtkCamera* camera, vtkProp3D* prop);
+
 protected:
   vtkDepthSortPainter();
   virtual ~vtkDepthSortPainter();
@@ -140,6 +176,10 @@ protected:
   vtkTimeStamp          CachedIsColorSemiTranslucentTime;
   int                   CachedIsColorSemiTranslucent;
   vtkDepthSortPolyData* DepthSortPolyData;
+  int                   UseThreadedSort;
+  int                   NumberOfThreads;
+  double                LastSortTime;
+  int                   LastSortReusedOrders;
 
   //BTX
   vtkWeakPointer<vtkDataObject> PrevInput;
@@ -150,6 +190,11 @@ protected:
 private:
   vtkDepthSortPainter(const vtkDepthSortPainter &);  // Not implemented.
   void operator=(const vtkDepthSortPainter &);  // Not implemented.
+
+  //BTX
+  class vtkInternals;
+  vtkInternals* Internals;
+  //ETX
 };
 
 #endif //__vtkDepthSortPainter_h
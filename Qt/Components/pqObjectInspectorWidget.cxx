@@ -45,6 +45,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <QVBoxLayout>
 
 // ParaView Server Manager includes
+#include <vtkProcessModule.h>
 #include <vtkSMProxy.h>
 
 // ParaView includes
@@ -501,6 +502,23 @@ void pqObjectInspectorWidget::accept()
 
   QSet<pqProxy*> proxies_to_show;
 
+  // Send the properties pushed by all the panels to the servers together.
+  QSet<vtkIdType> connections;
+  foreach(pqObjectPanel* panel, this->PanelStore)
+    {
+    connections.insert(panel->referenceProxy()->getProxy()->GetConnectionID());
+    }
+  if (this->CurrentPanel)
+    {
+    connections.insert(
+      this->CurrentPanel->referenceProxy()->getProxy()->GetConnectionID());
+    }
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  foreach(vtkIdType cid, connections)
+    {
+    pm->BeginStreamTransaction(cid);
+    }
+
   // accept all panels that are dirty.
   foreach(pqObjectPanel* panel, this->PanelStore)
     {
@@ -527,6 +545,11 @@ void pqObjectInspectorWidget::accept()
     this->CurrentPanel->accept();
     }
 
+  foreach(vtkIdType cid, connections)
+    {
+    pm->EndStreamTransaction(cid);
+    }
+
   foreach (pqProxy* proxy_to_show, proxies_to_show)
     {
     pqPipelineSource* source = qobject_cast<pqPipelineSource*>(proxy_to_show);
@@ -86,6 +86,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "vtkSMProxy.h"
 #include "vtkSMProxyManager.h"
 #include "vtkSMReaderFactory.h"
+#include "vtkSMStateLoader.h"
 #include "vtkSMWriterFactory.h"
 
 //-----------------------------------------------------------------------------
@@ -478,8 +479,10 @@ void pqApplicationCore::loadState(const char* filename, pqServer* server)
 
   // FIXME: this->LoadingState cannot be relied upon.
   this->LoadingState = true;
+  vtkSmartPointer<vtkSMStateLoader> loader;
+  loader.TakeReference(this->newStateLoader());
   vtkSMProxyManager* pxm = vtkSMProxyManager::GetProxyManager();
-  pxm->LoadState(filename, server->GetConnectionID());
+  pxm->LoadState(filename, server->GetConnectionID(), loader);
   this->LoadingState = false;
 }
 
@@ -501,11 +504,25 @@ void pqApplicationCore::loadState(
 
   // FIXME: this->LoadingState cannot be relied upon.
   this->LoadingState = true;
+  vtkSmartPointer<vtkSMStateLoader> loader;
+  loader.TakeReference(this->newStateLoader());
   vtkSMProxyManager* pxm = vtkSMProxyManager::GetProxyManager();
-  pxm->LoadState(rootElement, server->GetConnectionID());
+  pxm->LoadState(rootElement, server->GetConnectionID(), loader);
   this->LoadingState = false;
 }
 
+//-----------------------------------------------------------------------------
+vtkSMStateLoader* pqApplicationCore::newStateLoader()
+{
+  // When "DeferredStateLoading" is set, the loader creates all the proxies
+  // before updating the pipeline information of any of them, which saves
+  // round trips to remote servers.
+  vtkSMStateLoader* loader = vtkSMStateLoader::New();
+  loader->SetDeferredLoading(
+    this->settings()->value("DeferredStateLoading", false).toBool()? 1 : 0);
+  return loader;
+}
+
 //-----------------------------------------------------------------------------
 void pqApplicationCore::onStateLoaded(
   vtkPVXMLElement* root, vtkSMProxyLocator* locator)
@@ -62,6 +62,7 @@ class QStringList;
 class vtkPVXMLElement;
 class vtkSMGlobalPropertiesManager;
 class vtkSMProxyLocator;
+class vtkSMStateLoader;
 
 /// This class is the crux of the ParaView application. It creates
 /// and manages various managers which are necessary for the ParaView-based
@@ -276,6 +277,10 @@ protected slots:
   void onStateSaved(vtkPVXMLElement* root);
 
 protected:
+  /// Returns a new state loader for loadState(). The "DeferredStateLoading"
+  /// setting turns its deferred loading on.
+  vtkSMStateLoader* newStateLoader();
+
   bool LoadingState;
 
   pqOutputWindow* OutputWindow;
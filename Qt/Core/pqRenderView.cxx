@@ -143,6 +143,10 @@ void pqRenderView::InternalConstructor(vtkSMViewProxy* renModule)
   this->getConnector()->Connect(
     renModule, vtkCommand::ResetCameraEvent,
     this, SLOT(onResetCameraEvent()));
+
+  // Queued so that user events get processed between refinement passes.
+  QObject::connect(this, SIGNAL(endRender()),
+    this, SLOT(onEndRender()), Qt::QueuedConnection);
 }
 
 //-----------------------------------------------------------------------------
@@ -323,6 +327,16 @@ void pqRenderView::onResetCameraEvent()
   this->updateCenterAxes();
 }
 
+//-----------------------------------------------------------------------------
+void pqRenderView::onEndRender()
+{
+  vtkSMRenderViewProxy* view = this->getRenderViewProxy();
+  if (view && view->GetProgressiveRefinementNeeded())
+    {
+    this->render();
+    }
+}
+
 //-----------------------------------------------------------------------------
 void pqRenderView::resetCamera()
 {
@@ -250,6 +250,10 @@ private slots:
   /// orientation text actor. 
   void textAnnotationColorChanged();
 
+  /// Called after each render. Renders again while progressively rendered
+  /// volumes have not reached their full resolution.
+  void onEndRender();
+
 protected:
   /// Center Axes represents the 3D axes in the view. When GUI creates the view,
   /// we explicitly create a center axes, register it and add it to the view 
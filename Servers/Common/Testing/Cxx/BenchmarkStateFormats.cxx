@@ -0,0 +1,192 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    BenchmarkStateFormats.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Compares saving and loading a large state as XML and in the binary
+// format of vtkPVXMLBinaryFormat, and checks that both give the same tree.
+// The state holds proxies with large property vectors, like transfer
+// functions, selection id lists and camera key frames.
+//
+// Usage: BenchmarkStateFormats [numberOfProxies]
+
+#include "vtkPVXMLBinaryFormat.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPVXMLParser.h"
+#include "vtkTimerLog.h"
+
+#include <vtkstd/string>
+#include <vtksys/ios/sstream>
+
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------
+static void AddProperty(vtkPVXMLElement* proxy, const char* name,
+                        int numberOfElements, int kind)
+{
+  vtkPVXMLElement* property = vtkPVXMLElement::New();
+  property->SetName("Property");
+  property->AddAttribute("name", name);
+  property->AddAttribute("number_of_elements", numberOfElements);
+  for (int i = 0; i < numberOfElements; ++i)
+    {
+    vtkPVXMLElement* element = vtkPVXMLElement::New();
+    element->SetName("Element");
+    element->AddAttribute("index", i);
+    switch (kind)
+      {
+      case 0:
+        element->AddAttribute("value", (i * 7919) % 1000003);
+        break;
+      case 1:
+        element->AddAttribute("value", (i % 4 == 0)? i / 4.0 : 1.0 / (i + 3));
+        break;
+      case 2:
+        element->AddAttribute("value", 0.001 * i * i - 2.5, 16);
+        break;
+      default:
+        element->AddAttribute("value", (i % 2)? "Normals" : "Temperature");
+        break;
+      }
+    property->AddNestedElement(element);
+    element->Delete();
+    }
+  vtkPVXMLElement* domain = vtkPVXMLElement::New();
+  domain->SetName("Domain");
+  domain->AddAttribute("name", "range");
+  property->AddNestedElement(domain);
+  domain->Delete();
+  proxy->AddNestedElement(property);
+  property->Delete();
+}
+
+//----------------------------------------------------------------------------
+static vtkPVXMLElement* BuildState(int numberOfProxies)
+{
+  vtkPVXMLElement* root = vtkPVXMLElement::New();
+  root->SetName("ServerManagerState");
+  root->AddAttribute("version", "3.7.0");
+  for (int p = 0; p < numberOfProxies; ++p)
+    {
+    vtkPVXMLElement* proxy = vtkPVXMLElement::New();
+    proxy->SetName("Proxy");
+    proxy->AddAttribute("group", "lookup_tables");
+    proxy->AddAttribute("type", "PVLookupTable");
+    proxy->AddAttribute("id", 100 + p);
+    proxy->AddAttribute("servers", 21);
+    AddProperty(proxy, "SelectionIds", 5000, 0);
+    AddProperty(proxy, "RGBPoints", 4000, 1);
+    AddProperty(proxy, "KeyFrames", 1000, 2);
+    AddProperty(proxy, "ArrayNames", 200, 3);
+    root->AddNestedElement(proxy);
+    proxy->Delete();
+    }
+  return root;
+}
+
+//----------------------------------------------------------------------------
+static bool SameElements(vtkPVXMLElement* a, vtkPVXMLElement* b)
+{
+  if (strcmp(a->GetName(), b->GetName()) != 0 ||
+      strcmp(a->GetId(), b->GetId()) != 0 ||
+      a->GetNumberOfAttributes() != b->GetNumberOfAttributes() ||
+      a->GetNumberOfNestedElements() != b->GetNumberOfNestedElements())
+    {
+    return false;
+    }
+  unsigned int i;
+  for (i = 0; i < a->GetNumberOfAttributes(); ++i)
+    {
+    if (strcmp(a->GetAttributeName(i), b->GetAttributeName(i)) != 0 ||
+        strcmp(a->GetAttributeValue(i), b->GetAttributeValue(i)) != 0)
+      {
+      return false;
+      }
+    }
+  for (i = 0; i < a->GetNumberOfNestedElements(); ++i)
+    {
+    if (!SameElements(a->GetNestedElement(i), b->GetNestedElement(i)))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  int numberOfProxies = (argc > 1)? atoi(argv[1]) : 10;
+  if (numberOfProxies < 1)
+    {
+    numberOfProxies = 1;
+    }
+
+  vtkPVXMLElement* state = BuildState(numberOfProxies);
+  vtkTimerLog* timer = vtkTimerLog::New();
+
+  timer->StartTimer();
+  vtksys_ios::ostringstream xmlStream;
+  state->PrintXML(xmlStream, vtkIndent());
+  vtkstd::string xml = xmlStream.str();
+  timer->StopTimer();
+  double xmlSave = timer->GetElapsedTime();
+
+  timer->StartTimer();
+  vtkPVXMLParser* parser = vtkPVXMLParser::New();
+  int parsed = parser->Parse(xml.c_str());
+  timer->StopTimer();
+  double xmlLoad = timer->GetElapsedTime();
+
+  timer->StartTimer();
+  vtksys_ios::ostringstream binaryStream;
+  int written = vtkPVXMLBinaryFormat::Write(state, binaryStream);
+  vtkstd::string binary = binaryStream.str();
+  timer->StopTimer();
+  double binarySave = timer->GetElapsedTime();
+
+  timer->StartTimer();
+  vtkPVXMLElement* loaded =
+    vtkPVXMLBinaryFormat::Read(binary.c_str(), binary.size());
+  timer->StopTimer();
+  double binaryLoad = timer->GetElapsedTime();
+
+  int ret = 0;
+  if (!parsed || !written || !loaded)
+    {
+    cerr << "FAILED: could not save or load the state." << endl;
+    ret = 1;
+    }
+  else if (!SameElements(parser->GetRootElement(), loaded))
+    {
+    cerr << "FAILED: the binary state differs from the XML state." << endl;
+    ret = 1;
+    }
+  else
+    {
+    cout << "Proxies:      " << numberOfProxies << "\n";
+    cout << "XML:          " << xml.size() << " bytes, save "
+         << xmlSave << " s, load " << xmlLoad << " s\n";
+    cout << "Binary:       " << binary.size() << " bytes, save "
+         << binarySave << " s, load " << binaryLoad << " s" << endl;
+    }
+
+  if (loaded)
+    {
+    loaded->Delete();
+    }
+  parser->Delete();
+  timer->Delete();
+  state->Delete();
+  return ret;
+}
@@ -49,6 +49,8 @@
 #include "vtkPVServerOptions.h"
 #include "vtkPVServerSocket.h"
 #include "vtkPVTimerInformation.h"
+#include "vtkPVUndoStackInformation.h"
+#include "vtkPVXMLBinaryFormat.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
 #include "vtkRemoteConnection.h"
@@ -75,6 +77,8 @@ int main(int, char * [])
   c = vtkPVDataInformation::New(); c->Print(cout); c->Delete();
   c = vtkPVAlgorithmPortsInformation::New(); c->Print(cout); c->Delete();
   c = vtkPVTimerInformation::New(); c->Print(cout); c->Delete();
+  c = vtkPVUndoStackInformation::New(); c->Print(cout); c->Delete();
+  c = vtkPVXMLBinaryFormat::New(); c->Print(cout); c->Delete();
   c = vtkPVXMLElement::New(); c->Print(cout); c->Delete();
   c = vtkPVXMLParser::New(); c->Print(cout); c->Delete();
   c = vtkProcessModule::New(); c->Print(cout); c->Delete();
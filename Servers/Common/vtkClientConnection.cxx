@@ -96,6 +96,48 @@ void vtkClientConnectionRootRMI(void *vtkNotUsed(localArg), void *remoteArg,
     }
 }
 
+//-----------------------------------------------------------------------------
+// Called when the client sends several streams at once. Each message holds
+// the RMI tag the stream would have been sent with and the stream itself.
+void vtkClientConnectionBatchRMI(void *vtkNotUsed(localArg), void *remoteArg,
+  int remoteArgLength, int vtkNotUsed(remoteProcessId))
+{
+  try
+    {
+    vtkClientServerStream batch;
+    batch.SetData(reinterpret_cast<unsigned char*>(remoteArg), remoteArgLength);
+
+    vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+    vtkClientServerStream stream;
+    int numMessages = batch.GetNumberOfMessages();
+    for (int cc=0; cc < numMessages; cc++)
+      {
+      int tag = 0;
+      if (!batch.GetArgument(cc, 0, &tag) ||
+        !batch.GetArgument(cc, 1, &stream))
+        {
+        vtkGenericWarningMacro("Ignoring malformed batched stream.");
+        continue;
+        }
+      pm->SendStream(
+        vtkProcessModuleConnectionManager::GetSelfConnectionID(),
+        (tag == vtkRemoteConnection::CLIENT_SERVER_ROOT_RMI_TAG)?
+        vtkProcessModule::DATA_SERVER_ROOT : vtkProcessModule::DATA_SERVER,
+        stream);
+      }
+    }
+  catch (vtkstd::bad_alloc)
+    {
+    vtkProcessModule::GetProcessModule()->ExceptionEvent(
+      vtkProcessModule::EXCEPTION_BAD_ALLOC);
+    }
+  catch (...)
+    {
+    vtkProcessModule::GetProcessModule()->ExceptionEvent(
+      vtkProcessModule::EXCEPTION_UNKNOWN);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Called on client is requesting Information from this server.
 void vtkClientConnectionGatherInformationRMI(void *localArg, 
@@ -120,6 +162,30 @@ void vtkClientConnectionGatherInformationRMI(void *localArg,
     }
 }
 
+//-----------------------------------------------------------------------------
+// Called on client is requesting several Information objects from this server.
+void vtkClientConnectionGatherInformationBatchRMI(void *localArg, 
+  void *remoteArg, int remoteArgLength, int vtkNotUsed(remoteProcessId))
+{
+  vtkClientServerStream stream;
+  stream.SetData(reinterpret_cast<unsigned char*>(remoteArg), remoteArgLength);
+  vtkClientConnection* self = (vtkClientConnection*)localArg;
+  try
+    {
+    self->SendInformationBatch(stream);
+    }
+  catch (vtkstd::bad_alloc)
+    {
+    vtkProcessModule::GetProcessModule()->ExceptionEvent(
+      vtkProcessModule::EXCEPTION_BAD_ALLOC);
+    }
+  catch (...)
+    {
+    vtkProcessModule::GetProcessModule()->ExceptionEvent(
+      vtkProcessModule::EXCEPTION_UNKNOWN);
+    }
+}
+
 //-----------------------------------------------------------------------------
 // Called when the client wants to push undo set.
 void vtkClientConnectionPushUndoXML(void* localArg,
@@ -186,6 +252,10 @@ public:
     {
     this->XMLData = vtkstd::string(data);
     }
+  virtual vtkIdType GetMemorySize()
+    {
+    return static_cast<vtkIdType>(sizeof(*this) + this->XMLData.capacity());
+    }
   const char* GetXMLData(int &length)
     {
     length = static_cast<int>(this->XMLData.length());
@@ -335,10 +405,18 @@ void vtkClientConnection::SetupRMIs()
     (void *)(this),
     vtkRemoteConnection::CLIENT_SERVER_ROOT_RMI_TAG);
 
+  this->Controller->AddRMI(vtkClientConnectionBatchRMI, 
+    (void *)(this),
+    vtkRemoteConnection::CLIENT_SERVER_BATCH_RMI_TAG);
+
   this->Controller->AddRMI(vtkClientConnectionGatherInformationRMI,
     (void*)(this),
     vtkRemoteConnection::CLIENT_SERVER_GATHER_INFORMATION_RMI_TAG);
 
+  this->Controller->AddRMI(vtkClientConnectionGatherInformationBatchRMI,
+    (void*)(this),
+    vtkRemoteConnection::CLIENT_SERVER_GATHER_INFORMATION_BATCH_RMI_TAG);
+
   this->Controller->AddRMI(vtkClientConnectionPushUndoXML,
     (void*)(this),
     vtkRemoteConnection::CLIENT_SERVER_PUSH_UNDO_XML_TAG);
@@ -422,6 +500,65 @@ void vtkClientConnection::SendInformation(vtkClientServerStream& stream)
     }
 }
 
+//-----------------------------------------------------------------------------
+void vtkClientConnection::SendInformationBatch(vtkClientServerStream& stream)
+{
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+
+  // Each request becomes one message of the reply: a Reply with the
+  // serialized information, or an Error, so that the client can match the
+  // results with its requests.
+  vtkClientServerStream reply;
+  vtkClientServerStream css;
+  int numMessages = stream.GetNumberOfMessages();
+  for (int cc=0; cc < numMessages; cc++)
+    {
+    const char* infoClassName = 0;
+    vtkClientServerID id;
+    stream.GetArgument(cc, 0, &infoClassName);
+    stream.GetArgument(cc, 1, &id);
+
+    vtkObject* o = infoClassName?
+      vtkInstantiator::CreateInstance(infoClassName) : 0;
+    vtkPVInformation* info = vtkPVInformation::SafeDownCast(o);
+    if (info)
+      {
+      pm->GatherInformation(
+        vtkProcessModuleConnectionManager::GetSelfConnectionID(), 
+        vtkProcessModule::DATA_SERVER, info, id);
+
+      css.Reset();
+      info->CopyToStream(&css);
+      size_t length;
+      const unsigned char* data;
+      css.GetData(&data, &length);
+      reply << vtkClientServerStream::Reply
+        << vtkClientServerStream::InsertArray(data, static_cast<int>(length))
+        << vtkClientServerStream::End;
+      }
+    else
+      {
+      vtkErrorMacro("Could not create information object.");
+      reply << vtkClientServerStream::Error
+        << "Could not create information object."
+        << vtkClientServerStream::End;
+      }
+    if (o)
+      {
+      o->Delete();
+      }
+    }
+
+  size_t length;
+  const unsigned char* data;
+  reply.GetData(&data, &length);
+  int len = static_cast<int>(length);
+  this->GetSocketController()->Send(&len, 1, 1,
+    vtkRemoteConnection::ROOT_INFORMATION_LENGTH_TAG);
+  this->GetSocketController()->Send(const_cast<unsigned char*>(data),
+    length, 1, vtkRemoteConnection::ROOT_INFORMATION_TAG);
+}
+
 //-----------------------------------------------------------------------------
 void vtkClientConnection::PushUndoXMLRMI(const char* label, const char* data)
 {
@@ -48,6 +48,11 @@ public:
   // Gather information and send over to the Client.
   void SendInformation(vtkClientServerStream &stream);
 
+  // Description:
+  // Gather all the information requested by the messages of the stream and
+  // send them over to the Client in one reply.
+  void SendInformationBatch(vtkClientServerStream &stream);
+
   // Description:
   // Called when the server recieves a PushUndoSet request. Don't call
   // directly. Public so that the RMI callback can call it.
@@ -55,6 +60,10 @@ public:
   void UndoRMI();
   void RedoRMI();
 
+  // Description:
+  // Get the undo stack kept on the server for this client.
+  vtkGetObjectMacro(UndoRedoStack, vtkUndoStack);
+
   
   // Description:
   // Client connection does not support these method. Do nothing.
@@ -76,6 +76,87 @@ int vtkMultiProcessControllerHelper::ReduceToAll(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+template <class T>
+static int vtkMultiProcessControllerHelperExchange(
+  vtkMultiProcessController* controller,
+  vtkstd::vector<vtkstd::vector<T> >& outgoing,
+  vtkstd::vector<vtkstd::vector<T> >& incoming,
+  int tag)
+{
+  int myid = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+  outgoing.resize(numProcs);
+  incoming.clear();
+  incoming.resize(numProcs);
+
+  // Nothing to send over the wire for ourselves.
+  incoming[myid] = outgoing[myid];
+
+  // Pair up processes using XOR over the next power of two. Each step is a
+  // symmetric exchange, the lower id sends first.
+  int numSteps = 1;
+  while (numSteps < numProcs)
+    {
+    numSteps <<= 1;
+    }
+  for (int step = 1; step < numSteps; step++)
+    {
+    int partner = myid ^ step;
+    if (partner >= numProcs)
+      {
+      continue;
+      }
+
+    vtkstd::vector<T>& sendBuffer = outgoing[partner];
+    vtkstd::vector<T>& recvBuffer = incoming[partner];
+    vtkIdType sendLength = static_cast<vtkIdType>(sendBuffer.size());
+    vtkIdType recvLength = 0;
+    for (int phase = 0; phase < 2; phase++)
+      {
+      if ((phase == 0) == (myid < partner))
+        {
+        controller->Send(&sendLength, 1, partner, tag);
+        if (sendLength > 0)
+          {
+          controller->Send(&sendBuffer[0], sendLength, partner, tag);
+          }
+        }
+      else
+        {
+        controller->Receive(&recvLength, 1, partner, tag);
+        recvBuffer.resize(recvLength);
+        if (recvLength > 0)
+          {
+          controller->Receive(&recvBuffer[0], recvLength, partner, tag);
+          }
+        }
+      }
+    }
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+int vtkMultiProcessControllerHelper::ExchangeAllToAll(
+  vtkMultiProcessController* controller,
+  vtkstd::vector<vtkstd::vector<vtkIdType> >& outgoing,
+  vtkstd::vector<vtkstd::vector<vtkIdType> >& incoming,
+  int tag)
+{
+  return vtkMultiProcessControllerHelperExchange(
+    controller, outgoing, incoming, tag);
+}
+
+//----------------------------------------------------------------------------
+int vtkMultiProcessControllerHelper::ExchangeAllToAll(
+  vtkMultiProcessController* controller,
+  vtkstd::vector<vtkstd::vector<double> >& outgoing,
+  vtkstd::vector<vtkstd::vector<double> >& incoming,
+  int tag)
+{
+  return vtkMultiProcessControllerHelperExchange(
+    controller, outgoing, incoming, tag);
+}
 
 //----------------------------------------------------------------------------
 void vtkMultiProcessControllerHelper::PrintSelf(ostream& os, vtkIndent indent)
@@ -21,6 +21,9 @@
 #define __vtkMultiProcessControllerHelper_h
 
 #include "vtkObject.h"
+//BTX
+#include <vtkstd/vector> // needed for vector.
+//ETX
 
 class vtkMultiProcessController;
 class vtkMultiProcessStream;
@@ -40,6 +43,23 @@ public:
     vtkMultiProcessStream& data, 
     void (*operation)(vtkMultiProcessStream& A, vtkMultiProcessStream& B),
     int tag);
+
+  // Exchange variable length buffers between every pair of processes.
+  // outgoing[i] is sent to process i and incoming[i] is filled with the buffer
+  // received from process i (both vectors are sized to the number of
+  // processes). Processes are paired so that every exchange is symmetric,
+  // hence the blocking send/receive calls cannot deadlock. This must be called
+  // on all processes.
+  static int ExchangeAllToAll(
+    vtkMultiProcessController* controller,
+    vtkstd::vector<vtkstd::vector<vtkIdType> >& outgoing,
+    vtkstd::vector<vtkstd::vector<vtkIdType> >& incoming,
+    int tag);
+  static int ExchangeAllToAll(
+    vtkMultiProcessController* controller,
+    vtkstd::vector<vtkstd::vector<double> >& outgoing,
+    vtkstd::vector<vtkstd::vector<double> >& incoming,
+    int tag);
   //ETX
 
 //BTX
@@ -354,6 +354,8 @@ void vtkPVProgressHandler::CleanupPendingProgress()
     // consume any progress messages sent by the server.
     vtkRemoteConnection* rconn =
       vtkRemoteConnection::SafeDownCast(this->Connection);
+    // The server only replies once it got the cleanup request.
+    rconn->FlushStreams();
     int temp=0;
     rconn->GetSocketController()->Receive(&temp, 1, 1, CLEANUP_TAG);
     }
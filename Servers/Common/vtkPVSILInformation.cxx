@@ -16,13 +16,354 @@
 
 #include "vtkAlgorithm.h"
 #include "vtkAlgorithmOutput.h"
+#include "vtkCharArray.h"
 #include "vtkClientServerStream.h"
+#include "vtkDataSetAttributes.h"
 #include "vtkExecutive.h"
+#include "vtkFieldData.h"
 #include "vtkGraph.h"
-#include "vtkGraphReader.h"
-#include "vtkGraphWriter.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInEdgeIterator.h"
 #include "vtkInformation.h"
+#include "vtkMutableDirectedGraph.h"
 #include "vtkObjectFactory.h"
+#include "vtkOutEdgeIterator.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <vtkstd/map>
+#include <vtkstd/string>
+#include <vtkstd/utility>
+#include <vtkstd/vector>
+
+// Layout of the encoded SIL. All numbers are variable-length, 7 bits per
+// byte, and signed numbers are zigzag encoded.
+//   version, flags (1 if the "SIL Ids" and "Collapsed" arrays are present)
+//   number of vertices
+//   per vertex: length of the prefix shared with the previous name, length
+//     of the rest of the name, rest of the name
+//   if flags: per vertex, SIL id minus the previous SIL id (signed), then the
+//     number of collapsed vertices and their index minus the previous index
+//   per vertex: out degree, then per out edge (target - source) * 2 (signed)
+//     plus 1 for cross edges
+//   if flags: number of external cross edges, then per edge the vertex index
+//     and the SIL id of the other end * 2 plus 1 for edges entering the vertex
+static const vtkTypeUInt64 vtkPVSILInformationVersion = 2;
+
+//----------------------------------------------------------------------------
+static void vtkPVSILInformationWriteNumber(vtkstd::string& buffer,
+                                           vtkTypeUInt64 value)
+{
+  while (value >= 0x80)
+    {
+    buffer += static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+    }
+  buffer += static_cast<char>(value);
+}
+
+//----------------------------------------------------------------------------
+static void vtkPVSILInformationWriteSigned(vtkstd::string& buffer,
+                                           vtkTypeInt64 value)
+{
+  vtkPVSILInformationWriteNumber(buffer, value < 0?
+    ((static_cast<vtkTypeUInt64>(-(value + 1))) << 1) | 1 :
+    static_cast<vtkTypeUInt64>(value) << 1);
+}
+
+//----------------------------------------------------------------------------
+struct vtkPVSILInformationReader
+{
+  const unsigned char* Position;
+  const unsigned char* End;
+  bool Failed;
+
+  vtkTypeUInt64 ReadNumber()
+    {
+    vtkTypeUInt64 value = 0;
+    int shift = 0;
+    while (!this->Failed)
+      {
+      if (this->Position >= this->End || shift > 63)
+        {
+        this->Failed = true;
+        break;
+        }
+      unsigned char byte = *this->Position++;
+      value |= static_cast<vtkTypeUInt64>(byte & 0x7f) << shift;
+      if (!(byte & 0x80))
+        {
+        return value;
+        }
+      shift += 7;
+      }
+    return 0;
+    }
+
+  vtkTypeInt64 ReadSigned()
+    {
+    vtkTypeUInt64 value = this->ReadNumber();
+    return (value & 1)?
+      -static_cast<vtkTypeInt64>(value >> 1) - 1 :
+      static_cast<vtkTypeInt64>(value >> 1);
+    }
+
+  // Returns the number read if it is at most max, otherwise fails.
+  vtkIdType ReadCount(vtkTypeUInt64 max)
+    {
+    vtkTypeUInt64 value = this->ReadNumber();
+    if (value > max)
+      {
+      this->Failed = true;
+      return 0;
+      }
+    return static_cast<vtkIdType>(value);
+    }
+};
+
+//----------------------------------------------------------------------------
+static void vtkPVSILInformationEncode(vtkGraph* sil, vtkstd::string& buffer)
+{
+  vtkStringArray* names = vtkStringArray::SafeDownCast(
+    sil->GetVertexData()->GetAbstractArray("Names"));
+  vtkDataArray* crossEdges = vtkDataArray::SafeDownCast(
+    sil->GetEdgeData()->GetAbstractArray("CrossEdges"));
+  vtkIdTypeArray* silIds = vtkIdTypeArray::SafeDownCast(
+    sil->GetVertexData()->GetAbstractArray("SIL Ids"));
+  vtkUnsignedCharArray* collapsed = vtkUnsignedCharArray::SafeDownCast(
+    sil->GetVertexData()->GetAbstractArray("Collapsed"));
+  if (!silIds || !collapsed)
+    {
+    silIds = 0;
+    collapsed = 0;
+    }
+
+  vtkIdType numVertices = sil->GetNumberOfVertices();
+  vtkPVSILInformationWriteNumber(buffer, vtkPVSILInformationVersion);
+  vtkPVSILInformationWriteNumber(buffer, silIds? 1 : 0);
+  vtkPVSILInformationWriteNumber(buffer, 
+    static_cast<vtkTypeUInt64>(numVertices));
+
+  vtkStdString previous;
+  vtkIdType cc;
+  for (cc = 0; cc < numVertices; ++cc)
+    {
+    vtkStdString name;
+    if (names && cc < names->GetNumberOfTuples())
+      {
+      name = names->GetValue(cc);
+      }
+    size_t prefix = 0;
+    while (prefix < name.size() && prefix < previous.size() &&
+      name[prefix] == previous[prefix])
+      {
+      ++prefix;
+      }
+    vtkPVSILInformationWriteNumber(buffer, prefix);
+    vtkPVSILInformationWriteNumber(buffer, name.size() - prefix);
+    buffer.append(name, prefix, vtkstd::string::npos);
+    previous.swap(name);
+    }
+
+  if (silIds)
+    {
+    vtkIdType previousId = 0;
+    vtkstd::vector<vtkIdType> collapsedVertices;
+    for (cc = 0; cc < numVertices; ++cc)
+      {
+      vtkIdType id = cc < silIds->GetNumberOfTuples()?
+        silIds->GetValue(cc) : cc;
+      vtkPVSILInformationWriteSigned(buffer, id - previousId);
+      previousId = id;
+      if (cc < collapsed->GetNumberOfTuples() && collapsed->GetValue(cc))
+        {
+        collapsedVertices.push_back(cc);
+        }
+      }
+    vtkPVSILInformationWriteNumber(buffer, collapsedVertices.size());
+    vtkIdType previousIndex = 0;
+    for (size_t kk = 0; kk < collapsedVertices.size(); ++kk)
+      {
+      vtkPVSILInformationWriteNumber(buffer,
+        static_cast<vtkTypeUInt64>(collapsedVertices[kk] - previousIndex));
+      previousIndex = collapsedVertices[kk];
+      }
+    }
+
+  vtkSmartPointer<vtkOutEdgeIterator> iter =
+    vtkSmartPointer<vtkOutEdgeIterator>::New();
+  for (cc = 0; cc < numVertices; ++cc)
+    {
+    vtkPVSILInformationWriteNumber(buffer,
+      static_cast<vtkTypeUInt64>(sil->GetOutDegree(cc)));
+    sil->GetOutEdges(cc, iter);
+    while (iter->HasNext())
+      {
+      vtkOutEdgeType edge = iter->Next();
+      bool cross = crossEdges && crossEdges->GetTuple1(edge.Id) != 0;
+      vtkPVSILInformationWriteSigned(buffer,
+        2 * static_cast<vtkTypeInt64>(edge.Target - cc) + (cross? 1 : 0));
+      }
+    }
+
+  if (silIds)
+    {
+    vtkIdTypeArray* external = vtkIdTypeArray::SafeDownCast(
+      sil->GetFieldData()->GetAbstractArray("External Cross Edges"));
+    vtkIdType numExternal = (external &&
+      external->GetNumberOfComponents() == 3)?
+      external->GetNumberOfTuples() : 0;
+    vtkPVSILInformationWriteNumber(buffer,
+      static_cast<vtkTypeUInt64>(numExternal));
+    for (cc = 0; cc < numExternal; ++cc)
+      {
+      vtkPVSILInformationWriteNumber(buffer,
+        static_cast<vtkTypeUInt64>(external->GetValue(3*cc)));
+      vtkPVSILInformationWriteNumber(buffer,
+        2 * static_cast<vtkTypeUInt64>(external->GetValue(3*cc+1)) +
+        (external->GetValue(3*cc+2)? 1 : 0));
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+static vtkGraph* vtkPVSILInformationDecode(vtkPVSILInformationReader* reader)
+{
+  vtkTypeUInt64 remaining =
+    static_cast<vtkTypeUInt64>(reader->End - reader->Position);
+  if (reader->ReadNumber() != vtkPVSILInformationVersion)
+    {
+    return 0;
+    }
+  bool hasIds = reader->ReadNumber() != 0;
+  // Each vertex takes at least 3 bytes.
+  vtkIdType numVertices = reader->ReadCount(remaining / 3);
+  if (reader->Failed)
+    {
+    return 0;
+    }
+
+  vtkSmartPointer<vtkMutableDirectedGraph> sil =
+    vtkSmartPointer<vtkMutableDirectedGraph>::New();
+  vtkSmartPointer<vtkStringArray> names =
+    vtkSmartPointer<vtkStringArray>::New();
+  names->SetName("Names");
+  names->SetNumberOfTuples(numVertices);
+  vtkSmartPointer<vtkCharArray> crossEdges =
+    vtkSmartPointer<vtkCharArray>::New();
+  crossEdges->SetName("CrossEdges");
+
+  vtkstd::string previous;
+  vtkIdType cc;
+  for (cc = 0; cc < numVertices && !reader->Failed; ++cc)
+    {
+    size_t prefix = static_cast<size_t>(reader->ReadCount(previous.size()));
+    size_t length = static_cast<size_t>(reader->ReadCount(
+      static_cast<vtkTypeUInt64>(reader->End - reader->Position)));
+    if (reader->Failed)
+      {
+      break;
+      }
+    previous.resize(prefix);
+    previous.append(reinterpret_cast<const char*>(reader->Position), length);
+    reader->Position += length;
+    names->SetValue(cc, previous.c_str());
+    sil->AddVertex();
+    }
+
+  vtkSmartPointer<vtkIdTypeArray> silIds;
+  vtkSmartPointer<vtkUnsignedCharArray> collapsed;
+  if (hasIds)
+    {
+    silIds = vtkSmartPointer<vtkIdTypeArray>::New();
+    silIds->SetName("SIL Ids");
+    silIds->SetNumberOfTuples(numVertices);
+    collapsed = vtkSmartPointer<vtkUnsignedCharArray>::New();
+    collapsed->SetName("Collapsed");
+    collapsed->SetNumberOfTuples(numVertices);
+    collapsed->FillComponent(0, 0);
+    vtkIdType previousId = 0;
+    for (cc = 0; cc < numVertices && !reader->Failed; ++cc)
+      {
+      previousId += static_cast<vtkIdType>(reader->ReadSigned());
+      silIds->SetValue(cc, previousId);
+      }
+    vtkIdType numCollapsed = reader->ReadCount(
+      static_cast<vtkTypeUInt64>(numVertices));
+    vtkIdType index = 0;
+    for (cc = 0; cc < numCollapsed && !reader->Failed; ++cc)
+      {
+      index += static_cast<vtkIdType>(reader->ReadNumber());
+      if (index < 0 || index >= numVertices)
+        {
+        reader->Failed = true;
+        break;
+        }
+      collapsed->SetValue(index, 1);
+      }
+    }
+
+  for (cc = 0; cc < numVertices && !reader->Failed; ++cc)
+    {
+    vtkIdType degree = reader->ReadCount(
+      static_cast<vtkTypeUInt64>(reader->End - reader->Position));
+    for (vtkIdType kk = 0; kk < degree && !reader->Failed; ++kk)
+      {
+      vtkTypeInt64 value = reader->ReadSigned();
+      bool cross = (value & 1) != 0;
+      vtkIdType target = cc + static_cast<vtkIdType>((value - (cross? 1 : 0)) / 2);
+      if (target < 0 || target >= numVertices)
+        {
+        reader->Failed = true;
+        break;
+        }
+      vtkEdgeType edge = sil->AddEdge(cc, target);
+      crossEdges->InsertValue(edge.Id, cross? 1 : 0);
+      }
+    }
+
+  vtkSmartPointer<vtkIdTypeArray> external;
+  if (hasIds && !reader->Failed)
+    {
+    external = vtkSmartPointer<vtkIdTypeArray>::New();
+    external->SetName("External Cross Edges");
+    external->SetNumberOfComponents(3);
+    // Each external cross edge takes at least 2 bytes.
+    vtkIdType numExternal = reader->ReadCount(
+      static_cast<vtkTypeUInt64>(reader->End - reader->Position) / 2);
+    for (cc = 0; cc < numExternal && !reader->Failed; ++cc)
+      {
+      vtkIdType tuple[3];
+      tuple[0] = static_cast<vtkIdType>(reader->ReadNumber());
+      if (tuple[0] < 0 || tuple[0] >= numVertices)
+        {
+        reader->Failed = true;
+        break;
+        }
+      vtkTypeUInt64 value = reader->ReadNumber();
+      tuple[1] = static_cast<vtkIdType>(value >> 1);
+      tuple[2] = static_cast<vtkIdType>(value & 1);
+      external->InsertNextTupleValue(tuple);
+      }
+    }
+
+  if (reader->Failed)
+    {
+    return 0;
+    }
+
+  sil->GetVertexData()->AddArray(names);
+  if (hasIds)
+    {
+    sil->GetVertexData()->AddArray(silIds);
+    sil->GetVertexData()->AddArray(collapsed);
+    sil->GetFieldData()->AddArray(external);
+    }
+  sil->GetEdgeData()->AddArray(crossEdges);
+  sil->Register(0);
+  return sil;
+}
 
 vtkStandardNewMacro(vtkPVSILInformation);
 vtkCxxSetObjectMacro(vtkPVSILInformation, SIL, vtkGraph);
@@ -31,12 +372,16 @@ vtkPVSILInformation::vtkPVSILInformation()
 {
   this->RootOnly = 1;
   this->SIL = 0;
+  this->SubtreeRoot = 0;
+  this->SubtreeName = 0;
+  this->MaximumDepth = -1;
 }
 
 //----------------------------------------------------------------------------
 vtkPVSILInformation::~vtkPVSILInformation()
 {
   this->SetSIL(0);
+  this->SetSubtreeName(0);
 }
 
 //----------------------------------------------------------------------------
@@ -70,40 +415,183 @@ void vtkPVSILInformation::CopyFromObject(vtkObject* obj)
   if (info && info->Has(vtkDataObject::SIL()))
     {
     vtkGraph* sil = vtkGraph::SafeDownCast(info->Get(vtkDataObject::SIL()));
-    this->SetSIL(sil);
+    if (sil && (this->SubtreeRoot != 0 || this->SubtreeName ||
+        this->MaximumDepth >= 0))
+      {
+      vtkGraph* subtree = this->ExtractSubtree(sil);
+      this->SetSIL(subtree);
+      if (subtree)
+        {
+        subtree->Delete();
+        }
+      }
+    else
+      {
+      this->SetSIL(sil);
+      }
     }
 }
 
 //----------------------------------------------------------------------------
-void vtkPVSILInformation::CopyToStream(vtkClientServerStream* css)
+vtkGraph* vtkPVSILInformation::ExtractSubtree(vtkGraph* sil)
 {
-  css->Reset();
-  if (!this->SIL)
+  vtkStringArray* names = vtkStringArray::SafeDownCast(
+    sil->GetVertexData()->GetAbstractArray("Names"));
+  vtkDataArray* crossEdges = vtkDataArray::SafeDownCast(
+    sil->GetEdgeData()->GetAbstractArray("CrossEdges"));
+  if (!names || !crossEdges)
     {
-    *css << vtkClientServerStream::Reply 
-         << vtkClientServerStream::InsertArray(
-           static_cast<unsigned char*>(NULL), 0)
-         << vtkClientServerStream::End;
-    return;
+    vtkErrorMacro("SIL is missing the Names or CrossEdges arrays.");
+    return 0;
+    }
+
+  vtkIdType numVertices = sil->GetNumberOfVertices();
+  vtkIdType root = this->SubtreeRoot;
+  if (this->SubtreeName)
+    {
+    // Like vtkSMSILModel::FindVertex(), the last vertex with the name wins.
+    root = -1;
+    for (vtkIdType cc = 0; cc < numVertices; ++cc)
+      {
+      if (names->GetValue(cc) == this->SubtreeName)
+        {
+        root = cc;
+        }
+      }
+    }
+  if (root < 0 || root >= numVertices)
+    {
+    return 0;
+    }
+
+  vtkMutableDirectedGraph* subtree = vtkMutableDirectedGraph::New();
+  vtkSmartPointer<vtkStringArray> subtreeNames =
+    vtkSmartPointer<vtkStringArray>::New();
+  subtreeNames->SetName("Names");
+  vtkSmartPointer<vtkIdTypeArray> silIds =
+    vtkSmartPointer<vtkIdTypeArray>::New();
+  silIds->SetName("SIL Ids");
+  vtkSmartPointer<vtkUnsignedCharArray> collapsed =
+    vtkSmartPointer<vtkUnsignedCharArray>::New();
+  collapsed->SetName("Collapsed");
+  vtkSmartPointer<vtkCharArray> subtreeCrossEdges =
+    vtkSmartPointer<vtkCharArray>::New();
+  subtreeCrossEdges->SetName("CrossEdges");
+
+  // Breadth first walk of the child edges, adding the child edges of a
+  // vertex right after it so that they come before its cross edges.
+  typedef vtkstd::map<vtkIdType, vtkIdType> IdMapType;
+  IdMapType newIds;
+  vtkstd::vector<vtkstd::pair<vtkIdType, int> > queue;
+  queue.push_back(vtkstd::pair<vtkIdType, int>(root, 0));
+  newIds[root] = subtree->AddVertex();
+  subtreeNames->InsertNextValue(names->GetValue(root));
+  silIds->InsertNextValue(root);
+  collapsed->InsertNextValue(0);
+
+  vtkSmartPointer<vtkOutEdgeIterator> iter =
+    vtkSmartPointer<vtkOutEdgeIterator>::New();
+  for (size_t cc = 0; cc < queue.size(); ++cc)
+    {
+    vtkIdType vertex = queue[cc].first;
+    int depth = queue[cc].second;
+    vtkIdType newVertex = newIds[vertex];
+    sil->GetOutEdges(vertex, iter);
+    while (iter->HasNext())
+      {
+      vtkOutEdgeType edge = iter->Next();
+      if (crossEdges->GetTuple1(edge.Id) != 0 ||
+        newIds.find(edge.Target) != newIds.end())
+        {
+        continue;
+        }
+      if (this->MaximumDepth >= 0 && depth >= this->MaximumDepth)
+        {
+        collapsed->SetValue(newVertex, 1);
+        break;
+        }
+      vtkIdType child = subtree->AddVertex();
+      newIds[edge.Target] = child;
+      subtreeNames->InsertNextValue(names->GetValue(edge.Target));
+      silIds->InsertNextValue(edge.Target);
+      collapsed->InsertNextValue(0);
+      vtkEdgeType newEdge = subtree->AddEdge(newVertex, child);
+      subtreeCrossEdges->InsertValue(newEdge.Id, 0);
+      queue.push_back(vtkstd::pair<vtkIdType, int>(edge.Target, depth + 1));
+      }
+    }
+
+  // Cross edges between the vertices gathered. The cross edges to or from
+  // other vertices are kept with the SIL id of the other end, so that they
+  // can be restored when that vertex is gathered too.
+  vtkSmartPointer<vtkIdTypeArray> external =
+    vtkSmartPointer<vtkIdTypeArray>::New();
+  external->SetName("External Cross Edges");
+  external->SetNumberOfComponents(3);
+  vtkSmartPointer<vtkInEdgeIterator> inIter =
+    vtkSmartPointer<vtkInEdgeIterator>::New();
+  for (size_t cc = 0; cc < queue.size(); ++cc)
+    {
+    vtkIdType vertex = queue[cc].first;
+    vtkIdType tuple[3] = { newIds[vertex], 0, 0 };
+    sil->GetOutEdges(vertex, iter);
+    while (iter->HasNext())
+      {
+      vtkOutEdgeType edge = iter->Next();
+      if (crossEdges->GetTuple1(edge.Id) == 0)
+        {
+        continue;
+        }
+      IdMapType::iterator target = newIds.find(edge.Target);
+      if (target != newIds.end())
+        {
+        vtkEdgeType newEdge = subtree->AddEdge(tuple[0], target->second);
+        subtreeCrossEdges->InsertValue(newEdge.Id, 1);
+        }
+      else
+        {
+        tuple[1] = edge.Target;
+        tuple[2] = 0;
+        external->InsertNextTupleValue(tuple);
+        }
+      }
+    sil->GetInEdges(vertex, inIter);
+    while (inIter->HasNext())
+      {
+      vtkInEdgeType edge = inIter->Next();
+      if (crossEdges->GetTuple1(edge.Id) != 0 &&
+        newIds.find(edge.Source) == newIds.end())
+        {
+        tuple[1] = edge.Source;
+        tuple[2] = 1;
+        external->InsertNextTupleValue(tuple);
+        }
+      }
     }
 
-  vtkGraph* clone = this->SIL->NewInstance();
-  clone->ShallowCopy(this->SIL);
+  subtree->GetVertexData()->AddArray(subtreeNames);
+  subtree->GetVertexData()->AddArray(silIds);
+  subtree->GetVertexData()->AddArray(collapsed);
+  subtree->GetEdgeData()->AddArray(subtreeCrossEdges);
+  subtree->GetFieldData()->AddArray(external);
+  return subtree;
+}
 
-  vtkGraphWriter* writer = vtkGraphWriter::New();
-  writer->SetFileTypeToBinary();
-  writer->WriteToOutputStringOn();
-  writer->SetInput(clone);
-  writer->Write();
+//----------------------------------------------------------------------------
+void vtkPVSILInformation::CopyToStream(vtkClientServerStream* css)
+{
+  css->Reset();
+  vtkstd::string buffer;
+  if (this->SIL)
+    {
+    vtkPVSILInformationEncode(this->SIL, buffer);
+    }
 
   *css << vtkClientServerStream::Reply
        << vtkClientServerStream::InsertArray(
-         writer->GetBinaryOutputString(),
-         writer->GetOutputStringLength())
+         reinterpret_cast<const unsigned char*>(buffer.data()),
+         static_cast<int>(buffer.size()))
        << vtkClientServerStream::End;
-  writer->RemoveAllInputs();
-  writer->Delete();
-  clone->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -115,13 +603,19 @@ void vtkPVSILInformation::CopyFromStream(const vtkClientServerStream* css)
     {
     unsigned char* raw_data = new unsigned char[length];
     css->GetArgument(0, 0, raw_data, length);
-    vtkGraphReader* reader = vtkGraphReader::New();
-    reader->SetBinaryInputString(reinterpret_cast<const char*>(raw_data), length);
-    reader->ReadFromInputStringOn();
+    vtkPVSILInformationReader reader;
+    reader.Position = raw_data;
+    reader.End = raw_data + length;
+    reader.Failed = false;
+    vtkGraph* sil = vtkPVSILInformationDecode(&reader);
     delete []raw_data;
-    reader->Update();
-    this->SetSIL(reader->GetOutput());
-    reader->Delete();
+    if (!sil)
+      {
+      vtkErrorMacro("Error parsing SIL information.");
+      return;
+      }
+    this->SetSIL(sil);
+    sil->Delete();
     }
 }
 
@@ -130,6 +624,8 @@ void vtkPVSILInformation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "SIL: " <<  this->SIL << endl;
+  os << indent << "SubtreeRoot: " << this->SubtreeRoot << endl;
+  os << indent << "SubtreeName: "
+    << (this->SubtreeName? this->SubtreeName : "(none)") << endl;
+  os << indent << "MaximumDepth: " << this->MaximumDepth << endl;
 }
-
-
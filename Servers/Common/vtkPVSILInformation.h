@@ -12,9 +12,26 @@
      PURPOSE.  See the above copyright notice for more information.
 
 =========================================================================*/
-// .NAME vtkPVSILInformation
+// .NAME vtkPVSILInformation - information object to collect the SIL of a
+// reader.
 // .SECTION Description
+// vtkPVSILInformation gathers the subset inclusion lattice (SIL) a reader
+// provides in its output information. It is sent in a compact binary form:
+// vertex names share their prefix with the previous name and edges are
+// stored as small differences between vertex ids.
 //
+// Large SILs need not be gathered whole. SubtreeRoot (or SubtreeName) and
+// MaximumDepth restrict the SIL to the top levels of a subtree. Vertex 0 of
+// such a SIL is the subtree root, the "SIL Ids" vertex array gives the ids of
+// the vertices in the reader's SIL and the "Collapsed" vertex array is 1 for
+// vertices whose children were left out. Those can be fetched later with
+// another gather rooted at the collapsed vertex. Cross edges between vertices
+// gathered together are kept as edges. The cross edges between a gathered
+// vertex and a vertex left out are listed in the "External Cross Edges"
+// field data array, one tuple per edge: the vertex, the SIL id of the other
+// end and 1 if the edge enters the vertex (0 if it leaves it). Since
+// information objects do not send parameters to the server, partial gathers
+// on a server go through vtkPVServerSIL.
 
 #ifndef __vtkPVSILInformation_h
 #define __vtkPVSILInformation_h
@@ -45,13 +62,41 @@ public:
   // Returns the SIL.
   vtkGetObjectMacro(SIL, vtkGraph);
 
+  // Description:
+  // Id, in the reader's SIL, of the root of the subtree to gather. 0, the
+  // root of the SIL, by default.
+  vtkSetMacro(SubtreeRoot, vtkIdType);
+  vtkGetMacro(SubtreeRoot, vtkIdType);
+
+  // Description:
+  // When set, the subtree to gather is the one below the vertex with this
+  // name, as found by vtkSMSILModel::FindVertex(). Overrides SubtreeRoot.
+  vtkSetStringMacro(SubtreeName);
+  vtkGetStringMacro(SubtreeName);
+
+  // Description:
+  // Maximum number of child edges between the subtree root and the vertices
+  // gathered. -1, the default, gathers the whole subtree.
+  vtkSetMacro(MaximumDepth, int);
+  vtkGetMacro(MaximumDepth, int);
+
 //BTX
 protected:
   vtkPVSILInformation();
   ~vtkPVSILInformation();
 
   void SetSIL(vtkGraph*);
+
+  // Description:
+  // Returns a new graph holding the part of the SIL selected by
+  // SubtreeRoot, SubtreeName and MaximumDepth, or NULL if the subtree root
+  // does not exist.
+  vtkGraph* ExtractSubtree(vtkGraph* sil);
+
   vtkGraph* SIL;
+  vtkIdType SubtreeRoot;
+  char* SubtreeName;
+  int MaximumDepth;
 private:
   vtkPVSILInformation(const vtkPVSILInformation&); // Not implemented
   void operator=(const vtkPVSILInformation&); // Not implemented
@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVUndoStackInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVUndoStackInformation.h"
+
+#include "vtkClientConnection.h"
+#include "vtkClientServerStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkProcessModule.h"
+#include "vtkUndoStack.h"
+
+vtkStandardNewMacro(vtkPVUndoStackInformation);
+//-----------------------------------------------------------------------------
+vtkPVUndoStackInformation::vtkPVUndoStackInformation()
+{
+  this->RootOnly = 1;
+  this->NumberOfUndoSets = 0;
+  this->NumberOfRedoSets = 0;
+  this->MemorySize = 0;
+  this->MemoryBudget = 0;
+  this->NumberOfTrimmedSets = 0;
+}
+
+//-----------------------------------------------------------------------------
+vtkPVUndoStackInformation::~vtkPVUndoStackInformation()
+{
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVUndoStackInformation::CopyFromObject(vtkObject* obj)
+{
+  vtkUndoStack* stack = vtkUndoStack::SafeDownCast(obj);
+  vtkProcessModule* pm = vtkProcessModule::SafeDownCast(obj);
+  if (pm)
+    {
+    // Only servers keep undo stacks for their clients.
+    vtkClientConnection* connection = vtkClientConnection::SafeDownCast(
+      pm->GetActiveRemoteConnection());
+    stack = connection? connection->GetUndoRedoStack() : 0;
+    if (!stack)
+      {
+      return;
+      }
+    }
+  if (!stack)
+    {
+    vtkErrorMacro(
+      "vtkPVUndoStackInformation requires vtkUndoStack to gather info.");
+    return;
+    }
+  this->NumberOfUndoSets = static_cast<int>(stack->GetNumberOfUndoSets());
+  this->NumberOfRedoSets = static_cast<int>(stack->GetNumberOfRedoSets());
+  this->MemorySize = stack->GetMemorySize();
+  this->MemoryBudget = stack->GetMemoryBudget();
+  this->NumberOfTrimmedSets = stack->GetNumberOfTrimmedSets();
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVUndoStackInformation::CopyToStream(vtkClientServerStream* stream)
+{
+  stream->Reset();
+  *stream << vtkClientServerStream::Reply
+    << this->NumberOfUndoSets
+    << this->NumberOfRedoSets
+    << this->MemorySize
+    << this->MemoryBudget
+    << this->NumberOfTrimmedSets
+    << vtkClientServerStream::End;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVUndoStackInformation::CopyFromStream(
+  const vtkClientServerStream* stream)
+{
+  if (!stream->GetArgument(0, 0, &this->NumberOfUndoSets) ||
+    !stream->GetArgument(0, 1, &this->NumberOfRedoSets) ||
+    !stream->GetArgument(0, 2, &this->MemorySize) ||
+    !stream->GetArgument(0, 3, &this->MemoryBudget) ||
+    !stream->GetArgument(0, 4, &this->NumberOfTrimmedSets))
+    {
+    vtkErrorMacro("Error parsing undo stack information.");
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVUndoStackInformation::AddInformation(vtkPVInformation* info)
+{
+  vtkPVUndoStackInformation* uinfo =
+    vtkPVUndoStackInformation::SafeDownCast(info);
+  if (!uinfo)
+    {
+    vtkErrorMacro("AddInformation needs vtkPVUndoStackInformation.");
+    return;
+    }
+  this->NumberOfUndoSets += uinfo->NumberOfUndoSets;
+  this->NumberOfRedoSets += uinfo->NumberOfRedoSets;
+  this->MemorySize += uinfo->MemorySize;
+  this->MemoryBudget += uinfo->MemoryBudget;
+  this->NumberOfTrimmedSets += uinfo->NumberOfTrimmedSets;
+}
+
+//-----------------------------------------------------------------------------
+void vtkPVUndoStackInformation::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfUndoSets: " << this->NumberOfUndoSets << endl;
+  os << indent << "NumberOfRedoSets: " << this->NumberOfRedoSets << endl;
+  os << indent << "MemorySize: " << this->MemorySize << endl;
+  os << indent << "MemoryBudget: " << this->MemoryBudget << endl;
+  os << indent << "NumberOfTrimmedSets: " << this->NumberOfTrimmedSets
+    << endl;
+}
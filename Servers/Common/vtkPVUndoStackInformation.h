@@ -0,0 +1,77 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVUndoStackInformation.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPVUndoStackInformation - information object to collect the
+// size of an undo stack.
+// .SECTION Description
+// Gathers the number of sets and the memory used by a vtkUndoStack. When
+// gathered from the vtkProcessModule on a server, it describes the undo
+// stack the server keeps for the client asking.
+
+#ifndef __vtkPVUndoStackInformation_h
+#define __vtkPVUndoStackInformation_h
+
+#include "vtkPVInformation.h"
+
+class VTK_EXPORT vtkPVUndoStackInformation : public vtkPVInformation
+{
+public:
+  static vtkPVUndoStackInformation* New();
+  vtkTypeMacro(vtkPVUndoStackInformation, vtkPVInformation);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Transfer information about a single object into this object.
+  // The object is either a vtkUndoStack or the vtkProcessModule.
+  virtual void CopyFromObject(vtkObject*);
+
+  // Description:
+  // Merge another information object.
+  virtual void AddInformation(vtkPVInformation*);
+
+  //BTX
+  // Description:
+  // Manage a serialized version of the information.
+  virtual void CopyToStream(vtkClientServerStream*);
+  virtual void CopyFromStream(const vtkClientServerStream*);
+  //ETX
+
+  // Description:
+  // Number of sets on the undo and redo stacks.
+  vtkGetMacro(NumberOfUndoSets, int);
+  vtkGetMacro(NumberOfRedoSets, int);
+
+  // Description:
+  // Memory, in bytes, used by the sets, and the budget of the stack.
+  vtkGetMacro(MemorySize, vtkIdType);
+  vtkGetMacro(MemoryBudget, vtkIdType);
+
+  // Description:
+  // Number of sets removed to stay within the budget.
+  vtkGetMacro(NumberOfTrimmedSets, int);
+protected:
+  vtkPVUndoStackInformation();
+  ~vtkPVUndoStackInformation();
+
+  int NumberOfUndoSets;
+  int NumberOfRedoSets;
+  vtkIdType MemorySize;
+  vtkIdType MemoryBudget;
+  int NumberOfTrimmedSets;
+private:
+  vtkPVUndoStackInformation(const vtkPVUndoStackInformation&); // Not implemented.
+  void operator=(const vtkPVUndoStackInformation&); // Not implemented.
+};
+
+#endif
@@ -0,0 +1,665 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVXMLBinaryFormat.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVXMLBinaryFormat.h"
+
+#include "vtkByteSwap.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVXMLElement.h"
+
+#include <vtkstd/map>
+#include <vtkstd/string>
+#include <vtkstd/vector>
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32) && !defined(__CYGWIN__)
+# define SNPRINTF _snprintf
+#else
+# define SNPRINTF snprintf
+#endif
+
+vtkStandardNewMacro(vtkPVXMLBinaryFormat);
+
+// A file starts with this signature, followed by the format version, the
+// string table and the root element.
+static const char vtkPVXMLBinaryFormatSignature[8] =
+  { 'P', 'V', 'X', 'M', 'L', 'B', 'I', 'N' };
+static const unsigned int vtkPVXMLBinaryFormatVersion = 1;
+
+// Records in the list of nested elements of an element.
+enum
+{
+  VTK_PVXML_ELEMENT_RECORD = 0,
+  VTK_PVXML_RUN_RECORD = 1
+};
+
+// Encodings of the values of a run of <Element index="" value=""/>.
+enum
+{
+  VTK_PVXML_RUN_STRINGS = 0,
+  VTK_PVXML_RUN_INTEGERS = 1,
+  VTK_PVXML_RUN_DOUBLES = 2
+};
+
+// Shorter runs are written as plain elements.
+static const size_t vtkPVXMLBinaryFormatMinimumRunLength = 4;
+
+//----------------------------------------------------------------------------
+// Numbers are written 7 bits at a time, least significant first, with the
+// high bit set on all bytes but the last.
+static void vtkPVXMLBinaryFormatWriteNumber(vtkstd::string& buffer,
+                                            vtkTypeUInt64 value)
+{
+  while(value >= 0x80)
+    {
+    buffer += static_cast<char>((value & 0x7f) | 0x80);
+    value >>= 7;
+    }
+  buffer += static_cast<char>(value);
+}
+
+//----------------------------------------------------------------------------
+static bool vtkPVXMLBinaryFormatIsBlank(const char* text)
+{
+  for(; *text; ++text)
+    {
+    if(!isspace(static_cast<unsigned char>(*text)))
+      {
+      return false;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Parses an integer that is printed back as the same text.
+static bool vtkPVXMLBinaryFormatParseInteger(const char* text, int* value)
+{
+  char* end;
+  long parsed = strtol(text, &end, 10);
+  if(end == text || *end || parsed < VTK_INT_MIN || parsed > VTK_INT_MAX)
+    {
+    return false;
+    }
+  char buffer[32];
+  SNPRINTF(buffer, sizeof(buffer), "%d", static_cast<int>(parsed));
+  if(strcmp(buffer, text) != 0)
+    {
+    return false;
+    }
+  *value = static_cast<int>(parsed);
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Returns true for <Element index="i" value="..."/> and gives its index.
+static bool vtkPVXMLBinaryFormatIsRunElement(vtkPVXMLElement* element,
+                                             int* index)
+{
+  const char* name = element->GetName();
+  return (name && strcmp(name, "Element") == 0 &&
+          element->GetNumberOfAttributes() == 2 &&
+          element->GetNumberOfNestedElements() == 0 &&
+          strcmp(element->GetAttributeName(0), "index") == 0 &&
+          strcmp(element->GetAttributeName(1), "value") == 0 &&
+          vtkPVXMLBinaryFormatParseInteger(
+            element->GetAttributeValue(0), index) && *index >= 0 &&
+          vtkPVXMLBinaryFormatIsBlank(element->GetCharacterData()));
+}
+
+//----------------------------------------------------------------------------
+struct vtkPVXMLBinaryFormatWriter
+{
+  typedef vtkstd::map<vtkstd::string, vtkTypeUInt64> StringIdsType;
+  StringIdsType StringIds;
+  vtkstd::vector<const vtkstd::string*> Strings;
+  vtkstd::string Body;
+
+  // Scratch space for runs.
+  vtkstd::vector<const char*> Values;
+  vtkstd::vector<int> Integers;
+  vtkstd::vector<double> Doubles;
+
+  void WriteNumber(vtkTypeUInt64 value)
+    {
+    vtkPVXMLBinaryFormatWriteNumber(this->Body, value);
+    }
+
+  void WriteString(const char* text)
+    {
+    vtkstd::pair<StringIdsType::iterator, bool> result =
+      this->StringIds.insert(StringIdsType::value_type(
+          text, static_cast<vtkTypeUInt64>(this->Strings.size())));
+    if(result.second)
+      {
+      this->Strings.push_back(&result.first->first);
+      }
+    this->WriteNumber(result.first->second);
+    }
+
+  // Returns the smallest precision printing all Values back as they are
+  // with "%.*g", or 0 if there is none.
+  int FindPrecision()
+    {
+    size_t count = this->Values.size();
+    this->Doubles.resize(count);
+    size_t i;
+    for(i=0; i < count; ++i)
+      {
+      char* end;
+      this->Doubles[i] = strtod(this->Values[i], &end);
+      if(end == this->Values[i] || *end)
+        {
+        return 0;
+        }
+      }
+    char buffer[64];
+    for(int precision=1; precision <= 17; ++precision)
+      {
+      for(i=0; i < count; ++i)
+        {
+        SNPRINTF(buffer, sizeof(buffer), "%.*g", precision, this->Doubles[i]);
+        if(strcmp(buffer, this->Values[i]) != 0)
+          {
+          break;
+          }
+        }
+      if(i == count)
+        {
+        return precision;
+        }
+      }
+    return 0;
+    }
+
+  // Writes the run of elements starting at the given nested element of
+  // parent, if it is long enough. Returns the number of elements written.
+  unsigned int WriteRun(vtkPVXMLElement* parent, unsigned int first)
+    {
+    unsigned int numberOfNested = parent->GetNumberOfNestedElements();
+    int start = 0;
+    this->Values.clear();
+    for(unsigned int i=first; i < numberOfNested; ++i)
+      {
+      vtkPVXMLElement* child = parent->GetNestedElement(i);
+      int index;
+      if(!vtkPVXMLBinaryFormatIsRunElement(child, &index))
+        {
+        break;
+        }
+      if(i == first)
+        {
+        start = index;
+        }
+      else if(index - start != static_cast<int>(i - first))
+        {
+        break;
+        }
+      this->Values.push_back(child->GetAttributeValue(1));
+      }
+    size_t count = this->Values.size();
+    if(count < vtkPVXMLBinaryFormatMinimumRunLength)
+      {
+      return 0;
+      }
+
+    this->WriteNumber(VTK_PVXML_RUN_RECORD);
+    this->WriteNumber(static_cast<vtkTypeUInt64>(start));
+    this->WriteNumber(static_cast<vtkTypeUInt64>(count));
+
+    size_t i;
+    this->Integers.resize(count);
+    for(i=0; i < count; ++i)
+      {
+      if(!vtkPVXMLBinaryFormatParseInteger(this->Values[i],
+                                           &this->Integers[i]))
+        {
+        break;
+        }
+      }
+    if(i == count)
+      {
+      this->WriteNumber(VTK_PVXML_RUN_INTEGERS);
+      for(i=0; i < count; ++i)
+        {
+        // Zig-zag encoding keeps small negative numbers short.
+        vtkTypeUInt32 value = static_cast<vtkTypeUInt32>(this->Integers[i]);
+        this->WriteNumber((value << 1) ^ (this->Integers[i] < 0? 0xffffffff : 0));
+        }
+      return static_cast<unsigned int>(count);
+      }
+
+    int precision = this->FindPrecision();
+    if(precision > 0)
+      {
+      this->WriteNumber(VTK_PVXML_RUN_DOUBLES);
+      this->WriteNumber(static_cast<vtkTypeUInt64>(precision));
+      for(i=0; i < count; ++i)
+        {
+        double value = this->Doubles[i];
+        vtkByteSwap::Swap8LE(&value);
+        this->Body.append(reinterpret_cast<const char*>(&value), 8);
+        }
+      return static_cast<unsigned int>(count);
+      }
+
+    this->WriteNumber(VTK_PVXML_RUN_STRINGS);
+    for(i=0; i < count; ++i)
+      {
+      this->WriteString(this->Values[i]);
+      }
+    return static_cast<unsigned int>(count);
+    }
+};
+
+//----------------------------------------------------------------------------
+struct vtkPVXMLBinaryFormatReader
+{
+  const unsigned char* Position;
+  const unsigned char* End;
+  vtkstd::vector<vtkstd::string> Strings;
+  unsigned int ElementIdIndex;
+  bool Failed;
+
+  vtkTypeUInt64 ReadNumber()
+    {
+    vtkTypeUInt64 value = 0;
+    for(int shift=0; shift < 64 && this->Position < this->End; shift += 7)
+      {
+      unsigned char byte = *this->Position++;
+      value |= static_cast<vtkTypeUInt64>(byte & 0x7f) << shift;
+      if(!(byte & 0x80))
+        {
+        return value;
+        }
+      }
+    this->Failed = true;
+    return 0;
+    }
+
+  const char* ReadString()
+    {
+    vtkTypeUInt64 id = this->ReadNumber();
+    if(id >= this->Strings.size())
+      {
+      this->Failed = true;
+      return 0;
+      }
+    return this->Strings[static_cast<size_t>(id)].c_str();
+    }
+
+  // Returns the next length bytes, or 0 if there are not that many left.
+  const char* ReadBytes(vtkTypeUInt64 length)
+    {
+    if(length > static_cast<vtkTypeUInt64>(this->End - this->Position))
+      {
+      this->Failed = true;
+      return 0;
+      }
+    const char* bytes = reinterpret_cast<const char*>(this->Position);
+    this->Position += length;
+    return bytes;
+    }
+};
+
+//----------------------------------------------------------------------------
+vtkPVXMLBinaryFormat::vtkPVXMLBinaryFormat()
+{
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLBinaryFormat::~vtkPVXMLBinaryFormat()
+{
+}
+
+//----------------------------------------------------------------------------
+int vtkPVXMLBinaryFormat::IsBinaryFile(const char* filename)
+{
+  if(!filename)
+    {
+    return 0;
+    }
+  ifstream is(filename, ios::in | ios::binary);
+  char signature[sizeof(vtkPVXMLBinaryFormatSignature)];
+  if(!is || !is.read(signature, sizeof(signature)))
+    {
+    return 0;
+    }
+  return memcmp(signature, vtkPVXMLBinaryFormatSignature,
+                sizeof(signature)) == 0? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkPVXMLBinaryFormat::WriteFile(vtkPVXMLElement* root,
+                                    const char* filename)
+{
+  if(!filename)
+    {
+    return 0;
+    }
+  ofstream os(filename, ios::out | ios::binary);
+  if(!os)
+    {
+    vtkGenericWarningMacro("Cannot open " << filename << " for writing.");
+    return 0;
+    }
+  return vtkPVXMLBinaryFormat::Write(root, os);
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLElement* vtkPVXMLBinaryFormat::ReadFile(const char* filename)
+{
+  if(!filename)
+    {
+    return 0;
+    }
+  ifstream is(filename, ios::in | ios::binary);
+  if(!is)
+    {
+    vtkGenericWarningMacro("Cannot open " << filename << " for reading.");
+    return 0;
+    }
+  is.seekg(0, ios::end);
+  size_t length = static_cast<size_t>(is.tellg());
+  is.seekg(0, ios::beg);
+  vtkstd::vector<char> buffer(length + 1);
+  if(!is.read(&buffer[0], length))
+    {
+    vtkGenericWarningMacro("Cannot read " << filename << ".");
+    return 0;
+    }
+  return vtkPVXMLBinaryFormat::Read(&buffer[0], length);
+}
+
+//----------------------------------------------------------------------------
+int vtkPVXMLBinaryFormat::Write(vtkPVXMLElement* root, ostream& os)
+{
+  if(!root)
+    {
+    return 0;
+    }
+
+  // The body is written first since it fills the string table.
+  vtkPVXMLBinaryFormatWriter writer;
+  vtkPVXMLBinaryFormat::WriteElement(&writer, root);
+
+  vtkstd::string header(vtkPVXMLBinaryFormatSignature,
+                        sizeof(vtkPVXMLBinaryFormatSignature));
+  vtkPVXMLBinaryFormatWriteNumber(header, vtkPVXMLBinaryFormatVersion);
+  vtkPVXMLBinaryFormatWriteNumber(header, writer.Strings.size());
+  vtkstd::vector<const vtkstd::string*>::iterator iter;
+  for(iter = writer.Strings.begin(); iter != writer.Strings.end(); ++iter)
+    {
+    vtkPVXMLBinaryFormatWriteNumber(header, (*iter)->size());
+    header += **iter;
+    }
+
+  os.write(header.data(), header.size());
+  os.write(writer.Body.data(), writer.Body.size());
+  return os? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLBinaryFormat::WriteElement(vtkPVXMLBinaryFormatWriter* writer,
+                                        vtkPVXMLElement* element)
+{
+  // A flag tells elements without a name apart.
+  const char* name = element->GetName();
+  if(name)
+    {
+    writer->Body += static_cast<char>(1);
+    writer->WriteString(name);
+    }
+  else
+    {
+    writer->Body += static_cast<char>(0);
+    }
+
+  unsigned int numberOfAttributes = element->GetNumberOfAttributes();
+  writer->WriteNumber(numberOfAttributes);
+  for(unsigned int cc=0; cc < numberOfAttributes; ++cc)
+    {
+    writer->WriteString(element->GetAttributeName(cc));
+    writer->WriteString(element->GetAttributeValue(cc));
+    }
+
+  const char* data = element->GetCharacterData();
+  if(vtkPVXMLBinaryFormatIsBlank(data))
+    {
+    writer->WriteNumber(0);
+    }
+  else
+    {
+    size_t length = strlen(data);
+    writer->WriteNumber(length);
+    writer->Body.append(data, length);
+    }
+
+  unsigned int numberOfNested = element->GetNumberOfNestedElements();
+  writer->WriteNumber(numberOfNested);
+  unsigned int index = 0;
+  while(index < numberOfNested)
+    {
+    unsigned int count = writer->WriteRun(element, index);
+    if(count == 0)
+      {
+      writer->WriteNumber(VTK_PVXML_ELEMENT_RECORD);
+      vtkPVXMLBinaryFormat::WriteElement(writer,
+        element->GetNestedElement(index));
+      count = 1;
+      }
+    index += count;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLElement* vtkPVXMLBinaryFormat::Read(const char* data, size_t length)
+{
+  size_t signatureLength = sizeof(vtkPVXMLBinaryFormatSignature);
+  if(!data || length < signatureLength ||
+     memcmp(data, vtkPVXMLBinaryFormatSignature, signatureLength) != 0)
+    {
+    vtkGenericWarningMacro("Not a binary XML file.");
+    return 0;
+    }
+
+  vtkPVXMLBinaryFormatReader reader;
+  reader.Position = reinterpret_cast<const unsigned char*>(data) +
+    signatureLength;
+  reader.End = reinterpret_cast<const unsigned char*>(data) + length;
+  reader.ElementIdIndex = 0;
+  reader.Failed = false;
+
+  vtkTypeUInt64 version = reader.ReadNumber();
+  if(!reader.Failed && version > vtkPVXMLBinaryFormatVersion)
+    {
+    vtkGenericWarningMacro("Unsupported binary XML version " << version
+                           << ".");
+    return 0;
+    }
+
+  // Every string takes at least one byte, which bounds a valid count.
+  vtkTypeUInt64 numberOfStrings = reader.ReadNumber();
+  if(numberOfStrings > static_cast<vtkTypeUInt64>(reader.End - reader.Position))
+    {
+    reader.Failed = true;
+    }
+  if(!reader.Failed)
+    {
+    reader.Strings.resize(static_cast<size_t>(numberOfStrings));
+    }
+  for(size_t i=0; i < reader.Strings.size() && !reader.Failed; ++i)
+    {
+    vtkTypeUInt64 stringLength = reader.ReadNumber();
+    const char* text = reader.ReadBytes(stringLength);
+    if(text)
+      {
+      reader.Strings[i].assign(text, static_cast<size_t>(stringLength));
+      }
+    }
+
+  vtkPVXMLElement* root = 0;
+  if(!reader.Failed)
+    {
+    root = vtkPVXMLBinaryFormat::ReadElement(&reader);
+    }
+  if(reader.Failed)
+    {
+    vtkGenericWarningMacro("Corrupted binary XML data.");
+    if(root)
+      {
+      root->Delete();
+      }
+    return 0;
+    }
+  return root;
+}
+
+//----------------------------------------------------------------------------
+vtkPVXMLElement* vtkPVXMLBinaryFormat::ReadElement(
+  vtkPVXMLBinaryFormatReader* reader)
+{
+  vtkPVXMLElement* element = vtkPVXMLElement::New();
+  char buffer[64];
+
+  if(reader->ReadNumber())
+    {
+    element->SetName(reader->ReadString());
+    }
+
+  vtkTypeUInt64 numberOfAttributes = reader->ReadNumber();
+  for(vtkTypeUInt64 cc=0; cc < numberOfAttributes && !reader->Failed; ++cc)
+    {
+    const char* attributeName = reader->ReadString();
+    const char* attributeValue = reader->ReadString();
+    element->AddAttribute(attributeName, attributeValue);
+    }
+
+  // Assign the ids the way vtkPVXMLParser does.
+  const char* id = element->GetAttribute("id");
+  if(id)
+    {
+    element->SetId(id);
+    }
+  else
+    {
+    SNPRINTF(buffer, sizeof(buffer), "%u", reader->ElementIdIndex++);
+    element->SetId(buffer);
+    }
+
+  vtkTypeUInt64 dataLength = reader->ReadNumber();
+  const char* data = reader->ReadBytes(dataLength);
+  if(data && dataLength > 0)
+    {
+    element->AddCharacterData(data, static_cast<int>(dataLength));
+    }
+
+  vtkTypeUInt64 numberOfNested = reader->ReadNumber();
+  vtkTypeUInt64 numberRead = 0;
+  while(numberRead < numberOfNested && !reader->Failed)
+    {
+    vtkTypeUInt64 record = reader->ReadNumber();
+    if(record == VTK_PVXML_ELEMENT_RECORD)
+      {
+      vtkPVXMLElement* nested = vtkPVXMLBinaryFormat::ReadElement(reader);
+      if(nested)
+        {
+        element->AddNestedElement(nested);
+        nested->Delete();
+        }
+      ++numberRead;
+      continue;
+      }
+    if(record != VTK_PVXML_RUN_RECORD)
+      {
+      reader->Failed = true;
+      break;
+      }
+
+    vtkTypeUInt64 start = reader->ReadNumber();
+    vtkTypeUInt64 count = reader->ReadNumber();
+    vtkTypeUInt64 encoding = reader->ReadNumber();
+    vtkTypeUInt64 precision = 0;
+    if(encoding == VTK_PVXML_RUN_DOUBLES)
+      {
+      precision = reader->ReadNumber();
+      }
+    if(count > numberOfNested - numberRead ||
+       start + count > static_cast<vtkTypeUInt64>(VTK_INT_MAX) ||
+       encoding > VTK_PVXML_RUN_DOUBLES || precision > 17)
+      {
+      reader->Failed = true;
+      break;
+      }
+    for(vtkTypeUInt64 cc=0; cc < count && !reader->Failed; ++cc)
+      {
+      const char* value = buffer;
+      if(encoding == VTK_PVXML_RUN_STRINGS)
+        {
+        value = reader->ReadString();
+        }
+      else if(encoding == VTK_PVXML_RUN_INTEGERS)
+        {
+        vtkTypeUInt64 zigzag = reader->ReadNumber();
+        vtkTypeUInt32 bits = static_cast<vtkTypeUInt32>(zigzag >> 1) ^
+          ((zigzag & 1)? 0xffffffff : 0);
+        SNPRINTF(buffer, sizeof(buffer), "%d", static_cast<int>(bits));
+        }
+      else
+        {
+        const char* bytes = reader->ReadBytes(8);
+        if(bytes)
+          {
+          double number;
+          memcpy(&number, bytes, 8);
+          vtkByteSwap::Swap8LE(&number);
+          SNPRINTF(buffer, sizeof(buffer), "%.*g",
+                   static_cast<int>(precision), number);
+          }
+        }
+      if(reader->Failed)
+        {
+        break;
+        }
+
+      char index[32];
+      SNPRINTF(index, sizeof(index), "%d", static_cast<int>(start + cc));
+      vtkPVXMLElement* nested = vtkPVXMLElement::New();
+      nested->SetName("Element");
+      nested->AddAttribute("index", index);
+      nested->AddAttribute("value", value);
+      SNPRINTF(index, sizeof(index), "%u", reader->ElementIdIndex++);
+      nested->SetId(index);
+      element->AddNestedElement(nested);
+      nested->Delete();
+      }
+    numberRead += count;
+    }
+
+  if(reader->Failed)
+    {
+    element->Delete();
+    return 0;
+    }
+  return element;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVXMLBinaryFormat::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+}
@@ -0,0 +1,91 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVXMLBinaryFormat.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPVXMLBinaryFormat - compact binary form of vtkPVXMLElement trees.
+// .SECTION Description
+// vtkPVXMLBinaryFormat writes and reads a vtkPVXMLElement tree in a binary
+// format that is smaller and much faster to read than XML. It is used for
+// binary server manager state files (*.pvsmb).
+//
+// Reading a binary file gives the same tree as parsing the XML written by
+// vtkPVXMLElement::PrintXML() for the same element: the same names,
+// attributes (in the same order) and nested elements, with element ids
+// assigned the way vtkPVXMLParser does. Character data made only of white
+// space, such as the indentation read from XML files, is dropped.
+//
+// Element names, attribute names and attribute values are stored once in a
+// string table. Runs of <Element index="i" value="..."/> children, used for
+// property values, are packed into arrays: integers as variable-length
+// numbers and floating point values as 8-byte doubles when printing them
+// back gives the original text.
+// .SECTION See Also
+// vtkPVXMLElement vtkPVXMLParser
+
+#ifndef __vtkPVXMLBinaryFormat_h
+#define __vtkPVXMLBinaryFormat_h
+
+#include "vtkObject.h"
+
+class vtkPVXMLElement;
+//BTX
+struct vtkPVXMLBinaryFormatReader;
+struct vtkPVXMLBinaryFormatWriter;
+//ETX
+
+class VTK_EXPORT vtkPVXMLBinaryFormat : public vtkObject
+{
+public:
+  static vtkPVXMLBinaryFormat* New();
+  vtkTypeMacro(vtkPVXMLBinaryFormat, vtkObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Returns 1 if the file starts with the binary format signature.
+  static int IsBinaryFile(const char* filename);
+
+  // Description:
+  // Writes the tree under root to the file. Returns 1 on success.
+  static int WriteFile(vtkPVXMLElement* root, const char* filename);
+
+  // Description:
+  // Reads a tree from the file. Returns the root element, which the caller
+  // must Delete(), or NULL on error.
+  static vtkPVXMLElement* ReadFile(const char* filename);
+
+//BTX
+  // Description:
+  // Writes the tree under root to the stream, which must be opened in
+  // binary mode. Returns 1 on success.
+  static int Write(vtkPVXMLElement* root, ostream& os);
+
+  // Description:
+  // Reads a tree from a buffer holding a whole binary file. Returns the
+  // root element, which the caller must Delete(), or NULL on error.
+  static vtkPVXMLElement* Read(const char* data, size_t length);
+
+protected:
+  vtkPVXMLBinaryFormat();
+  ~vtkPVXMLBinaryFormat();
+
+  static void WriteElement(vtkPVXMLBinaryFormatWriter* writer,
+    vtkPVXMLElement* element);
+  static vtkPVXMLElement* ReadElement(vtkPVXMLBinaryFormatReader* reader);
+
+private:
+  vtkPVXMLBinaryFormat(const vtkPVXMLBinaryFormat&); // Not implemented.
+  void operator=(const vtkPVXMLBinaryFormat&); // Not implemented.
+//ETX
+};
+
+#endif
@@ -241,6 +241,32 @@ const char* vtkPVXMLElement::GetAttribute(const char* name)
   return 0;
 }
 
+//----------------------------------------------------------------------------
+unsigned int vtkPVXMLElement::GetNumberOfAttributes()
+{
+  return static_cast<unsigned int>(this->Internal->AttributeNames.size());
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVXMLElement::GetAttributeName(unsigned int index)
+{
+  if(index < this->Internal->AttributeNames.size())
+    {
+    return this->Internal->AttributeNames[index].c_str();
+    }
+  return 0;
+}
+
+//----------------------------------------------------------------------------
+const char* vtkPVXMLElement::GetAttributeValue(unsigned int index)
+{
+  if(index < this->Internal->AttributeValues.size())
+    {
+    return this->Internal->AttributeValues[index].c_str();
+    }
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 const char* vtkPVXMLElement::GetCharacterData()
 {
@@ -288,6 +314,31 @@ void vtkPVXMLElement::PrintXML(ostream& os, vtkIndent indent)
     }
 }
 
+//----------------------------------------------------------------------------
+vtkIdType vtkPVXMLElement::GetMemorySize()
+{
+  size_t size = sizeof(*this) + sizeof(*this->Internal);
+  size += this->Name? strlen(this->Name) + 1 : 0;
+  size += this->Id? strlen(this->Id) + 1 : 0;
+  size_t numAttributes = this->Internal->AttributeNames.size();
+  for(size_t i=0; i < numAttributes; ++i)
+    {
+    size += 2*sizeof(vtkstd::string) +
+      this->Internal->AttributeNames[i].capacity() +
+      this->Internal->AttributeValues[i].capacity();
+    }
+  size += this->Internal->CharacterData.capacity();
+  size += this->Internal->NestedElements.capacity() *
+    sizeof(vtkSmartPointer<vtkPVXMLElement>);
+  vtkIdType memorySize = static_cast<vtkIdType>(size);
+  size_t numberOfNestedElements = this->Internal->NestedElements.size();
+  for(size_t i=0; i < numberOfNestedElements; ++i)
+    {
+    memorySize += this->Internal->NestedElements[i]->GetMemorySize();
+    }
+  return memorySize;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVXMLElement::SetParent(vtkPVXMLElement* parent)
 {
@@ -52,6 +52,13 @@ public:
   // returns 0. 
   const char* GetAttribute(const char* name);
 
+  // Description:
+  // Get the number of attributes, and the name and value of the attribute
+  // at the given index. Attributes are kept in the order they were added.
+  unsigned int GetNumberOfAttributes();
+  const char* GetAttributeName(unsigned int index);
+  const char* GetAttributeValue(unsigned int index);
+
   // Description:
   // Get the character data for the element.
   const char* GetCharacterData();
@@ -168,6 +175,11 @@ public:
   // in the vtkCollection passed as an argument.
   void GetElementsByName(const char* name, vtkCollection* elements);
 
+  // Description:
+  // Returns an estimate, in bytes, of the memory used by this element and
+  // the elements nested in it.
+  vtkIdType GetMemorySize();
+
   // Description:
   // Encode a string. 
   static vtkStdString Encode(const char* plaintext);
@@ -197,6 +209,7 @@ protected:
 
   //BTX
   friend class vtkPVXMLParser;
+  friend class vtkPVXMLBinaryFormat;
   //ETX
 
 private:
@@ -18,6 +18,7 @@
 #include "vtkAlgorithm.h"
 #include "vtkCacheSizeKeeper.h"
 #include "vtkCallbackCommand.h"
+#include "vtkClientConnection.h"
 #include "vtkClientServerID.h"
 #include "vtkClientServerInterpreter.h"
 #include "vtkClientServerStream.h"
@@ -47,6 +48,7 @@
 #include "vtkStringList.h"
 #include "vtkTimerLog.h"
 #include "vtkToolkits.h" // For VTK_USE_MPI
+#include "vtkUndoStack.h"
 
 #ifdef VTK_USE_MPI
 # include "vtkMPIController.h"
@@ -298,6 +300,21 @@ void vtkProcessModule::GatherInformation(vtkIdType connectionID,
   this->ConnectionManager->GatherInformation(rootId, serverFlags, info, id);
 }
 
+//-----------------------------------------------------------------------------
+void vtkProcessModule::GatherInformation(vtkIdType connectionID,
+  vtkTypeUInt32 serverFlags, int count, vtkPVInformation** infos,
+  const vtkClientServerID* ids)
+{
+  if (count <= 0)
+    {
+    return;
+    }
+  vtkIdType rootId = 
+    vtkProcessModuleConnectionManager::GetRootConnection(connectionID);
+  this->ConnectionManager->GatherInformation(rootId, serverFlags, count,
+    infos, ids);
+}
+
 //-----------------------------------------------------------------------------
 int vtkProcessModule::Start(int argc, char** argv)
 {
@@ -750,6 +767,34 @@ int vtkProcessModule::IsRemote(vtkIdType id)
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+void vtkProcessModule::BeginStreamTransaction(vtkIdType id)
+{
+  vtkProcessModuleConnection* conn = 
+    this->ConnectionManager->GetConnectionFromID(id);
+  if (conn)
+    {
+    conn->BeginStreamTransaction();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkProcessModule::EndStreamTransaction(vtkIdType id)
+{
+  vtkProcessModuleConnection* conn = 
+    this->ConnectionManager->GetConnectionFromID(id);
+  if (conn)
+    {
+    conn->EndStreamTransaction();
+    }
+}
+
+//-----------------------------------------------------------------------------
+vtkProcessModuleConnection* vtkProcessModule::GetConnectionFromID(vtkIdType id)
+{
+  return this->ConnectionManager->GetConnectionFromID(id);
+}
+
 //-----------------------------------------------------------------------------
 vtkIdType vtkProcessModule::MonitorConnections(unsigned long msec)
 {
@@ -1851,6 +1896,17 @@ vtkPVXMLElement* vtkProcessModule::NewNextRedo(vtkIdType id)
   return this->ConnectionManager->NewNextRedo(id);
 }
 
+//-----------------------------------------------------------------------------
+void vtkProcessModule::SetUndoStackMemoryBudget(vtkIdType budget)
+{
+  vtkClientConnection* connection =
+    vtkClientConnection::SafeDownCast(this->ActiveRemoteConnection);
+  if (connection)
+    {
+    connection->GetUndoRedoStack()->SetMemoryBudget(budget);
+    }
+}
+
 //-----------------------------------------------------------------------------
 int vtkProcessModule::GetNumberOfConnections()
 {
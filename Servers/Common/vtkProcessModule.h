@@ -142,6 +142,15 @@ public:
   // this information must be collected.
   virtual void GatherInformation(vtkIdType connectionID,
     vtkTypeUInt32 serverFlags, vtkPVInformation* info, vtkClientServerID id);
+
+  // Description:
+  // Gather count information objects, infos[i] from the object ids[i].
+  // Over a client/server connection all requests travel in a single
+  // message and all results come back in a single reply, which avoids one
+  // network round trip per object.
+  virtual void GatherInformation(vtkIdType connectionID,
+    vtkTypeUInt32 serverFlags, int count, vtkPVInformation** infos,
+    const vtkClientServerID* ids);
 //ETX
   virtual void GatherInformation(vtkIdType connectionID,
     vtkTypeUInt32 serverFlags, vtkPVInformation* info, int id)
@@ -524,6 +533,19 @@ public:
   // Returns 1 is the connection is a connection with a remote server (or client).
   int IsRemote(vtkIdType id);
 
+  // Description:
+  // Open/close a stream transaction on the connection. The streams sent to
+  // the servers of a remote connection in between are queued and sent as
+  // a single message when the outermost transaction is closed. See
+  // vtkProcessModuleConnection::BeginStreamTransaction().
+  void BeginStreamTransaction(vtkIdType id);
+  void EndStreamTransaction(vtkIdType id);
+
+  // Description:
+  // Returns the connection with the given id, or NULL. Mostly useful to
+  // query the connection's counters.
+  vtkProcessModuleConnection* GetConnectionFromID(vtkIdType id);
+
   // Description:
   // Checks if any new connections are available, if so, creates
   // vtkConnections for them. The call will wait for a timeout of msec
@@ -566,6 +588,13 @@ public:
   // \returns NULL on failure, otherwise the XML element is returned.
   vtkPVXMLElement* NewNextRedo(vtkIdType id);
 
+  // Description:
+  // Set the memory budget, in bytes, of the undo stack that the server
+  // keeps for the client whose stream is being processed (see
+  // vtkUndoStack::SetMemoryBudget()). Sent by clients to the server in a
+  // stream; does nothing outside of a client connection.
+  void SetUndoStackMemoryBudget(vtkIdType budget);
+
   // Description:
   // This flag is used to shut the SendStream from sending any thing to
   // the servers. This is useful for reiviving a server manager.
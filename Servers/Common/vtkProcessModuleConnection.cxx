@@ -68,6 +68,9 @@ vtkProcessModuleConnection::vtkProcessModuleConnection()
   this->Observer->SetTarget(this);
 
   this->ProgressHandler = vtkPVProgressHandler::New();
+
+  this->StreamTransactionDepth = 0;
+  this->ResetStreamTransactionCounters();
 }
 
 //-----------------------------------------------------------------------------
@@ -211,6 +214,16 @@ void vtkProcessModuleConnection::GatherInformation(vtkTypeUInt32 ,
     << this->GetClassName());
 }
 
+//-----------------------------------------------------------------------------
+void vtkProcessModuleConnection::GatherInformation(vtkTypeUInt32 serverFlags,
+  int count, vtkPVInformation** infos, const vtkClientServerID* ids)
+{
+  for (int cc=0; cc < count; cc++)
+    {
+    this->GatherInformation(serverFlags, infos[cc], ids[cc]);
+    }
+}
+
 //-----------------------------------------------------------------------------
 int vtkProcessModuleConnection::SendStream(vtkTypeUInt32 servers, 
   vtkClientServerStream& stream)
@@ -301,11 +314,54 @@ int vtkProcessModuleConnection::LoadModule(const char* , const char* )
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+void vtkProcessModuleConnection::BeginStreamTransaction()
+{
+  this->StreamTransactionDepth++;
+}
+
+//-----------------------------------------------------------------------------
+void vtkProcessModuleConnection::EndStreamTransaction()
+{
+  if (this->StreamTransactionDepth <= 0)
+    {
+    vtkErrorMacro("EndStreamTransaction() called without a matching "
+      "BeginStreamTransaction().");
+    return;
+    }
+  this->StreamTransactionDepth--;
+  if (this->StreamTransactionDepth == 0)
+    {
+    this->FlushStreams();
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkProcessModuleConnection::ResetStreamTransactionCounters()
+{
+  this->NumberOfStreamFlushes = 0;
+  this->LastFlushNumberOfMessages = 0;
+  this->LastFlushNumberOfBytes = 0;
+  this->TotalFlushedMessages = 0;
+  this->TotalFlushedBytes = 0;
+}
+
 //-----------------------------------------------------------------------------
 void vtkProcessModuleConnection::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent << "AbortConnection: " << this->AbortConnection << endl;
+  os << indent << "StreamTransactionDepth: " 
+    << this->StreamTransactionDepth << endl;
+  os << indent << "NumberOfStreamFlushes: " 
+    << this->NumberOfStreamFlushes << endl;
+  os << indent << "LastFlushNumberOfMessages: " 
+    << this->LastFlushNumberOfMessages << endl;
+  os << indent << "LastFlushNumberOfBytes: " 
+    << this->LastFlushNumberOfBytes << endl;
+  os << indent << "TotalFlushedMessages: " 
+    << this->TotalFlushedMessages << endl;
+  os << indent << "TotalFlushedBytes: " << this->TotalFlushedBytes << endl;
   os << indent << "Controller: ";
   if (this->Controller)
     {
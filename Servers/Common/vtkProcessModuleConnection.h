@@ -86,6 +86,14 @@ public:
   // raises an error.
   virtual void GatherInformation(vtkTypeUInt32 serverFlags,
     vtkPVInformation* info,  vtkClientServerID id);
+
+  // Description:
+  // Gather several information objects at once, infos[i] being collected
+  // from the object ids[i]. Remote connections override this to fetch all
+  // of them in a single round trip. Default implementation calls
+  // GatherInformation() for each.
+  virtual void GatherInformation(vtkTypeUInt32 serverFlags, int count,
+    vtkPVInformation** infos, const vtkClientServerID* ids);
 //ETX
 
   // Description:
@@ -131,6 +139,31 @@ public:
   // Get the progress handler for this connection.
   vtkGetObjectMacro(ProgressHandler, vtkPVProgressHandler);
 
+  // Description:
+  // Between BeginStreamTransaction() and the matching
+  // EndStreamTransaction(), connections to remote servers queue the streams
+  // sent to the servers and send them as a single message when the
+  // outermost transaction ends, or earlier when an answer from the servers
+  // is needed (GetLastResult, GatherInformation...). Streams are still
+  // executed on the client right away. Code that exchanges data over the
+  // socket directly must call FlushStreams() first. Transactions nest. The
+  // default implementation only counts the nesting level.
+  virtual void BeginStreamTransaction();
+  virtual void EndStreamTransaction();
+  virtual void FlushStreams() {}
+  vtkGetMacro(StreamTransactionDepth, int);
+
+  // Description:
+  // Profiling counters for stream transactions: the number of flushes that
+  // sent queued streams, and the number of messages (streams) and bytes
+  // sent by the last one and by all of them.
+  vtkGetMacro(NumberOfStreamFlushes, int);
+  vtkGetMacro(LastFlushNumberOfMessages, int);
+  vtkGetMacro(LastFlushNumberOfBytes, int);
+  vtkGetMacro(TotalFlushedMessages, double);
+  vtkGetMacro(TotalFlushedBytes, double);
+  void ResetStreamTransactionCounters();
+
 protected:
   vtkProcessModuleConnection();
   ~vtkProcessModuleConnection();
@@ -169,6 +202,13 @@ protected:
   int AbortConnection;
  
   vtkPVProgressHandler* ProgressHandler;
+
+  int StreamTransactionDepth;
+  int NumberOfStreamFlushes;
+  int LastFlushNumberOfMessages;
+  int LastFlushNumberOfBytes;
+  double TotalFlushedMessages;
+  double TotalFlushedBytes;
 private:
   vtkProcessModuleConnection(const vtkProcessModuleConnection&); // Not implemented.
   void operator=(const vtkProcessModuleConnection&); // Not implemented.
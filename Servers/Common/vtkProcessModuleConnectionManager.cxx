@@ -564,6 +564,18 @@ void vtkProcessModuleConnectionManager::GatherInformation(
     }
 }
 
+//-----------------------------------------------------------------------------
+void vtkProcessModuleConnectionManager::GatherInformation(
+  vtkIdType connectionID, vtkTypeUInt32 serverFlags, int count,
+  vtkPVInformation** infos, const vtkClientServerID* ids)
+{
+  vtkProcessModuleConnection* conn = this->GetConnectionFromID(connectionID);
+  if (conn)
+    {
+    conn->GatherInformation(serverFlags, count, infos, ids);
+    }
+}
+
 //-----------------------------------------------------------------------------
 const vtkClientServerStream& vtkProcessModuleConnectionManager::GetLastResult(
     vtkIdType connectionID, vtkTypeUInt32 server)
@@ -269,6 +269,11 @@ public:
   void GatherInformation(vtkIdType connectionID,
     vtkTypeUInt32 serverFlags, vtkPVInformation* info, vtkClientServerID id);
 
+  // Description:
+  // Called to gather several information objects in one request.
+  void GatherInformation(vtkIdType connectionID, vtkTypeUInt32 serverFlags,
+    int count, vtkPVInformation** infos, const vtkClientServerID* ids);
+
   // Description:
   // Return the last result for the specified server.  In this case,
   // the server should be exactly one of the ServerFlags, and not a
@@ -47,7 +47,9 @@ public:
     ROOT_RESULT_LENGTH_TAG = 838487,
     ROOT_RESULT_TAG = 838488,
     UNDO_XML_TAG = 838495,
-    REDO_XML_TAG = 838496
+    REDO_XML_TAG = 838496,
+    CLIENT_SERVER_GATHER_INFORMATION_BATCH_RMI_TAG = 838497,
+    CLIENT_SERVER_BATCH_RMI_TAG = 838498
       
     };
 //ETX
@@ -29,15 +29,80 @@
 #include "vtkSmartPointer.h"
 #include "vtkSocketController.h"
 #include "vtkSocketCommunicator.h"
+#include "vtkTimerLog.h"
 
+#include <vtkstd/vector>
 #include <vtksys/ios/sstream>
 #include <vtksys/SystemTools.hxx>
 
 
 vtkStandardNewMacro(vtkServerConnection);
+
+//-----------------------------------------------------------------------------
+// Streams queued for one server while a stream transaction is open. Each
+// stream is wrapped in a message holding the RMI tag it would have been sent
+// with, so that the server can process it exactly as if it had been sent on
+// its own.
+// Streams that are incomplete or refer to local objects cannot be nested.
+static bool vtkServerConnectionCanNest(const vtkClientServerStream& stream)
+{
+  if (!stream.GetData(0, 0))
+    {
+    return false;
+    }
+  for (int m=0; m < stream.GetNumberOfMessages(); m++)
+    {
+    for (int a=0; a < stream.GetNumberOfArguments(m); a++)
+      {
+      if (stream.GetArgumentType(m, a) ==
+        vtkClientServerStream::vtk_object_pointer)
+        {
+        return false;
+        }
+      }
+    }
+  return true;
+}
+
+class vtkServerConnectionQueue
+{
+public:
+  vtkServerConnectionQueue() { this->NumberOfStreams = 0; }
+
+  bool Append(vtkClientServerStream& stream, int tag)
+    {
+    if (!vtkServerConnectionCanNest(stream))
+      {
+      return false;
+      }
+    // Write the stream straight into the queue.
+    this->Streams << vtkClientServerStream::Reply << tag << stream
+      << vtkClientServerStream::End;
+    this->NumberOfStreams++;
+    return true;
+    }
+
+  void Clear()
+    {
+    this->Streams.Reset();
+    this->NumberOfStreams = 0;
+    }
+
+  vtkClientServerStream Streams;
+  int NumberOfStreams;
+};
+
+class vtkServerConnection::vtkInternals
+{
+public:
+  vtkServerConnectionQueue DataServerQueue;
+  vtkServerConnectionQueue RenderServerQueue;
+};
+
 //-----------------------------------------------------------------------------
 vtkServerConnection::vtkServerConnection()
 {
+  this->Internals = new vtkInternals;
   this->RenderServerSocketController = 0;
   this->NumberOfServerProcesses = 0;
   this->MPIMToNSocketConnectionID.ID = 0;
@@ -56,6 +121,7 @@ vtkServerConnection::~vtkServerConnection()
     }
   this->ServerInformation->Delete();
   delete this->LastResultStream;
+  delete this->Internals;
 }
 
 //-----------------------------------------------------------------------------
@@ -71,6 +137,7 @@ void vtkServerConnection::OnSocketError()
 //-----------------------------------------------------------------------------
 void vtkServerConnection::Finalize()
 {
+  this->FlushStreams();
   if (this->MPIMToNSocketConnectionID.ID)
     {
     vtkClientServerStream stream;
@@ -194,26 +261,103 @@ int vtkServerConnection::SendStreamToClient(vtkClientServerStream& stream)
 int vtkServerConnection::SendStreamToServer(vtkSocketController* controller,
   vtkClientServerStream& stream)
 {
-  const unsigned char* data;
-  size_t len;
-  stream.GetData(&data, &len);
-  controller->TriggerRMI(1, (void*)data, static_cast<int>(len), 
+  return this->SendStreamToController(controller, stream,
     vtkRemoteConnection::CLIENT_SERVER_RMI_TAG);
-  return 0;
 }
 
 //-----------------------------------------------------------------------------
 int vtkServerConnection::SendStreamToRoot(vtkSocketController* controller,
   vtkClientServerStream& stream)
 {
+  return this->SendStreamToController(controller, stream,
+    vtkRemoteConnection::CLIENT_SERVER_ROOT_RMI_TAG);
+}
+
+//-----------------------------------------------------------------------------
+int vtkServerConnection::SendStreamToController(
+  vtkSocketController* controller, vtkClientServerStream& stream, int tag)
+{
+  if (this->StreamTransactionDepth > 0)
+    {
+    vtkServerConnectionQueue& queue =
+      (controller == this->RenderServerSocketController)?
+      this->Internals->RenderServerQueue : this->Internals->DataServerQueue;
+    if (queue.Append(stream, tag))
+      {
+      return 0;
+      }
+    // Keep the order of the streams.
+    this->FlushStreams();
+    }
+
   const unsigned char* data;
   size_t len;
   stream.GetData(&data, &len);
-  controller->TriggerRMI(1, (void*)data, static_cast<int>(len), 
-    vtkRemoteConnection::CLIENT_SERVER_ROOT_RMI_TAG);
+  controller->TriggerRMI(1, (void*)data, static_cast<int>(len), tag);
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+void vtkServerConnection::FlushStreams()
+{
+  vtkServerConnectionQueue* queues[2] = {
+    &this->Internals->DataServerQueue, &this->Internals->RenderServerQueue };
+  vtkSocketController* controllers[2] = {
+    this->GetSocketController(), this->RenderServerSocketController };
+
+  int numMessages = 0;
+  int numBytes = 0;
+  for (int cc=0; cc < 2; cc++)
+    {
+    vtkServerConnectionQueue& queue = *queues[cc];
+    if (queue.NumberOfStreams == 0)
+      {
+      continue;
+      }
+    if (this->AbortConnection || !controllers[cc])
+      {
+      queue.Clear();
+      continue;
+      }
+
+    // Move the queue out before sending: a socket error would call us
+    // again.
+    vtkClientServerStream streams;
+    streams.Swap(queue.Streams);
+    int numStreams = queue.NumberOfStreams;
+    queue.Clear();
+
+    const unsigned char* data;
+    size_t len;
+    streams.GetData(&data, &len);
+    numMessages += numStreams;
+    numBytes += static_cast<int>(len);
+    if (numStreams == 1)
+      {
+      // Nothing to coalesce, send the stream as it was given.
+      int tag = 0;
+      streams.GetArgument(0, 0, &tag);
+      streams.GetArgumentData(0, 1, &data, &len);
+      controllers[cc]->TriggerRMI(1, (void*)data, static_cast<int>(len), tag);
+      continue;
+      }
+
+    controllers[cc]->TriggerRMI(1, (void*)data, static_cast<int>(len),
+      vtkRemoteConnection::CLIENT_SERVER_BATCH_RMI_TAG);
+    }
+
+  if (numMessages > 0)
+    {
+    this->NumberOfStreamFlushes++;
+    this->LastFlushNumberOfMessages = numMessages;
+    this->LastFlushNumberOfBytes = numBytes;
+    this->TotalFlushedMessages += numMessages;
+    this->TotalFlushedBytes += numBytes;
+    vtkTimerLog::FormatAndMarkEvent("Flushed %d streams (%d bytes)",
+      numMessages, numBytes);
+    }
+}
+
 //-----------------------------------------------------------------------------
 const vtkClientServerStream& vtkServerConnection::GetLastResult(vtkTypeUInt32 
   serverFlags)
@@ -256,6 +400,7 @@ const vtkClientServerStream& vtkServerConnection::GetLastResultInternal(
     return *this->LastResultStream;
     }
 
+  this->FlushStreams();
   int length =0;
   controller->TriggerRMI(1, "", 
     vtkRemoteConnection::CLIENT_SERVER_LAST_RESULT_TAG);
@@ -326,6 +471,7 @@ void vtkServerConnection::GatherInformation(vtkTypeUInt32 serverFlags,
 void vtkServerConnection::GatherInformationFromController(vtkSocketController* controller,
   vtkPVInformation* info, vtkClientServerID id)
 {
+  this->FlushStreams();
   vtkClientServerStream stream;
   stream << vtkClientServerStream::Assign // dummy command.
     << info->GetClassName()
@@ -357,6 +503,118 @@ void vtkServerConnection::GatherInformationFromController(vtkSocketController* c
   delete [] data2;
 }
 
+//-----------------------------------------------------------------------------
+void vtkServerConnection::GatherInformation(vtkTypeUInt32 serverFlags, 
+  int count, vtkPVInformation** infos, const vtkClientServerID* ids)
+{
+  if (this->AbortConnection)
+    {
+    // Don't gather info on an aborted connection.
+    return;
+    }
+  serverFlags = this->CreateSendFlag(serverFlags);
+
+  if (serverFlags & vtkProcessModule::CLIENT)
+    {
+    vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+    for (int cc=0; cc < count; cc++)
+      {
+      vtkObject* object = vtkObject::SafeDownCast(pm->GetObjectFromID(ids[cc]));
+      if (!object)
+        {
+        vtkErrorMacro("Failed to locate object with ID: " << ids[cc]);
+        continue;
+        }
+      infos[cc]->CopyFromObject(object);
+      }
+    }
+
+  if (serverFlags & vtkProcessModule::DATA_SERVER ||
+    serverFlags & vtkProcessModule::DATA_SERVER_ROOT)
+    {
+    this->GatherInformationFromController(this->GetSocketController(), 
+      count, infos, ids);
+    return;
+    }
+  
+  if ( (serverFlags & vtkProcessModule::RENDER_SERVER 
+      || serverFlags & vtkProcessModule::RENDER_SERVER_ROOT) 
+    && this->RenderServerSocketController)
+    {
+    this->GatherInformationFromController(this->RenderServerSocketController,
+      count, infos, ids);
+    return;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// All requests are sent as one message holding one Assign per information
+// object. The server answers with one stream holding a Reply per request,
+// whose only argument is the serialized information, or an Error when that
+// information could not be gathered.
+void vtkServerConnection::GatherInformationFromController(
+  vtkSocketController* controller, int count, vtkPVInformation** infos,
+  const vtkClientServerID* ids)
+{
+  this->FlushStreams();
+  vtkClientServerStream stream;
+  for (int cc=0; cc < count; cc++)
+    {
+    stream << vtkClientServerStream::Assign // dummy command.
+      << infos[cc]->GetClassName()
+      << ids[cc] << vtkClientServerStream::End;
+    }
+  const unsigned char* data;
+  size_t length;
+  stream.GetData(&data, &length);
+  controller->TriggerRMI(1, (void*)(data), static_cast<int>(length),
+    vtkRemoteConnection::CLIENT_SERVER_GATHER_INFORMATION_BATCH_RMI_TAG);
+
+  int length2 = 0;
+  controller->Receive(&length2, 1, 1,
+    vtkRemoteConnection::ROOT_INFORMATION_LENGTH_TAG);
+  if (length2 <= 0)
+    {
+    vtkErrorMacro("Server failed to gather information.");
+    return;
+    }
+  unsigned char* data2 = new unsigned char[length2];
+  if (!controller->Receive((char*)data2, length2, 1, 
+    vtkRemoteConnection::ROOT_INFORMATION_TAG))
+    {
+    vtkErrorMacro("Failed to receive information correctly.");
+    delete [] data2;
+    return;
+    }
+  vtkClientServerStream reply;
+  reply.SetData(data2, length2);
+  delete [] data2;
+
+  if (reply.GetNumberOfMessages() != count)
+    {
+    vtkErrorMacro("Server returned " << reply.GetNumberOfMessages()
+      << " information objects, expected " << count << ".");
+    return;
+    }
+
+  vtkstd::vector<unsigned char> buffer;
+  for (int cc=0; cc < count; cc++)
+    {
+    vtkTypeUInt32 infoLength = 0;
+    if (reply.GetCommand(cc) != vtkClientServerStream::Reply ||
+      !reply.GetArgumentLength(cc, 0, &infoLength) || infoLength == 0)
+      {
+      vtkErrorMacro("Server failed to gather information for ID: "
+        << ids[cc]);
+      continue;
+      }
+    buffer.resize(infoLength);
+    reply.GetArgument(cc, 0, &buffer[0], infoLength);
+    stream.SetData(&buffer[0], infoLength);
+    infos[cc]->CopyFromStream(&stream);
+    }
+}
+
 //-----------------------------------------------------------------------------
 int vtkServerConnection::Initialize(int argc, char** argv, int *partitionId)
 {
@@ -656,6 +914,7 @@ void vtkServerConnection::PushUndo(const char* label, vtkPVXMLElement* uelem)
   root->PrintXML(xml_stream, vtkIndent());
   root->Delete();
 
+  this->FlushStreams();
   vtkClientServerStream stream;
   stream << vtkClientServerStream::Invoke
     << label
@@ -675,6 +934,7 @@ void vtkServerConnection::PushUndo(const char* label, vtkPVXMLElement* uelem)
 //-----------------------------------------------------------------------------
 vtkPVXMLElement* vtkServerConnection::NewNextUndo()
 {
+  this->FlushStreams();
   vtkSocketController* controller = this->GetSocketController();
   controller->TriggerRMI(1, NULL, 0, vtkRemoteConnection::UNDO_XML_TAG);
   int length;
@@ -719,6 +979,7 @@ vtkPVXMLElement* vtkServerConnection::NewNextUndo()
 //-----------------------------------------------------------------------------
 vtkPVXMLElement* vtkServerConnection::NewNextRedo()
 {
+  this->FlushStreams();
   vtkSocketController* controller = this->GetSocketController();
   controller->TriggerRMI(1, NULL, 0, vtkRemoteConnection::REDO_XML_TAG);
   int length;
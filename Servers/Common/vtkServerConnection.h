@@ -55,6 +55,11 @@ public:
   virtual void GatherInformation(vtkTypeUInt32 serverFlags, vtkPVInformation* info, 
     vtkClientServerID id);
 
+  // Description:
+  // Gather several information objects from the server in one round trip.
+  virtual void GatherInformation(vtkTypeUInt32 serverFlags, int count,
+    vtkPVInformation** infos, const vtkClientServerID* ids);
+
   // Description:
   vtkGetMacro(MPIMToNSocketConnectionID, vtkClientServerID);
 //ETX
@@ -99,6 +104,10 @@ public:
   // \returns NULL on failure, otherwise the XML element is returned.
   virtual vtkPVXMLElement* NewNextRedo();
 
+  // Description:
+  // Sends the streams queued by stream transactions to the servers.
+  virtual void FlushStreams();
+
 protected:
   vtkServerConnection();
   ~vtkServerConnection();
@@ -125,6 +134,12 @@ protected:
   int SendStreamToRoot(vtkSocketController* controller,
   vtkClientServerStream& stream);
 
+  // Description:
+  // Triggers the RMI with the given tag on the controller to process the
+  // stream, or queues it when a stream transaction is open.
+  int SendStreamToController(vtkSocketController* controller,
+    vtkClientServerStream& stream, int tag);
+
   // Description:
   // Authenticates with the Server. Returns 1 on success, 0 on failure.
   int AuthenticateWithServer(vtkSocketController*);
@@ -137,6 +152,8 @@ protected:
   // Internal method that gather information from appropriate controller.
   void GatherInformationFromController(vtkSocketController* controller, 
     vtkPVInformation* info, vtkClientServerID id);
+  void GatherInformationFromController(vtkSocketController* controller, 
+    int count, vtkPVInformation** infos, const vtkClientServerID* ids);
   
   // Description:
   // Internal method to obtain the last result.
@@ -160,6 +177,11 @@ protected:
 
   vtkPVServerInformation* ServerInformation;
   vtkClientServerStream* LastResultStream;
+
+//BTX
+  class vtkInternals;
+  vtkInternals* Internals;
+//ETX
 private:
   vtkServerConnection(const vtkServerConnection&); // Not implemented.
   void operator=(const vtkServerConnection&); // Not implemented.
@@ -50,6 +50,16 @@ void vtkUndoElement::LoadState(vtkPVXMLElement* element)
   this->LoadStateInternal(element);
 }
 
+//-----------------------------------------------------------------------------
+vtkIdType vtkUndoElement::GetMemorySize()
+{
+  vtkPVXMLElement* root = vtkPVXMLElement::New();
+  this->SaveStateInternal(root);
+  vtkIdType size = root->GetMemorySize();
+  root->Delete();
+  return size;
+}
+
 //-----------------------------------------------------------------------------
 void vtkUndoElement::PrintSelf(ostream& os, vtkIndent indent)
 {
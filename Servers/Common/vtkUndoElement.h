@@ -66,6 +66,11 @@ public:
   // \arg \c element is the XML element for this object. 
   void LoadState(vtkPVXMLElement* element);
 
+  // Description:
+  // Returns an estimate, in bytes, of the memory used by this element.
+  // The default implementation measures the XML state of the element.
+  virtual vtkIdType GetMemorySize();
+
   // Description:
   // Returns if this undo element can be merged with other
   // undo elements.
@@ -73,6 +73,27 @@ int vtkUndoSet::GetNumberOfElements()
   return this->Collection->GetNumberOfItems();
 }
 
+//-----------------------------------------------------------------------------
+vtkUndoElement* vtkUndoSet::GetElement(int index)
+{
+  return vtkUndoElement::SafeDownCast(
+    this->Collection->GetItemAsObject(index));
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkUndoSet::GetMemorySize()
+{
+  vtkIdType size = 0;
+  int max = this->Collection->GetNumberOfItems();
+  for (int cc=0; cc <max; cc++)
+    {
+    vtkUndoElement* elem = vtkUndoElement::SafeDownCast(
+      this->Collection->GetItemAsObject(cc));
+    size += elem->GetMemorySize();
+    }
+  return size;
+}
+
 //-----------------------------------------------------------------------------
 int vtkUndoSet::Redo()
 {
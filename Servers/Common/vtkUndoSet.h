@@ -71,6 +71,15 @@ public:
   // Get number of elements in the set.
   int GetNumberOfElements();
 
+  // Description:
+  // Get the element at a particular index.
+  vtkUndoElement* GetElement(int index);
+
+  // Description:
+  // Returns an estimate, in bytes, of the memory used by the elements of
+  // this set.
+  virtual vtkIdType GetMemorySize();
+
   // Description:
   // Saves the state of the element in an xml. 
   // \arg \c root parent element under which the state xml element for this
@@ -27,6 +27,8 @@ vtkUndoStack::vtkUndoStack()
   this->InUndo = false;
   this->InRedo = false;
   this->StackDepth = 10;
+  this->MemoryBudget = 0;
+  this->NumberOfTrimmedSets = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -53,11 +55,69 @@ void vtkUndoStack::Push(const char* label, vtkUndoSet* changeSet)
     {
     this->Internal->UndoStack.erase(this->Internal->UndoStack.begin()); 
     }
-  this->Internal->UndoStack.push_back(
-    vtkUndoStackInternal::Element(label, changeSet));
+  this->Internal->UndoStack.push_back(vtkUndoStackInternal::Element(label,
+      changeSet, changeSet? changeSet->GetMemorySize() : 0));
+  this->TrimToMemoryBudget();
   this->Modified();
 }
 
+//-----------------------------------------------------------------------------
+void vtkUndoStack::SetMemoryBudget(vtkIdType budget)
+{
+  if (budget < 0)
+    {
+    budget = 0;
+    }
+  if (this->MemoryBudget != budget)
+    {
+    this->MemoryBudget = budget;
+    this->TrimToMemoryBudget();
+    this->Modified();
+    }
+}
+
+//-----------------------------------------------------------------------------
+vtkIdType vtkUndoStack::GetMemorySize()
+{
+  vtkIdType size = 0;
+  vtkUndoStackInternal::VectorOfElements::iterator iter;
+  for (iter = this->Internal->UndoStack.begin();
+    iter != this->Internal->UndoStack.end(); ++iter)
+    {
+    size += iter->MemorySize;
+    }
+  for (iter = this->Internal->RedoStack.begin();
+    iter != this->Internal->RedoStack.end(); ++iter)
+    {
+    size += iter->MemorySize;
+    }
+  return size;
+}
+
+//-----------------------------------------------------------------------------
+void vtkUndoStack::TrimToMemoryBudget()
+{
+  if (this->MemoryBudget <= 0)
+    {
+    return;
+    }
+  vtkIdType size = this->GetMemorySize();
+
+  // The bottom of the redo stack is the set furthest from the current state.
+  while (size > this->MemoryBudget && !this->Internal->RedoStack.empty())
+    {
+    size -= this->Internal->RedoStack.front().MemorySize;
+    this->Internal->RedoStack.erase(this->Internal->RedoStack.begin());
+    this->NumberOfTrimmedSets++;
+    }
+  while (size > this->MemoryBudget && this->Internal->UndoStack.size() > 1)
+    {
+    size -= this->Internal->UndoStack.front().MemorySize;
+    this->Internal->UndoStack.erase(this->Internal->UndoStack.begin());
+    this->NumberOfTrimmedSets++;
+    }
+}
+
 //-----------------------------------------------------------------------------
 unsigned int vtkUndoStack::GetNumberOfUndoSets()
 {
@@ -183,4 +243,7 @@ void vtkUndoStack::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "InUndo: " << this->InUndo << endl;
   os << indent << "InRedo: " << this->InRedo << endl;
   os << indent << "StackDepth: " << this->StackDepth << endl;
+  os << indent << "MemoryBudget: " << this->MemoryBudget << endl;
+  os << indent << "NumberOfTrimmedSets: " << this->NumberOfTrimmedSets
+    << endl;
 }
@@ -28,6 +28,10 @@
 // Each undo set are assigned user-readable labels providing information about
 // the operation(s) that will be undone/redone.
 //
+// The size of the stack is limited by StackDepth and, optionally, by a
+// MemoryBudget: when the sets on the stack use more memory than the
+// budget, the oldest ones are removed.
+//
 // vtkUndoElement, vtkUndoSet and vtkUndoStack form the undo/redo framework core.
 // .SECTION See Also
 // vtkUndoSet vtkUndoElement
@@ -146,12 +150,36 @@ public:
   // Default is 10.
   vtkSetClampMacro(StackDepth, int, 1, 100);
   vtkGetMacro(StackDepth, int);
+
+  // Description:
+  // Get/Set the memory, in bytes, the undo and redo sets may use. When
+  // exceeded, the oldest sets are removed, first from the redo stack and
+  // then from the undo stack, keeping at least the most recent undo set.
+  // 0 (the default) means no limit.
+  virtual void SetMemoryBudget(vtkIdType budget);
+  vtkGetMacro(MemoryBudget, vtkIdType);
+
+  // Description:
+  // Returns the memory, in bytes, used by the sets on the undo and redo
+  // stacks, as measured when they were pushed.
+  vtkIdType GetMemorySize();
+
+  // Description:
+  // Returns the number of sets removed to stay within the MemoryBudget
+  // since the stack was created.
+  vtkGetMacro(NumberOfTrimmedSets, int);
 protected:
   vtkUndoStack();
   ~vtkUndoStack();
 
+  // Description:
+  // Removes the oldest sets until the stack fits the MemoryBudget.
+  void TrimToMemoryBudget();
+
   vtkUndoStackInternal* Internal;
   int StackDepth;
+  vtkIdType MemoryBudget;
+  int NumberOfTrimmedSets;
 
 private:
   vtkUndoStack(const vtkUndoStack&); // Not implemented.
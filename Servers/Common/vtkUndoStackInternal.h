@@ -25,10 +25,13 @@ public:
     {
     vtkstd::string Label;
     vtkSmartPointer<vtkUndoSet> UndoSet;
-    Element(const char* label, vtkUndoSet* set)
+    // Memory used by the set, measured when it was pushed.
+    vtkIdType MemorySize;
+    Element(const char* label, vtkUndoSet* set, vtkIdType memorySize=0)
       {
       this->Label = label;
       this->UndoSet = set;
+      this->MemorySize = memorySize;
       }
     };
   typedef vtkstd::vector<Element> VectorOfElements;
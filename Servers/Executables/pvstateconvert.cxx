@@ -0,0 +1,70 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    pvstateconvert.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Converts server manager state files between XML (*.pvsm) and the binary
+// format of vtkPVXMLBinaryFormat (*.pvsmb). The input format is detected;
+// the output is written in the other format.
+//
+// Usage: pvstateconvert input output
+#include "vtkPVXMLBinaryFormat.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPVXMLParser.h"
+
+//----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+    {
+    cerr << "Usage: " << argv[0] << " input output" << endl
+         << "Converts a state file from XML to binary or from binary to XML."
+         << endl;
+    return 1;
+    }
+
+  if (vtkPVXMLBinaryFormat::IsBinaryFile(argv[1]))
+    {
+    vtkPVXMLElement* root = vtkPVXMLBinaryFormat::ReadFile(argv[1]);
+    if (!root)
+      {
+      cerr << "Failed to read " << argv[1] << endl;
+      return 1;
+      }
+    ofstream os(argv[2], ios::out);
+    root->PrintXML(os, vtkIndent());
+    root->Delete();
+    if (!os)
+      {
+      cerr << "Failed to write " << argv[2] << endl;
+      return 1;
+      }
+    return 0;
+    }
+
+  vtkPVXMLParser* parser = vtkPVXMLParser::New();
+  parser->SetFileName(argv[1]);
+  if (!parser->Parse() || !parser->GetRootElement())
+    {
+    cerr << "Failed to read " << argv[1] << endl;
+    parser->Delete();
+    return 1;
+    }
+  int ret = vtkPVXMLBinaryFormat::WriteFile(parser->GetRootElement(), argv[2]);
+  parser->Delete();
+  if (!ret)
+    {
+    cerr << "Failed to write " << argv[2] << endl;
+    return 1;
+    }
+  return 0;
+}
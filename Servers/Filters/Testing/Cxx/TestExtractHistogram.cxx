@@ -92,5 +92,32 @@ int main(int, char*[])
     vtkGenericWarningMacro("incorrect bin value.");
     return 1;
     }
+
+  // Equal count bins must still hold all the values, spread more evenly than
+  // the uniform bins above.
+  extraction->SetBinningModeToEqualCount();
+  extraction->Update();
+  vtkIntArray* const equal_values = vtkIntArray::SafeDownCast(
+    extraction->GetOutput()->GetRowData()->GetArray("bin_values"));
+  if(!equal_values || equal_values->GetNumberOfTuples() != bin_count)
+    {
+    vtkGenericWarningMacro("bin_values missing for equal count bins.");
+    return 1;
+    }
+  int total = 0;
+  for(int i = 0; i < bin_count; ++i)
+    {
+    total += equal_values->GetValue(i);
+    if(equal_values->GetValue(i) >= 22)
+      {
+      vtkGenericWarningMacro("equal count bins are not balanced.");
+      return 1;
+      }
+    }
+  if(total != 50)
+    {
+    vtkGenericWarningMacro("equal count bins lost values.");
+    return 1;
+    }
   return 0;
 }
@@ -76,6 +76,7 @@
 class MyProcess : public vtkProcess
 {
   vtkSmartPointer<vtkPKdTree> KdTree;
+  vtkSmartPointer<vtkIceTCompositePass> IceTPass;
   int UseOrderedCompositing;
   int UseDepthPeeling;
   bool UseBlurPass;
@@ -293,6 +294,7 @@ void MyProcess::SetupRenderPasses(vtkRenderer* renderer)
   iceTPass->SetImageReductionFactor(this->ImageReductionFactor);
   iceTPass->SetDepthOnly(this->DepthOnly);
   iceTPass->SetFixBackground(true);
+  this->IceTPass = iceTPass;
 
   if (this->ServerMode && this->Controller->GetLocalProcessId() == 0)
     {
@@ -443,6 +445,17 @@ void MyProcess::Execute()
         {
         iren->Start();
         }
+      // Translucent geometry must be composited in visibility order, which
+      // VTREE and SPLIT cannot do.
+      int strategy = this->IceTPass->GetLastStrategy();
+      if (this->UseOrderedCompositing &&
+        (strategy == vtkIceTConstants::VTREE ||
+         strategy == vtkIceTConstants::SPLIT))
+        {
+        cerr << "ERROR: strategy " << strategy
+          << " was used with ordered compositing." << endl;
+        retVal = vtkTesting::FAILED;
+        }
       }
     iren->Delete();
 
@@ -461,6 +474,7 @@ void MyProcess::Execute()
     retVal=vtkTesting::PASSED;
     }
 
+  this->IceTPass = 0;
   renderer->Delete();
   renWin->Delete();
   syncWindows->Delete();
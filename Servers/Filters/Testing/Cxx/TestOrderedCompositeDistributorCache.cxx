@@ -0,0 +1,170 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestOrderedCompositeDistributorCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Redistributes a dataset, then a new dataset with the same points and cells
+// (copied into new arrays, as an upstream filter re-executing would produce)
+// but other cell attributes. Checks that the second update only sends the
+// attributes using the cached plan, and that its output matches a full
+// redistribution of the new dataset.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCellData.h"
+#include "vtkCommand.h"
+#include "vtkCommunicator.h"
+#include "vtkDistributedDataFilter.h"
+#include "vtkFloatArray.h"
+#include "vtkMPIController.h"
+#include "vtkOrderedCompositeDistributor.h"
+#include "vtkPKdTree.h"
+#include "vtkPointData.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkSphereSource.h"
+
+static void CountExecutions(vtkObject*, unsigned long, void* clientdata,
+  void*)
+{
+  ++(*static_cast<int*>(clientdata));
+}
+
+static vtkPolyData* NewInput(int myId, float scale)
+{
+  vtkSmartPointer<vtkSphereSource> sphere =
+    vtkSmartPointer<vtkSphereSource>::New();
+  sphere->SetThetaResolution(32);
+  sphere->SetPhiResolution(32);
+  sphere->SetCenter(0.5 * myId, 0.0, 0.0);
+  sphere->Update();
+
+  // Deep copied so that every input has its own points and cells.
+  vtkPolyData* input = vtkPolyData::New();
+  input->DeepCopy(sphere->GetOutput());
+  input->GetPointData()->Initialize();
+
+  vtkFloatArray* values = vtkFloatArray::New();
+  values->SetName("Values");
+  values->SetNumberOfTuples(input->GetNumberOfCells());
+  for (vtkIdType cc = 0; cc < input->GetNumberOfCells(); cc++)
+    {
+    values->SetValue(cc, scale * (1000 * myId + cc));
+    }
+  input->GetCellData()->AddArray(values);
+  values->Delete();
+  return input;
+}
+
+static bool CompareOutputs(vtkPolyData* expected, vtkPolyData* actual)
+{
+  if (expected->GetNumberOfCells() != actual->GetNumberOfCells() ||
+    expected->GetNumberOfPoints() != actual->GetNumberOfPoints())
+    {
+    cerr << "ERROR: " << actual->GetNumberOfCells() << " cells and "
+      << actual->GetNumberOfPoints() << " points instead of "
+      << expected->GetNumberOfCells() << " and "
+      << expected->GetNumberOfPoints() << endl;
+    return false;
+    }
+  vtkDataArray* expectedValues = expected->GetCellData()->GetArray("Values");
+  vtkDataArray* actualValues = actual->GetCellData()->GetArray("Values");
+  if (!expectedValues || !actualValues)
+    {
+    cerr << "ERROR: the output has no Values array." << endl;
+    return false;
+    }
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfCells(); cc++)
+    {
+    if (expectedValues->GetTuple1(cc) != actualValues->GetTuple1(cc))
+      {
+      cerr << "ERROR: cell " << cc << " has value "
+        << actualValues->GetTuple1(cc) << " instead of "
+        << expectedValues->GetTuple1(cc) << endl;
+      return false;
+      }
+    }
+  for (vtkIdType cc = 0; cc < expected->GetNumberOfPoints(); cc++)
+    {
+    double x[3], y[3];
+    expected->GetPoint(cc, x);
+    actual->GetPoint(cc, y);
+    if (x[0] != y[0] || x[1] != y[1] || x[2] != y[2])
+      {
+      cerr << "ERROR: point " << cc << " differs." << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+int main(int argc, char* argv[])
+{
+  vtkSmartPointer<vtkMPIController> contr =
+    vtkSmartPointer<vtkMPIController>::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+  int myId = contr->GetLocalProcessId();
+
+  vtkPolyData* first = NewInput(myId, 1.0f);
+  vtkPolyData* second = NewInput(myId, -2.0f);
+
+  vtkSmartPointer<vtkPKdTree> kdtree = vtkSmartPointer<vtkPKdTree>::New();
+  kdtree->SetController(contr);
+  kdtree->SetNumberOfRegionsOrMore(contr->GetNumberOfProcesses());
+  kdtree->SetDataSet(first);
+  kdtree->BuildLocator();
+
+  // Counts the full redistributions of the cached distributor.
+  int executions = 0;
+  vtkSmartPointer<vtkCallbackCommand> counter =
+    vtkSmartPointer<vtkCallbackCommand>::New();
+  counter->SetCallback(CountExecutions);
+  counter->SetClientData(&executions);
+  vtkSmartPointer<vtkDistributedDataFilter> d3 =
+    vtkSmartPointer<vtkDistributedDataFilter>::New();
+  d3->AddObserver(vtkCommand::EndEvent, counter);
+
+  vtkSmartPointer<vtkOrderedCompositeDistributor> cached =
+    vtkSmartPointer<vtkOrderedCompositeDistributor>::New();
+  cached->SetController(contr);
+  cached->SetPKdTree(kdtree);
+  cached->SetD3(d3);
+  cached->SetInput(first);
+  cached->Update();
+  cached->SetInput(second);
+  cached->Update();
+
+  vtkSmartPointer<vtkOrderedCompositeDistributor> full =
+    vtkSmartPointer<vtkOrderedCompositeDistributor>::New();
+  full->SetController(contr);
+  full->SetPKdTree(kdtree);
+  full->CacheSendPlanOff();
+  full->SetInput(second);
+  full->Update();
+
+  int ok = CompareOutputs(vtkPolyData::SafeDownCast(full->GetOutput()),
+    vtkPolyData::SafeDownCast(cached->GetOutput()))? 1 : 0;
+  if (executions != 1)
+    {
+    cerr << "ERROR: the dataset was redistributed " << executions
+      << " times instead of once." << endl;
+    ok = 0;
+    }
+  int allOk;
+  contr->AllReduce(&ok, &allOk, 1, vtkCommunicator::MIN_OP);
+
+  first->Delete();
+  second->Delete();
+  vtkMultiProcessController::SetGlobalController(0);
+  contr->Finalize();
+  return allOk? 0 : 1;
+}
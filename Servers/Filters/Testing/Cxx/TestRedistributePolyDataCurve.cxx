@@ -0,0 +1,115 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestRedistributePolyDataCurve.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Redistributes skewed input along the Morton and Hilbert curves and checks
+// that no cell is lost and that the pieces are balanced. Process 0 starts
+// with ten times as many cells as the others and the cells are clustered
+// near one corner of the domain.
+
+#include "vtkCellArray.h"
+#include "vtkCommunicator.h"
+#include "vtkMath.h"
+#include "vtkMPIController.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRedistributePolyData.h"
+#include "vtkSmartPointer.h"
+
+// Largest accepted ratio between the biggest piece and the average piece.
+#define MAX_IMBALANCE 1.25
+
+static vtkPolyData* NewSkewedInput(int myId)
+{
+  vtkIdType numCells = (myId == 0 ? 20000 : 2000);
+  vtkMath::RandomSeed(1234 + myId);
+
+  vtkPoints* points = vtkPoints::New();
+  vtkCellArray* verts = vtkCellArray::New();
+  for (vtkIdType cc = 0; cc < numCells; cc++)
+    {
+    double u = vtkMath::Random();
+    double v = vtkMath::Random();
+    double w = vtkMath::Random();
+    vtkIdType ptId = points->InsertNextPoint(u*u*u*u, v*v*v*v, w);
+    verts->InsertNextCell(1, &ptId);
+    }
+
+  vtkPolyData* input = vtkPolyData::New();
+  input->SetPoints(points);
+  input->SetVerts(verts);
+  points->Delete();
+  verts->Delete();
+  return input;
+}
+
+static bool TestCurve(vtkMultiProcessController* contr, int curve,
+  const char* name)
+{
+  int myId = contr->GetLocalProcessId();
+  int numProcs = contr->GetNumberOfProcesses();
+
+  vtkPolyData* input = NewSkewedInput(myId);
+  vtkRedistributePolyData* redistribute = vtkRedistributePolyData::New();
+  redistribute->SetController(contr);
+  redistribute->SetSpaceFillingCurve(curve);
+  redistribute->SetInput(input);
+  redistribute->Update();
+
+  vtkIdType counts[2] = { input->GetNumberOfCells(),
+    redistribute->GetOutput()->GetNumberOfCells() };
+  vtkIdType totals[2];
+  vtkIdType largest;
+  contr->AllReduce(counts, totals, 2, vtkCommunicator::SUM_OP);
+  contr->AllReduce(&counts[1], &largest, 1, vtkCommunicator::MAX_OP);
+
+  redistribute->Delete();
+  input->Delete();
+
+  bool ret = true;
+  if (totals[0] != totals[1])
+    {
+    if (myId == 0)
+      {
+      cerr << "ERROR: " << name << ": " << totals[1] << " cells out of "
+        << totals[0] << endl;
+      }
+    ret = false;
+    }
+  double average = static_cast<double>(totals[0]) / numProcs;
+  if (largest > MAX_IMBALANCE * average)
+    {
+    if (myId == 0)
+      {
+      cerr << "ERROR: " << name << ": largest piece has " << largest
+        << " cells, the average is " << average << endl;
+      }
+    ret = false;
+    }
+  return ret;
+}
+
+int main(int argc, char* argv[])
+{
+  vtkSmartPointer<vtkMPIController> contr =
+    vtkSmartPointer<vtkMPIController>::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  bool ret = TestCurve(contr, vtkRedistributePolyData::MORTON, "Morton");
+  ret = TestCurve(contr, vtkRedistributePolyData::HILBERT, "Hilbert") && ret;
+
+  vtkMultiProcessController::SetGlobalController(0);
+  contr->Finalize();
+  return ret ? 0 : 1;
+}
@@ -82,4 +82,20 @@ void vtkAllToNRedistributePolyData::MakeSchedule ( vtkCommSched* localSched)
   this->Superclass::MakeSchedule(localSched);
 
 }
+
+//*****************************************************************
+void vtkAllToNRedistributePolyData::ComputeCurveWeights(double* weights)
+{
+  int numProcs = this->Controller->GetNumberOfProcesses();
+  int numberOfValidProcesses = this->NumberOfProcesses;
+  if (numberOfValidProcesses <= 0) { numberOfValidProcesses = numProcs; }
+  if (numberOfValidProcesses > numProcs ) { numberOfValidProcesses = numProcs; }
+
+  this->SetWeights(0, numberOfValidProcesses-1, 1.);
+  if (numberOfValidProcesses < numProcs)
+    {
+    this->SetWeights(numberOfValidProcesses, numProcs-1, 0.);
+    }
+  this->Superclass::ComputeCurveWeights(weights);
+}
 //*****************************************************************
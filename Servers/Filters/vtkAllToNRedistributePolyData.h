@@ -45,6 +45,7 @@ protected:
   ~vtkAllToNRedistributePolyData();
 
   void MakeSchedule (vtkCommSched*);
+  void ComputeCurveWeights (double*);
 
   int NumberOfProcesses;
 
@@ -68,4 +68,11 @@ void vtkBalancedRedistributePolyData::MakeSchedule ( vtkCommSched* localSched)
   this->vtkWeightedRedistributePolyData::MakeSchedule(localSched);
 
 }
+
+//*****************************************************************
+void vtkBalancedRedistributePolyData::ComputeCurveWeights(double* weights)
+{
+  this->SetWeights(0, this->Controller->GetNumberOfProcesses()-1, 1.);
+  this->vtkWeightedRedistributePolyData::ComputeCurveWeights(weights);
+}
 //*****************************************************************
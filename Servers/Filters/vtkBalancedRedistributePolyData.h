@@ -41,6 +41,7 @@ protected:
   vtkBalancedRedistributePolyData();
   ~vtkBalancedRedistributePolyData();
   void MakeSchedule (vtkCommSched*);
+  void ComputeCurveWeights (double*);
 
 private:
   vtkBalancedRedistributePolyData(const vtkBalancedRedistributePolyData&); // Not implemented
@@ -0,0 +1,630 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkBlockCullingPainter.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkBlockCullingPainter.h"
+
+#include "vtkActor.h"
+#include "vtkCamera.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkDataArray.h"
+#include "vtkHardwareSelector.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMath.h"
+#include "vtkMatrix4x4.h"
+#include "vtkObjectFactory.h"
+#include "vtkPolyData.h"
+#include "vtkRenderer.h"
+#include "vtkTimerLog.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/map>
+#include <vtkstd/utility>
+
+#include <math.h>
+
+// A block of the input: its bounds and its cells in each cell array (verts,
+// lines, polys, strips).
+struct vtkBlockCullingBlock
+{
+  double Bounds[6];
+  vtkstd::vector<vtkIdType> Cells[4];
+};
+
+class vtkBlockCullingPainter::vtkInternals
+{
+public:
+  vtkInternals() : Valid(false) {}
+
+  // False when the input has no block ids.
+  bool Valid;
+  vtkstd::vector<vtkBlockCullingBlock> Blocks;
+  // Location of each cell in the connectivity array of each cell array.
+  vtkstd::vector<vtkIdType> Offsets[4];
+  // Blocks rendered by the last render.
+  vtkstd::vector<bool> Visible;
+  // Coarse depth buffer, in normalized device coordinates.
+  vtkstd::vector<double> Depth;
+};
+
+//----------------------------------------------------------------------------
+// Depth of the plane through the triangle at (x, y), in pixel coordinates.
+static inline double vtkBlockCullingPlaneDepth(const double plane[3],
+                                               double x, double y)
+{
+  return plane[0] * x + plane[1] * y + plane[2];
+}
+
+//----------------------------------------------------------------------------
+// Updates the depth buffer with the pixels entirely covered by the triangle
+// (in pixel coordinates, z in normalized device coordinates). The farthest
+// depth of the triangle over each pixel is used, so the buffer never
+// occludes more than the triangle does.
+static void vtkBlockCullingRasterize(const double a[3], const double b[3],
+                                     const double c[3], int resolution,
+                                     double* depth)
+{
+  double area = (b[0] - a[0]) * (c[1] - a[1]) - (c[0] - a[0]) * (b[1] - a[1]);
+  if (area == 0.0)
+    {
+    return;
+    }
+  // z = plane[0]*x + plane[1]*y + plane[2]
+  double plane[3];
+  plane[0] = ((b[2] - a[2]) * (c[1] - a[1]) - (c[2] - a[2]) * (b[1] - a[1]))
+    / area;
+  plane[1] = ((c[2] - a[2]) * (b[0] - a[0]) - (b[2] - a[2]) * (c[0] - a[0]))
+    / area;
+  plane[2] = a[2] - plane[0] * a[0] - plane[1] * a[1];
+
+  const double* v[3] = { a, b, c };
+  double sign = area > 0.0 ? 1.0 : -1.0;
+  int xmin = static_cast<int>(ceil(vtkstd::min(a[0], vtkstd::min(b[0], c[0]))));
+  int xmax = static_cast<int>(floor(vtkstd::max(a[0], vtkstd::max(b[0], c[0]))));
+  int ymin = static_cast<int>(ceil(vtkstd::min(a[1], vtkstd::min(b[1], c[1]))));
+  int ymax = static_cast<int>(floor(vtkstd::max(a[1], vtkstd::max(b[1], c[1]))));
+  xmin = vtkstd::max(xmin, 0);
+  ymin = vtkstd::max(ymin, 0);
+  xmax = vtkstd::min(xmax, resolution);
+  ymax = vtkstd::min(ymax, resolution);
+
+  for (int y = ymin; y < ymax; y++)
+    {
+    for (int x = xmin; x < xmax; x++)
+      {
+      // All four corners of the pixel must be inside the triangle.
+      bool covered = true;
+      for (int corner = 0; corner < 4 && covered; corner++)
+        {
+        double px = x + (corner & 1);
+        double py = y + (corner >> 1);
+        for (int e = 0; e < 3 && covered; e++)
+          {
+          const double* p0 = v[e];
+          const double* p1 = v[(e + 1) % 3];
+          double edge = (p1[0] - p0[0]) * (py - p0[1]) -
+            (p1[1] - p0[1]) * (px - p0[0]);
+          covered = (edge * sign >= 0.0);
+          }
+        }
+      if (!covered)
+        {
+        continue;
+        }
+      double farthest = vtkstd::max(
+        vtkstd::max(vtkBlockCullingPlaneDepth(plane, x, y),
+                    vtkBlockCullingPlaneDepth(plane, x + 1, y)),
+        vtkstd::max(vtkBlockCullingPlaneDepth(plane, x, y + 1),
+                    vtkBlockCullingPlaneDepth(plane, x + 1, y + 1)));
+      double& pixel = depth[y * resolution + x];
+      pixel = vtkstd::min(pixel, farthest);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+// Returns true if the polygon (npts vertices of 3 components, in pixel
+// coordinates) is convex on screen: every corner turns the same way and the
+// boundary goes around only once, i.e. x changes direction at most twice.
+// Only then does a triangle fan cover exactly the polygon.
+static bool vtkBlockCullingIsConvex(const double* v, vtkIdType npts)
+{
+  double turn = 0.0;
+  int xFlips = 0;
+  double lastDx = 0.0;
+  for (vtkIdType i = 0; i < npts; i++)
+    {
+    const double* p0 = v + 3 * i;
+    const double* p1 = v + 3 * ((i + 1) % npts);
+    const double* p2 = v + 3 * ((i + 2) % npts);
+    double cross = (p1[0] - p0[0]) * (p2[1] - p1[1]) -
+      (p1[1] - p0[1]) * (p2[0] - p1[0]);
+    if (cross != 0.0)
+      {
+      if (turn * cross < 0.0)
+        {
+        return false;
+        }
+      turn = cross;
+      }
+    double dx = p1[0] - p0[0];
+    if (dx != 0.0)
+      {
+      if (lastDx * dx < 0.0 && ++xFlips > 2)
+        {
+        return false;
+        }
+      lastDx = dx;
+      }
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkBlockCullingPainter);
+//----------------------------------------------------------------------------
+vtkBlockCullingPainter::vtkBlockCullingPainter()
+{
+  this->BlockIdArrayName = 0;
+  this->SetBlockIdArrayName("vtkCompositeIndex");
+  this->OcclusionCulling = 1;
+  this->OcclusionResolution = 64;
+  this->MaximumNumberOfOccluders = 100000;
+  this->NumberOfBlocks = 0;
+  this->NumberOfFrustumCulledBlocks = 0;
+  this->NumberOfOcclusionCulledBlocks = 0;
+  this->OutputData = 0;
+  this->Internals = new vtkInternals();
+}
+
+//----------------------------------------------------------------------------
+vtkBlockCullingPainter::~vtkBlockCullingPainter()
+{
+  this->SetBlockIdArrayName(0);
+  this->SetOutputData(0);
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+vtkCxxSetObjectMacro(vtkBlockCullingPainter, OutputData, vtkDataObject);
+
+//----------------------------------------------------------------------------
+vtkDataObject* vtkBlockCullingPainter::GetOutput()
+{
+  return this->OutputData ? this->OutputData : this->GetInput();
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockCullingPainter::PrepareForRendering(vtkRenderer* renderer,
+                                                 vtkActor* actor)
+{
+  vtkPolyData* input = vtkPolyData::SafeDownCast(this->GetInput());
+  this->NumberOfFrustumCulledBlocks = 0;
+  this->NumberOfOcclusionCulledBlocks = 0;
+  if (!input)
+    {
+    this->NumberOfBlocks = 0;
+    this->SetOutputData(this->GetInput());
+    return;
+    }
+
+  if (input->GetMTime() > this->BlocksTime ||
+    this->GetMTime() > this->BlocksTime)
+    {
+    this->BuildBlocks(input);
+    this->Internals->Visible.clear();
+    this->BlocksTime.Modified();
+    }
+  this->NumberOfBlocks = static_cast<int>(this->Internals->Blocks.size());
+
+  if (!this->Internals->Valid || this->NumberOfBlocks == 0 ||
+    renderer->GetSelector() != NULL)
+    {
+    this->Internals->Visible.clear();
+    this->SetOutputData(input);
+    return;
+    }
+
+  vtkstd::vector<bool> visible;
+  bool occlusion = this->OcclusionCulling &&
+    !actor->HasTranslucentPolygonalGeometry();
+  this->ComputeVisibleBlocks(renderer, actor, input, occlusion, visible);
+  vtkTimerLog::FormatAndMarkEvent(
+    "vtkBlockCullingPainter: %d of %d blocks culled "
+    "(%d outside the frustum, %d occluded)",
+    this->NumberOfFrustumCulledBlocks + this->NumberOfOcclusionCulledBlocks,
+    this->NumberOfBlocks, this->NumberOfFrustumCulledBlocks,
+    this->NumberOfOcclusionCulledBlocks);
+
+  if (visible == this->Internals->Visible && this->OutputData)
+    {
+    return;
+    }
+  this->Internals->Visible = visible;
+  if (this->NumberOfFrustumCulledBlocks +
+    this->NumberOfOcclusionCulledBlocks == 0)
+    {
+    this->SetOutputData(input);
+    }
+  else
+    {
+    this->BuildOutput(input, visible);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockCullingPainter::BuildBlocks(vtkPolyData* input)
+{
+  vtkInternals* internals = this->Internals;
+  internals->Blocks.clear();
+  for (int t = 0; t < 4; t++)
+    {
+    internals->Offsets[t].clear();
+    }
+
+  vtkDataArray* blockIds = this->BlockIdArrayName ?
+    input->GetCellData()->GetArray(this->BlockIdArrayName) : NULL;
+  internals->Valid = (blockIds != NULL &&
+    blockIds->GetNumberOfTuples() == input->GetNumberOfCells());
+  if (!internals->Valid)
+    {
+    return;
+    }
+
+  vtkTimerLog::MarkStartEvent("vtkBlockCullingPainter::BuildBlocks");
+  vtkstd::map<double, size_t> blockIndices;
+  vtkCellArray* cellArrays[4] = { input->GetVerts(), input->GetLines(),
+    input->GetPolys(), input->GetStrips() };
+  vtkIdType cellId = 0;
+  double x[3];
+  for (int t = 0; t < 4; t++)
+    {
+    vtkIdType numCells = cellArrays[t] ? cellArrays[t]->GetNumberOfCells() : 0;
+    if (numCells == 0)
+      {
+      continue;
+      }
+    const vtkIdType* connectivity = cellArrays[t]->GetPointer();
+    vtkstd::vector<vtkIdType>& offsets = internals->Offsets[t];
+    offsets.resize(numCells);
+    vtkIdType offset = 0;
+    for (vtkIdType i = 0; i < numCells; i++, cellId++)
+      {
+      offsets[i] = offset;
+      vtkIdType npts = connectivity[offset];
+
+      double id = blockIds->GetTuple1(cellId);
+      vtkstd::map<double, size_t>::iterator iter = blockIndices.find(id);
+      if (iter == blockIndices.end())
+        {
+        iter = blockIndices.insert(
+          vtkstd::pair<const double, size_t>(id, internals->Blocks.size())).first;
+        internals->Blocks.push_back(vtkBlockCullingBlock());
+        vtkMath::UninitializeBounds(internals->Blocks.back().Bounds);
+        }
+      vtkBlockCullingBlock& block = internals->Blocks[iter->second];
+      block.Cells[t].push_back(i);
+
+      for (vtkIdType j = 1; j <= npts; j++)
+        {
+        input->GetPoint(connectivity[offset + j], x);
+        if (block.Bounds[0] > block.Bounds[1])
+          {
+          block.Bounds[0] = block.Bounds[1] = x[0];
+          block.Bounds[2] = block.Bounds[3] = x[1];
+          block.Bounds[4] = block.Bounds[5] = x[2];
+          continue;
+          }
+        for (int k = 0; k < 3; k++)
+          {
+          block.Bounds[2*k] = vtkstd::min(block.Bounds[2*k], x[k]);
+          block.Bounds[2*k+1] = vtkstd::max(block.Bounds[2*k+1], x[k]);
+          }
+        }
+      offset += npts + 1;
+      }
+    }
+  vtkTimerLog::MarkEndEvent("vtkBlockCullingPainter::BuildBlocks");
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockCullingPainter::ComputeVisibleBlocks(vtkRenderer* renderer,
+  vtkActor* actor, vtkPolyData* input, bool occlusion,
+  vtkstd::vector<bool>& visible)
+{
+  vtkInternals* internals = this->Internals;
+  size_t numBlocks = internals->Blocks.size();
+  visible.assign(numBlocks, true);
+
+  vtkCamera* camera = renderer->GetActiveCamera();
+  double aspect = renderer->GetTiledAspectRatio();
+  double planes[24];
+  camera->GetFrustumPlanes(aspect, planes);
+
+  // Data to normalized device coordinates.
+  vtkMatrix4x4* toDevice = vtkMatrix4x4::New();
+  vtkMatrix4x4::Multiply4x4(
+    camera->GetCompositeProjectionTransformMatrix(aspect, -1, 1),
+    actor->GetMatrix(), toDevice);
+
+  // Blocks in front of the eye that can be tested for occlusion, with their
+  // screen rectangle (pixels) and nearest depth.
+  int resolution = this->OcclusionResolution;
+  vtkstd::vector<vtkstd::pair<double, size_t> > candidates;
+  vtkstd::vector<double> rectangles(4 * numBlocks, 0.0);
+
+  double corner[4], world[4], device[4];
+  for (size_t b = 0; b < numBlocks; b++)
+    {
+    const double* bounds = internals->Blocks[b].Bounds;
+    if (bounds[0] > bounds[1])
+      {
+      continue;
+      }
+
+    int outside[6] = { 1, 1, 1, 1, 1, 1 };
+    bool behindEye = false;
+    double rect[4] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX,
+                       VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    double nearest = VTK_DOUBLE_MAX;
+    for (int c = 0; c < 8; c++)
+      {
+      corner[0] = bounds[(c & 1)];
+      corner[1] = bounds[2 + ((c >> 1) & 1)];
+      corner[2] = bounds[4 + ((c >> 2) & 1)];
+      corner[3] = 1.0;
+      actor->GetMatrix()->MultiplyPoint(corner, world);
+      for (int p = 0; p < 6; p++)
+        {
+        const double* plane = planes + 4 * p;
+        if (plane[0] * world[0] + plane[1] * world[1] + plane[2] * world[2] +
+          plane[3] * world[3] >= 0.0)
+          {
+          outside[p] = 0;
+          }
+        }
+
+      toDevice->MultiplyPoint(corner, device);
+      if (device[3] <= 0.0)
+        {
+        behindEye = true;
+        continue;
+        }
+      double px = (device[0] / device[3] + 1.0) * 0.5 * resolution;
+      double py = (device[1] / device[3] + 1.0) * 0.5 * resolution;
+      rect[0] = vtkstd::min(rect[0], px);
+      rect[1] = vtkstd::max(rect[1], px);
+      rect[2] = vtkstd::min(rect[2], py);
+      rect[3] = vtkstd::max(rect[3], py);
+      nearest = vtkstd::min(nearest, device[2] / device[3]);
+      }
+
+    if (outside[0] || outside[1] || outside[2] || outside[3] || outside[4] ||
+      outside[5])
+      {
+      visible[b] = false;
+      this->NumberOfFrustumCulledBlocks++;
+      }
+    else if (occlusion && !behindEye)
+      {
+      candidates.push_back(vtkstd::pair<double, size_t>(nearest, b));
+      vtkstd::copy(rect, rect + 4, &rectangles[4 * b]);
+      }
+    }
+
+  if (occlusion && candidates.size() > 1)
+    {
+    // Front to back, each block is tested against the depth of the blocks in
+    // front of it and then rasterized as an occluder.
+    vtkstd::sort(candidates.begin(), candidates.end());
+    internals->Depth.assign(resolution * resolution, VTK_DOUBLE_MAX);
+    double* depth = &internals->Depth[0];
+    int occluders = this->MaximumNumberOfOccluders;
+    vtkCellArray* polys = input->GetPolys();
+    const vtkIdType* connectivity = polys->GetNumberOfCells() > 0 ?
+      polys->GetPointer() : NULL;
+    vtkstd::vector<double> v;
+
+    for (size_t i = 0; i < candidates.size(); i++)
+      {
+      size_t b = candidates[i].second;
+      const double* rect = &rectangles[4 * b];
+      int xmin = vtkstd::max(static_cast<int>(floor(rect[0])), 0);
+      int xmax = vtkstd::min(static_cast<int>(ceil(rect[1])), resolution);
+      int ymin = vtkstd::max(static_cast<int>(floor(rect[2])), 0);
+      int ymax = vtkstd::min(static_cast<int>(ceil(rect[3])), resolution);
+      bool occluded = (xmin < xmax && ymin < ymax);
+      for (int y = ymin; y < ymax && occluded; y++)
+        {
+        for (int x = xmin; x < xmax && occluded; x++)
+          {
+          occluded = (depth[y * resolution + x] < candidates[i].first);
+          }
+        }
+      if (occluded)
+        {
+        visible[b] = false;
+        this->NumberOfOcclusionCulledBlocks++;
+        continue;
+        }
+
+      const vtkstd::vector<vtkIdType>& cells = internals->Blocks[b].Cells[2];
+      for (size_t c = 0; c < cells.size() && occluders > 0; c++, occluders--)
+        {
+        const vtkIdType* cell = connectivity + internals->Offsets[2][cells[c]];
+        vtkIdType npts = cell[0];
+        if (npts < 3)
+          {
+          continue;
+          }
+        v.resize(3 * npts);
+        bool valid = true;
+        for (vtkIdType j = 0; j < npts && valid; j++)
+          {
+          input->GetPoint(cell[j + 1], corner);
+          corner[3] = 1.0;
+          toDevice->MultiplyPoint(corner, device);
+          valid = (device[3] > 0.0);
+          double* vertex = &v[3 * j];
+          vertex[0] = (device[0] / device[3] + 1.0) * 0.5 * resolution;
+          vertex[1] = (device[1] / device[3] + 1.0) * 0.5 * resolution;
+          vertex[2] = device[2] / device[3];
+          }
+        // A fan over a concave polygon covers pixels outside of it, which
+        // would cull visible blocks, so such polygons are not occluders.
+        if (!valid || (npts > 3 && !vtkBlockCullingIsConvex(&v[0], npts)))
+          {
+          continue;
+          }
+        for (vtkIdType j = 2; j < npts; j++)
+          {
+          vtkBlockCullingRasterize(&v[0], &v[3 * (j - 1)], &v[3 * j],
+            resolution, depth);
+          }
+        }
+      }
+    }
+  toDevice->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockCullingPainter::BuildOutput(vtkPolyData* input,
+  const vtkstd::vector<bool>& visible)
+{
+  vtkInternals* internals = this->Internals;
+  vtkPolyData* output = vtkPolyData::New();
+  output->ShallowCopy(input);
+
+  vtkCellArray* cellArrays[4] = { input->GetVerts(), input->GetLines(),
+    input->GetPolys(), input->GetStrips() };
+  vtkCellArray* outArrays[4] = { NULL, NULL, NULL, NULL };
+
+  // Cell data follows the cells.
+  bool hasCellData = (input->GetCellData()->GetNumberOfArrays() > 0);
+  vtkIdList* cellMap = vtkIdList::New();
+
+  vtkIdType firstCellId = 0;
+  for (int t = 0; t < 4; t++)
+    {
+    vtkIdType numCells = cellArrays[t] ? cellArrays[t]->GetNumberOfCells() : 0;
+    if (numCells == 0)
+      {
+      continue;
+      }
+    const vtkIdType* connectivity = cellArrays[t]->GetPointer();
+    const vtkstd::vector<vtkIdType>& offsets = internals->Offsets[t];
+
+    vtkIdType numOutCells = 0;
+    vtkIdType size = 0;
+    size_t b;
+    for (b = 0; b < visible.size(); b++)
+      {
+      if (!visible[b])
+        {
+        continue;
+        }
+      const vtkstd::vector<vtkIdType>& cells = internals->Blocks[b].Cells[t];
+      numOutCells += static_cast<vtkIdType>(cells.size());
+      for (size_t c = 0; c < cells.size(); c++)
+        {
+        size += connectivity[offsets[cells[c]]] + 1;
+        }
+      }
+
+    vtkIdTypeArray* outConnectivity = vtkIdTypeArray::New();
+    outConnectivity->SetNumberOfTuples(size);
+    vtkIdType* outPtr = outConnectivity->GetPointer(0);
+    for (b = 0; b < visible.size(); b++)
+      {
+      if (!visible[b])
+        {
+        continue;
+        }
+      const vtkstd::vector<vtkIdType>& cells = internals->Blocks[b].Cells[t];
+      for (size_t c = 0; c < cells.size(); c++)
+        {
+        const vtkIdType* cell = connectivity + offsets[cells[c]];
+        for (vtkIdType j = 0; j <= cell[0]; j++)
+          {
+          *outPtr++ = cell[j];
+          }
+        if (hasCellData)
+          {
+          cellMap->InsertNextId(firstCellId + cells[c]);
+          }
+        }
+      }
+    outArrays[t] = vtkCellArray::New();
+    outArrays[t]->SetCells(numOutCells, outConnectivity);
+    outConnectivity->Delete();
+    firstCellId += numCells;
+    }
+
+  output->SetVerts(outArrays[0]);
+  output->SetLines(outArrays[1]);
+  output->SetPolys(outArrays[2]);
+  output->SetStrips(outArrays[3]);
+  for (int t = 0; t < 4; t++)
+    {
+    if (outArrays[t])
+      {
+      outArrays[t]->Delete();
+      }
+    }
+
+  if (hasCellData)
+    {
+    vtkCellData* inCD = input->GetCellData();
+    vtkCellData* outCD = vtkCellData::New();
+    for (int i = 0; i < inCD->GetNumberOfArrays(); i++)
+      {
+      vtkAbstractArray* inArray = inCD->GetAbstractArray(i);
+      vtkAbstractArray* outArray = inArray->NewInstance();
+      outArray->SetName(inArray->GetName());
+      outArray->SetNumberOfComponents(inArray->GetNumberOfComponents());
+      inArray->GetTuples(cellMap, outArray);
+      int index = outCD->AddArray(outArray);
+      outArray->Delete();
+      int attribute = inCD->IsArrayAnAttribute(i);
+      if (attribute >= 0)
+        {
+        outCD->SetActiveAttribute(index, attribute);
+        }
+      }
+    output->GetCellData()->ShallowCopy(outCD);
+    outCD->Delete();
+    }
+  cellMap->Delete();
+
+  this->SetOutputData(output);
+  output->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkBlockCullingPainter::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "BlockIdArrayName: "
+     << (this->BlockIdArrayName ? this->BlockIdArrayName : "(none)") << endl;
+  os << indent << "OcclusionCulling: " << this->OcclusionCulling << endl;
+  os << indent << "OcclusionResolution: " << this->OcclusionResolution << endl;
+  os << indent << "MaximumNumberOfOccluders: "
+     << this->MaximumNumberOfOccluders << endl;
+  os << indent << "NumberOfBlocks: " << this->NumberOfBlocks << endl;
+  os << indent << "NumberOfFrustumCulledBlocks: "
+     << this->NumberOfFrustumCulledBlocks << endl;
+  os << indent << "NumberOfOcclusionCulledBlocks: "
+     << this->NumberOfOcclusionCulledBlocks << endl;
+}
@@ -0,0 +1,138 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkBlockCullingPainter.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkBlockCullingPainter - painter that skips the blocks of a
+// vtkPolyData that cannot be seen.
+// .SECTION Description
+// vtkPVGeometryFilter appends the blocks of a composite dataset into a single
+// vtkPolyData, tagging each cell with the flat index of its block
+// ("vtkCompositeIndex"). vtkBlockCullingPainter groups the cells by that
+// index, keeps the bounds of every block and, before each render, passes on
+// to its delegate only the cells of the blocks that intersect the view
+// frustum. When OcclusionCulling is on, blocks whose screen footprint is
+// entirely behind a coarse software depth buffer, rasterized from the
+// polygons of the blocks in front of them, are skipped as well. Only
+// triangles and polygons that are convex on screen are used as occluders;
+// concave polygons are ignored since their fan triangulation would cover
+// pixels outside of them. Occlusion culling is not used for translucent
+// actors.
+//
+// Culling is disabled while a hardware selection is in progress so that the
+// cell ids seen by the selector are those of the input.
+//
+// The number of culled blocks is recorded in the vtkTimerLog with every
+// render, hence it is reported by vtkPVTimerInformation.
+// .SECTION See Also
+// vtkPVBlockCullingMapper
+
+#ifndef __vtkBlockCullingPainter_h
+#define __vtkBlockCullingPainter_h
+
+#include "vtkPainter.h"
+//BTX
+#include <vtkstd/vector> // needed for vector.
+//ETX
+
+class vtkPolyData;
+
+class VTK_EXPORT vtkBlockCullingPainter : public vtkPainter
+{
+public:
+  static vtkBlockCullingPainter* New();
+  vtkTypeMacro(vtkBlockCullingPainter, vtkPainter);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Get the output data object from this painter, i.e. the input without the
+  // cells of the culled blocks.
+  virtual vtkDataObject* GetOutput();
+
+  // Description:
+  // Name of the cell array holding the block index of each cell. Default is
+  // "vtkCompositeIndex".
+  vtkSetStringMacro(BlockIdArrayName);
+  vtkGetStringMacro(BlockIdArrayName);
+
+  // Description:
+  // Turn on/off culling of the blocks hidden behind other blocks. Default is
+  // on.
+  vtkSetMacro(OcclusionCulling, int);
+  vtkGetMacro(OcclusionCulling, int);
+  vtkBooleanMacro(OcclusionCulling, int);
+
+  // Description:
+  // Resolution (in both directions) of the coarse depth buffer used for
+  // occlusion culling. Default is 64.
+  vtkSetClampMacro(OcclusionResolution, int, 8, 1024);
+  vtkGetMacro(OcclusionResolution, int);
+
+  // Description:
+  // Maximum number of polygons rasterized in the coarse depth buffer per
+  // render. Default is 100000.
+  vtkSetClampMacro(MaximumNumberOfOccluders, int, 0, VTK_LARGE_INTEGER);
+  vtkGetMacro(MaximumNumberOfOccluders, int);
+
+  // Description:
+  // Counts for the last render.
+  vtkGetMacro(NumberOfBlocks, int);
+  vtkGetMacro(NumberOfFrustumCulledBlocks, int);
+  vtkGetMacro(NumberOfOcclusionCulledBlocks, int);
+
+//BTX
+protected:
+  vtkBlockCullingPainter();
+  ~vtkBlockCullingPainter();
+
+  // Description:
+  // Called before RenderInternal(). Computes the visible blocks and updates
+  // the output.
+  virtual void PrepareForRendering(vtkRenderer* renderer, vtkActor* actor);
+
+  // Description:
+  // Groups the cells of the input by block and computes the block bounds.
+  void BuildBlocks(vtkPolyData* input);
+
+  // Description:
+  // Fills visible with the blocks to render.
+  void ComputeVisibleBlocks(vtkRenderer* renderer, vtkActor* actor,
+    vtkPolyData* input, bool occlusion, vtkstd::vector<bool>& visible);
+
+  // Description:
+  // Builds the output from the cells of the visible blocks.
+  void BuildOutput(vtkPolyData* input, const vtkstd::vector<bool>& visible);
+
+  void SetOutputData(vtkDataObject*);
+
+  char* BlockIdArrayName;
+  int OcclusionCulling;
+  int OcclusionResolution;
+  int MaximumNumberOfOccluders;
+
+  int NumberOfBlocks;
+  int NumberOfFrustumCulledBlocks;
+  int NumberOfOcclusionCulledBlocks;
+
+  vtkDataObject* OutputData;
+  vtkTimeStamp BlocksTime;
+
+private:
+  vtkBlockCullingPainter(const vtkBlockCullingPainter&); // Not implemented.
+  void operator=(const vtkBlockCullingPainter&); // Not implemented.
+
+  class vtkInternals;
+  vtkInternals* Internals;
+//ETX
+};
+
+#endif
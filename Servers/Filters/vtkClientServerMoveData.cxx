@@ -152,6 +152,9 @@ int vtkClientServerMoveData::RequestData(vtkInformation*,
     else if (is_client || rc->IsA("vtkServerConnection"))
       {
       vtkDebugMacro("Client: Get data from server and put it on the output.");
+      // The server only sends the data once it got the streams asking for
+      // it, which may still be queued by a stream transaction.
+      rc->FlushStreams();
       // This is a client node.
       // If it is a selection, use the XML serializer.
       // Otherwise, use the communicator.
@@ -15,6 +15,10 @@
 #include "vtkEquivalenceSet.h"
 #include "vtkObjectFactory.h"
 #include "vtkIntArray.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessControllerHelper.h"
+
+#include <vtkstd/algorithm>
 
 
 vtkStandardNewMacro(vtkEquivalenceSet);
@@ -241,3 +245,212 @@ int vtkEquivalenceSet::ResolveEquivalences()
   return count;
 }
 
+//----------------------------------------------------------------------------
+// Returns the process that owns a global fragment id.  Process p owns the
+// ids in (fragmentIdOffsets[p], fragmentIdOffsets[p+1]].
+static int vtkEquivalenceSetOwner(
+  const vtkstd::vector<int>& fragmentIdOffsets,
+  vtkIdType globalFragmentId)
+{
+  return static_cast<int>(
+    vtkstd::upper_bound(fragmentIdOffsets.begin(), fragmentIdOffsets.end(),
+                        static_cast<int>(globalFragmentId - 1)) -
+    fragmentIdOffsets.begin()) - 1;
+}
+
+//----------------------------------------------------------------------------
+// Distributed union-find of global fragment ids.  Every process owns the
+// labels of the fragments it created.  A label is the smallest global id known
+// to be connected to the fragment.  Rendezvous processes fetch the labels of
+// the fragments in their equivalences, propagate the smallest label across the
+// equivalences and send the lowered labels back to the owners.  This repeats
+// until no label changes.  The fragments that are their own label are then
+// numbered consecutively in global id order, which gives the same ids as
+// resolving the equivalence set on a single process.
+// On return "finalFragmentIds" maps the local resolved fragment ids
+// to the final fragment ids (both start at 1, 0 maps to 0).
+int vtkEquivalenceSet::ResolveDistributedEquivalences(
+  vtkMultiProcessController* controller,
+  const vtkstd::vector<int>& fragmentIdOffsets,
+  const vtkstd::vector<vtkIdType>& equivalences,
+  vtkstd::vector<int>& finalFragmentIds)
+{
+  int numProcs = controller->GetNumberOfProcesses();
+  int myId = controller->GetLocalProcessId();
+  int firstId = fragmentIdOffsets[myId] + 1;
+  int numOwned = fragmentIdOffsets[myId+1] - fragmentIdOffsets[myId];
+
+  vtkstd::vector<int> labels(numOwned);
+  for (int ii = 0; ii < numOwned; ++ii)
+    {
+    labels[ii] = firstId + ii;
+    }
+
+  // The distinct fragments referenced by our equivalences.  They are sorted,
+  // so requests grouped by owner come back in the same order.
+  vtkstd::vector<vtkIdType> endpoints(equivalences);
+  vtkstd::sort(endpoints.begin(), endpoints.end());
+  endpoints.erase(vtkstd::unique(endpoints.begin(), endpoints.end()),
+                  endpoints.end());
+  size_t numEndpoints = endpoints.size();
+  size_t numEquivalences = equivalences.size() / 2;
+  vtkstd::vector<size_t> edges(equivalences.size());
+  for (size_t ii = 0; ii < equivalences.size(); ++ii)
+    {
+    edges[ii] = vtkstd::lower_bound(endpoints.begin(), endpoints.end(),
+                                    equivalences[ii]) - endpoints.begin();
+    }
+
+  vtkstd::vector<vtkstd::vector<vtkIdType> > requests(numProcs);
+  for (size_t ii = 0; ii < numEndpoints; ++ii)
+    {
+    requests[vtkEquivalenceSetOwner(fragmentIdOffsets, endpoints[ii])]
+      .push_back(endpoints[ii]);
+    }
+
+  vtkstd::vector<vtkstd::vector<vtkIdType> > incoming;
+  vtkstd::vector<vtkstd::vector<vtkIdType> > replies(numProcs);
+  vtkstd::vector<vtkIdType> endpointLabels(numEndpoints);
+  vtkstd::vector<vtkIdType> newLabels(numEndpoints);
+  int changed = 1;
+  while (changed)
+    {
+    // Fetch the current labels of our endpoints from their owners.
+    vtkMultiProcessControllerHelper::ExchangeAllToAll(
+      controller, requests, incoming, 7308930);
+    for (int procIdx = 0; procIdx < numProcs; ++procIdx)
+      {
+      replies[procIdx].resize(incoming[procIdx].size());
+      for (size_t ii = 0; ii < incoming[procIdx].size(); ++ii)
+        {
+        replies[procIdx][ii] = labels[incoming[procIdx][ii] - firstId];
+        }
+      }
+    vtkMultiProcessControllerHelper::ExchangeAllToAll(
+      controller, replies, incoming, 7308931);
+    size_t endpointIdx = 0;
+    for (int procIdx = 0; procIdx < numProcs; ++procIdx)
+      {
+      for (size_t ii = 0; ii < incoming[procIdx].size(); ++ii)
+        {
+        endpointLabels[endpointIdx++] = incoming[procIdx][ii];
+        }
+      }
+
+    // Propagate the smallest label across our equivalences until
+    // nothing changes locally.
+    newLabels = endpointLabels;
+    int localChange = 1;
+    while (localChange)
+      {
+      localChange = 0;
+      for (size_t ii = 0; ii < numEquivalences; ++ii)
+        {
+        vtkIdType& label1 = newLabels[edges[2*ii]];
+        vtkIdType& label2 = newLabels[edges[2*ii+1]];
+        if (label1 != label2)
+          {
+          label1 = label2 = (label1 < label2) ? label1 : label2;
+          localChange = 1;
+          }
+        }
+      }
+
+    // Send the lowered labels to the owners.
+    vtkstd::vector<vtkstd::vector<vtkIdType> > updates(numProcs);
+    for (size_t ii = 0; ii < numEndpoints; ++ii)
+      {
+      if (newLabels[ii] < endpointLabels[ii])
+        {
+        vtkstd::vector<vtkIdType>& msg = updates[
+          vtkEquivalenceSetOwner(fragmentIdOffsets, endpoints[ii])];
+        msg.push_back(endpoints[ii]);
+        msg.push_back(newLabels[ii]);
+        }
+      }
+    vtkMultiProcessControllerHelper::ExchangeAllToAll(
+      controller, updates, incoming, 7308932);
+    int labelChanged = 0;
+    for (int procIdx = 0; procIdx < numProcs; ++procIdx)
+      {
+      const vtkstd::vector<vtkIdType>& msg = incoming[procIdx];
+      for (size_t ii = 0; ii + 1 < msg.size(); ii += 2)
+        {
+        int& label = labels[msg[ii] - firstId];
+        if (msg[ii+1] < label)
+          {
+          label = static_cast<int>(msg[ii+1]);
+          labelChanged = 1;
+          }
+        }
+      }
+    controller->AllReduce(&labelChanged, &changed, 1,
+                                vtkCommunicator::MAX_OP);
+    }
+
+  // Number the fragments that are their own label (one per final fragment).
+  int numRoots = 0;
+  for (int ii = 0; ii < numOwned; ++ii)
+    {
+    if (labels[ii] == firstId + ii)
+      {
+      ++numRoots;
+      }
+    }
+  vtkstd::vector<int> rootCounts(numProcs, 0);
+  controller->AllGather(&numRoots, &rootCounts[0], 1);
+  int nextFinalId = 1;
+  int numberOfFinalFragments = 0;
+  for (int procIdx = 0; procIdx < numProcs; ++procIdx)
+    {
+    if (procIdx == myId)
+      {
+      nextFinalId = numberOfFinalFragments + 1;
+      }
+    numberOfFinalFragments += rootCounts[procIdx];
+    }
+
+  finalFragmentIds.assign(numOwned+1, 0);
+  for (int procIdx = 0; procIdx < numProcs; ++procIdx)
+    {
+    requests[procIdx].clear();
+    }
+  for (int ii = 0; ii < numOwned; ++ii)
+    {
+    if (labels[ii] == firstId + ii)
+      {
+      finalFragmentIds[ii+1] = nextFinalId++;
+      }
+    else
+      {
+      requests[vtkEquivalenceSetOwner(fragmentIdOffsets, labels[ii])]
+        .push_back(labels[ii]);
+      }
+    }
+
+  // Ask the owners of the root fragments for their final ids.
+  vtkMultiProcessControllerHelper::ExchangeAllToAll(
+    controller, requests, incoming, 7308933);
+  for (int procIdx = 0; procIdx < numProcs; ++procIdx)
+    {
+    replies[procIdx].resize(incoming[procIdx].size());
+    for (size_t ii = 0; ii < incoming[procIdx].size(); ++ii)
+      {
+      replies[procIdx][ii] = finalFragmentIds[incoming[procIdx][ii] - firstId + 1];
+      }
+    }
+  vtkMultiProcessControllerHelper::ExchangeAllToAll(
+    controller, replies, incoming, 7308934);
+  vtkstd::vector<size_t> cursors(numProcs, 0);
+  for (int ii = 0; ii < numOwned; ++ii)
+    {
+    if (labels[ii] != firstId + ii)
+      {
+      int owner = vtkEquivalenceSetOwner(fragmentIdOffsets, labels[ii]);
+      finalFragmentIds[ii+1] =
+        static_cast<int>(incoming[owner][cursors[owner]++]);
+      }
+    }
+
+  return numberOfFinalFragments;
+}
@@ -21,7 +21,11 @@
 #define __vtkEquivalenceSet_h
 
 #include "vtkObject.h"
+//BTX
+#include <vtkstd/vector> // needed for vector.
+//ETX
 class vtkIntArray;
+class vtkMultiProcessController;
 
 
 class VTK_EXPORT vtkEquivalenceSet : public vtkObject
@@ -66,6 +70,22 @@ public:
   // We should fix the pointer API and hide this ivar.
   int Resolved;
 
+//BTX
+  // Resolve equivalences between fragments created by different processes
+  // without collecting them on a single process.  Process p owns the global
+  // ids in (offsets[p], offsets[p+1]].  "equivalences" holds pairs of
+  // equivalent global ids found by the local process (they do not need to be
+  // owned by it).  On return finalIds maps the owned ids (local id + 1, entry
+  // 0 maps to 0) to final set ids starting at 1, numbered in the order of
+  // their smallest member like ResolveEquivalences.  Returns the total
+  // number of final sets.  This must be called on all processes.
+  static int ResolveDistributedEquivalences(
+    vtkMultiProcessController* controller,
+    const vtkstd::vector<int>& offsets,
+    const vtkstd::vector<vtkIdType>& equivalences,
+    vtkstd::vector<int>& finalIds);
+//ETX
+
 private:
   vtkEquivalenceSet();
   ~vtkEquivalenceSet();
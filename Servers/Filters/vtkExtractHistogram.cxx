@@ -25,6 +25,7 @@
 #include "vtkIntArray.h"
 #include "vtkIOStream.h"
 #include "vtkMath.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkOnePieceExtentTranslator.h"
 #include "vtkPointData.h"
@@ -32,9 +33,13 @@
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkTable.h"
 
+#include <vtkstd/algorithm>
 #include <vtkstd/vector>
 #include <vtkstd/map>
 #include <vtkstd/string>
+#include <vtkstd/utility>
+
+#include <math.h>
 
 struct vtkEHInternals
 {
@@ -48,6 +53,9 @@ struct vtkEHInternals
   typedef vtkstd::map<vtkstd::string, ArrayValuesType> ArrayMapType;
   ArrayMapType ArrayValues;
   int FieldAssociation;
+  // The BinCount+1 bin edges of the adaptive binning modes, empty for
+  // uniform bins.
+  vtkstd::vector<double> BinEdges;
 };
 
 vtkStandardNewMacro(vtkExtractHistogram);
@@ -64,6 +72,7 @@ vtkExtractHistogram::vtkExtractHistogram() :
     vtkDataSetAttributes::SCALARS);
   this->Internal = new vtkEHInternals;
   this->CalculateAverages = 0;
+  this->BinningMode = vtkExtractHistogram::UNIFORM;
   this->UseCustomBinRanges = false;
   this->CustomBinRanges[0] = 0;
   this->CustomBinRanges[1] = 100;
@@ -85,6 +94,7 @@ void vtkExtractHistogram::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "UseCustomBinRanges: " << this->UseCustomBinRanges << endl;
   os << indent << "CustomBinRanges: " <<
     this->CustomBinRanges[0] << ", " << this->CustomBinRanges[1] << endl;
+  os << indent << "BinningMode: " << this->BinningMode << endl;
 }
 
 //-----------------------------------------------------------------------------
@@ -262,6 +272,192 @@ void vtkExtractHistogram::FillBinExtents(vtkDoubleArray* bin_extents,
     }
 }
 
+//-----------------------------------------------------------------------------
+// Appends the values of the selected component that lie within [min, max].
+static void vtkExtractHistogramCollectValues(vtkDataArray* data_array,
+  int component, double min, double max, vtkstd::vector<double>& values)
+{
+  if (!data_array || component < 0 ||
+    component >= data_array->GetNumberOfComponents())
+    {
+    return;
+    }
+  vtkIdType num_of_tuples = data_array->GetNumberOfTuples();
+  values.reserve(values.size() + num_of_tuples);
+  for (vtkIdType i = 0; i < num_of_tuples; ++i)
+    {
+    double value = data_array->GetComponent(i, component);
+    if (value >= min && value <= max)
+      {
+      values.push_back(value);
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkExtractHistogram::ComputeAdaptiveBinEdges(
+  vtkInformationVector** inputVector,
+  vtkDoubleArray* bin_extents,
+  double min, double max)
+{
+  vtkstd::vector<double> values;
+  if (inputVector)
+    {
+    vtkInformation* inInfo = inputVector[0]->GetInformationObject(0);
+    vtkDataObject *input = inInfo->Get(vtkDataObject::DATA_OBJECT());
+    vtkCompositeDataSet *cdin = vtkCompositeDataSet::SafeDownCast(input);
+    if (cdin)
+      {
+      vtkCompositeDataIterator *cdit = cdin->NewIterator();
+      for (cdit->InitTraversal(); !cdit->IsDoneWithTraversal(); 
+        cdit->GoToNextItem())
+        {
+        ::vtkExtractHistogramCollectValues(
+          this->GetInputArrayToProcess(0, cdit->GetCurrentDataObject()),
+          this->Component, min, max, values);
+        }
+      cdit->Delete();
+      }
+    else
+      {
+      ::vtkExtractHistogramCollectValues(
+        this->GetInputArrayToProcess(0, inputVector),
+        this->Component, min, max, values);
+      }
+    }
+
+  // Regular sampling of the sorted values: the values are split in 
+  // numSamples slices of (nearly) equal size and the middle value of each
+  // slice is kept, weighted with the size of the slice.
+  vtkstd::sort(values.begin(), values.end());
+  vtkstd::vector<double> samples;
+  size_t numValues = values.size();
+  if (numValues > 0)
+    {
+    size_t numSamples = 16 * static_cast<size_t>(this->BinCount);
+    numSamples = numSamples < 1024 ? 1024 : numSamples;
+    numSamples = numSamples > numValues ? numValues : numSamples;
+    samples.reserve(2 * numSamples + 2);
+    for (size_t cc = 0; cc < numSamples; cc++)
+      {
+      size_t begin = cc * numValues / numSamples;
+      size_t end = (cc + 1) * numValues / numSamples;
+      samples.push_back(values[(begin + end) / 2]);
+      samples.push_back(static_cast<double>(end - begin));
+      }
+
+    // The smallest positive value starts the logarithmic scale. It is passed
+    // along with no weight so it does not bias the quantiles.
+    vtkstd::vector<double>::iterator positive = 
+      vtkstd::upper_bound(values.begin(), values.end(), 0.0);
+    if (positive != values.end())
+      {
+      samples.push_back(*positive);
+      samples.push_back(0.0);
+      }
+    }
+  vtkstd::vector<double>().swap(values);
+
+  this->GatherBinningSamples(samples);
+
+  size_t numPairs = samples.size() / 2;
+  vtkstd::vector<vtkstd::pair<double, double> > sorted(numPairs);
+  double total = 0.0;
+  for (size_t cc = 0; cc < numPairs; cc++)
+    {
+    sorted[cc].first = samples[2*cc];
+    sorted[cc].second = samples[2*cc+1];
+    total += sorted[cc].second;
+    }
+  vtkstd::sort(sorted.begin(), sorted.end());
+
+  vtkstd::vector<double>& edges = this->Internal->BinEdges;
+  edges.resize(this->BinCount + 1);
+  edges[0] = min;
+  edges[this->BinCount] = max;
+  if (this->BinningMode == vtkExtractHistogram::LOGARITHMIC)
+    {
+    // When the range includes values <= 0, they are all put in the first
+    // bin and the remaining bins cover [lowest positive value, max].
+    int first = min > 0.0 ? 0 : 1;
+    double lowest = min;
+    if (first)
+      {
+      lowest = max;
+      for (size_t cc = 0; cc < numPairs; cc++)
+        {
+        if (sorted[cc].first > 0.0)
+          {
+          lowest = sorted[cc].first;
+          break;
+          }
+        }
+      }
+    if (lowest <= 0.0 || lowest >= max || this->BinCount <= first)
+      {
+      edges.clear();
+      }
+    else
+      {
+      double ratio = max / lowest;
+      for (int k = first; k < this->BinCount; k++)
+        {
+        edges[k] = lowest * pow(ratio,
+          static_cast<double>(k - first) / (this->BinCount - first));
+        }
+      }
+    }
+  else if (total > 0.0)
+    {
+    // EQUAL_COUNT: the edge k is the sample at which the cumulative weight
+    // reaches k/BinCount of the total.
+    double accumulated = 0.0;
+    size_t next = 0;
+    for (int k = 1; k < this->BinCount; k++)
+      {
+      double target = total * k / this->BinCount;
+      while (next < numPairs && accumulated + sorted[next].second < target)
+        {
+        accumulated += sorted[next].second;
+        next++;
+        }
+      double edge = next < numPairs ? sorted[next].first : max;
+      edge = edge < edges[k-1] ? edges[k-1] : edge;
+      edges[k] = edge > max ? max : edge;
+      }
+    }
+  else
+    {
+    edges.clear();
+    }
+
+  if (edges.empty())
+    {
+    // Not enough information for adaptive bins, fall back to uniform ones.
+    this->FillBinExtents(bin_extents, min, max);
+    return;
+    }
+
+  bin_extents->SetNumberOfComponents(1);
+  bin_extents->SetNumberOfTuples(this->BinCount);
+  for (int i = 0; i < this->BinCount; ++i)
+    {
+    if (this->BinningMode == vtkExtractHistogram::LOGARITHMIC &&
+      edges[i] > 0.0)
+      {
+      bin_extents->SetValue(i, sqrt(edges[i] * edges[i+1]));
+      }
+    else
+      {
+      bin_extents->SetValue(i, 0.5 * (edges[i] + edges[i+1]));
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkExtractHistogram::GatherBinningSamples(vtkstd::vector<double>&)
+{
+}
 
 inline int vtkExtractHistogramClamp(int value, int min, int max)
 {
@@ -270,6 +466,68 @@ inline int vtkExtractHistogramClamp(int value, int min, int max)
   return value;
 }
 
+inline int vtkExtractHistogramBinIndex(double value, double min, 
+  double bin_delta, const vtkstd::vector<double>& edges, int bin_count)
+{
+  if (!edges.empty())
+    {
+    // Only the inner edges matter, values out of the range are clamped.
+    return static_cast<int>(vtkstd::upper_bound(
+        edges.begin() + 1, edges.end() - 1, value) - (edges.begin() + 1));
+    }
+  int index = static_cast<int>((value - min) / bin_delta);
+  // If the value is equal to max, include it in the last bin.
+  return ::vtkExtractHistogramClamp(index, 0, bin_count-1);
+}
+
+//-----------------------------------------------------------------------------
+// Counting the values of large arrays is split among threads, each thread
+// filling its own bins.
+static const vtkIdType vtkExtractHistogramMinimumTuplesPerThread = 65536;
+
+struct vtkExtractHistogramBinningTask
+{
+  vtkDataArray* Array;
+  int Component;
+  double Min;
+  double BinDelta;
+  const vtkstd::vector<double>* Edges;
+  int BinCount;
+  vtkstd::vector<vtkstd::vector<int> > Counts;
+};
+
+template <class T>
+void vtkExtractHistogramCountValues(const T* data, vtkIdType begin,
+  vtkIdType end, vtkExtractHistogramBinningTask* task, int* counts)
+{
+  int numComps = task->Array->GetNumberOfComponents();
+  const T* value = data + begin * numComps + task->Component;
+  for (vtkIdType i = begin; i < end; ++i, value += numComps)
+    {
+    counts[::vtkExtractHistogramBinIndex(static_cast<double>(*value), 
+        task->Min, task->BinDelta, *task->Edges, task->BinCount)]++;
+    }
+}
+
+static VTK_THREAD_RETURN_TYPE vtkExtractHistogramBinningThread(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkExtractHistogramBinningTask* task =
+    static_cast<vtkExtractHistogramBinningTask*>(info->UserData);
+  vtkIdType num_of_tuples = task->Array->GetNumberOfTuples();
+  vtkIdType begin = num_of_tuples * info->ThreadID / info->NumberOfThreads;
+  vtkIdType end = num_of_tuples * (info->ThreadID + 1) / info->NumberOfThreads;
+  int* counts = &task->Counts[info->ThreadID][0];
+  switch (task->Array->GetDataType())
+    {
+    vtkTemplateMacro(vtkExtractHistogramCountValues(
+        static_cast<VTK_TT*>(task->Array->GetVoidPointer(0)),
+        begin, end, task, counts));
+    }
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 //-----------------------------------------------------------------------------
 void vtkExtractHistogram::BinAnArray(vtkDataArray *data_array,
                                      vtkIntArray *bin_values,
@@ -287,6 +545,45 @@ void vtkExtractHistogram::BinAnArray(vtkDataArray *data_array,
 
   int num_of_tuples = data_array->GetNumberOfTuples();
   double bin_delta = (max-min)/this->BinCount;
+  const vtkstd::vector<double>& edges = this->Internal->BinEdges;
+
+  vtkSmartPointer<vtkMultiThreader> threader;
+  int num_of_threads = 1;
+  if (!this->CalculateAverages && data_array->GetDataType() != VTK_BIT)
+    {
+    threader = vtkSmartPointer<vtkMultiThreader>::New();
+    num_of_threads = threader->GetNumberOfThreads();
+    vtkIdType max_threads =
+      num_of_tuples / vtkExtractHistogramMinimumTuplesPerThread;
+    num_of_threads = num_of_threads > max_threads ?
+      static_cast<int>(max_threads) : num_of_threads;
+    }
+  if (num_of_threads > 1)
+    {
+    vtkExtractHistogramBinningTask task;
+    task.Array = data_array;
+    task.Component = this->Component;
+    task.Min = min;
+    task.BinDelta = bin_delta;
+    task.Edges = &edges;
+    task.BinCount = this->BinCount;
+    task.Counts.resize(num_of_threads, 
+      vtkstd::vector<int>(this->BinCount, 0));
+    threader->SetNumberOfThreads(num_of_threads);
+    threader->SetSingleMethod(::vtkExtractHistogramBinningThread, &task);
+    threader->SingleMethodExecute();
+    for (int t = 0; t < num_of_threads; ++t)
+      {
+      for (int index = 0; index < this->BinCount; ++index)
+        {
+        bin_values->SetValue(index,
+          bin_values->GetValue(index) + task.Counts[t][index]);
+        }
+      }
+    this->UpdateProgress(1.0);
+    return;
+    }
+
   for(int i = 0; i != num_of_tuples; ++i)
     {
     if (i%1000 == 0)
@@ -294,9 +591,8 @@ void vtkExtractHistogram::BinAnArray(vtkDataArray *data_array,
       this->UpdateProgress(0.10 + 0.90*i/num_of_tuples);
       }
     const double value = data_array->GetComponent(i, this->Component);
-    int index = static_cast<int>((value - min) / bin_delta);
-    // If the value is equal to max, include it in the last bin.
-    index = ::vtkExtractHistogramClamp(index, 0, this->BinCount-1);
+    int index = ::vtkExtractHistogramBinIndex(value, min, bin_delta, edges,
+      this->BinCount);
     bin_values->SetValue(index, bin_values->GetValue(index)+1);
     
     if (this->CalculateAverages)
@@ -364,8 +660,17 @@ int vtkExtractHistogram::RequestData(vtkInformation* /*request*/,
   bin_values->FillComponent(0, 0.0);
 
   // Initializes the bin_extents array.
-  double min, max;
-  if (!this->InitializeBinExtents(inputVector, bin_extents, min, max))
+  double min = 0.0, max = 1.0;
+  bool valid = this->InitializeBinExtents(inputVector, bin_extents, min, max);
+  this->Internal->BinEdges.clear();
+  if (this->BinningMode != vtkExtractHistogram::UNIFORM)
+    {
+    // Processes without the array still take part in the sample exchange
+    // of the parallel subclass.
+    this->ComputeAdaptiveBinEdges(valid ? inputVector : 0, bin_extents,
+      min, max);
+    }
+  if (!valid)
     {
     this->Internal->ArrayValues.clear();
     return 1;
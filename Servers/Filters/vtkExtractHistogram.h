@@ -19,6 +19,7 @@
 #include "vtkTableAlgorithm.h"
 
 //BTX
+#include <vtkstd/vector> // needed for vector.
 class vtkDoubleArray;
 class vtkFieldData;
 class vtkIntArray;
@@ -72,6 +73,32 @@ public:
   vtkSetMacro(CalculateAverages, int);
   vtkGetMacro(CalculateAverages, int);
   vtkBooleanMacro(CalculateAverages, int);
+
+//BTX
+  enum
+    {
+    UNIFORM = 0,
+    LOGARITHMIC,
+    EQUAL_COUNT
+    };
+//ETX
+
+  // Description:
+  // Controls how the bins are laid out over the range of the binned values.
+  // UNIFORM (the default) uses bins of equal width. LOGARITHMIC spaces the
+  // bin edges evenly on a log scale starting at the smallest positive value
+  // (values <= 0 fall in the first bin). EQUAL_COUNT places the bin edges at
+  // the quantiles of the values so that each bin holds about the same number
+  // of values. The adaptive edges are estimated from a regular sample of the
+  // sorted values.
+  vtkSetClampMacro(BinningMode, int, UNIFORM, EQUAL_COUNT);
+  vtkGetMacro(BinningMode, int);
+  void SetBinningModeToUniform() 
+    { this->SetBinningMode(UNIFORM); }
+  void SetBinningModeToLogarithmic() 
+    { this->SetBinningMode(LOGARITHMIC); }
+  void SetBinningModeToEqualCount() 
+    { this->SetBinningMode(EQUAL_COUNT); }
   
 protected: 
   vtkExtractHistogram();
@@ -99,11 +126,27 @@ protected:
 
   void FillBinExtents(vtkDoubleArray* bin_extents, double min, double max);
 
+  // Computes the edges of the adaptive bins (see BinningMode) over 
+  // [min, max] and sets bin_extents to the bin centers. inputVector is NULL
+  // when the selected array is not available, in which case only the
+  // (possibly collective) GatherBinningSamples() step is performed.
+  void ComputeAdaptiveBinEdges(vtkInformationVector** inputVector,
+    vtkDoubleArray* bin_extents, double min, double max);
+
+//BTX
+  // Called by ComputeAdaptiveBinEdges() with the local sample stored as
+  // (value, weight) pairs, where the weight is the number of input values
+  // the sample stands for. Parallel subclasses replace it with the samples
+  // of all processes. Does nothing by default.
+  virtual void GatherBinningSamples(vtkstd::vector<double>& samples);
+//ETX
+
   double CustomBinRanges[2];
   bool UseCustomBinRanges;
   int Component;
   int BinCount;
   int CalculateAverages;
+  int BinningMode;
 
   vtkEHInternals* Internal;
   
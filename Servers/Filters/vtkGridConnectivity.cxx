@@ -39,13 +39,16 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkCellArray.h"
 #include "vtkEquivalenceSet.h"
+#include "vtkMultiProcessControllerHelper.h"
+
+#include <vtkstd/algorithm>
 
 
 // Distributed:
 // Find the max process global point id (face hash).
-// Create a map of fragment id/process.
-// Send face structures to process 0.
-// Add remote faces to face hash (mapping fragment ids).
+// Resolve local fragments and assign global fragment ids.
+// Send face structures to rendezvous processes (smallest corner id).
+// Resolve equivalent fragments with a distributed union-find.
 
 
 // Arbitrary maximum.  Cells are 3D.
@@ -703,38 +706,25 @@ void vtkGridConnectivity::InitializeFaceHash(
     vtkDataArray* a = inputs[ii]->GetPointData()->GetGlobalIds();
     void *ptr = a->GetVoidPointer(0);
     vtkIdType numIds = a->GetNumberOfTuples();
-    maxId = 0;
+    vtkIdType blockMaxId = 0;
     this->GlobalPointIdType = a->GetDataType();
     switch(this->GlobalPointIdType)
       {
         vtkTemplateMacro(
-          maxId = vtkGridConnectivityComputeMax(static_cast<VTK_TT*>(ptr), numIds));
+          blockMaxId = vtkGridConnectivityComputeMax(static_cast<VTK_TT*>(ptr), numIds));
       default:
         vtkErrorMacro("ThreadedRequestData: Unknown input ScalarType");
         return;
       }
-    }
-
-  // Now we need to compute the maximum of all processes.
-  int numProcs = this->Controller->GetNumberOfProcesses();
-  if (this->Controller->GetLocalProcessId() != 0)
-    {
-    this->Controller->Send(&maxId, 1, 0, 8897324);
-    // Only process 0 needs a hash to hold all procs faces.
-    }
-  else
-    {
-    for (int ii = 1; ii < numProcs; ++ii)
+    if (blockMaxId > maxId)
       {
-      vtkIdType tmp;
-      this->Controller->Receive(&tmp, 1, ii, 8897324);
-      if (tmp > maxId)
-        {
-        maxId = tmp;
-        }
+      maxId = blockMaxId;
       }
     }
 
+  // The hash only holds local faces.  Faces shared between processes are
+  // matched by the rendezvous processes in ResolveProcessesFaces, so there
+  // is no need to size the hash for the global point ids.
   if (this->FaceHash) { delete this->FaceHash;}
   this->FaceHash = new vtkGridConnectivityFaceHash;
   this->FaceHash->Initialize(maxId + 1);
@@ -873,7 +863,7 @@ int vtkGridConnectivity::RequestData(vtkInformation*,
   // integrated values for each attribute.  The arrays
   // are initialized to 0 and indexed by fragment id.
   this->InitializeIntegrationArrays(inputs, numberOfInputs);
-  // We need to know the maximum globalNodeId (across all processes)
+  // We need to know the maximum local globalNodeId
   // to initialize the face hash.  This methods computes it and initializes.
   this->InitializeFaceHash(inputs, numberOfInputs);
 
@@ -890,10 +880,8 @@ int vtkGridConnectivity::RequestData(vtkInformation*,
       return 0;
     }
 
-  // Deal with distributed data. Send all polygons to a single process.
-  // Find equivalences in process 0.
-  // If this becomes a bottleneck,  we could build up an occupancy map indexed
-  // by global node ids.
+  // Deal with distributed data. Boundary faces are matched by rendezvous
+  // processes and the fragment equivalences are resolved in parallel.
   // This also combines the volume integration of the partial fragment volumes
   // into final volumes indexed by the resolved fragment ids.
   // Note: the ids start from 1.  This is because we started assigning partial fragment ids
@@ -1138,139 +1126,6 @@ void vtkGridConnectivity::IntegrateCellVolume(
 
 
 
-//----------------------------------------------------------------------------
-// This method expects that every process has raw (unresolved) equivalence set
-// faces and arrays.  At the end of this method, process 0 has face hash,
-// equivalence set and arrays merged from all processes, and resolved.
-// Every thing looks like it was generated locally (single arrays...).
-// Faces in the root process hash have a processId and marshalId to indicate 
-// the source process.  This is important because only the source process has
-// the inputs used to create the surface geometry.  The marshalId is the index
-// of the face in the originating process hash.
-// All processes call this method at the same time (potential to hang).
-// The fragmentIdOffsets is an empty array allocated byu the caller.
-// The function that maps the local fragment ids to global fragment ids
-// is returned in the array.
-void vtkGridConnectivity::CollectFacesAndArraysToRootProcess(int* fragmentIdOffsets)
-{
-  vtkIdType msg1[2];
-  vtkIdType numFaces;
-  vtkIdType msgLength;
-  vtkIdType* msg2;
-  vtkIdType* msgPtr;
-  vtkIdType corner1, corner2, corner3;
-  vtkIdType blockId, faceId, cellId, fragmentId;
-  vtkGridConnectivityFace* face;
-  int numberOfFragments;
-  
-  if (this->Controller->GetLocalProcessId() != 0)
-    { // Remote process
-    // Resolve equivaleneces Before we send the faces.
-    // This is important because we do not send the equivalence set to process 0.
-    this->ResolveEquivalentFragments();
-    // Marshal the hash and send it to process 0.
-    numFaces = this->FaceHash->GetNumberOfFaces();
-    // Number of fragments.  I assuem this is the
-    // resolved number of fragments, but it will little difference.
-    vtkIdType numFragments = this->EquivalenceSet->GetNumberOfResolvedSets();
-    msg1[0] = numFragments;
-    msg1[1] = numFaces;
-    this->Controller->Send(msg1, 2, 0, 9890831);
-    if (numFaces > 0)
-      {
-      // Lets put everything into a single vtkIdType array
-      msgLength = numFaces * 7;
-      msg2 = new vtkIdType[msgLength];
-      msgPtr = msg2;
-      this->FaceHash->InitTraversal();
-      while ( (face = this->FaceHash->GetNextFace()) )
-        {
-        *msgPtr++ = this->FaceHash->GetFirstPointIndex();
-        *msgPtr++ = face->CornerId2;
-        *msgPtr++ = face->CornerId3;
-        *msgPtr++ = face->BlockId;
-        *msgPtr++ = face->CellId;
-        *msgPtr++ = face->FaceId;
-        *msgPtr++ = face->FragmentId;
-        }
-      this->Controller->Send(msg2, msgLength, 0, 1344897);
-      delete [] msg2;
-      // Now send the integration arrays (volume).
-      this->Controller->Send(this->FragmentVolumes->GetPointer(0), numFragments, 0, 5634780);
-      } // endif numFaces > 0
-    } // end if not process 0
-  else
-    { // Process is 0
-    // Build up a map to make each processes fragment
-    int numProcs = this->Controller->GetNumberOfProcesses();
-    fragmentIdOffsets[0] = 0;
-    fragmentIdOffsets[1] = this->EquivalenceSet->GetNumberOfMembers();
-    for (int procIdx = 1; procIdx < numProcs; ++procIdx)
-      { // loop over every process. 
-      // Receive
-      this->Controller->Receive(msg1, 2, procIdx, 9890831);
-      numberOfFragments = msg1[0];
-      numFaces = msg1[1];
-      // Create a map to assign global fragment ids.
-      fragmentIdOffsets[procIdx+1] = fragmentIdOffsets[procIdx] + numFaces;
-      if (numFaces > 0)
-        {
-        // Receive faces from a remote process.
-        msgLength = numFaces * 7;
-        msg2 = new vtkIdType[msgLength];
-        this->Controller->Receive(msg2,msgLength,procIdx,1344897);
-        msgPtr = msg2;
-        for (int faceIdx = 0; faceIdx < numFaces; ++faceIdx)
-          {
-          corner1 = *msgPtr++;
-          corner2 = *msgPtr++;
-          corner3 = *msgPtr++;
-          blockId = *msgPtr++;
-          cellId = *msgPtr++;
-          faceId = *msgPtr++;
-          fragmentId = *msgPtr++;
-          // Translate the fragmentId to global value.
-          fragmentId +=fragmentIdOffsets[procIdx];
-          // Add the face to the hash.
-          face = this->FaceHash->AddFace(corner1, corner2, corner3);
-          if (face->FragmentId > 0)
-            { // face is attached to another cell.
-            // It has been removed from the hash because it is internal.
-            // It is valid until we create another face. (recycle bin)
-            // This cell connects two fragments, we need
-            // to make the fragment ids equivalent.
-            this->EquivalenceSet->AddEquivalence(fragmentId,
-                                                 face->FragmentId);
-            }
-          else
-            { // Face is new.  Add our cell info.
-            // These are needed to create the surface in the second stage.
-            face->ProcessId = procIdx;
-            face->BlockId = blockId;
-            face->CellId = cellId;
-            face->FaceId = faceId;
-            face->FragmentId = fragmentId;
-            face->MarshalId = faceIdx;
-            } // end if face is new or shared.
-          } // end loop over faces in messages
-        // Now receive the integration arrays and add them to ours.
-        this->FragmentVolumes->Resize(fragmentIdOffsets[procIdx+1]);
-        // I hope the vtkDataArray allocates more than we ask.
-        this->FragmentVolumes->SetNumberOfTuples(fragmentIdOffsets[procIdx+1]);
-        // Read the array right into the end of our array.
-        this->Controller->Receive(
-          this->FragmentVolumes->GetPointer(fragmentIdOffsets[procIdx]), 
-          numberOfFragments, 
-          procIdx,
-          5634780);
-        } // endif numFace > 0
-      } // end loop over processes
-    // Resolve all the fragments, faces and arrays for all processes.
-    this->ResolveEquivalentFragments();
-    } // end if process 0.
-}
-
-
 //----------------------------------------------------------------------------
 // This method expects every process to have local faces, equivalences set
 // ind integration arrays.
@@ -1278,123 +1133,237 @@ void vtkGridConnectivity::CollectFacesAndArraysToRootProcess(int* fragmentIdOffs
 // across all processes and the faces shared between processes (internal)
 // have been removed from the hash.
 //
-// The algorithm is:  Collect number of faces to process 0.
-// Create a map from process fragment ids to global fragment ids.
-// Collect face hashes to process 0 and merge into 1.
-// Send a mask/fragmentIdArray indexed by original process fragment id
-// back to originating process.
-// The only issue I ran into is returning triangles to their original
-// process.  I am going to create a mask/fragment array to return.
-// The hash has to remember the original process face index to 
-// construct the mask.
-// For resolving integration arrays, Each process needs:
-// A full map of localFragmentIds,procOwner to globalFragId,procOwner.
+// The algorithm is:  Resolve the local fragments on every process.
+// Assign global fragment ids (process by process, so the order is the same
+// as if the fragments were resolved by a single process).
+// Route every face left in the hash to a rendezvous process selected by its
+// smallest corner id.  Faces that show up twice are shared by two processes:
+// they are masked on the originating processes and their fragments are
+// recorded as equivalent.
+// Resolve the equivalences with a distributed union-find where each process
+// owns the labels of its own fragments (vtkEquivalenceSet).
+// Finally reduce the integration arrays indexed by the final fragment ids.
+// No process ever holds more than its share of faces and fragments.
 void vtkGridConnectivity::ResolveProcessesFaces()
 {
-  vtkIdType numFaces;
+  // Resolve the local equivalences first.  After this, the faces and the
+  // integration arrays are indexed by the local resolved fragment ids.
+  this->ResolveEquivalentFragments();
+
   int numProcs = this->Controller->GetNumberOfProcesses();
-  int* fragmentIdOffsets = new int[numProcs+1];
+  if (numProcs <= 1)
+    {
+    return;
+    }
 
-  this->CollectFacesAndArraysToRootProcess(fragmentIdOffsets);
-  
-  // Now send the mask and arrays back to the remote processes.
-  // It may not be necessary to send the entire volume array to all processes,
-  // but it is easy.  There should not be too many fragments anyway.
-  if (this->Controller->GetLocalProcessId() != 0)
-    { // Remote process
-    // Now receive the triangles that survived the resolution process.
-    numFaces = this->FaceHash->GetNumberOfFaces();
-    int* fragmentIds = new int[numFaces];
-    int* fragmentIdPtr = fragmentIds;
-    if (numFaces)
-      {
-      this->Controller->Receive(fragmentIds, numFaces, 0, 2034301);
-      // Get rid of faces shared by multiple processe and
-      // set the resolved fragment ids.
-      this->FaceHash->InitTraversal();
-      vtkGridConnectivityFace* face;
-      while ( (face = this->FaceHash->GetNextFace()) )
-        {
-        // I do not want to remove the face from the hash because
-        // we are in the middle of traversing the hash.
-        // It would not work the way the iterator is implemented.
-        // The invalid fragment id (value 0) will be enough to skip faces.
-        face->FragmentId = *fragmentIdPtr++;
-        }
-      delete [] fragmentIds;
-      vtkIdType numFragments;
-      this->Controller->Receive(&numFragments, 1, 0, 909034);
-      this->FragmentVolumes->SetNumberOfTuples(numFragments);
-      this->Controller->Receive(this->FragmentVolumes->GetPointer(0), 
-                                numFragments, 0, 909035);
-      } // endif numFaces != 0
-    } // endif remote process.
-  else
-    { // if process 0 (root)
-    // Now we have to distribute the new face hash back
-    // to the remote processes.  We have to loop through the hash
-    // to construct the face mask for each process.
-    // Lets create them one by one (looping many times) rather
-    // than all at once.  The code will be simpler and
-    // it should not be too expensive.
-    for (int procIdx = 1; procIdx < numProcs; ++procIdx)
+  // The resolved set 0 is the unused "remove face" fragment, so it is
+  // not counted.
+  int numLocalFragments = this->EquivalenceSet->GetNumberOfResolvedSets() - 1;
+  if (numLocalFragments < 0)
+    {
+    numLocalFragments = 0;
+    }
+  vtkstd::vector<int> counts(numProcs, 0);
+  this->Controller->AllGather(&numLocalFragments, &counts[0], 1);
+  vtkstd::vector<int> fragmentIdOffsets(numProcs+1, 0);
+  for (int procIdx = 0; procIdx < numProcs; ++procIdx)
+    {
+    fragmentIdOffsets[procIdx+1] = fragmentIdOffsets[procIdx] + counts[procIdx];
+    }
+
+  // Pairs of equivalent global fragment ids found by this rendezvous process.
+  vtkstd::vector<vtkIdType> equivalences;
+  this->ExchangeBoundaryFaces(fragmentIdOffsets, equivalences);
+
+  // Map from local resolved fragment ids to final fragment ids.
+  vtkstd::vector<int> finalFragmentIds;
+  int numberOfFinalFragments =
+    vtkEquivalenceSet::ResolveDistributedEquivalences(
+      this->Controller, fragmentIdOffsets, equivalences, finalFragmentIds);
+
+  // Relabel the faces that survived.  Masked faces keep the special 0 value.
+  vtkGridConnectivityFace* face;
+  this->FaceHash->InitTraversal();
+  while ( (face = this->FaceHash->GetNextFace()) )
+    {
+    if (face->FragmentId > 0)
       {
-      // decode the number of faces from the offsets.
-      vtkGridConnectivityFace* face;
-      numFaces = fragmentIdOffsets[procIdx+1] - fragmentIdOffsets[procIdx];
-      if (numFaces)
-        { // just in case new or MPI does not like 0 length arrays.
-        // Construct the mask / message
-        int* faceMask = new int[numFaces];
-        // Initialize the mask to "empty set".
-        // I am going to index the final fragments starting at 1
-        // so I can use 0 as the special "remove face" value.
-        memset(faceMask,0,numFaces*sizeof(int));
-        // Loop over the faces in the hash.
-        this->FaceHash->InitTraversal();
-        while ( (face = this->FaceHash->GetNextFace()) != 0);
-          {
-          if (face->ProcessId == procIdx)
-            {
-            faceMask[face->MarshalId] = face->FragmentId;
-            } // end if face belongs to process.
-          } // endloop face in hash
-        // Send the mask to the remote process.
-        this->Controller->Send(faceMask, numFaces, procIdx, 2034301);
-        delete [] faceMask;
-        
-        // We need to send the volume array to the remote processes too.
-        vtkIdType numFragments = this->FragmentVolumes->GetNumberOfTuples();
-        this->Controller->Send(&numFragments, 1, procIdx, 909034);
-        this->Controller->Send(this->FragmentVolumes->GetPointer(0),
-                               numFragments, procIdx, 909035);
-        } // endif numFaces > 0
-      } // endloop procIdx
-    } // endelse process 0 (root)
+      face->FragmentId = finalFragmentIds[face->FragmentId];
+      }
+    }
 
-/*
-    // Terms:  PartialFragmentId: Local process frag id before resolution.
-    //         GlobalFragmentId:  PartialFragmentId offset to form global id.
-    //         FinalFragmentId:
+  this->ReduceIntegrationArrays(finalFragmentIds, numberOfFinalFragments);
+}
 
-    // Now that we know the NumberOfFinal fragments, collect the volumes.
-    vtkDoubleArray* globalVolumes = vtkDoubleArray::New();
-    globalVolumes->SetNumberOfValues(
-    for (int procIdx = 1; procIdx < numProcs; ++procIdx)
-      { // loop over every process. 
+//----------------------------------------------------------------------------
+// A face sent to a rendezvous process.
+struct vtkGridConnectivityFaceRecord
+{
+  vtkIdType CornerIds[3];
+  vtkIdType FragmentId;
+  vtkIdType MarshalId;
+  int ProcessId;
 
+  bool SameFace(const vtkGridConnectivityFaceRecord& other) const
+    {
+    return (this->CornerIds[0] == other.CornerIds[0] &&
+            this->CornerIds[1] == other.CornerIds[1] &&
+            this->CornerIds[2] == other.CornerIds[2]);
+    }
+  bool operator<(const vtkGridConnectivityFaceRecord& other) const
+    {
+    for (int ii = 0; ii < 3; ++ii)
+      {
+      if (this->CornerIds[ii] != other.CornerIds[ii])
+        {
+        return this->CornerIds[ii] < other.CornerIds[ii];
+        }
+      }
+    return this->ProcessId < other.ProcessId;
+    }
+};
 
-  double* msgVolume;
+//----------------------------------------------------------------------------
+// Every process sends the faces left in its hash to a rendezvous process
+// (smallest corner id modulo the number of processes).  Two processes that
+// share a face always pick the same rendezvous process.  The rendezvous
+// process sorts the faces it received, masks the faces that appear more than
+// once and returns the masks to the originating processes.  The fragments of
+// the masked faces are returned in "equivalences" as pairs of global ids.
+void vtkGridConnectivity::ExchangeBoundaryFaces(
+  const vtkstd::vector<int>& fragmentIdOffsets,
+  vtkstd::vector<vtkIdType>& equivalences)
+{
+  int numProcs = this->Controller->GetNumberOfProcesses();
+  int myId = this->Controller->GetLocalProcessId();
 
-      // Now receive the volume array index on partial fragmentIds.
-      this->Controller->Receive(msgVolume, numberOfFragments,procIdx,8729987);
+  vtkstd::vector<vtkstd::vector<vtkIdType> > outgoing(numProcs);
+  vtkstd::vector<vtkstd::vector<vtkIdType> > incoming;
 
-*/
+  // Remember the faces in traversal order so that the rendezvous
+  // processes can refer to them by index (marshal id).
+  vtkstd::vector<vtkGridConnectivityFace*> faces;
+  faces.reserve(this->FaceHash->GetNumberOfFaces());
+  vtkGridConnectivityFace* face;
+  this->FaceHash->InitTraversal();
+  while ( (face = this->FaceHash->GetNextFace()) )
+    {
+    vtkIdType corner1 = this->FaceHash->GetFirstPointIndex();
+    vtkstd::vector<vtkIdType>& msg = outgoing[corner1 % numProcs];
+    msg.push_back(corner1);
+    msg.push_back(face->CornerId2);
+    msg.push_back(face->CornerId3);
+    msg.push_back(fragmentIdOffsets[myId] + face->FragmentId);
+    msg.push_back(static_cast<vtkIdType>(faces.size()));
+    faces.push_back(face);
+    }
+  vtkMultiProcessControllerHelper::ExchangeAllToAll(
+    this->Controller, outgoing, incoming, 1344897);
+  outgoing.clear();
+
+  vtkstd::vector<vtkGridConnectivityFaceRecord> records;
+  for (int procIdx = 0; procIdx < numProcs; ++procIdx)
+    {
+    const vtkstd::vector<vtkIdType>& msg = incoming[procIdx];
+    for (size_t ii = 0; ii + 4 < msg.size(); ii += 5)
+      {
+      vtkGridConnectivityFaceRecord record;
+      record.CornerIds[0] = msg[ii];
+      record.CornerIds[1] = msg[ii+1];
+      record.CornerIds[2] = msg[ii+2];
+      record.FragmentId = msg[ii+3];
+      record.MarshalId = msg[ii+4];
+      record.ProcessId = procIdx;
+      records.push_back(record);
+      }
+    incoming[procIdx].clear();
+    }
+  vtkstd::sort(records.begin(), records.end());
 
+  // Faces that appear more than once are internal.
+  vtkstd::vector<vtkstd::vector<vtkIdType> > masks(numProcs);
+  size_t numRecords = records.size();
+  size_t first = 0;
+  while (first < numRecords)
+    {
+    size_t last = first + 1;
+    while (last < numRecords && records[last].SameFace(records[first]))
+      {
+      ++last;
+      }
+    if (last - first > 1)
+      {
+      for (size_t ii = first; ii < last; ++ii)
+        {
+        masks[records[ii].ProcessId].push_back(records[ii].MarshalId);
+        if (records[ii].FragmentId != records[first].FragmentId)
+          {
+          equivalences.push_back(records[first].FragmentId);
+          equivalences.push_back(records[ii].FragmentId);
+          }
+        }
+      }
+    first = last;
+    }
+  records.clear();
 
+  // Send the masks back to the processes that own the faces.
+  vtkMultiProcessControllerHelper::ExchangeAllToAll(
+    this->Controller, masks, incoming, 2034301);
+  for (int procIdx = 0; procIdx < numProcs; ++procIdx)
+    {
+    const vtkstd::vector<vtkIdType>& msg = incoming[procIdx];
+    for (size_t ii = 0; ii < msg.size(); ++ii)
+      {
+      // I do not want to remove the face from the hash because
+      // the hash is still referenced by the faces vector.
+      // The invalid fragment id (value 0) will be enough to skip faces.
+      faces[msg[ii]]->FragmentId = 0;
+      }
+    }
+}
 
-  delete [] fragmentIdOffsets;
+//----------------------------------------------------------------------------
+// Sum the integration arrays (indexed by local resolved fragment ids) of all
+// processes into arrays indexed by the final fragment ids.  Every process
+// ends up with the complete arrays, as they are added to the output field
+// data.  These arrays only have one value per fragment.
+void vtkGridConnectivity::ReduceIntegrationArrays(
+  const vtkstd::vector<int>& finalFragmentIds,
+  int numberOfFinalFragments)
+{
+  // Entry 0 is the unused "remove face" fragment.
+  vtkIdType numValues = numberOfFinalFragments + 1;
+  vtkIdType numLocal = static_cast<vtkIdType>(finalFragmentIds.size());
+  vtkstd::vector<double> contributions(numValues);
 
+  int numArrays = static_cast<int>(this->CellAttributesIntegration.size());
+  for (int arrayIdx = -1; arrayIdx < numArrays; ++arrayIdx)
+    {
+    vtkDoubleArray* localArray = (arrayIdx < 0) ? this->FragmentVolumes :
+      this->CellAttributesIntegration[arrayIdx].GetPointer();
+    vtkstd::fill(contributions.begin(), contributions.end(), 0.0);
+    vtkIdType numTuples = localArray->GetNumberOfTuples();
+    for (vtkIdType ii = 1; ii < numLocal && ii < numTuples; ++ii)
+      {
+      contributions[finalFragmentIds[ii]] += localArray->GetValue(ii);
+      }
+    vtkDoubleArray* globalArray = vtkDoubleArray::New();
+    globalArray->SetName(localArray->GetName());
+    globalArray->SetNumberOfTuples(numValues);
+    this->Controller->AllReduce(&contributions[0], globalArray->GetPointer(0),
+                                numValues, vtkCommunicator::SUM_OP);
+    if (arrayIdx < 0)
+      {
+      this->FragmentVolumes->Delete();
+      this->FragmentVolumes = globalArray;
+      }
+    else
+      {
+      this->CellAttributesIntegration[arrayIdx] = globalArray;
+      globalArray->Delete();
+      }
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -1451,6 +1420,30 @@ void vtkGridConnectivity::ResolveIntegrationArrays()
   // new total fragment volume array.
   this->FragmentVolumes->Delete();
   this->FragmentVolumes = newVolumes;
+
+  // The attribute integration arrays are indexed the same way.
+  int numArrays = static_cast<int>(this->CellAttributesIntegration.size());
+  for (int arrayIdx = 0; arrayIdx < numArrays; ++arrayIdx)
+    {
+    vtkDoubleArray* da = this->CellAttributesIntegration[arrayIdx];
+    if (da->GetNumberOfTuples() < numMembers)
+      {
+      vtkErrorMacro("More partial fragments than integration entries.");
+      continue;
+      }
+    vtkSmartPointer<vtkDoubleArray> newArray =
+      vtkSmartPointer<vtkDoubleArray>::New();
+    newArray->SetName(da->GetName());
+    newArray->SetNumberOfTuples(numSets);
+    memset(newArray->GetPointer(0),0,numSets*sizeof(double));
+    double* partialPtr = da->GetPointer(0);
+    double* finalPtr = newArray->GetPointer(0);
+    for (int ii = 0; ii < numMembers; ++ii)
+      {
+      finalPtr[this->EquivalenceSet->GetEquivalentSetId(ii)] += *partialPtr++;
+      }
+    this->CellAttributesIntegration[arrayIdx] = newArray;
+    }
 }
 
 
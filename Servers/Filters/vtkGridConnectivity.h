@@ -111,7 +111,17 @@ protected:
   
   void ResolveEquivalentFragments();
   void ResolveProcessesFaces();
-  void CollectFacesAndArraysToRootProcess(int* fragmentIdOffsets);
+
+//BTX
+  // Helpers for the distributed resolution of fragments. Faces left in the
+  // hash are routed to a rendezvous process (chosen from their smallest
+  // corner id) where shared faces are detected. Fragment equivalences are
+  // then resolved with vtkEquivalenceSet::ResolveDistributedEquivalences.
+  void ExchangeBoundaryFaces(const vtkstd::vector<int>& fragmentIdOffsets,
+    vtkstd::vector<vtkIdType>& equivalences);
+  void ReduceIntegrationArrays(const vtkstd::vector<int>& finalFragmentIds,
+    int numberOfFinalFragments);
+//ETX
 
 private:
   vtkGridConnectivity(const vtkGridConnectivity&);  // Not implemented.
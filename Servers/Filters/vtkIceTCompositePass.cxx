@@ -18,9 +18,12 @@
 #include "vtkFrameBufferObject.h"
 #include "vtkIceTContext.h"
 #include "vtkIntArray.h"
+#include "vtkMatrix4x4.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 #include "vtkPKdTree.h"
+#include "vtkPropCollection.h"
+#include "vtkProp.h"
 #include "vtkRenderer.h"
 #include "vtkRenderState.h"
 #include "vtkRenderWindow.h"
@@ -34,7 +37,9 @@
 #include "vtkUniformVariables.h"
 #include "vtkShader2.h"
 #include "vtkShader2Collection.h"
+#include "vtkTimerLog.h"
 
+#include <vtkstd/vector>
 #include <assert.h>
 #include "vtkgl.h"
 #include <GL/ice-t.h>
@@ -88,6 +93,12 @@ vtkIceTCompositePass::vtkIceTCompositePass()
   this->FixBackground=false;
   this->BackgroundTexture=0;
   this->IceTTexture=0;
+
+  this->Strategy = vtkIceTConstants::DEFAULT;
+  this->LastStrategy = vtkIceTConstants::REDUCE;
+  this->UseProjectedBounds = true;
+  this->LastProjectedViewport[0] = this->LastProjectedViewport[1] =
+    this->LastProjectedViewport[2] = this->LastProjectedViewport[3] = 0.0;
 }
 
 //----------------------------------------------------------------------------
@@ -173,14 +184,24 @@ void vtkIceTCompositePass::SetupContext(const vtkRenderState* render_state)
   // need to pass appropriate tile parameters to IceT.
   this->UpdateTileInformation(render_state);
 
-  // Set IceT compositing strategy.
-  icetStrategy(ICET_STRATEGY_REDUCE);
-
   bool use_ordered_compositing =
     (this->KdTree && this->UseOrderedCompositing && !this->DepthOnly &&
      this->KdTree->GetNumberOfRegions() >=
      this->IceTContext->GetController()->GetNumberOfProcesses());
 
+  // Set IceT compositing strategy.
+  this->LastStrategy = this->ChooseStrategy(render_state,
+    use_ordered_compositing);
+  switch (this->LastStrategy)
+    {
+    case vtkIceTConstants::VTREE:  icetStrategy(ICET_STRATEGY_VTREE); break;
+    case vtkIceTConstants::SPLIT:  icetStrategy(ICET_STRATEGY_SPLIT); break;
+    case vtkIceTConstants::SERIAL: icetStrategy(ICET_STRATEGY_SERIAL);break;
+    case vtkIceTConstants::DIRECT: icetStrategy(ICET_STRATEGY_DIRECT);break;
+    case vtkIceTConstants::REDUCE:
+    default:                       icetStrategy(ICET_STRATEGY_REDUCE);break;
+    }
+
   GLenum flags;
   if(this->DepthOnly)
     {
@@ -247,21 +268,7 @@ void vtkIceTCompositePass::SetupContext(const vtkRenderState* render_state)
 
   // Let IceT know the data bounds. This allows IceT to make smarter compositing
   // decisions.
-  double allBounds[6];
-  render_state->GetRenderer()->ComputeVisiblePropBounds(allBounds);
-  //Try to detect when bounds are empty and try to let ICE-T know that
-  //nothing is in bounds.
-  if (allBounds[0] > allBounds[1])
-    {
-    cout << "nothing visible" << endl;
-    float tmp = VTK_LARGE_FLOAT;
-    icetBoundingVertices(1, ICET_FLOAT, 0, 1, &tmp);
-    }
-  else
-    {
-    icetBoundingBoxd(allBounds[0], allBounds[1], allBounds[2], allBounds[3],
-                     allBounds[4], allBounds[5]);
-    }
+  this->UpdateBoundingVertices(render_state);
 
   // These line are required when shadow maps are used.
   icetEnable(ICET_DISPLAY);
@@ -678,6 +685,169 @@ void vtkIceTCompositePass::UpdateTileInformation(
   this->LastTileDimensions[1] = this->TileDimensions[1];
 }
 
+//----------------------------------------------------------------------------
+int vtkIceTCompositePass::ChooseStrategy(const vtkRenderState*,
+  bool use_ordered_compositing)
+{
+  if (this->Strategy != vtkIceTConstants::DEFAULT)
+    {
+    // VTREE and SPLIT ignore the composite order, which would blend
+    // translucent geometry and volumes in the wrong order.
+    if (use_ordered_compositing &&
+      (this->Strategy == vtkIceTConstants::VTREE ||
+       this->Strategy == vtkIceTConstants::SPLIT))
+      {
+      return vtkIceTConstants::REDUCE;
+      }
+    return this->Strategy;
+    }
+
+  // The strategy must be the same on all processes, so it is only based on
+  // values that every process agrees upon: the number of processes and the
+  // tile layout. Data-dependent values such as the projected bounds are
+  // different on each process and cannot be used here.
+  int num_procs = this->Controller->GetNumberOfProcesses();
+  GLint num_tiles = 0;
+  GLint tile_width = 0;
+  GLint tile_height = 0;
+  icetGetIntegerv(ICET_NUM_TILES, &num_tiles);
+  icetGetIntegerv(ICET_TILE_MAX_WIDTH, &tile_width);
+  icetGetIntegerv(ICET_TILE_MAX_HEIGHT, &tile_height);
+  double num_pixels = static_cast<double>(tile_width) * tile_height;
+
+  if (num_tiles > 1)
+    {
+    // With at least as many tiles as processes, every process owns a tile and
+    // sending the images straight to the tile owners is cheapest. Otherwise
+    // let IceT reduce the tiles to groups of processes.
+    return (num_procs <= num_tiles)?
+      vtkIceTConstants::DIRECT : vtkIceTConstants::REDUCE;
+    }
+
+  // Single tile. For a handful of processes or small images the number of
+  // messages dominates and tree compositing is fastest. For larger jobs and
+  // images, the SERIAL strategy composites the tile with binary-swap, which
+  // splits the image so that each process only handles a fraction of the
+  // pixels. Tree compositing cannot honor the composite order, so REDUCE
+  // takes its place when ordered compositing is in use.
+  if (num_procs <= 4 || num_pixels <= 256.0*256.0)
+    {
+    return use_ordered_compositing?
+      vtkIceTConstants::REDUCE : vtkIceTConstants::VTREE;
+    }
+  return vtkIceTConstants::SERIAL;
+}
+
+//----------------------------------------------------------------------------
+void vtkIceTCompositePass::UpdateBoundingVertices(
+  const vtkRenderState* render_state)
+{
+  vtkRenderer* renderer = render_state->GetRenderer();
+
+  // Collect the corners of the bounding box of every visible prop.
+  vtkstd::vector<double> vertices;
+  vtkPropCollection* props = renderer->GetViewProps();
+  vtkCollectionSimpleIterator pit;
+  props->InitTraversal(pit);
+  while (vtkProp* prop = props->GetNextProp(pit))
+    {
+    if (!prop->GetVisibility() || !prop->GetUseBounds())
+      {
+      continue;
+      }
+    double* bounds = prop->GetBounds();
+    // Skip uninitialized and empty bounds, same as
+    // vtkRenderer::ComputeVisiblePropBounds().
+    if (bounds == NULL || bounds[0] > bounds[1] ||
+      bounds[0] == -VTK_DOUBLE_MAX || bounds[1] == VTK_DOUBLE_MAX)
+      {
+      continue;
+      }
+    for (int cc=0; cc < 8; cc++)
+      {
+      vertices.push_back(bounds[(cc & 1)? 1 : 0]);
+      vertices.push_back(bounds[(cc & 2)? 3 : 2]);
+      vertices.push_back(bounds[(cc & 4)? 5 : 4]);
+      }
+    }
+
+  if (vertices.size() == 0)
+    {
+    // Let IceT know that nothing is in bounds.
+    float tmp = VTK_LARGE_FLOAT;
+    icetBoundingVertices(1, ICET_FLOAT, 0, 1, &tmp);
+    this->LastProjectedViewport[0] = this->LastProjectedViewport[1] =
+      this->LastProjectedViewport[2] = this->LastProjectedViewport[3] = 0.0;
+    return;
+    }
+
+  GLsizei num_vertices = static_cast<GLsizei>(vertices.size()/3);
+  if (this->UseProjectedBounds)
+    {
+    // IceT projects these vertices with the current matrices and only reads
+    // back and composites the screen region covering them.
+    icetBoundingVertices(3, ICET_DOUBLE, 0, num_vertices, &vertices[0]);
+    }
+  else
+    {
+    double allBounds[6] = { VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX,
+      VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, -VTK_DOUBLE_MAX };
+    for (GLsizei cc=0; cc < num_vertices; cc++)
+      {
+      for (int j=0; j < 3; j++)
+        {
+        double v = vertices[3*cc+j];
+        allBounds[2*j] = (v < allBounds[2*j])? v : allBounds[2*j];
+        allBounds[2*j+1] = (v > allBounds[2*j+1])? v : allBounds[2*j+1];
+        }
+      }
+    icetBoundingBoxd(allBounds[0], allBounds[1], allBounds[2], allBounds[3],
+                     allBounds[4], allBounds[5]);
+    }
+
+  // Compute the same projection here to report how much of the viewport this
+  // process covers.
+  vtkMatrix4x4* mat =
+    renderer->GetActiveCamera()->GetCompositeProjectionTransformMatrix(
+      renderer->GetTiledAspectRatio(), -1, 1);
+  double screen[4] = { 1.0, 1.0, -1.0, -1.0 };
+  for (GLsizei cc=0; cc < num_vertices; cc++)
+    {
+    double in[4] = { vertices[3*cc], vertices[3*cc+1], vertices[3*cc+2], 1.0 };
+    double out[4];
+    mat->MultiplyPoint(in, out);
+    if (out[3] <= 0.0)
+      {
+      // Vertex behind the viewer, the box may cover the whole viewport.
+      screen[0] = screen[1] = -1.0;
+      screen[2] = screen[3] = 1.0;
+      break;
+      }
+    double x = out[0]/out[3];
+    double y = out[1]/out[3];
+    screen[0] = (x < screen[0])? x : screen[0];
+    screen[1] = (y < screen[1])? y : screen[1];
+    screen[2] = (x > screen[2])? x : screen[2];
+    screen[3] = (y > screen[3])? y : screen[3];
+    }
+  for (int cc=0; cc < 4; cc++)
+    {
+    double v = (screen[cc] + 1.0)*0.5;
+    this->LastProjectedViewport[cc] = (v < 0.0)? 0.0 : ((v > 1.0)? 1.0 : v);
+    }
+  if (this->LastProjectedViewport[0] >= this->LastProjectedViewport[2] ||
+    this->LastProjectedViewport[1] >= this->LastProjectedViewport[3])
+    {
+    this->LastProjectedViewport[0] = this->LastProjectedViewport[1] =
+      this->LastProjectedViewport[2] = this->LastProjectedViewport[3] = 0.0;
+    }
+
+  vtkTimerLog::FormatAndMarkEvent(
+    "IceT: strategy %d, projected viewport coverage %.1f%%", this->LastStrategy,
+    100.0*(this->LastProjectedViewport[2] - this->LastProjectedViewport[0])*
+    (this->LastProjectedViewport[3] - this->LastProjectedViewport[1]));
+}
+
 //----------------------------------------------------------------------------
 void vtkIceTCompositePass::GetLastRenderedTile(
   vtkSynchronizedRenderers::vtkRawImage& tile)
@@ -757,4 +927,12 @@ void vtkIceTCompositePass::IceTInflateAndDisplay(vtkRenderer* renderer)
 void vtkIceTCompositePass::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "Strategy: " << this->Strategy << endl;
+  os << indent << "LastStrategy: " << this->LastStrategy << endl;
+  os << indent << "UseProjectedBounds: " << this->UseProjectedBounds << endl;
+  os << indent << "LastProjectedViewport: "
+    << this->LastProjectedViewport[0] << ", "
+    << this->LastProjectedViewport[1] << ", "
+    << this->LastProjectedViewport[2] << ", "
+    << this->LastProjectedViewport[3] << endl;
 }
@@ -33,6 +33,7 @@
 
 #include "vtkRenderPass.h"
 #include "vtkSynchronizedRenderers.h" //  needed for vtkRawImage.
+#include "vtkIceTConstants.h" // needed for StrategyType.
 
 class vtkMultiProcessController;
 class vtkPKdTree;
@@ -140,6 +141,44 @@ public:
   vtkGetMacro(FixBackground,bool);
   vtkSetMacro(FixBackground,bool);
 
+  // Description:
+  // Get/Set the IceT compositing strategy. Accepted values are defined in
+  // vtkIceTConstants::StrategyType. vtkIceTConstants::DEFAULT lets the pass
+  // pick a strategy each frame from values all processes agree upon: the
+  // number of processes, the number of tiles and the tile size (see
+  // GetLastStrategy()). With several tiles it picks DIRECT when every
+  // process owns a tile and REDUCE otherwise. With a single tile it picks
+  // VTREE for up to 4 processes or tiles of at most 256x256 pixels, and
+  // SERIAL otherwise. VTREE and SPLIT cannot composite in visibility order,
+  // so while ordered compositing is in use (see UseOrderedCompositing) they
+  // are replaced by REDUCE, whether picked automatically or set explicitly.
+  // Initial value is vtkIceTConstants::DEFAULT.
+  vtkSetClampMacro(Strategy, int, vtkIceTConstants::DEFAULT,
+    vtkIceTConstants::DIRECT);
+  vtkGetMacro(Strategy, int);
+
+  // Description:
+  // When true (default), the bounding boxes of each visible prop are
+  // passed to IceT individually rather than as a single box enclosing all
+  // of them. IceT projects these vertices to find the region of the
+  // viewport this process actually draws into, so with a tighter set of
+  // vertices fewer empty pixels are read back and sent when the local
+  // data only covers part of the view (e.g. zoomed-in distributed data).
+  vtkSetMacro(UseProjectedBounds, bool);
+  vtkGetMacro(UseProjectedBounds, bool);
+  vtkBooleanMacro(UseProjectedBounds, bool);
+
+  // Description:
+  // Returns the region of the renderer's viewport covered by the local
+  // visible props during the last render, as normalized (xmin, ymin, xmax,
+  // ymax) in [0, 1]. It is (0, 0, 0, 0) when nothing is visible locally.
+  vtkGetVector4Macro(LastProjectedViewport, double);
+
+  // Description:
+  // Returns the strategy that was used for the last render. This is the
+  // same as Strategy unless Strategy is vtkIceTConstants::DEFAULT.
+  vtkGetMacro(LastStrategy, int);
+
 //BTX
   // Description:
   // Internal callback. Don't call directly.
@@ -167,6 +206,17 @@ protected:
 
   void UpdateTileInformation(const vtkRenderState*);
 
+  // Description:
+  // Passes the bounds of the visible props to IceT and updates
+  // LastProjectedViewport.
+  void UpdateBoundingVertices(const vtkRenderState*);
+
+  // Description:
+  // Returns the IceT strategy to use for the current frame. Only
+  // strategies that honor the composite order are returned when
+  // use_ordered_compositing is true.
+  int ChooseStrategy(const vtkRenderState*, bool use_ordered_compositing);
+
   vtkMultiProcessController *Controller;
   vtkPKdTree *KdTree;
   vtkRenderPass* RenderPass;
@@ -193,6 +243,11 @@ protected:
   vtkTextureObject *BackgroundTexture;
   vtkTextureObject *IceTTexture;
 
+  int Strategy;
+  int LastStrategy;
+  bool UseProjectedBounds;
+  double LastProjectedViewport[4];
+
 private:
   vtkIceTCompositePass(const vtkIceTCompositePass&); // Not implemented
   void operator=(const vtkIceTCompositePass&); // Not implemented
@@ -77,6 +77,19 @@ public:
   void SetUseOrderedCompositing(bool uoc)
     { this->IceTCompositePass->SetUseOrderedCompositing(uoc); }
 
+  // Description:
+  // Set the IceT compositing strategy. vtkIceTConstants::DEFAULT (the
+  // default) picks one based on the number of processes and the image size.
+  void SetStrategy(int strategy)
+    { this->IceTCompositePass->SetStrategy(strategy); }
+
+  // Description:
+  // Set whether the bounds of each visible prop are passed to IceT
+  // individually so that only the region of the view covered by the local
+  // data is composited. On by default.
+  void SetUseProjectedBounds(bool val)
+    { this->IceTCompositePass->SetUseProjectedBounds(val); }
+
   // Description:
   // Set the image reduction factor. Overrides superclass implementation.
   virtual void SetImageReductionFactor(int val);
@@ -15,6 +15,7 @@
 #include "vtkKdTreeManager.h"
 
 #include "vtkAlgorithm.h"
+#include "vtkCellArray.h"
 #include "vtkCellType.h"
 #include "vtkCommunicator.h"
 #include "vtkKdTreeGenerator.h"
@@ -22,20 +23,73 @@
 #include "vtkObjectFactory.h"
 #include "vtkPKdTree.h"
 #include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkPVUpdateSuppressor.h"
 #include "vtkSmartPointer.h"
 #include "vtkSphereSource.h"
+#include "vtkTimerLog.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <math.h>
+
 #define VTK_CREATE(type, name) \
   vtkSmartPointer<type> name = vtkSmartPointer<type>::New()
 
+#include <vtkstd/algorithm>
+#include <vtkstd/map>
 #include <vtkstd/set>
 #include <vtkstd/vector>
 
 class vtkKdTreeManager::vtkAlgorithmSet : 
   public vtkstd::set<vtkSmartPointer<vtkAlgorithm> > {};
 
+// For each dataset given to the KdTree, the values that change when its
+// geometry changes (but not when only its attributes do).
+class vtkKdTreeManager::vtkGeometryStamps :
+  public vtkstd::map<vtkDataSet*, vtkstd::vector<double> > {};
+
+// Number of cells sampled per dataset to estimate the load balance.
+static const vtkIdType vtkKdTreeManagerBalanceSamples = 10000;
+
+//----------------------------------------------------------------------------
+static void vtkKdTreeManagerGetGeometryStamp(vtkDataSet* data,
+  vtkstd::vector<double>& stamp)
+{
+  unsigned long mtime = 0;
+  vtkPointSet* ps = vtkPointSet::SafeDownCast(data);
+  if (ps && ps->GetPoints())
+    {
+    mtime = ps->GetPoints()->GetMTime();
+    }
+  vtkPolyData* pd = vtkPolyData::SafeDownCast(data);
+  if (pd)
+    {
+    vtkCellArray* cells[4] = { pd->GetVerts(), pd->GetLines(),
+      pd->GetPolys(), pd->GetStrips() };
+    for (int cc = 0; cc < 4; cc++)
+      {
+      if (cells[cc] && cells[cc]->GetMTime() > mtime)
+        {
+        mtime = cells[cc]->GetMTime();
+        }
+      }
+    }
+  vtkUnstructuredGrid* ug = vtkUnstructuredGrid::SafeDownCast(data);
+  if (ug && ug->GetCells() && ug->GetCells()->GetMTime() > mtime)
+    {
+    mtime = ug->GetCells()->GetMTime();
+    }
+
+  // Structured datasets are fully described by their bounds and sizes.
+  double bounds[6];
+  data->GetBounds(bounds);
+  stamp.clear();
+  stamp.push_back(static_cast<double>(mtime));
+  stamp.push_back(static_cast<double>(data->GetNumberOfPoints()));
+  stamp.push_back(static_cast<double>(data->GetNumberOfCells()));
+  stamp.insert(stamp.end(), bounds, bounds+6);
+}
+
 vtkStandardNewMacro(vtkKdTreeManager);
 vtkCxxSetObjectMacro(vtkKdTreeManager, StructuredProducer, vtkAlgorithm);
 //----------------------------------------------------------------------------
@@ -46,6 +100,18 @@ vtkKdTreeManager::vtkKdTreeManager()
   this->KdTree = 0;
   this->NumberOfPieces = 1;
   this->KdTreeInitialized = false;
+
+  this->GeometryStamps = new vtkGeometryStamps();
+  this->BoundsTolerance = 0.05;
+  this->BalanceTolerance = 0.1;
+  this->ReuseCuts = true;
+  this->LastUpdateType = UPDATE_NONE;
+  this->LastUpdateDuration = 0.0;
+  this->NumberOfRebuilds = 0;
+  this->NumberOfReusedCuts = 0;
+  this->BuiltImbalance = 1.0;
+  this->LastStructuredProducer = 0;
+  this->LastNumberOfPieces = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -55,6 +121,7 @@ vtkKdTreeManager::~vtkKdTreeManager()
   this->SetStructuredProducer(0);
 
   delete this->Producers;
+  delete this->GeometryStamps;
 }
 
 //----------------------------------------------------------------------------
@@ -141,6 +208,44 @@ void vtkKdTreeManager::Update()
     return;
     }
 
+  double startTime = vtkTimerLog::GetUniversalTime();
+
+  // Find out if the geometry changed at all. Changes limited to attributes
+  // keep the KdTree as is.
+  bool rebuild_required = !this->KdTreeInitialized ||
+    !this->KdTree->GetCuts() ||
+    this->LastStructuredProducer != this->StructuredProducer ||
+    this->LastNumberOfPieces != this->NumberOfPieces;
+  vtkGeometryStamps stamps;
+  for (dsIter = outputs.begin(); dsIter != outputs.end(); ++dsIter)
+    {
+    vtkKdTreeManagerGetGeometryStamp(*dsIter, stamps[*dsIter]);
+    }
+  bool geometry_changed = rebuild_required ||
+    stamps != *this->GeometryStamps;
+  *this->GeometryStamps = stamps;
+  this->LastStructuredProducer = this->StructuredProducer;
+  this->LastNumberOfPieces = this->NumberOfPieces;
+
+  vtkMultiProcessController *controller = this->KdTree->GetController();
+  int flags[2] = { geometry_changed? 1 : 0, rebuild_required? 1 : 0 };
+  int globalFlags[2] = { flags[0], flags[1] };
+  if (controller)
+    {
+    controller->AllReduce(flags, globalFlags, 2, vtkCommunicator::MAX_OP);
+    }
+  geometry_changed = (globalFlags[0] != 0);
+  rebuild_required = (globalFlags[1] != 0);
+
+  if (!geometry_changed)
+    {
+    this->LastUpdateType = UPDATE_ATTRIBUTES_ONLY;
+    this->LastUpdateDuration = vtkTimerLog::GetUniversalTime() - startTime;
+    this->UpdateTime.Modified();
+    return;
+    }
+
+  vtkTimerLog::MarkStartEvent("vtkKdTreeManager::Update");
   this->KdTree->RemoveAllDataSets();
   if (!this->KdTreeInitialized)
     {
@@ -164,28 +269,173 @@ void vtkKdTreeManager::Update()
     this->AddDataSetToKdTree(*dsIter);
     } 
 
-  if (this->StructuredProducer)
+  // Cuts generated from the structured extents are cheap to regenerate and
+  // must match the extents, so they are never reused.
+  vtkDataSet** data = outputs.size() > 0? &outputs[0] : 0;
+  int numData = static_cast<int>(outputs.size());
+  if (!rebuild_required && this->ReuseCuts && !this->StructuredProducer &&
+    controller)
     {
-    // Ask the vtkKdTreeGenerator to generate the cuts for the kd tree.
-    vtkKdTreeGenerator* generator = vtkKdTreeGenerator::New();
-    generator->SetKdTree(this->KdTree);
-    generator->SetNumberOfPieces(this->NumberOfPieces);
-    generator->BuildTree(this->StructuredProducer->GetOutputDataObject(0));
-    generator->Delete();
+    double localBounds[6] = { VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX,
+      VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX };
+    for (dsIter = outputs.begin(); dsIter != outputs.end(); ++dsIter)
+      {
+      if ((*dsIter)->GetNumberOfCells() == 0)
+        {
+        continue;
+        }
+      double bounds[6];
+      (*dsIter)->GetBounds(bounds);
+      for (int cc = 0; cc < 3; cc++)
+        {
+        localBounds[cc] = vtkstd::min(localBounds[cc], bounds[2*cc]);
+        localBounds[cc+3] = vtkstd::min(localBounds[cc+3], -bounds[2*cc+1]);
+        }
+      }
+    double globalBounds[6];
+    controller->AllReduce(localBounds, globalBounds, 6,
+      vtkCommunicator::MIN_OP);
+    double dataBounds[6];
+    for (int cc = 0; cc < 3; cc++)
+      {
+      dataBounds[2*cc] = globalBounds[cc];
+      dataBounds[2*cc+1] = -globalBounds[cc+3];
+      }
+
+    bool outside = false;
+    double imbalance = this->ComputeImbalance(data, numData, outside);
+    rebuild_required = outside || !this->CanReuseCuts(dataBounds, imbalance);
     }
   else
     {
-    // Ensure that the kdtree is not using predefined cuts.
-    this->KdTree->SetCuts(0);
-    // this is needed to clear the region assignments provided by the structured
-    // dataset.
-    this->KdTree->AssignRegionsContiguous();
+    rebuild_required = true;
     }
 
-  this->KdTree->BuildLocator();
+  if (rebuild_required)
+    {
+    if (this->StructuredProducer)
+      {
+      // Ask the vtkKdTreeGenerator to generate the cuts for the kd tree.
+      vtkKdTreeGenerator* generator = vtkKdTreeGenerator::New();
+      generator->SetKdTree(this->KdTree);
+      generator->SetNumberOfPieces(this->NumberOfPieces);
+      generator->BuildTree(this->StructuredProducer->GetOutputDataObject(0));
+      generator->Delete();
+      }
+    else
+      {
+      // Ensure that the kdtree is not using predefined cuts.
+      this->KdTree->SetCuts(0);
+      // this is needed to clear the region assignments provided by the
+      // structured dataset.
+      this->KdTree->AssignRegionsContiguous();
+      }
+
+    this->KdTree->BuildLocator();
+
+    // Remember how good the fresh cuts are, to decide later whether they are
+    // still good enough.
+    if (this->ReuseCuts && !this->StructuredProducer && controller)
+      {
+      bool outside = false;
+      this->BuiltImbalance = this->ComputeImbalance(data, numData, outside);
+      }
+    this->NumberOfRebuilds++;
+    this->LastUpdateType = UPDATE_CUTS_REBUILT;
+    }
+  else
+    {
+    this->NumberOfReusedCuts++;
+    this->LastUpdateType = UPDATE_CUTS_KEPT;
+    }
+
+  vtkTimerLog::MarkEndEvent("vtkKdTreeManager::Update");
+  this->LastUpdateDuration = vtkTimerLog::GetUniversalTime() - startTime;
   this->UpdateTime.Modified();
 }
 
+//-----------------------------------------------------------------------------
+double vtkKdTreeManager::ComputeImbalance(vtkDataSet** data, int numData,
+  bool& outside)
+{
+  vtkMultiProcessController *controller = this->KdTree->GetController();
+  int numProcs = controller->GetNumberOfProcesses();
+
+  // Each sampled cell center stands for 'stride' cells.
+  vtkstd::vector<double> localLoads(numProcs+1, 0.0);
+  for (int dd = 0; dd < numData; dd++)
+    {
+    vtkIdType numCells = data[dd]->GetNumberOfCells();
+    vtkIdType stride = numCells / vtkKdTreeManagerBalanceSamples + 1;
+    for (vtkIdType cellId = 0; cellId < numCells; cellId += stride)
+      {
+      double bounds[6];
+      data[dd]->GetCellBounds(cellId, bounds);
+      int region = this->KdTree->GetRegionContainingPoint(
+        0.5*(bounds[0]+bounds[1]), 0.5*(bounds[2]+bounds[3]),
+        0.5*(bounds[4]+bounds[5]));
+      int proc = region < 0? -1 :
+        this->KdTree->GetProcessAssignedToRegion(region);
+      if (proc < 0 || proc >= numProcs)
+        {
+        // The last entry counts the samples outside of the KdTree.
+        localLoads[numProcs] += 1.0;
+        }
+      else
+        {
+        localLoads[proc] += static_cast<double>(stride);
+        }
+      }
+    }
+
+  vtkstd::vector<double> loads(numProcs+1, 0.0);
+  controller->AllReduce(&localLoads[0], &loads[0], numProcs+1,
+    vtkCommunicator::SUM_OP);
+  outside = (loads[numProcs] > 0.0);
+
+  double total = 0.0, maximum = 0.0;
+  for (int cc = 0; cc < numProcs; cc++)
+    {
+    total += loads[cc];
+    maximum = vtkstd::max(maximum, loads[cc]);
+    }
+  return total > 0.0? maximum * numProcs / total : 1.0;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkKdTreeManager::CanReuseCuts(const double dataBounds[6],
+  double imbalance)
+{
+  if (dataBounds[0] > dataBounds[1])
+    {
+    // No cells anywhere.
+    return false;
+    }
+
+  double treeBounds[6];
+  this->KdTree->GetBounds(treeBounds);
+  double diagonal = sqrt(
+    (treeBounds[1]-treeBounds[0])*(treeBounds[1]-treeBounds[0]) +
+    (treeBounds[3]-treeBounds[2])*(treeBounds[3]-treeBounds[2]) +
+    (treeBounds[5]-treeBounds[4])*(treeBounds[5]-treeBounds[4]));
+  double slack = this->BoundsTolerance * diagonal;
+  for (int cc = 0; cc < 3; cc++)
+    {
+    if (dataBounds[2*cc] < treeBounds[2*cc] ||
+      dataBounds[2*cc+1] > treeBounds[2*cc+1])
+      {
+      return false;
+      }
+    if (dataBounds[2*cc] - treeBounds[2*cc] > slack ||
+      treeBounds[2*cc+1] - dataBounds[2*cc+1] > slack)
+      {
+      return false;
+      }
+    }
+
+  return (imbalance <= this->BuiltImbalance * (1.0 + this->BalanceTolerance));
+}
+
 //-----------------------------------------------------------------------------
 void vtkKdTreeManager::AddDataSetToKdTree(vtkDataSet *data)
 {
@@ -272,6 +522,13 @@ void vtkKdTreeManager::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "KdTree: " << this->KdTree << endl;
   os << indent << "NumberOfPieces: " << this->NumberOfPieces << endl;
+  os << indent << "BoundsTolerance: " << this->BoundsTolerance << endl;
+  os << indent << "BalanceTolerance: " << this->BalanceTolerance << endl;
+  os << indent << "ReuseCuts: " << this->ReuseCuts << endl;
+  os << indent << "LastUpdateType: " << this->LastUpdateType << endl;
+  os << indent << "LastUpdateDuration: " << this->LastUpdateDuration << endl;
+  os << indent << "NumberOfRebuilds: " << this->NumberOfRebuilds << endl;
+  os << indent << "NumberOfReusedCuts: " << this->NumberOfReusedCuts << endl;
 }
 
 
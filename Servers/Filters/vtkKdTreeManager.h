@@ -45,8 +45,57 @@ public:
   // Description:
   // Updates all producers are rebuilds the KdTree if the data from any producer
   // changed.
+  // Changes that do not affect the geometry (e.g. new attribute arrays) never
+  // rebuild the KdTree. When the geometry changes, the existing cuts are kept
+  // as long as the data still fits in them (see BoundsTolerance) and the
+  // distribution of cells among processes is not significantly worse than
+  // right after the last rebuild (see BalanceTolerance). Keeping the cuts
+  // means that the data of unchanged producers does not need to be
+  // redistributed.
   void Update();
 
+  // Description:
+  // Fraction of the diagonal of the KdTree by which the data bounds may
+  // shrink, on any side, before the cuts are rebuilt. Data extending beyond
+  // the KdTree bounds always rebuilds the cuts. Default is 0.05.
+  vtkSetClampMacro(BoundsTolerance, double, 0.0, 1.0);
+  vtkGetMacro(BoundsTolerance, double);
+
+  // Description:
+  // Relative increase of the load imbalance (most loaded process over the
+  // average) allowed before the cuts are rebuilt. Default is 0.1.
+  vtkSetClampMacro(BalanceTolerance, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(BalanceTolerance, double);
+
+  // Description:
+  // Set to false to rebuild the cuts on every geometry change, as done
+  // before. Default is true.
+  vtkSetMacro(ReuseCuts, bool);
+  vtkGetMacro(ReuseCuts, bool);
+  vtkBooleanMacro(ReuseCuts, bool);
+
+//BTX
+  enum
+    {
+    UPDATE_NONE = 0,
+    UPDATE_ATTRIBUTES_ONLY,
+    UPDATE_CUTS_KEPT,
+    UPDATE_CUTS_REBUILT
+    };
+//ETX
+
+  // Description:
+  // What the last Update() did (one of the UPDATE_* values) and how long it
+  // took, in seconds. Rebuilds are also recorded in the vtkTimerLog as
+  // "vtkKdTreeManager::Update".
+  vtkGetMacro(LastUpdateType, int);
+  vtkGetMacro(LastUpdateDuration, double);
+
+  // Description:
+  // Number of times the cuts were rebuilt/kept since this object was created.
+  vtkGetMacro(NumberOfRebuilds, int);
+  vtkGetMacro(NumberOfReusedCuts, int);
+
   // Description:
   // Get/Set the KdTree managed by this manager.
   void SetKdTree(vtkPKdTree*);
@@ -65,11 +114,33 @@ protected:
 
   void AddDataSetToKdTree(vtkDataSet *data);
 
+  // Description:
+  // Returns true if the current cuts can be kept for the given data.
+  bool CanReuseCuts(const double dataBounds[6], double imbalance);
+
+  // Description:
+  // Computes the load imbalance of the current cuts for the given data from
+  // a sample of the cell centers. Also tells if some of the samples fall
+  // outside of the KdTree. Collective.
+  double ComputeImbalance(vtkDataSet** data, int numData, bool& outside);
+
   bool KdTreeInitialized;
   vtkAlgorithm* StructuredProducer;
   vtkPKdTree* KdTree;
   int NumberOfPieces;
   vtkTimeStamp UpdateTime;
+
+  double BoundsTolerance;
+  double BalanceTolerance;
+  bool ReuseCuts;
+
+  int LastUpdateType;
+  double LastUpdateDuration;
+  int NumberOfRebuilds;
+  int NumberOfReusedCuts;
+  double BuiltImbalance;
+  vtkAlgorithm* LastStructuredProducer;
+  int LastNumberOfPieces;
 private:
   vtkKdTreeManager(const vtkKdTreeManager&); // Not implemented
   void operator=(const vtkKdTreeManager&); // Not implemented
@@ -77,6 +148,9 @@ private:
   class vtkAlgorithmSet;
   vtkAlgorithmSet* Producers;
 
+  class vtkGeometryStamps;
+  vtkGeometryStamps* GeometryStamps;
+
 //ETX
 };
 
@@ -35,6 +35,7 @@
 #include "vtkPointData.h"
 #include "vtkPolyData.h"
 #include "vtkProcessModule.h"
+#include "vtkRemoteConnection.h"
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
@@ -837,6 +838,15 @@ void vtkMPIMoveData::ClientReceiveFromDataServer(vtkDataObject* output)
     return;
     }
 
+  // The data server only sends once it got the streams asking for the data,
+  // which may still be queued by a stream transaction.
+  vtkRemoteConnection* rc =
+    vtkProcessModule::GetProcessModule()->GetActiveRemoteConnection();
+  if (rc)
+    {
+    rc->FlushStreams();
+    }
+
   this->ClearBuffer();
   com->Receive(&(this->NumberOfBuffers), 1, 1, 23490);
   this->BufferLengths = new vtkIdType[this->NumberOfBuffers];
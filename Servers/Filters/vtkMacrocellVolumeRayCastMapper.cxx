@@ -0,0 +1,861 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkMacrocellVolumeRayCastMapper.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkMacrocellVolumeRayCastMapper.h"
+
+#include "vtkCamera.h"
+#include "vtkColorTransferFunction.h"
+#include "vtkDataArray.h"
+#include "vtkImageData.h"
+#include "vtkMatrix4x4.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkPiecewiseFunction.h"
+#include "vtkRayCastImageDisplayHelper.h"
+#include "vtkRenderer.h"
+#include "vtkRenderWindow.h"
+#include "vtkTimerLog.h"
+#include "vtkVolume.h"
+#include "vtkVolumeProperty.h"
+
+#include <vtkstd/vector>
+#include <math.h>
+
+namespace
+{
+  // Number of entries in the color and opacity lookup tables.
+  const int TABLE_SIZE = 1024;
+
+  // Rays stop once they are this opaque.
+  const float EARLY_RAY_TERMINATION_OPACITY = 0.99f;
+
+  // Rays are cast in square tiles of this many pixels per side. Tiles are
+  // interleaved among the threads.
+  const int TILE_SIZE = 16;
+
+  // Everything the threads need to build the macrocells and cast the rays.
+  class vtkMacrocellState
+  {
+  public:
+    // Sample grid. This is the point grid of the input, or the grid of cell
+    // centers when cell scalars are rendered.
+    vtkDataArray* Scalars;
+    void* ScalarPointer;
+    int NumberOfComponents;
+    int Dimensions[3];
+    double Origin[3];
+    double Spacing[3];
+    vtkIdType Increments[3];
+
+    // Macrocells.
+    int MacrocellSize;
+    int CellDimensions[3];
+    vtkstd::vector<float> CellMin;
+    vtkstd::vector<float> CellMax;
+    vtkstd::vector<unsigned char> CellEmpty;
+    vtkTimeStamp MacrocellBuildTime;
+    vtkDataArray* MacrocellScalars;
+
+    // Transfer functions.
+    double Range[2];
+    double TableScale;
+    float ColorTable[3*TABLE_SIZE];
+    float OpacityTable[TABLE_SIZE];
+    int NonZeroOpacityCount[TABLE_SIZE+1];
+    double TableSampleDistance;
+    int TableBlendMode;
+    vtkTimeStamp TableBuildTime;
+    int BlendMode;
+
+    // Ray geometry.
+    double NDCToIndex[16];
+    double SampleDistance;
+    double ImageSampleDistance;
+    int ImageViewportSize[2];
+    int ImageInUseSize[2];
+    int ImageOrigin[2];
+    int ImageMemorySize[2];
+    vtkstd::vector<unsigned char> Image;
+    float* ZBuffer;
+    int ZBufferSize[2];
+    float MinimumDepth;
+
+    int TableIndex(double value) const
+      {
+      double f = (value - this->Range[0])*this->TableScale;
+      if (f <= 0.0)
+        {
+        return 0;
+        }
+      if (f >= TABLE_SIZE-1)
+        {
+        return TABLE_SIZE-1;
+        }
+      return static_cast<int>(f + 0.5);
+      }
+
+    vtkIdType CellIndex(const double x[3]) const
+      {
+      int c[3];
+      for (int i=0; i < 3; i++)
+        {
+        c[i] = (x[i] <= 0.0)? 0 : static_cast<int>(x[i]/this->MacrocellSize);
+        c[i] = (c[i] >= this->CellDimensions[i])?
+          this->CellDimensions[i]-1 : c[i];
+        }
+      return c[0] + this->CellDimensions[0]*
+        (c[1] + static_cast<vtkIdType>(this->CellDimensions[1])*c[2]);
+      }
+
+    // Parametric distance, along the ray a + t*d, to the exit of the
+    // macrocell containing x.
+    double CellExit(const double a[3], const double d[3],
+      const double x[3]) const
+      {
+      double exit = VTK_DOUBLE_MAX;
+      for (int i=0; i < 3; i++)
+        {
+        if (d[i] == 0.0)
+          {
+          continue;
+          }
+        int c = (x[i] <= 0.0)? 0 : static_cast<int>(x[i]/this->MacrocellSize);
+        c = (c >= this->CellDimensions[i])? this->CellDimensions[i]-1 : c;
+        double plane = (d[i] > 0.0)?
+          (c+1)*this->MacrocellSize : c*this->MacrocellSize;
+        double t = (plane - a[i])/d[i];
+        exit = (t < exit)? t : exit;
+        }
+      return exit;
+      }
+  };
+
+  //----------------------------------------------------------------------------
+  template <class T>
+  double vtkMacrocellTrilinear(const vtkMacrocellState* state, const T* data,
+    const double x[3])
+  {
+  int i[3];
+  double f[3];
+  for (int c=0; c < 3; c++)
+    {
+    double v = x[c] < 0.0? 0.0 : x[c];
+    i[c] = static_cast<int>(v);
+    if (i[c] >= state->Dimensions[c]-1)
+      {
+      i[c] = state->Dimensions[c]-2;
+      }
+    f[c] = v - i[c];
+    f[c] = f[c] > 1.0? 1.0 : f[c];
+    }
+  const vtkIdType* inc = state->Increments;
+  int nc = state->NumberOfComponents;
+  const T* p = data + nc*(i[0] + i[1]*inc[1] + i[2]*inc[2]);
+  double v000 = p[0];
+  double v100 = p[nc];
+  double v010 = p[nc*inc[1]];
+  double v110 = p[nc*(inc[1]+1)];
+  double v001 = p[nc*inc[2]];
+  double v101 = p[nc*(inc[2]+1)];
+  double v011 = p[nc*(inc[2]+inc[1])];
+  double v111 = p[nc*(inc[2]+inc[1]+1)];
+  double v00 = v000 + f[0]*(v100 - v000);
+  double v10 = v010 + f[0]*(v110 - v010);
+  double v01 = v001 + f[0]*(v101 - v001);
+  double v11 = v011 + f[0]*(v111 - v011);
+  double v0 = v00 + f[1]*(v10 - v00);
+  double v1 = v01 + f[1]*(v11 - v01);
+  return v0 + f[2]*(v1 - v0);
+  }
+
+  //----------------------------------------------------------------------------
+  // Computes the min/max of the macrocells in the z-slabs assigned to this
+  // thread. Neighboring macrocells share their boundary voxels so that any
+  // value interpolated inside a cell is within its range.
+  template <class T>
+  void vtkMacrocellBuild(vtkMacrocellState* state, const T* data,
+    int threadId, int numThreads)
+  {
+  int M = state->MacrocellSize;
+  int nc = state->NumberOfComponents;
+  const int* cdims = state->CellDimensions;
+  const int* dims = state->Dimensions;
+  for (int cz = threadId; cz < cdims[2]; cz += numThreads)
+    {
+    int kmax = ((cz+1)*M < dims[2]-1)? (cz+1)*M : dims[2]-1;
+    for (int cy = 0; cy < cdims[1]; cy++)
+      {
+      int jmax = ((cy+1)*M < dims[1]-1)? (cy+1)*M : dims[1]-1;
+      for (int cx = 0; cx < cdims[0]; cx++)
+        {
+        int imax = ((cx+1)*M < dims[0]-1)? (cx+1)*M : dims[0]-1;
+        float cmin = VTK_FLOAT_MAX;
+        float cmax = -VTK_FLOAT_MAX;
+        for (int k = cz*M; k <= kmax; k++)
+          {
+          for (int j = cy*M; j <= jmax; j++)
+            {
+            const T* p = data + nc*(cx*M + j*state->Increments[1] +
+              k*state->Increments[2]);
+            for (int i = cx*M; i <= imax; i++, p += nc)
+              {
+              float v = static_cast<float>(*p);
+              cmin = (v < cmin)? v : cmin;
+              cmax = (v > cmax)? v : cmax;
+              }
+            }
+          }
+        vtkIdType cell = cx + cdims[0]*(cy + static_cast<vtkIdType>(cdims[1])*cz);
+        state->CellMin[cell] = cmin;
+        state->CellMax[cell] = cmax;
+        }
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Casts the ray through image pixel (i, j) and returns its premultiplied
+  // color.
+  template <class T>
+  void vtkMacrocellCastRay(const vtkMacrocellState* state, const T* data,
+    int i, int j, float rgba[4])
+  {
+  rgba[0] = rgba[1] = rgba[2] = rgba[3] = 0.0f;
+
+  double gx = state->ImageOrigin[0] + i + 0.5;
+  double gy = state->ImageOrigin[1] + j + 0.5;
+  double ndc[4];
+  ndc[0] = 2.0*gx/state->ImageViewportSize[0] - 1.0;
+  ndc[1] = 2.0*gy/state->ImageViewportSize[1] - 1.0;
+  ndc[3] = 1.0;
+
+  double farZ = 1.0;
+  if (state->ZBuffer)
+    {
+    int px = static_cast<int>(gx*state->ImageSampleDistance);
+    int py = static_cast<int>(gy*state->ImageSampleDistance);
+    px = (px >= state->ZBufferSize[0])? state->ZBufferSize[0]-1 : px;
+    py = (py >= state->ZBufferSize[1])? state->ZBufferSize[1]-1 : py;
+    farZ = 2.0*state->ZBuffer[py*state->ZBufferSize[0] + px] - 1.0;
+    }
+
+  // Ray end points in index space.
+  double a[4], b[4];
+  ndc[2] = -1.0;
+  vtkMatrix4x4::MultiplyPoint(state->NDCToIndex, ndc, a);
+  ndc[2] = farZ;
+  vtkMatrix4x4::MultiplyPoint(state->NDCToIndex, ndc, b);
+  if (a[3] == 0.0 || b[3] == 0.0)
+    {
+    return;
+    }
+  double d[3];
+  double length = 0.0;
+  for (int c=0; c < 3; c++)
+    {
+    a[c] /= a[3];
+    b[c] /= b[3];
+    d[c] = b[c] - a[c];
+    length += d[c]*d[c]*state->Spacing[c]*state->Spacing[c];
+    }
+  length = sqrt(length);
+  if (length <= 0.0)
+    {
+    return;
+    }
+  double dt = state->SampleDistance/length;
+
+  // Clip the ray to the volume.
+  double t0 = 0.0;
+  double t1 = 1.0;
+  for (int c=0; c < 3; c++)
+    {
+    double upper = state->Dimensions[c] - 1;
+    if (fabs(d[c]) < 1e-12)
+      {
+      if (a[c] < 0.0 || a[c] > upper)
+        {
+        return;
+        }
+      continue;
+      }
+    double tl = -a[c]/d[c];
+    double th = (upper - a[c])/d[c];
+    if (tl > th)
+      {
+      double tmp = tl; tl = th; th = tmp;
+      }
+    t0 = (tl > t0)? tl : t0;
+    t1 = (th < t1)? th : t1;
+    }
+  if (t0 >= t1)
+    {
+    return;
+    }
+
+  const float* colors = state->ColorTable;
+  const float* opacities = state->OpacityTable;
+  double x[3];
+  double t = t0;
+
+  if (state->BlendMode == vtkVolumeMapper::COMPOSITE_BLEND)
+    {
+    const unsigned char* empty = &state->CellEmpty[0];
+    while (t <= t1)
+      {
+      x[0] = a[0] + t*d[0];
+      x[1] = a[1] + t*d[1];
+      x[2] = a[2] + t*d[2];
+      if (empty[state->CellIndex(x)])
+        {
+        // Jump to the first sample past this macrocell. Staying on the
+        // sample grid of the ray avoids artifacts at cell boundaries.
+        double steps = ceil((state->CellExit(a, d, x) - t)/dt);
+        t += (steps < 1.0? 1.0 : steps)*dt;
+        continue;
+        }
+      int index = state->TableIndex(vtkMacrocellTrilinear(state, data, x));
+      float opacity = opacities[index];
+      if (opacity > 0.0f)
+        {
+        float w = (1.0f - rgba[3])*opacity;
+        rgba[0] += w*colors[3*index];
+        rgba[1] += w*colors[3*index+1];
+        rgba[2] += w*colors[3*index+2];
+        rgba[3] += w;
+        if (rgba[3] >= EARLY_RAY_TERMINATION_OPACITY)
+          {
+          break;
+          }
+        }
+      t += dt;
+      }
+    return;
+    }
+
+  // Maximum or minimum intensity projection. Skip the macrocells that cannot
+  // hold a better value than the one found so far.
+  bool maximum = (state->BlendMode == vtkVolumeMapper::MAXIMUM_INTENSITY_BLEND);
+  bool found = false;
+  double best = 0.0;
+  while (t <= t1)
+    {
+    x[0] = a[0] + t*d[0];
+    x[1] = a[1] + t*d[1];
+    x[2] = a[2] + t*d[2];
+    if (found)
+      {
+      vtkIdType cell = state->CellIndex(x);
+      if ((maximum && state->CellMax[cell] <= best) ||
+        (!maximum && state->CellMin[cell] >= best))
+        {
+        double steps = ceil((state->CellExit(a, d, x) - t)/dt);
+        t += (steps < 1.0? 1.0 : steps)*dt;
+        continue;
+        }
+      }
+    double value = vtkMacrocellTrilinear(state, data, x);
+    if (!found || (maximum && value > best) || (!maximum && value < best))
+      {
+      best = value;
+      found = true;
+      }
+    t += dt;
+    }
+  if (found)
+    {
+    int index = state->TableIndex(best);
+    float opacity = opacities[index];
+    rgba[0] = opacity*colors[3*index];
+    rgba[1] = opacity*colors[3*index+1];
+    rgba[2] = opacity*colors[3*index+2];
+    rgba[3] = opacity;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  template <class T>
+  void vtkMacrocellCastTiles(vtkMacrocellState* state, const T* data,
+    int threadId, int numThreads)
+  {
+  int tilesX = (state->ImageInUseSize[0] + TILE_SIZE - 1)/TILE_SIZE;
+  int tilesY = (state->ImageInUseSize[1] + TILE_SIZE - 1)/TILE_SIZE;
+  for (int tile = threadId; tile < tilesX*tilesY; tile += numThreads)
+    {
+    int i0 = (tile % tilesX)*TILE_SIZE;
+    int j0 = (tile / tilesX)*TILE_SIZE;
+    int i1 = (i0 + TILE_SIZE < state->ImageInUseSize[0])?
+      i0 + TILE_SIZE : state->ImageInUseSize[0];
+    int j1 = (j0 + TILE_SIZE < state->ImageInUseSize[1])?
+      j0 + TILE_SIZE : state->ImageInUseSize[1];
+    for (int j = j0; j < j1; j++)
+      {
+      unsigned char* pixel =
+        &state->Image[4*(j*state->ImageMemorySize[0] + i0)];
+      for (int i = i0; i < i1; i++, pixel += 4)
+        {
+        float rgba[4];
+        vtkMacrocellCastRay(state, data, i, j, rgba);
+        for (int c=0; c < 4; c++)
+          {
+          float v = rgba[c]*255.0f + 0.5f;
+          pixel[c] = static_cast<unsigned char>(v > 255.0f? 255.0f : v);
+          }
+        }
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  VTK_THREAD_RETURN_TYPE vtkMacrocellCastRaysThread(void* arg)
+  {
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  static_cast<vtkMacrocellVolumeRayCastMapper*>(info->UserData)->CastRays(
+    info->ThreadID, info->NumberOfThreads);
+  return VTK_THREAD_RETURN_VALUE;
+  }
+
+  //----------------------------------------------------------------------------
+  VTK_THREAD_RETURN_TYPE vtkMacrocellBuildThread(void* arg)
+  {
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  static_cast<vtkMacrocellVolumeRayCastMapper*>(info->UserData)->BuildMacrocells(
+    info->ThreadID, info->NumberOfThreads);
+  return VTK_THREAD_RETURN_VALUE;
+  }
+}
+
+//----------------------------------------------------------------------------
+class vtkMacrocellVolumeRayCastMapper::vtkInternals : public vtkMacrocellState
+{
+public:
+  vtkInternals()
+    {
+    this->Scalars = 0;
+    this->ScalarPointer = 0;
+    this->MacrocellScalars = 0;
+    this->MacrocellSize = 0;
+    this->TableSampleDistance = 0.0;
+    this->TableBlendMode = -1;
+    this->ZBuffer = 0;
+    this->Range[0] = this->Range[1] = 0.0;
+    }
+};
+
+vtkStandardNewMacro(vtkMacrocellVolumeRayCastMapper);
+//----------------------------------------------------------------------------
+vtkMacrocellVolumeRayCastMapper::vtkMacrocellVolumeRayCastMapper()
+{
+  this->SampleDistance = 0.0;
+  this->ImageSampleDistance = 1.0;
+  this->InteractiveImageSampleDistance = 2.0;
+  this->InteractiveSampleDistanceFactor = 2.0;
+  this->Interactive = 0;
+  this->MacrocellSize = 8;
+  this->NumberOfThreads = 0;
+  this->IntermixIntersectingGeometry = 1;
+  this->NumberOfMacrocells = 0;
+  this->NumberOfEmptyMacrocells = 0;
+
+  this->Threader = vtkMultiThreader::New();
+  this->ImageDisplayHelper = vtkRayCastImageDisplayHelper::New();
+  this->Internals = new vtkInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkMacrocellVolumeRayCastMapper::~vtkMacrocellVolumeRayCastMapper()
+{
+  this->Threader->Delete();
+  this->ImageDisplayHelper->Delete();
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkMacrocellVolumeRayCastMapper::ReleaseGraphicsResources(vtkWindow*)
+{
+  vtkstd::vector<unsigned char>().swap(this->Internals->Image);
+}
+
+//----------------------------------------------------------------------------
+void vtkMacrocellVolumeRayCastMapper::UpdateMacrocells(vtkImageData* input,
+  vtkDataArray* scalars, int cellFlag)
+{
+  vtkInternals* state = this->Internals;
+
+  int dims[3];
+  input->GetDimensions(dims);
+  input->GetOrigin(state->Origin);
+  input->GetSpacing(state->Spacing);
+  for (int i=0; i < 3; i++)
+    {
+    if (cellFlag && dims[i] > 1)
+      {
+      dims[i]--;
+      state->Origin[i] += 0.5*state->Spacing[i];
+      }
+    state->Dimensions[i] = dims[i];
+    }
+  state->Increments[0] = 1;
+  state->Increments[1] = dims[0];
+  state->Increments[2] = static_cast<vtkIdType>(dims[0])*dims[1];
+  state->Scalars = scalars;
+  state->ScalarPointer = scalars->GetVoidPointer(0);
+  state->NumberOfComponents = scalars->GetNumberOfComponents();
+
+  if (dims[0] < 2 || dims[1] < 2 || dims[2] < 2)
+    {
+    return;
+    }
+
+  if (state->MacrocellScalars == scalars &&
+    state->MacrocellSize == this->MacrocellSize &&
+    state->MacrocellBuildTime > scalars->GetMTime() &&
+    state->MacrocellBuildTime > input->GetMTime())
+    {
+    return;
+    }
+
+  vtkTimerLog::MarkStartEvent("Build Macrocells");
+  state->MacrocellSize = this->MacrocellSize;
+  for (int i=0; i < 3; i++)
+    {
+    state->CellDimensions[i] =
+      (dims[i] - 1 + this->MacrocellSize - 1)/this->MacrocellSize;
+    }
+  this->NumberOfMacrocells = static_cast<vtkIdType>(state->CellDimensions[0])*
+    state->CellDimensions[1]*state->CellDimensions[2];
+  state->CellMin.resize(this->NumberOfMacrocells);
+  state->CellMax.resize(this->NumberOfMacrocells);
+  state->CellEmpty.resize(this->NumberOfMacrocells);
+
+  int numThreads = this->NumberOfThreads > 0? this->NumberOfThreads :
+    vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  this->Threader->SetNumberOfThreads(numThreads);
+  this->Threader->SetSingleMethod(vtkMacrocellBuildThread, this);
+  this->Threader->SingleMethodExecute();
+
+  state->MacrocellScalars = scalars;
+  state->MacrocellBuildTime.Modified();
+  vtkTimerLog::MarkEndEvent("Build Macrocells");
+}
+
+//----------------------------------------------------------------------------
+void vtkMacrocellVolumeRayCastMapper::BuildMacrocells(int threadId,
+  int numberOfThreads)
+{
+  vtkInternals* state = this->Internals;
+  switch (state->Scalars->GetDataType())
+    {
+    vtkTemplateMacro(vtkMacrocellBuild(state,
+        static_cast<VTK_TT*>(state->ScalarPointer), threadId, numberOfThreads));
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMacrocellVolumeRayCastMapper::UpdateTransferFunctions(vtkVolume* vol,
+  double sampleDistance)
+{
+  vtkInternals* state = this->Internals;
+  vtkVolumeProperty* property = vol->GetProperty();
+
+  double range[2];
+  state->Scalars->GetRange(range, 0);
+  if (range[1] <= range[0])
+    {
+    range[1] = range[0] + 1.0;
+    }
+
+  if (property->GetMTime() < state->TableBuildTime &&
+    state->MacrocellBuildTime < state->TableBuildTime &&
+    state->Range[0] == range[0] && state->Range[1] == range[1] &&
+    state->TableSampleDistance == sampleDistance &&
+    state->TableBlendMode == this->BlendMode)
+    {
+    return;
+    }
+
+  state->Range[0] = range[0];
+  state->Range[1] = range[1];
+  state->TableScale = (TABLE_SIZE-1)/(range[1] - range[0]);
+  state->TableSampleDistance = sampleDistance;
+  state->TableBlendMode = this->BlendMode;
+
+  if (property->GetColorChannels(0) == 1)
+    {
+    float gray[TABLE_SIZE];
+    property->GetGrayTransferFunction(0)->GetTable(
+      range[0], range[1], TABLE_SIZE, gray);
+    for (int i=0; i < TABLE_SIZE; i++)
+      {
+      state->ColorTable[3*i] = state->ColorTable[3*i+1] =
+        state->ColorTable[3*i+2] = gray[i];
+      }
+    }
+  else
+    {
+    property->GetRGBTransferFunction(0)->GetTable(
+      range[0], range[1], TABLE_SIZE, state->ColorTable);
+    }
+
+  // Opacities are given per unit distance, correct them for the sample
+  // distance.
+  property->GetScalarOpacity(0)->GetTable(
+    range[0], range[1], TABLE_SIZE, state->OpacityTable);
+  double unitDistance = property->GetScalarOpacityUnitDistance(0);
+  double exponent = sampleDistance/(unitDistance > 0.0? unitDistance : 1.0);
+  state->NonZeroOpacityCount[0] = 0;
+  for (int i=0; i < TABLE_SIZE; i++)
+    {
+    float opacity = state->OpacityTable[i];
+    opacity = opacity < 0.0f? 0.0f : (opacity > 1.0f? 1.0f : opacity);
+    if (this->BlendMode == vtkVolumeMapper::COMPOSITE_BLEND)
+      {
+      opacity = static_cast<float>(1.0 - pow(1.0 - opacity, exponent));
+      }
+    state->OpacityTable[i] = opacity;
+    state->NonZeroOpacityCount[i+1] =
+      state->NonZeroOpacityCount[i] + (opacity > 0.0f? 1 : 0);
+    }
+
+  // A macrocell is empty when no value within its range has any opacity.
+  this->NumberOfEmptyMacrocells = 0;
+  vtkIdType numCells = static_cast<vtkIdType>(state->CellEmpty.size());
+  for (vtkIdType cc=0; cc < numCells; cc++)
+    {
+    int low = state->TableIndex(state->CellMin[cc]);
+    int high = state->TableIndex(state->CellMax[cc]);
+    bool empty = (this->BlendMode == vtkVolumeMapper::COMPOSITE_BLEND) &&
+      (state->NonZeroOpacityCount[high+1] == state->NonZeroOpacityCount[low]);
+    state->CellEmpty[cc] = empty? 1 : 0;
+    this->NumberOfEmptyMacrocells += empty? 1 : 0;
+    }
+  state->TableBuildTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+bool vtkMacrocellVolumeRayCastMapper::ComputeRayGeometry(vtkRenderer* ren,
+  vtkVolume* vol)
+{
+  vtkInternals* state = this->Internals;
+
+  int width, height, x0, y0;
+  ren->GetTiledSizeAndOrigin(&width, &height, &x0, &y0);
+  if (width < 1 || height < 1)
+    {
+    return false;
+    }
+  state->ImageSampleDistance = this->Interactive?
+    this->InteractiveImageSampleDistance : this->ImageSampleDistance;
+  state->ImageViewportSize[0] =
+    static_cast<int>(width/state->ImageSampleDistance);
+  state->ImageViewportSize[1] =
+    static_cast<int>(height/state->ImageSampleDistance);
+  state->ImageViewportSize[0] = state->ImageViewportSize[0] < 1? 1 :
+    state->ImageViewportSize[0];
+  state->ImageViewportSize[1] = state->ImageViewportSize[1] < 1? 1 :
+    state->ImageViewportSize[1];
+
+  // index -> volume coordinates -> world -> normalized device coordinates.
+  double indexToLocal[16] = {
+    state->Spacing[0], 0, 0, state->Origin[0],
+    0, state->Spacing[1], 0, state->Origin[1],
+    0, 0, state->Spacing[2], state->Origin[2],
+    0, 0, 0, 1 };
+  vtkMatrix4x4* projection =
+    ren->GetActiveCamera()->GetCompositeProjectionTransformMatrix(
+      ren->GetTiledAspectRatio(), -1, 1);
+  double localToNDC[16], indexToNDC[16];
+  vtkMatrix4x4::Multiply4x4(&projection->Element[0][0],
+    &vol->GetMatrix()->Element[0][0], localToNDC);
+  vtkMatrix4x4::Multiply4x4(localToNDC, indexToLocal, indexToNDC);
+  vtkMatrix4x4::Invert(indexToNDC, state->NDCToIndex);
+
+  // Project the corners of the volume to find the part of the image it
+  // covers and how close it gets to the viewer.
+  double bounds[4] = { 1.0, 1.0, -1.0, -1.0 };
+  double minZ = 1.0;
+  for (int cc=0; cc < 8; cc++)
+    {
+    double corner[4] = {
+      (cc & 1)? state->Dimensions[0]-1 : 0,
+      (cc & 2)? state->Dimensions[1]-1 : 0,
+      (cc & 4)? state->Dimensions[2]-1 : 0,
+      1.0 };
+    double p[4];
+    vtkMatrix4x4::MultiplyPoint(indexToNDC, corner, p);
+    if (p[3] <= 0.0)
+      {
+      // Part of the volume is behind the viewer.
+      bounds[0] = bounds[1] = -1.0;
+      bounds[2] = bounds[3] = 1.0;
+      minZ = -1.0;
+      break;
+      }
+    bounds[0] = (p[0]/p[3] < bounds[0])? p[0]/p[3] : bounds[0];
+    bounds[1] = (p[1]/p[3] < bounds[1])? p[1]/p[3] : bounds[1];
+    bounds[2] = (p[0]/p[3] > bounds[2])? p[0]/p[3] : bounds[2];
+    bounds[3] = (p[1]/p[3] > bounds[3])? p[1]/p[3] : bounds[3];
+    minZ = (p[2]/p[3] < minZ)? p[2]/p[3] : minZ;
+    }
+
+  int rect[4];
+  for (int cc=0; cc < 4; cc++)
+    {
+    int size = state->ImageViewportSize[cc%2];
+    double v = (bounds[cc] + 1.0)*0.5*size;
+    v = (cc < 2)? floor(v) : ceil(v);
+    v = v < 0? 0 : (v > size? size : v);
+    rect[cc] = static_cast<int>(v);
+    }
+  if (rect[2] <= rect[0] || rect[3] <= rect[1])
+    {
+    return false;
+    }
+  state->ImageOrigin[0] = rect[0];
+  state->ImageOrigin[1] = rect[1];
+  state->ImageInUseSize[0] = rect[2] - rect[0];
+  state->ImageInUseSize[1] = rect[3] - rect[1];
+  for (int cc=0; cc < 2; cc++)
+    {
+    state->ImageMemorySize[cc] = 32;
+    while (state->ImageMemorySize[cc] < state->ImageInUseSize[cc])
+      {
+      state->ImageMemorySize[cc] *= 2;
+      }
+    }
+  state->Image.resize(4*state->ImageMemorySize[0]*state->ImageMemorySize[1]);
+
+  double depth = (minZ + 1.0)*0.5;
+  state->MinimumDepth = static_cast<float>(
+    depth < 0.001? 0.001 : (depth > 0.999? 0.999 : depth));
+
+  state->ZBuffer = 0;
+  if (this->IntermixIntersectingGeometry)
+    {
+    state->ZBuffer = ren->GetRenderWindow()->GetZbufferData(
+      x0, y0, x0 + width - 1, y0 + height - 1);
+    state->ZBufferSize[0] = width;
+    state->ZBufferSize[1] = height;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkMacrocellVolumeRayCastMapper::CastRays(int threadId,
+  int numberOfThreads)
+{
+  vtkInternals* state = this->Internals;
+  switch (state->Scalars->GetDataType())
+    {
+    vtkTemplateMacro(vtkMacrocellCastTiles(state,
+        static_cast<VTK_TT*>(state->ScalarPointer), threadId, numberOfThreads));
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkMacrocellVolumeRayCastMapper::Render(vtkRenderer* ren, vtkVolume* vol)
+{
+  vtkImageData* input = this->GetInput();
+  if (!input)
+    {
+    return;
+    }
+  double startTime = vtkTimerLog::GetUniversalTime();
+
+  input->UpdateInformation();
+  input->SetUpdateExtentToWholeExtent();
+  input->Update();
+
+  int cellFlag = 0;
+  vtkDataArray* scalars = this->GetScalars(input, this->ScalarMode,
+    this->ArrayAccessMode, this->ArrayId, this->ArrayName, cellFlag);
+  if (!scalars || scalars->GetNumberOfTuples() == 0)
+    {
+    vtkErrorMacro("Can't use the macrocell ray cast mapper without scalars!");
+    return;
+    }
+
+  vtkInternals* state = this->Internals;
+  this->UpdateMacrocells(input, scalars, cellFlag);
+  if (state->Dimensions[0] < 2 || state->Dimensions[1] < 2 ||
+    state->Dimensions[2] < 2)
+    {
+    return;
+    }
+
+  double sampleDistance = this->SampleDistance;
+  if (sampleDistance <= 0.0)
+    {
+    double* spacing = state->Spacing;
+    sampleDistance = spacing[0] < spacing[1]? spacing[0] : spacing[1];
+    sampleDistance = 0.5*(sampleDistance < spacing[2]? sampleDistance :
+      spacing[2]);
+    }
+  if (this->Interactive)
+    {
+    sampleDistance *= this->InteractiveSampleDistanceFactor;
+    }
+  state->SampleDistance = sampleDistance;
+  state->BlendMode = this->BlendMode;
+
+  this->UpdateTransferFunctions(vol, sampleDistance);
+  if (!this->ComputeRayGeometry(ren, vol))
+    {
+    return;
+    }
+
+  vtkTimerLog::MarkStartEvent("Macrocell Ray Cast");
+  int numThreads = this->NumberOfThreads > 0? this->NumberOfThreads :
+    vtkMultiThreader::GetGlobalDefaultNumberOfThreads();
+  this->Threader->SetNumberOfThreads(numThreads);
+  this->Threader->SetSingleMethod(vtkMacrocellCastRaysThread, this);
+  this->Threader->SingleMethodExecute();
+  vtkTimerLog::MarkEndEvent("Macrocell Ray Cast");
+
+  delete [] state->ZBuffer;
+  state->ZBuffer = 0;
+
+  this->ImageDisplayHelper->RenderTexture(vol, ren,
+    state->ImageMemorySize, state->ImageViewportSize, state->ImageInUseSize,
+    state->ImageOrigin, state->MinimumDepth, &state->Image[0]);
+
+  vtkTimerLog::FormatAndMarkEvent(
+    "Macrocell ray cast: %d of %d macrocells empty",
+    static_cast<int>(this->NumberOfEmptyMacrocells),
+    static_cast<int>(this->NumberOfMacrocells));
+
+  this->TimeToDraw = vtkTimerLog::GetUniversalTime() - startTime;
+}
+
+//----------------------------------------------------------------------------
+void vtkMacrocellVolumeRayCastMapper::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "SampleDistance: " << this->SampleDistance << endl;
+  os << indent << "ImageSampleDistance: " << this->ImageSampleDistance << endl;
+  os << indent << "InteractiveImageSampleDistance: "
+    << this->InteractiveImageSampleDistance << endl;
+  os << indent << "InteractiveSampleDistanceFactor: "
+    << this->InteractiveSampleDistanceFactor << endl;
+  os << indent << "Interactive: " << this->Interactive << endl;
+  os << indent << "MacrocellSize: " << this->MacrocellSize << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
+  os << indent << "IntermixIntersectingGeometry: "
+    << this->IntermixIntersectingGeometry << endl;
+  os << indent << "NumberOfMacrocells: " << this->NumberOfMacrocells << endl;
+  os << indent << "NumberOfEmptyMacrocells: "
+    << this->NumberOfEmptyMacrocells << endl;
+}
@@ -0,0 +1,168 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkMacrocellVolumeRayCastMapper.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkMacrocellVolumeRayCastMapper - software ray caster for image data
+// with empty-space skipping.
+// .SECTION Description
+// vtkMacrocellVolumeRayCastMapper is a CPU-only volume mapper meant for
+// render servers without graphics hardware. The volume is split into
+// macrocells of MacrocellSize^3 voxels. The min/max scalar of every
+// macrocell is computed once per data update. Each render, the cells
+// whose scalar range maps to zero opacity are flagged as empty, and rays
+// jump over them. Rays stop once they are opaque (early ray termination).
+// Maximum and minimum intensity projections skip the cells that cannot
+// change the result.
+//
+// Rays are cast in parallel over tiles of the image. The depth buffer is
+// honored so that opaque geometry correctly hides the volume.
+//
+// When Interactive is set (vtkPVLODVolume does so for interactive renders),
+// the InteractiveImageSampleDistance and InteractiveSampleDistanceFactor are
+// used, trading image quality for speed.
+//
+// Only the first component of the selected scalars is rendered, without
+// shading or gradient opacity.
+// .SECTION See Also
+// vtkPVLODVolume vtkFixedPointVolumeRayCastMapper
+
+#ifndef __vtkMacrocellVolumeRayCastMapper_h
+#define __vtkMacrocellVolumeRayCastMapper_h
+
+#include "vtkVolumeMapper.h"
+
+class vtkMultiThreader;
+class vtkRayCastImageDisplayHelper;
+class vtkDataArray;
+
+class VTK_EXPORT vtkMacrocellVolumeRayCastMapper : public vtkVolumeMapper
+{
+public:
+  static vtkMacrocellVolumeRayCastMapper* New();
+  vtkTypeMacro(vtkMacrocellVolumeRayCastMapper, vtkVolumeMapper);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Distance between samples along a ray, in world coordinates. When 0 (the
+  // default), half the smallest spacing of the input is used.
+  vtkSetClampMacro(SampleDistance, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(SampleDistance, double);
+
+  // Description:
+  // Distance between rays in pixels for still renders. Default is 1.
+  vtkSetClampMacro(ImageSampleDistance, double, 1.0, 32.0);
+  vtkGetMacro(ImageSampleDistance, double);
+
+  // Description:
+  // Distance between rays in pixels for interactive renders. Default is 2.
+  vtkSetClampMacro(InteractiveImageSampleDistance, double, 1.0, 32.0);
+  vtkGetMacro(InteractiveImageSampleDistance, double);
+
+  // Description:
+  // Factor applied to the sample distance for interactive renders. Default
+  // is 2.
+  vtkSetClampMacro(InteractiveSampleDistanceFactor, double, 1.0, 16.0);
+  vtkGetMacro(InteractiveSampleDistanceFactor, double);
+
+  // Description:
+  // Set when the next renders are interactive.
+  vtkSetMacro(Interactive, int);
+  vtkGetMacro(Interactive, int);
+  vtkBooleanMacro(Interactive, int);
+
+  // Description:
+  // Number of voxels along each side of a macrocell. Smaller cells skip
+  // more empty space but cost more to classify and traverse. Default is 8.
+  vtkSetClampMacro(MacrocellSize, int, 2, 64);
+  vtkGetMacro(MacrocellSize, int);
+
+  // Description:
+  // Number of threads used to cast rays. 0 (default) uses
+  // vtkMultiThreader::GetGlobalDefaultNumberOfThreads().
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_MAX_THREADS);
+  vtkGetMacro(NumberOfThreads, int);
+
+  // Description:
+  // When on (default), rays stop at the opaque geometry found in the depth
+  // buffer.
+  vtkSetMacro(IntermixIntersectingGeometry, int);
+  vtkGetMacro(IntermixIntersectingGeometry, int);
+  vtkBooleanMacro(IntermixIntersectingGeometry, int);
+
+  // Description:
+  // Statistics of the last render: the number of macrocells and how many of
+  // them were classified as empty.
+  vtkGetMacro(NumberOfMacrocells, vtkIdType);
+  vtkGetMacro(NumberOfEmptyMacrocells, vtkIdType);
+
+//BTX
+  // Description:
+  // WARNING: INTERNAL METHOD - NOT INTENDED FOR GENERAL USE
+  // Initialize rendering for this volume.
+  virtual void Render(vtkRenderer*, vtkVolume*);
+
+  // Description:
+  // WARNING: INTERNAL METHOD - NOT INTENDED FOR GENERAL USE
+  // Release any graphics resources that are being consumed by this mapper.
+  virtual void ReleaseGraphicsResources(vtkWindow*);
+
+  // Description:
+  // Internal callbacks for the threads. Don't call directly.
+  void CastRays(int threadId, int numberOfThreads);
+  void BuildMacrocells(int threadId, int numberOfThreads);
+
+protected:
+  vtkMacrocellVolumeRayCastMapper();
+  ~vtkMacrocellVolumeRayCastMapper();
+
+  // Description:
+  // Rebuilds the macrocell min/max grid when the scalars changed.
+  void UpdateMacrocells(vtkImageData* input, vtkDataArray* scalars,
+    int cellFlag);
+
+  // Description:
+  // Rebuilds the color and opacity lookup tables for the scalar range and
+  // sample distance, and flags empty macrocells.
+  void UpdateTransferFunctions(vtkVolume* vol, double sampleDistance);
+
+  // Description:
+  // Computes the part of the image covered by the volume and the matrix
+  // mapping normalized device coordinates to the volume's index space.
+  // Returns false when the volume is not visible.
+  bool ComputeRayGeometry(vtkRenderer* ren, vtkVolume* vol);
+
+  double SampleDistance;
+  double ImageSampleDistance;
+  double InteractiveImageSampleDistance;
+  double InteractiveSampleDistanceFactor;
+  int Interactive;
+  int MacrocellSize;
+  int NumberOfThreads;
+  int IntermixIntersectingGeometry;
+
+  vtkIdType NumberOfMacrocells;
+  vtkIdType NumberOfEmptyMacrocells;
+
+  vtkMultiThreader* Threader;
+  vtkRayCastImageDisplayHelper* ImageDisplayHelper;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+
+private:
+  vtkMacrocellVolumeRayCastMapper(const vtkMacrocellVolumeRayCastMapper&); // Not implemented
+  void operator=(const vtkMacrocellVolumeRayCastMapper&); // Not implemented
+//ETX
+};
+
+#endif
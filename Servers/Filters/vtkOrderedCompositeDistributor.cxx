@@ -26,19 +26,396 @@
 
 #include "vtkBSPCuts.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCommunicator.h"
 #include "vtkDataSet.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkDataSetSurfaceFilter.h"
 #include "vtkDistributedDataFilter.h"
 #include "vtkGarbageCollector.h"
 #include "vtkInformation.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkInformationVector.h"
+#include "vtkIntArray.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessControllerHelper.h"
 #include "vtkObjectFactory.h"
 #include "vtkPKdTree.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
 #include "vtkPolyData.h"
+#include "vtkTimerLog.h"
+#include "vtkType.h"
+#include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
 
+#include <vtkstd/string>
+#include <vtkstd/vector>
+
+#include <vtksys/ios/sstream>
+
+// Names of the arrays used to track where the output cells/points come from.
+static const char *vtkOCDOriginalProcess
+  = "vtkOrderedCompositeDistributorOriginalProcess";
+static const char *vtkOCDOriginalId
+  = "vtkOrderedCompositeDistributorOriginalId";
+
+// Values exchanged to decide what kind of update is needed.
+enum
+{
+  UPDATE_NONE = 0,
+  UPDATE_ATTRIBUTES,
+  UPDATE_ALL
+};
+
+// Which local elements go to which process and where the elements received
+// from each process go in the output.
+struct vtkOCDSendList
+{
+  vtkstd::vector<vtkstd::vector<vtkIdType> > Send;
+  vtkstd::vector<vtkstd::vector<vtkIdType> > Receive;
+  vtkIdType NumberOfOutputElements;
+};
+
+class vtkOrderedCompositeDistributor::vtkSendPlan
+{
+public:
+  vtkSendPlan() : Valid(false), PointsValid(false) {}
+
+  bool Valid;
+  // Splitting boundary cells creates points whose attributes are
+  // interpolated, origin arrays included. The point plan is only used when
+  // every output point is an input point.
+  bool PointsValid;
+  vtkOCDSendList Cells;
+  vtkOCDSendList Points;
+
+  // Identify the input topology and attribute layout the plan was built for.
+  vtkstd::vector<vtkTypeUInt64> TopologyStamp;
+  vtkstd::string Layout;
+};
+
+//-----------------------------------------------------------------------------
+// Offset basis and prime of the 64 bit FNV-1a checksum.
+static const vtkTypeUInt64 vtkOCDChecksumBasis =
+  (static_cast<vtkTypeUInt64>(0xcbf29ce4) << 32) | 0x84222325;
+static const vtkTypeUInt64 vtkOCDChecksumPrime =
+  (static_cast<vtkTypeUInt64>(0x100) << 32) | 0x1b3;
+
+// Adds the bytes to a 64 bit FNV-1a checksum.
+static void vtkOCDChecksum(vtkTypeUInt64 &checksum, const void *data,
+                           size_t size)
+{
+  const unsigned char *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; i++)
+    {
+    checksum ^= bytes[i];
+    checksum *= vtkOCDChecksumPrime;
+    }
+}
+
+//-----------------------------------------------------------------------------
+static void vtkOCDChecksumArray(vtkTypeUInt64 &checksum, vtkDataArray *array)
+{
+  if (!array)
+    {
+    vtkOCDChecksum(checksum, "", 1);
+    return;
+    }
+  int type = array->GetDataType();
+  vtkOCDChecksum(checksum, &type, sizeof(type));
+  vtkOCDChecksum(checksum, array->GetVoidPointer(0),
+                 static_cast<size_t>(array->GetNumberOfTuples()) *
+                 array->GetNumberOfComponents() * array->GetDataTypeSize());
+}
+
+//-----------------------------------------------------------------------------
+// Identifies the geometry and topology of the data by their content, so that
+// the plan is reused when an upstream filter regenerates the same points and
+// cells (in new arrays or a new data object) and only the attributes differ.
+static void vtkOCDGetTopologyStamp(vtkDataSet *data,
+                                   vtkstd::vector<vtkTypeUInt64> &stamp)
+{
+  stamp.clear();
+  stamp.push_back(static_cast<vtkTypeUInt64>(data->GetDataObjectType()));
+  stamp.push_back(static_cast<vtkTypeUInt64>(data->GetNumberOfPoints()));
+  stamp.push_back(static_cast<vtkTypeUInt64>(data->GetNumberOfCells()));
+
+  vtkTypeUInt64 checksum = vtkOCDChecksumBasis;
+  vtkPointSet *ps = vtkPointSet::SafeDownCast(data);
+  if (ps)
+    {
+    vtkOCDChecksumArray(checksum,
+                        ps->GetPoints()? ps->GetPoints()->GetData() : NULL);
+    }
+  else
+    {
+    double x[3];
+    for (vtkIdType i = 0; i < data->GetNumberOfPoints(); i++)
+      {
+      data->GetPoint(i, x);
+      vtkOCDChecksum(checksum, x, sizeof(x));
+      }
+    }
+
+  vtkPolyData *pd = vtkPolyData::SafeDownCast(data);
+  vtkUnstructuredGrid *ug = vtkUnstructuredGrid::SafeDownCast(data);
+  if (pd)
+    {
+    vtkCellArray *cells[4] = { pd->GetVerts(), pd->GetLines(),
+                               pd->GetPolys(), pd->GetStrips() };
+    for (int i = 0; i < 4; i++)
+      {
+      vtkOCDChecksumArray(checksum, cells[i]? cells[i]->GetData() : NULL);
+      }
+    }
+  else if (ug)
+    {
+    vtkOCDChecksumArray(checksum,
+                        ug->GetCells()? ug->GetCells()->GetData() : NULL);
+    vtkOCDChecksumArray(checksum, ug->GetCellTypesArray());
+    }
+  else
+    {
+    vtkIdList *ptIds = vtkIdList::New();
+    for (vtkIdType i = 0; i < data->GetNumberOfCells(); i++)
+      {
+      int type = data->GetCellType(i);
+      vtkOCDChecksum(checksum, &type, sizeof(type));
+      data->GetCellPoints(i, ptIds);
+      vtkOCDChecksum(checksum, ptIds->GetPointer(0),
+                     ptIds->GetNumberOfIds() * sizeof(vtkIdType));
+      }
+    ptIds->Delete();
+    }
+  stamp.push_back(checksum);
+}
+
+//-----------------------------------------------------------------------------
+// Describes the arrays of the attributes. Returns false if some array cannot
+// be sent with the plan.
+static bool vtkOCDGetLayout(vtkDataSetAttributes *attributes,
+                            vtksys_ios::ostringstream &layout)
+{
+  for (int i = 0; i < attributes->GetNumberOfArrays(); i++)
+    {
+    vtkAbstractArray *array = attributes->GetAbstractArray(i);
+    if (!vtkDataArray::SafeDownCast(array))
+      {
+      return false;
+      }
+    layout << (array->GetName()? array->GetName() : "") << ";"
+           << array->GetDataType() << ";"
+           << array->GetNumberOfComponents() << ";";
+    }
+  layout << "|";
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+static unsigned long vtkOCDHash(const vtkstd::string &str)
+{
+  unsigned long hash = 5381;
+  for (size_t i = 0; i < str.size(); i++)
+    {
+    hash = hash * 33 + static_cast<unsigned char>(str[i]);
+    }
+  return hash;
+}
+
+//-----------------------------------------------------------------------------
+static void vtkOCDAddOriginArrays(vtkDataSetAttributes *attributes,
+                                  vtkIdType numElements, int processId)
+{
+  vtkIntArray *procs = vtkIntArray::New();
+  procs->SetName(vtkOCDOriginalProcess);
+  procs->SetNumberOfTuples(numElements);
+  vtkIdTypeArray *ids = vtkIdTypeArray::New();
+  ids->SetName(vtkOCDOriginalId);
+  ids->SetNumberOfTuples(numElements);
+  for (vtkIdType i = 0; i < numElements; i++)
+    {
+    procs->SetValue(i, processId);
+    ids->SetValue(i, i);
+    }
+  attributes->AddArray(procs);
+  attributes->AddArray(ids);
+  procs->Delete();
+  ids->Delete();
+}
+
+//-----------------------------------------------------------------------------
+// Builds the send list from the origin arrays of the output attributes and
+// removes these arrays. Returns false if the origin of some elements is not
+// known.
+static bool vtkOCDBuildSendList(vtkMultiProcessController *controller,
+                                vtkDataSetAttributes *attributes,
+                                vtkIdType numElements, int tag,
+                                vtkOCDSendList &list)
+{
+  int numProcs = controller->GetNumberOfProcesses();
+  vtkIntArray *procs = vtkIntArray::SafeDownCast(
+                               attributes->GetArray(vtkOCDOriginalProcess));
+  vtkIdTypeArray *ids = vtkIdTypeArray::SafeDownCast(
+                               attributes->GetArray(vtkOCDOriginalId));
+  bool valid = (numElements == 0) ||
+    (procs && ids && procs->GetNumberOfTuples() == numElements &&
+     ids->GetNumberOfTuples() == numElements);
+
+  vtkstd::vector<vtkstd::vector<vtkIdType> > requests(numProcs);
+  list.Receive.assign(numProcs, vtkstd::vector<vtkIdType>());
+  list.NumberOfOutputElements = numElements;
+  for (vtkIdType i = 0; valid && i < numElements; i++)
+    {
+    int proc = procs->GetValue(i);
+    if (proc < 0 || proc >= numProcs)
+      {
+      valid = false;
+      break;
+      }
+    requests[proc].push_back(ids->GetValue(i));
+    list.Receive[proc].push_back(i);
+    }
+  attributes->RemoveArray(vtkOCDOriginalProcess);
+  attributes->RemoveArray(vtkOCDOriginalId);
+
+  // The requests tell every process what to send where.
+  list.Send.clear();
+  vtkMultiProcessControllerHelper::ExchangeAllToAll(controller,
+                                                    requests, list.Send, tag);
+  return valid;
+}
+
+//-----------------------------------------------------------------------------
+// Checks that the output points are the input points the send list says
+// they come from, by sending the coordinates of the points in the list.
+// Points created by splitting boundary cells have interpolated origin ids
+// and fail the check.
+static bool vtkOCDCheckPointOrigins(vtkMultiProcessController *controller,
+                                    vtkDataSet *input, vtkDataSet *output,
+                                    const vtkOCDSendList &list, int tag)
+{
+  int numProcs = controller->GetNumberOfProcesses();
+  vtkIdType numInputPoints = input->GetNumberOfPoints();
+  bool valid = true;
+
+  vtkstd::vector<vtkstd::vector<double> > outgoing(numProcs);
+  vtkstd::vector<vtkstd::vector<double> > incoming;
+  int p;
+  for (p = 0; p < numProcs; p++)
+    {
+    const vtkstd::vector<vtkIdType> &ids = list.Send[p];
+    vtkstd::vector<double> &buffer = outgoing[p];
+    buffer.resize(ids.size()*3, 0.0);
+    for (size_t i = 0; i < ids.size(); i++)
+      {
+      if (ids[i] >= 0 && ids[i] < numInputPoints)
+        {
+        input->GetPoint(ids[i], &buffer[i*3]);
+        }
+      else
+        {
+        valid = false;
+        }
+      }
+    }
+
+  vtkMultiProcessControllerHelper::ExchangeAllToAll(controller,
+                                                    outgoing, incoming, tag);
+
+  for (p = 0; p < numProcs && valid; p++)
+    {
+    const vtkstd::vector<vtkIdType> &ids = list.Receive[p];
+    const vtkstd::vector<double> &buffer = incoming[p];
+    if (buffer.size() != ids.size()*3)
+      {
+      valid = false;
+      break;
+      }
+    for (size_t i = 0; i < ids.size(); i++)
+      {
+      double x[3];
+      output->GetPoint(ids[i], x);
+      if (x[0] != buffer[i*3] || x[1] != buffer[i*3+1] ||
+          x[2] != buffer[i*3+2])
+        {
+        valid = false;
+        break;
+        }
+      }
+    }
+  return valid;
+}
+
+//-----------------------------------------------------------------------------
+// Sends the arrays of input to the processes in the list and adds the
+// received arrays to output.
+static void vtkOCDExchangeArrays(vtkMultiProcessController *controller,
+                                 vtkDataSetAttributes *input,
+                                 vtkDataSetAttributes *output,
+                                 const vtkOCDSendList &list, int tag)
+{
+  int numProcs = controller->GetNumberOfProcesses();
+  int numArrays = input->GetNumberOfArrays();
+
+  // The buffer for each process holds the tuples of each array in turn.
+  vtkstd::vector<vtkstd::vector<double> > outgoing(numProcs);
+  vtkstd::vector<vtkstd::vector<double> > incoming;
+  int p, a;
+  for (p = 0; p < numProcs; p++)
+    {
+    const vtkstd::vector<vtkIdType> &ids = list.Send[p];
+    vtkstd::vector<double> &buffer = outgoing[p];
+    for (a = 0; a < numArrays; a++)
+      {
+      vtkDataArray *array = input->GetArray(a);
+      int numComps = array->GetNumberOfComponents();
+      vtkIdType numTuples = array->GetNumberOfTuples();
+      size_t offset = buffer.size();
+      buffer.resize(offset + ids.size()*numComps, 0.0);
+      for (size_t i = 0; i < ids.size(); i++)
+        {
+        if (ids[i] >= 0 && ids[i] < numTuples)
+          {
+          array->GetTuple(ids[i], &buffer[offset + i*numComps]);
+          }
+        }
+      }
+    }
+
+  vtkMultiProcessControllerHelper::ExchangeAllToAll(controller,
+                                                    outgoing, incoming, tag);
+
+  vtkstd::vector<size_t> positions(numProcs, 0);
+  for (a = 0; a < numArrays; a++)
+    {
+    vtkDataArray *array = input->GetArray(a);
+    int numComps = array->GetNumberOfComponents();
+    vtkDataArray *result = array->NewInstance();
+    result->SetName(array->GetName());
+    result->SetNumberOfComponents(numComps);
+    result->SetNumberOfTuples(list.NumberOfOutputElements);
+    for (p = 0; p < numProcs; p++)
+      {
+      const vtkstd::vector<vtkIdType> &ids = list.Receive[p];
+      const vtkstd::vector<double> &buffer = incoming[p];
+      size_t &pos = positions[p];
+      for (size_t i = 0;
+           i < ids.size() && pos + numComps <= buffer.size(); i++)
+        {
+        result->SetTuple(ids[i], &buffer[pos]);
+        pos += numComps;
+        }
+      }
+    // Arrays with the same name (all of them, since the layout did not
+    // change) are replaced in place, keeping the active attributes.
+    output->AddArray(result);
+    result->Delete();
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 static void D3UpdateProgress(vtkObject *_D3, unsigned long,
@@ -76,12 +453,15 @@ vtkOrderedCompositeDistributor::vtkOrderedCompositeDistributor()
   this->ToPolyData = NULL;
 
   this->PassThrough = 0;
+  this->CacheSendPlan = 1;
 
   this->OutputType = NULL;
 
   this->LastInput = NULL;
   this->LastOutput = NULL;
   this->LastCuts = vtkBSPCuts::New();
+
+  this->Plan = new vtkSendPlan;
 }
 
 vtkOrderedCompositeDistributor::~vtkOrderedCompositeDistributor()
@@ -96,6 +476,8 @@ vtkOrderedCompositeDistributor::~vtkOrderedCompositeDistributor()
 
   if (this->LastOutput) this->LastOutput->Delete();
   if (this->LastCuts) this->LastCuts->Delete();
+
+  delete this->Plan;
 }
 
 void vtkOrderedCompositeDistributor::PrintSelf(ostream &os, vtkIndent indent)
@@ -105,6 +487,7 @@ void vtkOrderedCompositeDistributor::PrintSelf(ostream &os, vtkIndent indent)
   os << indent << "PKdTree: " << this->PKdTree << endl;
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "PassThrough: " << this->PassThrough << endl;
+  os << indent << "CacheSendPlan: " << this->CacheSendPlan << endl;
   os << indent << "OutputType: " << 
     (this->OutputType? this->OutputType : "(none)") << endl;
   os << indent << "D3: " << this->D3 << endl;
@@ -224,13 +607,34 @@ int vtkOrderedCompositeDistributor::RequestData(
     }
 
   // Check to see if update needs to be done (parallel operation), and pass
-  // through old data if not.
-  int needUpdate = 0;
-  if (   (this->LastInput != input)
-      || (this->LastUpdate < input->GetMTime())
-      || !this->LastCuts->Equals(cuts) )
+  // through old data if not. When only the attributes changed, the cached
+  // send plan is enough.
+  int needUpdate = UPDATE_NONE;
+  if (!this->LastCuts->Equals(cuts))
+    {
+    needUpdate = UPDATE_ALL;
+    }
+  else if (this->LastInput != input || this->LastUpdate < input->GetMTime())
     {
-    needUpdate = 1;
+    needUpdate = UPDATE_ALL;
+    // Without a point plan, only cell attributes can be sent. The topology
+    // stamp compares the content of the input, so a new input object with
+    // the same points and cells still uses the plan.
+    if (this->CacheSendPlan && this->Plan->Valid && this->LastOutput &&
+        (this->Plan->PointsValid ||
+         input->GetPointData()->GetNumberOfArrays() == 0))
+      {
+      vtkstd::vector<vtkTypeUInt64> stamp;
+      vtkOCDGetTopologyStamp(input, stamp);
+      vtksys_ios::ostringstream layout;
+      if (stamp == this->Plan->TopologyStamp &&
+          vtkOCDGetLayout(input->GetPointData(), layout) &&
+          vtkOCDGetLayout(input->GetCellData(), layout) &&
+          layout.str() == this->Plan->Layout)
+        {
+        needUpdate = UPDATE_ATTRIBUTES;
+        }
+      }
     }
 
   const int COLLECT_NEED_UPDATE = 25234;
@@ -243,7 +647,10 @@ int vtkOrderedCompositeDistributor::RequestData(
       {
       int remoteNeedUpdate;
       this->Controller->Receive(&remoteNeedUpdate, 1, i, COLLECT_NEED_UPDATE);
-      needUpdate |= remoteNeedUpdate;
+      if (remoteNeedUpdate > needUpdate)
+        {
+        needUpdate = remoteNeedUpdate;
+        }
       }
     for (i = 1; i < numproc; i++)
       {
@@ -256,12 +663,26 @@ int vtkOrderedCompositeDistributor::RequestData(
     this->Controller->Receive(&needUpdate, 1, 0, BROADCAST_NEED_UPDATE);
     }
 
-  if (!needUpdate)
+  if (needUpdate == UPDATE_NONE)
     {
     output->ShallowCopy(this->LastOutput);
     return 1;
     }
 
+  if (needUpdate == UPDATE_ATTRIBUTES)
+    {
+    vtkTimerLog::MarkStartEvent("vtkOrderedCompositeDistributor::ExchangeAttributes");
+    this->ExchangeAttributes(input, output);
+    vtkTimerLog::MarkEndEvent("vtkOrderedCompositeDistributor::ExchangeAttributes");
+
+    this->LastUpdate.Modified();
+    this->LastInput = input;
+    this->LastOutput->ShallowCopy(output);
+    return 1;
+    }
+
+  this->Plan->Valid = false;
+
   this->UpdateProgress(0.01);
 
   if (this->D3 == NULL)
@@ -274,8 +695,22 @@ int vtkOrderedCompositeDistributor::RequestData(
   cbc->SetCallback(D3UpdateProgress);
   this->D3->AddObserver(vtkCommand::ProgressEvent, cbc);
 
+  // Tag the cells and points with their origin to be able to build the send
+  // plan from the output.
+  vtkDataSet *d3Input = input;
+  if (this->CacheSendPlan)
+    {
+    d3Input = input->NewInstance();
+    d3Input->ShallowCopy(input);
+    int myId = this->Controller->GetLocalProcessId();
+    vtkOCDAddOriginArrays(d3Input->GetCellData(),
+                          d3Input->GetNumberOfCells(), myId);
+    vtkOCDAddOriginArrays(d3Input->GetPointData(),
+                          d3Input->GetNumberOfPoints(), myId);
+    }
+
   this->D3->SetBoundaryModeToSplitBoundaryCells();
-  this->D3->SetInput(input);
+  this->D3->SetInput(d3Input);
   this->D3->SetCuts(cuts);
   this->D3->SetController(this->Controller);
   this->D3->Modified();
@@ -284,6 +719,11 @@ int vtkOrderedCompositeDistributor::RequestData(
   this->D3->RemoveObserver(cbc);
   cbc->Delete();
 
+  if (d3Input != input)
+    {
+    d3Input->Delete();
+    }
+
   if (output->IsA("vtkUnstructuredGrid"))
     {
     output->ShallowCopy(this->D3->GetOutput());
@@ -306,6 +746,11 @@ int vtkOrderedCompositeDistributor::RequestData(
     return 0;
     }
 
+  if (this->CacheSendPlan)
+    {
+    this->BuildSendPlan(input, output);
+    }
+
   this->LastUpdate.Modified();
   this->LastInput = input;
   this->LastCuts->CreateCuts(cuts->GetKdNodeTree());
@@ -323,3 +768,60 @@ int vtkOrderedCompositeDistributor::RequestData(
 
   return 1;
 }
+
+//-----------------------------------------------------------------------------
+void vtkOrderedCompositeDistributor::BuildSendPlan(vtkDataSet *input,
+                                                   vtkDataSet *output)
+{
+  const int CELL_REQUESTS = 25236;
+  const int POINT_REQUESTS = 25237;
+  const int POINT_COORDINATES = 25240;
+
+  vtkSendPlan *plan = this->Plan;
+  bool valid = vtkOCDBuildSendList(this->Controller, output->GetCellData(),
+                                   output->GetNumberOfCells(), CELL_REQUESTS,
+                                   plan->Cells);
+  bool pointsValid = vtkOCDBuildSendList(this->Controller,
+                                         output->GetPointData(),
+                                         output->GetNumberOfPoints(),
+                                         POINT_REQUESTS, plan->Points);
+  // All processes take part in the exchange, even if their list is invalid.
+  pointsValid = vtkOCDCheckPointOrigins(this->Controller, input, output,
+                                        plan->Points, POINT_COORDINATES) &&
+    pointsValid;
+
+  vtkOCDGetTopologyStamp(input, plan->TopologyStamp);
+  vtksys_ios::ostringstream layout;
+  valid = vtkOCDGetLayout(input->GetPointData(), layout) &&
+    vtkOCDGetLayout(input->GetCellData(), layout) && valid;
+  plan->Layout = layout.str();
+
+  // The attributes are exchanged array by array, so all processes must have
+  // the same arrays for the plan to be usable.
+  unsigned long local[3] = { vtkOCDHash(plan->Layout), valid? 0 : 1,
+                             pointsValid? 0 : 1 };
+  unsigned long maximum[3], minimum[3];
+  this->Controller->AllReduce(local, maximum, 3, vtkCommunicator::MAX_OP);
+  this->Controller->AllReduce(local, minimum, 3, vtkCommunicator::MIN_OP);
+  plan->Valid = (maximum[1] == 0 && maximum[0] == minimum[0]);
+  plan->PointsValid = plan->Valid && maximum[2] == 0;
+}
+
+//-----------------------------------------------------------------------------
+void vtkOrderedCompositeDistributor::ExchangeAttributes(vtkDataSet *input,
+                                                        vtkDataSet *output)
+{
+  const int CELL_ATTRIBUTES = 25238;
+  const int POINT_ATTRIBUTES = 25239;
+
+  output->ShallowCopy(this->LastOutput);
+  vtkOCDExchangeArrays(this->Controller, input->GetCellData(),
+                       output->GetCellData(), this->Plan->Cells,
+                       CELL_ATTRIBUTES);
+  if (this->Plan->PointsValid)
+    {
+    vtkOCDExchangeArrays(this->Controller, input->GetPointData(),
+                         output->GetPointData(), this->Plan->Points,
+                         POINT_ATTRIBUTES);
+    }
+}
@@ -35,6 +35,18 @@
 // This class also has an optional pass through mode to make it easy to
 // turn ordered compositing on and off.
 //
+// When CacheSendPlan is on, the distributor remembers where every output cell
+// and point came from. As long as the input topology and the cuts do not
+// change (e.g. when animating a dataset whose attributes vary over time),
+// only the attribute arrays are sent using that plan instead of
+// redistributing the whole dataset. The topology is compared by content
+// (counts and a checksum of the points and cells), so the plan is also used
+// when the input is a new data object or has new point and cell arrays with
+// the same values. Points created by splitting boundary
+// cells have interpolated attributes that the plan cannot reproduce; when
+// there are such points, the plan is only used for inputs without point
+// attributes.
+//
 
 #ifndef __vtkOrderedCompositeDistributor_h
 #define __vtkOrderedCompositeDistributor_h
@@ -76,6 +88,14 @@ public:
   vtkSetStringMacro(OutputType);
   vtkGetStringMacro(OutputType);
 
+  // Description:
+  // When on (the default), the cell/point send plan computed by the last
+  // redistribution is reused to send only the attributes when the input
+  // topology and the cuts did not change.
+  vtkSetMacro(CacheSendPlan, int);
+  vtkGetMacro(CacheSendPlan, int);
+  vtkBooleanMacro(CacheSendPlan, int);
+
   // Description:
   // Set/get some internal filters.
   vtkGetObjectMacro(D3, vtkDistributedDataFilter);
@@ -94,6 +114,7 @@ protected:
   vtkDataSetSurfaceFilter *ToPolyData;
 
   int PassThrough;
+  int CacheSendPlan;
 
   int FillInputPortInformation(int port, vtkInformation *info);
 
@@ -104,6 +125,16 @@ protected:
 
   virtual void ReportReferences(vtkGarbageCollector *collector);
 
+  // Description:
+  // Builds the send plan from the origin arrays of the output and removes
+  // them from the output. Collective.
+  void BuildSendPlan(vtkDataSet *input, vtkDataSet *output);
+
+  // Description:
+  // Fills output with the structure of the last output and the attributes of
+  // the input sent using the cached plan. Collective.
+  void ExchangeAttributes(vtkDataSet *input, vtkDataSet *output);
+
   char *OutputType;
 
   vtkDataSet *LastInput;
@@ -114,6 +145,11 @@ protected:
 private:
   vtkOrderedCompositeDistributor(const vtkOrderedCompositeDistributor &);  // Not implemented.
   void operator=(const vtkOrderedCompositeDistributor &);  // Not implemented.
+
+//BTX
+  class vtkSendPlan;
+  vtkSendPlan *Plan;
+//ETX
 };
 
 #endif //__vtkOrderedCompositeDistributor_h
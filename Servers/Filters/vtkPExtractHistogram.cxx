@@ -33,6 +33,7 @@
 #endif
 
 #include <vtkstd/string>
+#include <vtkstd/vector>
 #include <vtksys/RegularExpression.hxx>
 
 vtkStandardNewMacro(vtkPExtractHistogram);
@@ -181,6 +182,49 @@ bool vtkPExtractHistogram::InitializeBinExtents(
 #endif
 }
 
+//-----------------------------------------------------------------------------
+void vtkPExtractHistogram::GatherBinningSamples(
+  vtkstd::vector<double>& samples)
+{
+  if (!this->Controller || this->Controller->GetNumberOfProcesses() <= 1)
+    {
+    return;
+    }
+#ifdef VTK_USE_MPI
+  vtkMPICommunicator* comm = vtkMPICommunicator::SafeDownCast(
+    this->Controller->GetCommunicator());
+  if (!comm)
+    {
+    vtkErrorMacro("vtkMPICommunicator is needed.");
+    return;
+    }
+
+  int num_processes = this->Controller->GetNumberOfProcesses();
+  vtkIdType my_length = static_cast<vtkIdType>(samples.size());
+  vtkstd::vector<vtkIdType> lengths(num_processes);
+  vtkstd::vector<vtkIdType> offsets(num_processes);
+  comm->AllGather(&my_length, &lengths[0], 1);
+
+  vtkIdType total_size = 0;
+  for (int cc=0; cc < num_processes; cc++)
+    {
+    offsets[cc] = total_size;
+    total_size += lengths[cc];
+    }
+  if (total_size == 0)
+    {
+    return;
+    }
+
+  // The sample holds (value, weight) pairs, so does the gathered one.
+  vtkstd::vector<double> gathered(total_size);
+  double dummy = 0.0;
+  comm->AllGatherV(my_length > 0 ? &samples[0] : &dummy, &gathered[0],
+    my_length, &lengths[0], &offsets[0]);
+  samples.swap(gathered);
+#endif
+}
+
 //-----------------------------------------------------------------------------
 int vtkPExtractHistogram::RequestData(vtkInformation *request,
   vtkInformationVector **inputVector, vtkInformationVector *outputVector)
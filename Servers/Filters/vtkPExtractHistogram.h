@@ -15,7 +15,9 @@
 // .NAME vtkPExtractHistogram - Extract histogram for parallel dataset.
 // .SECTION Description
 // vtkPExtractHistogram is vtkExtractHistogram subclass for parallel datasets.
-// It gathers the histogram data on the root node.
+// It gathers the histogram data on the root node. With the adaptive binning
+// modes, the regular samples of the sorted values of all processes are
+// exchanged so that every process computes the same bin edges in one pass.
 
 #ifndef __vtkPExtractHistogram_h
 #define __vtkPExtractHistogram_h
@@ -52,6 +54,11 @@ protected:
     vtkInformationVector** inputVector, vtkDoubleArray* bin_extents,
     double& min, double& max);
 
+//BTX
+  // Replace the local samples with the samples of all processes.
+  virtual void GatherBinningSamples(vtkstd::vector<double>& samples);
+//ETX
+
   vtkMultiProcessController* Controller;
 private:
   vtkPExtractHistogram(const vtkPExtractHistogram&); // Not implemented.
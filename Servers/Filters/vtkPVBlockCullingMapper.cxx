@@ -0,0 +1,81 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVBlockCullingMapper.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVBlockCullingMapper.h"
+
+#include "vtkBlockCullingPainter.h"
+#include "vtkObjectFactory.h"
+
+vtkStandardNewMacro(vtkPVBlockCullingMapper);
+//----------------------------------------------------------------------------
+vtkPVBlockCullingMapper::vtkPVBlockCullingMapper()
+{
+  this->BlockCulling = 0;
+  this->BlockCullingPainter = vtkBlockCullingPainter::New();
+}
+
+//----------------------------------------------------------------------------
+vtkPVBlockCullingMapper::~vtkPVBlockCullingMapper()
+{
+  this->SetBlockCulling(0);
+  this->BlockCullingPainter->Delete();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVBlockCullingMapper::SetBlockCulling(int culling)
+{
+  culling = culling ? 1 : 0;
+  if (this->BlockCulling == culling)
+    {
+    return;
+    }
+
+  // The culling painter goes in front of the painter chain.
+  if (culling)
+    {
+    this->BlockCullingPainter->SetDelegatePainter(this->GetPainter());
+    this->SetPainter(this->BlockCullingPainter);
+    }
+  else
+    {
+    this->SetPainter(this->BlockCullingPainter->GetDelegatePainter());
+    this->BlockCullingPainter->SetDelegatePainter(0);
+    }
+  this->BlockCulling = culling;
+  this->Modified();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVBlockCullingMapper::SetOcclusionCulling(int culling)
+{
+  if (this->BlockCullingPainter->GetOcclusionCulling() != culling)
+    {
+    this->BlockCullingPainter->SetOcclusionCulling(culling);
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+int vtkPVBlockCullingMapper::GetOcclusionCulling()
+{
+  return this->BlockCullingPainter->GetOcclusionCulling();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVBlockCullingMapper::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "BlockCulling: " << this->BlockCulling << endl;
+  os << indent << "BlockCullingPainter: " << this->BlockCullingPainter << endl;
+}
@@ -0,0 +1,71 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVBlockCullingMapper.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPVBlockCullingMapper - vtkPainterPolyDataMapper that can skip the
+// blocks of its input that cannot be seen.
+// .SECTION Description
+// When BlockCulling is on, a vtkBlockCullingPainter is put in front of the
+// painter chain of the mapper. It skips the cells of the blocks (as tagged
+// by vtkPVGeometryFilter) that are outside of the view frustum and, when
+// OcclusionCulling is also on, those hidden by other blocks. Otherwise this
+// mapper behaves like vtkPainterPolyDataMapper.
+// .SECTION See Also
+// vtkBlockCullingPainter
+
+#ifndef __vtkPVBlockCullingMapper_h
+#define __vtkPVBlockCullingMapper_h
+
+#include "vtkPainterPolyDataMapper.h"
+
+class vtkBlockCullingPainter;
+
+class VTK_EXPORT vtkPVBlockCullingMapper : public vtkPainterPolyDataMapper
+{
+public:
+  static vtkPVBlockCullingMapper* New();
+  vtkTypeMacro(vtkPVBlockCullingMapper, vtkPainterPolyDataMapper);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Turn on/off the culling of the blocks. Default is off.
+  virtual void SetBlockCulling(int);
+  vtkGetMacro(BlockCulling, int);
+  vtkBooleanMacro(BlockCulling, int);
+
+  // Description:
+  // Turn on/off the culling of the blocks hidden by other blocks, when
+  // BlockCulling is on. Default is on.
+  virtual void SetOcclusionCulling(int);
+  virtual int GetOcclusionCulling();
+  vtkBooleanMacro(OcclusionCulling, int);
+
+  // Description:
+  // Access to the painter doing the culling, e.g. for the culling counts.
+  vtkGetObjectMacro(BlockCullingPainter, vtkBlockCullingPainter);
+
+//BTX
+protected:
+  vtkPVBlockCullingMapper();
+  ~vtkPVBlockCullingMapper();
+
+  int BlockCulling;
+  vtkBlockCullingPainter* BlockCullingPainter;
+
+private:
+  vtkPVBlockCullingMapper(const vtkPVBlockCullingMapper&); // Not implemented.
+  void operator=(const vtkPVBlockCullingMapper&); // Not implemented.
+//ETX
+};
+
+#endif
@@ -69,6 +69,9 @@ vtkPVClientServerRenderManager::vtkPVClientServerRenderManager()
   this->LossLessCompression=1;
   this->CompressionEnabled=1;
   this->CompressorBuffer = vtkUnsignedCharArray::New();
+
+  this->PipelinedDelivery = 0;
+  this->ResetLatencyHistogram();
 }
 
 //----------------------------------------------------------------------------
@@ -213,6 +216,88 @@ void vtkPVClientServerRenderManager::DeActivate()
   this->SetController(0);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVClientServerRenderManager::FlushStreams()
+{
+  vtkRemoteConnection* rc =
+    vtkProcessModule::GetProcessModule()->GetActiveRemoteConnection();
+  if (rc)
+    {
+    rc->FlushStreams();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerRenderManager::RecordLatency(int stage, double seconds)
+{
+  if (stage < 0 || stage >= NUMBER_OF_DELIVERY_STAGES)
+    {
+    return;
+    }
+  double ms = seconds*1000.0;
+  int bin = 0;
+  for (double limit = 1.0; ms >= limit && bin < NUMBER_OF_LATENCY_BINS-1;
+    limit *= 2.0)
+    {
+    bin++;
+    }
+  this->LatencyHistogram[stage][bin]++;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkPVClientServerRenderManager::GetLatencyHistogramValue(
+  int stage, int bin)
+{
+  if (stage < 0 || stage >= NUMBER_OF_DELIVERY_STAGES ||
+    bin < 0 || bin >= NUMBER_OF_LATENCY_BINS)
+    {
+    return 0;
+    }
+  return this->LatencyHistogram[stage][bin];
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerRenderManager::ResetLatencyHistogram()
+{
+  for (int stage=0; stage < NUMBER_OF_DELIVERY_STAGES; stage++)
+    {
+    for (int bin=0; bin < NUMBER_OF_LATENCY_BINS; bin++)
+      {
+      this->LatencyHistogram[stage][bin] = 0;
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVClientServerRenderManager::PrintLatencyHistogram(ostream& os)
+{
+  static const char* stageNames[NUMBER_OF_DELIVERY_STAGES] =
+    { "Server Render", "Server Readback", "Server Compress", "Transfer",
+      "Frame Latency" };
+  os << "Latency (ms):";
+  for (int bin=0; bin < NUMBER_OF_LATENCY_BINS; bin++)
+    {
+    if (bin == NUMBER_OF_LATENCY_BINS-1)
+      {
+      os << " >=" << (1 << (bin-1));
+      }
+    else
+      {
+      os << " <" << (1 << bin);
+      }
+    }
+  os << endl;
+  for (int stage=0; stage < NUMBER_OF_DELIVERY_STAGES; stage++)
+    {
+    os << stageNames[stage] << ":";
+    for (int bin=0; bin < NUMBER_OF_LATENCY_BINS; bin++)
+      {
+      os << " " << this->LatencyHistogram[stage][bin];
+      }
+    os << endl;
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkPVClientServerRenderManager::PrintSelf(ostream& os, vtkIndent indent)
 {
@@ -225,6 +310,7 @@ void vtkPVClientServerRenderManager::PrintSelf(ostream& os, vtkIndent indent)
     }
   os << indent << "LossLessCompression: " << this->LossLessCompression << endl;
   os << indent << "CompressionEnabled: " << this->CompressionEnabled << endl;
+  os << indent << "PipelinedDelivery: " << this->PipelinedDelivery << endl;
 }
 
 // virtual void SetCompressionEnabled(int i) {
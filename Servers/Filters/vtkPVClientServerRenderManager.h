@@ -58,6 +58,7 @@ public:
 
   virtual void GenericStartRenderCallback()
     {
+    this->FlushStreams();
     this->Activate();
     this->Superclass::GenericStartRenderCallback();
     }
@@ -91,6 +92,44 @@ public:
   virtual void ConfigureCompressor(const char *stream);
   virtual char *GetCompressorConfiguration();
 
+  // Description:
+  // When set, interactive (lossy) renders are delivered in a pipelined
+  // fashion: the server compresses the previous frame while it renders the
+  // current one and sends it once the render is done, and the client
+  // displays the newest frame that has been completed. Still renders always
+  // flush the pipeline and deliver the current frame. Off by default. Must be
+  // set on both the client and the server.
+  vtkSetMacro(PipelinedDelivery, int);
+  vtkGetMacro(PipelinedDelivery, int);
+  vtkBooleanMacro(PipelinedDelivery, int);
+
+//BTX
+  // Description:
+  // Stages of the frame delivery for which latencies are recorded.
+  enum DeliveryStages
+    {
+    SERVER_RENDER_STAGE=0,
+    SERVER_READBACK_STAGE,
+    SERVER_COMPRESS_STAGE,
+    TRANSFER_STAGE,
+    FRAME_LATENCY_STAGE,
+    NUMBER_OF_DELIVERY_STAGES
+    };
+  enum
+    {
+    NUMBER_OF_LATENCY_BINS=12
+    };
+//ETX
+
+  // Description:
+  // Per-stage latency histogram, filled on the client as frames are
+  // delivered. Bin 0 counts latencies below 1 ms, bin i (i > 0) latencies in
+  // [2^(i-1), 2^i) ms, and the last bin everything above. FRAME_LATENCY_STAGE
+  // is the time from the render request to the display of that frame.
+  vtkIdType GetLatencyHistogramValue(int stage, int bin);
+  void ResetLatencyHistogram();
+  void PrintLatencyHistogram(ostream& os);
+
 //BTX
 protected:
   vtkPVClientServerRenderManager();
@@ -99,12 +138,25 @@ protected:
   void Activate();
   void DeActivate();
 
+  // Description:
+  // Sends the streams queued by an open stream transaction on the active
+  // connection. Called before triggering RMIs on the server so that they do
+  // not overtake the state changes queued before them.
+  void FlushStreams();
+
+  // Description:
+  // Adds a latency (in seconds) to the histogram for the given stage.
+  void RecordLatency(int stage, double seconds);
+
   // Compressor related
   int LossLessCompression;                // Set when processing still render.
   int CompressionEnabled;                 // Set when user enables compression.
   vtkImageCompressor *Compressor;         // A compressor instance.
   vtkUnsignedCharArray *CompressorBuffer; // Scratch array for the compressor
 
+  int PipelinedDelivery;
+  vtkIdType LatencyHistogram[NUMBER_OF_DELIVERY_STAGES][NUMBER_OF_LATENCY_BINS];
+
 private:
   vtkPVClientServerRenderManager(const vtkPVClientServerRenderManager&); // Not implemented
   void operator=(const vtkPVClientServerRenderManager&); // Not implemented
@@ -82,6 +82,14 @@ vtkPVDesktopDeliveryClient::vtkPVDesktopDeliveryClient()
   this->ViewSizeCompact[0] = this->ViewSizeCompact[1] = 0;
   this->ViewPositionCompact[0] = this->ViewPositionCompact[1] = 0;
 
+  this->FrameCounter = 0;
+  for (int i = 0; i < NUMBER_OF_REQUEST_TIMES; i++)
+    {
+    this->RequestTimes[i] = 0.0;
+    }
+  this->LastDeliveredImage = vtkUnsignedCharArray::New();
+  this->LastDeliveredImageSize[0] = this->LastDeliveredImageSize[1] = 0;
+
   vtkCallbackCommand *cbc = vtkCallbackCommand::New();
   cbc->SetClientData(this);
   cbc->SetCallback(vtkPVDesktopDeliveryClientReceiveImageCallback);
@@ -96,6 +104,7 @@ vtkPVDesktopDeliveryClient::vtkPVDesktopDeliveryClient()
 vtkPVDesktopDeliveryClient::~vtkPVDesktopDeliveryClient()
 {
   this->ReceiveImageCallback->Delete();
+  this->LastDeliveredImage->Delete();
 }
 
 //----------------------------------------------------------------------------
@@ -147,6 +156,7 @@ void vtkPVDesktopDeliveryClient::ComputeVisiblePropBounds(vtkRenderer *ren,
 {
   if (this->ParallelRendering && this->Controller)
     {
+    this->FlushStreams();
     this->Controller->TriggerRMI(this->ServerProcessId, &this->Id, sizeof(int),
                                  vtkPVDesktopDeliveryServer::WINDOW_ID_RMI_TAG);
     }
@@ -201,6 +211,14 @@ void vtkPVDesktopDeliveryClient::CollectWindowInformation(vtkMultiProcessStream&
 
   winGeoInfo.Id = this->Id;
   winGeoInfo.AnnotationLayer = this->AnnotationLayer;
+
+  // Only interactive renders are pipelined. A still render always gets the
+  // image rendered for it, which also drops any frame the server still holds.
+  winGeoInfo.Pipelined =
+    (this->PipelinedDelivery && !this->LossLessCompression)? 1 : 0;
+  winGeoInfo.FrameId = ++this->FrameCounter;
+  this->RequestTimes[winGeoInfo.FrameId % NUMBER_OF_REQUEST_TIMES] =
+    vtkTimerLog::GetUniversalTime();
   winGeoInfo.Save(stream);
 }
 
@@ -321,6 +339,18 @@ void vtkPVDesktopDeliveryClient::ReceiveImageFromServer()
   this->Timer->StopTimer();
   this->RenderTime += this->Timer->GetElapsedTime();
 
+  // With pipelined delivery the server may not have a completed frame yet.
+  // Display the last image we got instead.
+  int reuseLastImage = 0;
+  if (comm_success && ip.RemoteDisplay && ip.FrameId < 0)
+    {
+    reuseLastImage = (this->LastDeliveredImage->GetNumberOfTuples() > 0);
+    ip.RemoteDisplay = reuseLastImage;
+    ip.ImageSize[0] = this->LastDeliveredImageSize[0];
+    ip.ImageSize[1] = this->LastDeliveredImageSize[1];
+    ip.NumberOfComponents = this->LastDeliveredImage->GetNumberOfComponents();
+    }
+
   if (comm_success && ip.RemoteDisplay)
     {
     // Receive image.
@@ -341,7 +371,14 @@ void vtkPVDesktopDeliveryClient::ReceiveImageFromServer()
     this->ReducedImage->SetNumberOfTuples(  this->ReducedImageSize[0]
                                           * this->ReducedImageSize[1]);
 
-    if (this->CompressionEnabled)
+    if (reuseLastImage)
+      {
+      memcpy(this->ReducedImage->GetPointer(0),
+             this->LastDeliveredImage->GetPointer(0),
+             this->ReducedImageSize[0]*this->ReducedImageSize[1]
+             *ip.NumberOfComponents);
+      }
+    else if (this->CompressionEnabled)
       {
       // Allocate buffer.
       this->CompressorBuffer->SetNumberOfComponents(1);
@@ -387,6 +424,12 @@ void vtkPVDesktopDeliveryClient::ReceiveImageFromServer()
                                 ip.BufferSize, this->ServerProcessId,
                                 vtkPVDesktopDeliveryServer::IMAGE_TAG);
       }
+    if (this->PipelinedDelivery && !reuseLastImage)
+      {
+      this->LastDeliveredImage->DeepCopy(this->ReducedImage);
+      this->LastDeliveredImageSize[0] = this->ReducedImageSize[0];
+      this->LastDeliveredImageSize[1] = this->ReducedImageSize[1];
+      }
     this->ReducedImageUpToDate = 1;
     this->RenderWindowImageUpToDate = 0;
 
@@ -418,6 +461,19 @@ void vtkPVDesktopDeliveryClient::ReceiveImageFromServer()
                             vtkPVDesktopDeliveryServer::TIMING_METRICS_TAG);
   this->RemoteImageProcessingTime = tm.ImageProcessingTime;
 
+  if (comm_success && ip.RemoteDisplay && !reuseLastImage)
+    {
+    this->RecordLatency(SERVER_RENDER_STAGE, tm.RenderTime);
+    this->RecordLatency(SERVER_READBACK_STAGE, tm.ReadbackTime);
+    this->RecordLatency(SERVER_COMPRESS_STAGE, tm.CompressTime);
+    this->RecordLatency(TRANSFER_STAGE, this->TransferTime);
+    if (ip.FrameId > this->FrameCounter - NUMBER_OF_REQUEST_TIMES)
+      {
+      this->RecordLatency(FRAME_LATENCY_STAGE, vtkTimerLog::GetUniversalTime()
+        - this->RequestTimes[ip.FrameId % NUMBER_OF_REQUEST_TIMES]);
+      }
+    }
+
   this->WriteFullImage();
 
   this->Timer->StartTimer();
@@ -448,4 +504,5 @@ void vtkPVDesktopDeliveryClient::PrintSelf(ostream& os, vtkIndent indent)
      << this->WindowPosition[0] << ", " << this->WindowPosition[1] << endl;
   os << indent << "GUISize: "
      << this->GUISize[0] << ", " << this->GUISize[1] << endl;
+  this->PrintLatencyHistogram(os);
 }
@@ -172,6 +172,22 @@ protected:
 
   int ReceivedImageFromServer;
   vtkCommand *ReceiveImageCallback;
+
+  // Description:
+  // Used for pipelined delivery. Id of the last render request and the time
+  // each recent request was issued, used to measure the frame latency.
+  // Since at most one frame is in flight, a few slots are enough.
+  int FrameCounter;
+  //BTX
+  enum { NUMBER_OF_REQUEST_TIMES=8 };
+  //ETX
+  double RequestTimes[NUMBER_OF_REQUEST_TIMES];
+
+  // Description:
+  // Copy of the last image delivered by the server. It is displayed again
+  // when the server has no completed frame to deliver.
+  vtkUnsignedCharArray *LastDeliveredImage;
+  int LastDeliveredImageSize[2];
   
 private:
   vtkPVDesktopDeliveryClient(const vtkPVDesktopDeliveryClient &); //Not implemented
@@ -23,6 +23,7 @@ PURPOSE.  See the above copyright notice for more information.
 #include "vtkLight.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkMultiThreader.h"
 #include "vtkObjectFactory.h"
 #include "vtkRendererCollection.h"
 #include "vtkRenderer.h"
@@ -57,6 +58,53 @@ public:
   RendererMapType Renderers;
 };
 
+//-----------------------------------------------------------------------------
+// The image kept from the previous render request when pipelined delivery is
+// used, and the thread compressing it.
+class vtkPVDesktopDeliveryServer::vtkPipelineState
+{
+public:
+  vtkPipelineState()
+    {
+    this->Image = vtkUnsignedCharArray::New();
+    this->Threader = vtkMultiThreader::New();
+    this->ThreadId = -1;
+    this->HasImage = false;
+    this->GUISize[0] = this->GUISize[1] = 0;
+    }
+  ~vtkPipelineState()
+    {
+    this->Image->Delete();
+    this->Threader->Delete();
+    }
+
+  vtkUnsignedCharArray* Image;
+  vtkPVDesktopDeliveryServer::ImageParams Params;
+  vtkPVDesktopDeliveryServer::TimingMetrics Metrics;
+  bool HasImage;
+  // Client GUI size the image was rendered for. Images rendered for a
+  // different size are stale and never delivered.
+  int GUISize[2];
+
+  // Params and metrics to send once the compression thread is done.
+  vtkPVDesktopDeliveryServer::ImageParams SendParams;
+  vtkPVDesktopDeliveryServer::TimingMetrics SendMetrics;
+
+  vtkMultiThreader* Threader;
+  int ThreadId;
+};
+
+//-----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkPVDesktopDeliveryServerDeliver(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkPVDesktopDeliveryServer* self =
+    static_cast<vtkPVDesktopDeliveryServer*>(info->UserData);
+  self->CompressPendingImage();
+  return VTK_THREAD_RETURN_VALUE;
+}
+
 //-----------------------------------------------------------------------------
 
 vtkStandardNewMacro(vtkPVDesktopDeliveryServer);
@@ -80,11 +128,20 @@ vtkPVDesktopDeliveryServer::vtkPVDesktopDeliveryServer()
 
   // The other process is the root process.
   this->RootProcessId = 1;
+
+  this->PipelinedFrame = 0;
+  this->FrameId = 0;
+  this->RenderStartTime = 0.0;
+  this->Pipeline = new vtkPipelineState;
 }
 
 //----------------------------------------------------------------------------
 vtkPVDesktopDeliveryServer::~vtkPVDesktopDeliveryServer()
 {
+  this->FinishPendingImageDelivery();
+  delete this->Pipeline;
+  this->Pipeline = 0;
+
   this->SetParallelRenderManager(NULL);
 
   delete this->RendererMap;
@@ -289,6 +346,8 @@ bool vtkPVDesktopDeliveryServer::ProcessWindowInformation(
   this->ClientGUISize[1] = winGeoInfo.GUISize[1];
 
   this->AnnotationLayer = winGeoInfo.AnnotationLayer;
+  this->PipelinedFrame = winGeoInfo.Pipelined;
+  this->FrameId = winGeoInfo.FrameId;
 
   this->UseRendererSet(winGeoInfo.Id);
 
@@ -358,140 +417,303 @@ void vtkPVDesktopDeliveryServer::PreRenderProcessing()
     }
 
   this->ImageResized = 0;
+
+  if (this->PipelinedFrame)
+    {
+    // Compress the image rendered for the previous request while this one
+    // renders. The client displays it as the reply to this request.
+    this->StartPendingImageDelivery();
+    }
+  else
+    {
+    // The client wants the image for this request, anything older is stale.
+    this->DropPendingImage();
+    }
+  this->RenderStartTime = vtkTimerLog::GetUniversalTime();
 }
 
 //----------------------------------------------------------------------------
 void vtkPVDesktopDeliveryServer::PostRenderProcessing()
 {
   vtkDebugMacro("PostRenderProcessing");
-  vtkTimerLog::MarkStartEvent("Sending");
+  double renderTime = vtkTimerLog::GetUniversalTime() - this->RenderStartTime;
+
+  vtkPVDesktopDeliveryServer::TimingMetrics tm;
+  if (this->ParallelRenderManager)
+    {
+    tm.ImageProcessingTime
+      = this->ParallelRenderManager->GetImageProcessingTime();
+    }
+  else
+    {
+    tm.ImageProcessingTime = 0.0;
+    }
+  tm.RenderTime = renderTime;
+  tm.ReadbackTime = 0.0;
+  tm.CompressTime = 0.0;
 
   vtkPVDesktopDeliveryServer::ImageParams ip;
   ip.RemoteDisplay = this->RemoteDisplay;
+  ip.NumberOfComponents = 0;
+  ip.BufferSize = 0;
+  ip.ImageSize[0] = ip.ImageSize[1] = 0;
+  ip.FrameId = this->FrameId;
+
+  if (this->PipelinedFrame)
+    {
+    // The previous image must be out before the buffers are reused. It is
+    // sent from this thread: progress messages are sent on the same
+    // controller while rendering, so the compression thread never sends.
+    this->FinishPendingImageDelivery();
+    this->SendPendingImage();
 
-  if (ip.RemoteDisplay)
+    vtkTimerLog::MarkStartEvent("Pipelined Readback");
+    if (ip.RemoteDisplay)
+      {
+      double startTime = vtkTimerLog::GetUniversalTime();
+      this->PrepareSendImage(ip);
+      this->Pipeline->Image->DeepCopy(this->SendImageBuffer);
+      tm.ReadbackTime = vtkTimerLog::GetUniversalTime() - startTime;
+      this->Pipeline->Params = ip;
+      this->Pipeline->Metrics = tm;
+      this->Pipeline->GUISize[0] = this->ClientGUISize[0];
+      this->Pipeline->GUISize[1] = this->ClientGUISize[1];
+      this->Pipeline->HasImage = true;
+      }
+    vtkTimerLog::MarkEndEvent("Pipelined Readback");
+    }
+  else
     {
-    this->ReadReducedImage();
-    ip.NumberOfComponents = this->ReducedImage->GetNumberOfComponents();
-    if (   (this->ClientWindowSize[0] == this->ClientGUISize[0])
-        && (this->ClientWindowSize[1] == this->ClientGUISize[1]) )
+    vtkTimerLog::MarkStartEvent("Sending");
+    if (ip.RemoteDisplay)
       {
-      ip.ImageSize[0] = this->ReducedImageSize[0];
-      ip.ImageSize[1] = this->ReducedImageSize[1];
-      this->SendImageBuffer->SetArray(this->ReducedImage->GetPointer(0),
-                                      ip.ImageSize[0]*ip.ImageSize[1]
-                                      *ip.NumberOfComponents, 1);
-      this->SendImageBuffer->SetNumberOfComponents(ip.NumberOfComponents);
-      this->SendImageBuffer->SetNumberOfTuples(ip.ImageSize[0]*ip.ImageSize[1]);
+      double startTime = vtkTimerLog::GetUniversalTime();
+      this->PrepareSendImage(ip);
+      tm.ReadbackTime = vtkTimerLog::GetUniversalTime() - startTime;
+      }
+    this->SendImage(ip, this->SendImageBuffer, tm);
+    vtkTimerLog::MarkEndEvent("Sending");
+    }
+
+  // If another parallel render manager has already made an image, don't
+  // clober it.
+  if (this->ParallelRenderManager)
+    {
+    this->RenderWindowImageUpToDate = 1;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDesktopDeliveryServer::PrepareSendImage(
+  vtkPVDesktopDeliveryServer::ImageParams& ip)
+{
+  this->ReadReducedImage();
+  ip.NumberOfComponents = this->ReducedImage->GetNumberOfComponents();
+  if (   (this->ClientWindowSize[0] == this->ClientGUISize[0])
+      && (this->ClientWindowSize[1] == this->ClientGUISize[1]) )
+    {
+    ip.ImageSize[0] = this->ReducedImageSize[0];
+    ip.ImageSize[1] = this->ReducedImageSize[1];
+    this->SendImageBuffer->SetArray(this->ReducedImage->GetPointer(0),
+                                    ip.ImageSize[0]*ip.ImageSize[1]
+                                    *ip.NumberOfComponents, 1);
+    this->SendImageBuffer->SetNumberOfComponents(ip.NumberOfComponents);
+    this->SendImageBuffer->SetNumberOfTuples(ip.ImageSize[0]*ip.ImageSize[1]);
+    }
+  else
+    {
+    // Grab a subset of the server's window that corresponds to the window on
+    // the client.
+    if (   (this->ClientGUISize[0] == this->FullImageSize[0])
+        && !this->ImageResized )
+      {
+      // Window was not resized.  Return image size requested.
+      ip.ImageSize[0] = this->ClientRequestedImageSize[0];
+      ip.ImageSize[1] = this->ClientRequestedImageSize[1];
       }
     else
       {
-      // Grab a subset of the server's window that corresponds to the window on
-      // the client.
-      if (   (this->ClientGUISize[0] == this->FullImageSize[0])
-          && !this->ImageResized )
-        {
-        // Window was not resized.  Return image size requested.
-        ip.ImageSize[0] = this->ClientRequestedImageSize[0];
-        ip.ImageSize[1] = this->ClientRequestedImageSize[1];
-        }
-      else
-        {
-        ip.ImageSize[0]
-          = (  (this->ReducedImageSize[0]*this->ClientWindowSize[0])
-             / this->ClientGUISize[0] );
-        ip.ImageSize[1]
-          = (  (this->ReducedImageSize[1]*this->ClientWindowSize[1])
-             / this->ClientGUISize[1] );
-        }
-      int left   = (  (this->ReducedImageSize[0]*this->ClientWindowPosition[0])
-                    / this->ClientGUISize[0] );
-      int bottom = (  (this->ReducedImageSize[1]*this->ClientWindowPosition[1])
-                    / this->ClientGUISize[1] );
-
-      this->SendImageBuffer->Initialize();
-      this->SendImageBuffer->SetNumberOfComponents(ip.NumberOfComponents);
-      this->SendImageBuffer->SetNumberOfTuples(ip.ImageSize[0]*ip.ImageSize[1]);
-      for (int i = 0; i < ip.ImageSize[1]; i++)
-        {
-        int destPos = i*ip.ImageSize[0]*ip.NumberOfComponents;
-        int srcPos
-          = (left + (bottom+i)*this->ReducedImageSize[0])*ip.NumberOfComponents;
-        memcpy(this->SendImageBuffer->GetPointer(destPos),
-               this->ReducedImage->GetPointer(srcPos),
-               ip.ImageSize[0]*ip.NumberOfComponents);
-        }
+      ip.ImageSize[0]
+        = (  (this->ReducedImageSize[0]*this->ClientWindowSize[0])
+           / this->ClientGUISize[0] );
+      ip.ImageSize[1]
+        = (  (this->ReducedImageSize[1]*this->ClientWindowSize[1])
+           / this->ClientGUISize[1] );
+      }
+    int left   = (  (this->ReducedImageSize[0]*this->ClientWindowPosition[0])
+                  / this->ClientGUISize[0] );
+    int bottom = (  (this->ReducedImageSize[1]*this->ClientWindowPosition[1])
+                  / this->ClientGUISize[1] );
+
+    this->SendImageBuffer->Initialize();
+    this->SendImageBuffer->SetNumberOfComponents(ip.NumberOfComponents);
+    this->SendImageBuffer->SetNumberOfTuples(ip.ImageSize[0]*ip.ImageSize[1]);
+    for (int i = 0; i < ip.ImageSize[1]; i++)
+      {
+      int destPos = i*ip.ImageSize[0]*ip.NumberOfComponents;
+      int srcPos
+        = (left + (bottom+i)*this->ReducedImageSize[0])*ip.NumberOfComponents;
+      memcpy(this->SendImageBuffer->GetPointer(destPos),
+             this->ReducedImage->GetPointer(srcPos),
+             ip.ImageSize[0]*ip.NumberOfComponents);
       }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDesktopDeliveryServer::SendImage(
+  vtkPVDesktopDeliveryServer::ImageParams& ip, vtkUnsignedCharArray* buffer,
+  vtkPVDesktopDeliveryServer::TimingMetrics& tm)
+{
+  this->CompressImage(ip, buffer, tm);
+  this->SendImageData(ip, buffer, tm);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDesktopDeliveryServer::CompressImage(
+  vtkPVDesktopDeliveryServer::ImageParams& ip, vtkUnsignedCharArray* buffer,
+  vtkPVDesktopDeliveryServer::TimingMetrics& tm)
+{
+  if (!ip.RemoteDisplay || ip.FrameId < 0)
+    {
+    return;
+    }
 
-    // ip.SquirtCompressed = this->Squirt && (ip.NumberOfComponents == 4);
-    // if (ip.SquirtCompressed)
+  // ip.SquirtCompressed = this->Squirt && (ip.NumberOfComponents == 4);
+  // if (ip.SquirtCompressed)
+  if (this->CompressionEnabled)
+    {
+    double startTime = vtkTimerLog::GetUniversalTime();
+    this->Compressor->SetLossLessMode(this->LossLessCompression);
+    this->Compressor->SetInput(buffer);
+    this->Compressor->SetOutput(this->CompressorBuffer);
+    this->Compressor->Compress();
+    this->Compressor->SetInput(0);
+    this->Compressor->SetOutput(0);
+    tm.CompressTime = vtkTimerLog::GetUniversalTime() - startTime;
+
+    ip.NumberOfComponents=buffer->GetNumberOfComponents();
+    ip.BufferSize=this->CompressorBuffer->GetNumberOfTuples();
+    }
+  else
+    {
+    ip.BufferSize
+      = ip.NumberOfComponents*buffer->GetNumberOfTuples();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDesktopDeliveryServer::SendImageData(
+  vtkPVDesktopDeliveryServer::ImageParams& ip, vtkUnsignedCharArray* buffer,
+  vtkPVDesktopDeliveryServer::TimingMetrics& tm)
+{
+  vtkMultiProcessController* controller = this->Controller;
+
+  if (ip.RemoteDisplay && ip.FrameId >= 0)
+    {
     if (this->CompressionEnabled)
       {
-      this->Compressor->SetLossLessMode(this->LossLessCompression);
-      this->Compressor->SetInput(this->SendImageBuffer);
-      this->Compressor->SetOutput(this->CompressorBuffer);
-      this->Compressor->Compress();
-      this->Compressor->SetInput(0);
-      this->Compressor->SetOutput(0);
-
-      ip.NumberOfComponents=this->SendImageBuffer->GetNumberOfComponents();
-      ip.BufferSize=this->CompressorBuffer->GetNumberOfTuples();
-
-      this->Controller->Send(reinterpret_cast<int *>(&ip),
-                             IMAGE_PARAMS_SIZE,
-                             this->RootProcessId,
-                             IMAGE_PARAMS_TAG);
-
-      this->Controller->Send(this->CompressorBuffer->GetPointer(0),
-                             ip.BufferSize,
-                             this->RootProcessId,
-                             IMAGE_TAG);
+      controller->Send(reinterpret_cast<int *>(&ip),
+                       IMAGE_PARAMS_SIZE,
+                       this->RootProcessId,
+                       IMAGE_PARAMS_TAG);
+
+      controller->Send(this->CompressorBuffer->GetPointer(0),
+                       ip.BufferSize,
+                       this->RootProcessId,
+                       IMAGE_TAG);
       }
     else
       {
-      ip.BufferSize
-        = ip.NumberOfComponents*this->SendImageBuffer->GetNumberOfTuples();
-      this->Controller->Send(reinterpret_cast<int *>(&ip),
-                             vtkPVDesktopDeliveryServer::IMAGE_PARAMS_SIZE,
-                             this->RootProcessId,
-                             vtkPVDesktopDeliveryServer::IMAGE_PARAMS_TAG);
-      this->Controller->Send(this->SendImageBuffer->GetPointer(0), ip.BufferSize,
-                             this->RootProcessId,
-                             vtkPVDesktopDeliveryServer::IMAGE_TAG);
+      controller->Send(reinterpret_cast<int *>(&ip),
+                       vtkPVDesktopDeliveryServer::IMAGE_PARAMS_SIZE,
+                       this->RootProcessId,
+                       vtkPVDesktopDeliveryServer::IMAGE_PARAMS_TAG);
+      controller->Send(buffer->GetPointer(0), ip.BufferSize,
+                       this->RootProcessId,
+                       vtkPVDesktopDeliveryServer::IMAGE_TAG);
       }
     }
   else
     {
-    this->Controller->Send(reinterpret_cast<int *>(&ip),
-                           vtkPVDesktopDeliveryServer::IMAGE_PARAMS_SIZE,
-                           this->RootProcessId,
-                           vtkPVDesktopDeliveryServer::IMAGE_PARAMS_TAG);
+    controller->Send(reinterpret_cast<int *>(&ip),
+                     vtkPVDesktopDeliveryServer::IMAGE_PARAMS_SIZE,
+                     this->RootProcessId,
+                     vtkPVDesktopDeliveryServer::IMAGE_PARAMS_TAG);
     }
 
   // Send timing metrics
-  vtkPVDesktopDeliveryServer::TimingMetrics tm;
-  if (this->ParallelRenderManager)
+  controller->Send(reinterpret_cast<double *>(&tm),
+                   vtkPVDesktopDeliveryServer::TIMING_METRICS_SIZE,
+                   this->RootProcessId,
+                   vtkPVDesktopDeliveryServer::TIMING_METRICS_TAG);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDesktopDeliveryServer::StartPendingImageDelivery()
+{
+  if (this->Pipeline->HasImage &&
+    (this->Pipeline->GUISize[0] != this->ClientGUISize[0] ||
+     this->Pipeline->GUISize[1] != this->ClientGUISize[1]))
     {
-    tm.ImageProcessingTime
-      = this->ParallelRenderManager->GetImageProcessingTime();
+    // The window was resized since the image was rendered.
+    this->DropPendingImage();
     }
-  else
+
+  this->Pipeline->ThreadId = this->Pipeline->Threader->SpawnThread(
+    vtkPVDesktopDeliveryServerDeliver, this);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDesktopDeliveryServer::FinishPendingImageDelivery()
+{
+  if (this->Pipeline && this->Pipeline->ThreadId >= 0)
     {
-    tm.ImageProcessingTime = 0.0;
+    this->Pipeline->Threader->TerminateThread(this->Pipeline->ThreadId);
+    this->Pipeline->ThreadId = -1;
     }
-  this->Controller->Send(reinterpret_cast<double *>(&tm),
-                         vtkPVDesktopDeliveryServer::TIMING_METRICS_SIZE,
-                         this->RootProcessId,
-                         vtkPVDesktopDeliveryServer::TIMING_METRICS_TAG);
+}
 
-  // If another parallel render manager has already made an image, don't
-  // clober it.
-  if (this->ParallelRenderManager)
+//----------------------------------------------------------------------------
+void vtkPVDesktopDeliveryServer::SendPendingImage()
+{
+  this->SendImageData(this->Pipeline->SendParams, this->Pipeline->Image,
+    this->Pipeline->SendMetrics);
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDesktopDeliveryServer::DropPendingImage()
+{
+  this->FinishPendingImageDelivery();
+  this->Pipeline->HasImage = false;
+  this->Pipeline->Image->Initialize();
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDesktopDeliveryServer::CompressPendingImage()
+{
+  vtkPVDesktopDeliveryServer::ImageParams ip;
+  vtkPVDesktopDeliveryServer::TimingMetrics tm;
+  if (this->Pipeline->HasImage)
     {
-    this->RenderWindowImageUpToDate = 1;
+    ip = this->Pipeline->Params;
+    tm = this->Pipeline->Metrics;
     }
-
-  vtkTimerLog::MarkEndEvent("Sending");
+  else
+    {
+    // Nothing completed yet, the client keeps showing its last image.
+    ip.RemoteDisplay = this->RemoteDisplay;
+    ip.NumberOfComponents = 0;
+    ip.BufferSize = 0;
+    ip.ImageSize[0] = ip.ImageSize[1] = 0;
+    ip.FrameId = -1;
+    tm.ImageProcessingTime = tm.RenderTime = tm.ReadbackTime =
+      tm.CompressTime = 0.0;
+    }
+  this->CompressImage(ip, this->Pipeline->Image, tm);
+  this->Pipeline->SendParams = ip;
+  this->Pipeline->SendMetrics = tm;
+  this->Pipeline->HasImage = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -694,7 +916,9 @@ void vtkPVDesktopDeliveryServer::WindowGeometry::Save(vtkMultiProcessStream& str
     << this->GUISize[0] << this->GUISize[1]
     << this->ViewSize[0] << this->ViewSize[1]
     << this->Id
-    << this->AnnotationLayer;
+    << this->AnnotationLayer
+    << this->Pipelined
+    << this->FrameId;
 }
 
 //-----------------------------------------------------------------------------
@@ -710,7 +934,9 @@ bool vtkPVDesktopDeliveryServer::WindowGeometry::Restore(vtkMultiProcessStream&
     >> this->GUISize[0] >> this->GUISize[1]
     >> this->ViewSize[0] >> this->ViewSize[1]
     >> this->Id
-    >> this->AnnotationLayer;
+    >> this->AnnotationLayer
+    >> this->Pipelined
+    >> this->FrameId;
   return true;
 }
 
@@ -84,6 +84,11 @@ public:
   // DO NOT USE.  FOR INTERNAL USE ONLY.
   virtual void UseRendererSet(int id);
 
+  // Description:
+  // DO NOT USE.  FOR INTERNAL USE ONLY.
+  // Called from the compression thread when PipelinedDelivery is used.
+  void CompressPendingImage();
+
   // Description:
   // Capture Z buffer from render window on end render. Works only when
   // ParallelRenderManager is 0.
@@ -119,6 +124,9 @@ public:
 
   struct TimingMetrics {
     double ImageProcessingTime;
+    double RenderTime;
+    double ReadbackTime;
+    double CompressTime;
   };
 
   struct WindowGeometry {
@@ -127,6 +135,11 @@ public:
     int ViewSize[2];
     int Id;
     int AnnotationLayer;
+    // Set when the client accepts the previous completed frame as the
+    // reply to this render request.
+    int Pipelined;
+    // Client side id of this render request.
+    int FrameId;
     void Save(vtkMultiProcessStream& stream);
     bool Restore(vtkMultiProcessStream& stream);
   };
@@ -136,6 +149,9 @@ public:
     int NumberOfComponents;
     int BufferSize;
     int ImageSize[2];
+    // Id of the render request this image was rendered for, or -1 when no
+    // image is delivered i.e. the client should keep showing its last image.
+    int FrameId;
   };
 
   enum TimingMetricSize {
@@ -167,6 +183,39 @@ protected:
 
   virtual void ReadReducedImage();
 
+  // Description:
+  // Reads back the image and fills SendImageBuffer with the part requested
+  // by the client.
+  virtual void PrepareSendImage(ImageParams& ip);
+
+  // Description:
+  // Compresses (if enabled) and sends the image in buffer along with the
+  // image params and timing metrics.
+  virtual void SendImage(ImageParams& ip, vtkUnsignedCharArray* buffer,
+    TimingMetrics& tm);
+
+  // Description:
+  // The two halves of SendImage(). CompressImage() compresses buffer into
+  // CompressorBuffer when compression is enabled and fills in the buffer
+  // size; it does not touch the controller. SendImageData() sends the
+  // result.
+  void CompressImage(ImageParams& ip, vtkUnsignedCharArray* buffer,
+    TimingMetrics& tm);
+  void SendImageData(ImageParams& ip, vtkUnsignedCharArray* buffer,
+    TimingMetrics& tm);
+
+  // Description:
+  // Pipelined delivery. StartPendingImageDelivery() compresses the image
+  // kept from the previous render request in a separate thread while the
+  // current frame renders; FinishPendingImageDelivery() waits for it to be
+  // done. SendPendingImage() then sends it from the main thread, so the
+  // controller is only ever used by one thread. DropPendingImage() forgets
+  // it.
+  void StartPendingImageDelivery();
+  void FinishPendingImageDelivery();
+  void SendPendingImage();
+  void DropPendingImage();
+
   virtual bool ProcessWindowInformation(vtkMultiProcessStream&);
   virtual bool ProcessRendererInformation(vtkRenderer *, vtkMultiProcessStream&);
 
@@ -191,7 +240,15 @@ protected:
   vtkUnsignedCharArray *SendImageBuffer;
   unsigned long WindowIdRMIId;
 
+  // Pipelined delivery state for the current render request.
+  int PipelinedFrame;
+  int FrameId;
+  double RenderStartTime;
+
 private:
+  class vtkPipelineState;
+  vtkPipelineState* Pipeline;
+
   vtkPVDesktopDeliveryServer(const vtkPVDesktopDeliveryServer &); //Not implemented
   void operator=(const vtkPVDesktopDeliveryServer &);    //Not implemented
 //ETX
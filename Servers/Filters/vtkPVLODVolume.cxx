@@ -16,6 +16,7 @@
 
 #include "vtkAbstractVolumeMapper.h"
 #include "vtkLODProp3D.h"
+#include "vtkMacrocellVolumeRayCastMapper.h"
 #include "vtkMapper.h"
 #include "vtkProperty.h"
 #include "vtkVolumeProperty.h"
@@ -321,6 +322,20 @@ void vtkPVLODVolume::SetAllocatedRenderTime(double t, vtkViewport *v)
   this->LODProp->SetSelectedLODID(lod);
   this->LODProp->SetSelectedPickLODID(lod);
 
+  // The software ray caster lowers its sampling rates while interacting.
+  if (lod >= 0 && lod == this->HighLODId)
+    {
+    vtkMacrocellVolumeRayCastMapper* rayCaster =
+      vtkMacrocellVolumeRayCastMapper::SafeDownCast(
+        this->LODProp->GetLODMapper(this->HighLODId));
+    vtkRenderer* ren = vtkRenderer::SafeDownCast(v);
+    if (rayCaster && ren && ren->GetRenderWindow())
+      {
+      rayCaster->SetInteractive(
+        ren->GetRenderWindow()->GetDesiredUpdateRate() >= 1.0);
+      }
+    }
+
   this->LODProp->SetAllocatedRenderTime(t, v);
 }
 
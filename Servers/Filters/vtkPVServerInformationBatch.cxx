@@ -0,0 +1,76 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVServerInformationBatch.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVServerInformationBatch.h"
+
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkProcessModule.h"
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkPVServerInformationBatch);
+
+//----------------------------------------------------------------------------
+class vtkPVServerInformationBatchInternals
+{
+public:
+  vtkClientServerStream Result;
+};
+
+//----------------------------------------------------------------------------
+vtkPVServerInformationBatch::vtkPVServerInformationBatch()
+{
+  this->Internal = new vtkPVServerInformationBatchInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkPVServerInformationBatch::~vtkPVServerInformationBatch()
+{
+  delete this->Internal;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVServerInformationBatch::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+}
+
+//----------------------------------------------------------------------------
+const vtkClientServerStream& vtkPVServerInformationBatch::ProcessRequests(
+  const vtkClientServerStream& requests)
+{
+  this->Internal->Result.Reset();
+  this->Internal->Result << vtkClientServerStream::Reply;
+
+  vtkClientServerInterpreter* interp = this->ProcessModule?
+    this->ProcessModule->GetInterpreter() : 0;
+  if (!interp)
+    {
+    vtkErrorMacro("ProcessRequests needs the process module.");
+    this->Internal->Result << vtkClientServerStream::End;
+    return this->Internal->Result;
+    }
+
+  int numMessages = requests.GetNumberOfMessages();
+  for (int cc=0; cc < numMessages; cc++)
+    {
+    // The interpreter leaves the result of the message, or its error, in
+    // its last result. Our own result is written after we return.
+    interp->ProcessOneMessage(requests, cc);
+    this->Internal->Result << interp->GetLastResult();
+    }
+  this->Internal->Result << vtkClientServerStream::End;
+  return this->Internal->Result;
+}
@@ -0,0 +1,60 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVServerInformationBatch.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPVServerInformationBatch - Server-side helper to run several
+// information requests in one round trip.
+// .SECTION Description
+// The client sends a stream of Invoke messages, typically the getters of
+// information properties of many proxies. Each one is processed by the
+// interpreter and its result is returned as one argument of the reply, so
+// that the client gets all of them with a single GetLastResult().
+// .SECTION See Also
+// vtkSMProxy::UpdatePropertyInformation(vtkCollection*)
+
+#ifndef __vtkPVServerInformationBatch_h
+#define __vtkPVServerInformationBatch_h
+
+#include "vtkPVServerObject.h"
+
+class vtkClientServerStream;
+class vtkPVServerInformationBatchInternals;
+
+class VTK_EXPORT vtkPVServerInformationBatch : public vtkPVServerObject
+{
+public:
+  static vtkPVServerInformationBatch* New();
+  vtkTypeMacro(vtkPVServerInformationBatch, vtkPVServerObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Processes every message of requests and returns a single Reply message
+  // whose argument i is the result of message i, as a nested stream. The
+  // result of a message that failed is the error reported by the
+  // interpreter.
+  const vtkClientServerStream& ProcessRequests(
+    const vtkClientServerStream& requests);
+
+protected:
+  vtkPVServerInformationBatch();
+  ~vtkPVServerInformationBatch();
+
+  // Internal implementation details.
+  vtkPVServerInformationBatchInternals* Internal;
+
+private:
+  vtkPVServerInformationBatch(const vtkPVServerInformationBatch&); // Not implemented
+  void operator=(const vtkPVServerInformationBatch&); // Not implemented
+};
+
+#endif
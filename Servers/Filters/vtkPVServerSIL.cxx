@@ -0,0 +1,151 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVServerSIL.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkPVServerSIL.h"
+
+#include "vtkAlgorithm.h"
+#include "vtkClientServerStream.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkGraph.h"
+#include "vtkObjectFactory.h"
+#include "vtkOutEdgeIterator.h"
+#include "vtkPVSILInformation.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+
+#include <vtkstd/vector>
+
+//----------------------------------------------------------------------------
+vtkStandardNewMacro(vtkPVServerSIL);
+
+//----------------------------------------------------------------------------
+class vtkPVServerSILInternals
+{
+public:
+  vtkClientServerStream Result;
+};
+
+//----------------------------------------------------------------------------
+vtkPVServerSIL::vtkPVServerSIL()
+{
+  this->Internal = new vtkPVServerSILInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkPVServerSIL::~vtkPVServerSIL()
+{
+  delete this->Internal;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVServerSIL::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os,indent);
+}
+
+//----------------------------------------------------------------------------
+const vtkClientServerStream& vtkPVServerSIL::GetSIL(
+  vtkAlgorithm* algo, int root, int depth)
+{
+  vtkPVSILInformation* info = vtkPVSILInformation::New();
+  info->SetSubtreeRoot(root);
+  info->SetMaximumDepth(depth);
+  if (algo)
+    {
+    info->CopyFromObject(algo);
+    }
+  else
+    {
+    vtkErrorMacro("GetSIL cannot work with a NULL reader.");
+    }
+  info->CopyToStream(&this->Internal->Result);
+  info->Delete();
+  return this->Internal->Result;
+}
+
+//----------------------------------------------------------------------------
+const vtkClientServerStream& vtkPVServerSIL::GetPath(
+  vtkAlgorithm* algo, const char* name)
+{
+  this->Internal->Result.Reset();
+  this->Internal->Result << vtkClientServerStream::Reply;
+
+  vtkPVSILInformation* info = vtkPVSILInformation::New();
+  if (algo && name)
+    {
+    info->CopyFromObject(algo);
+    }
+  else
+    {
+    vtkErrorMacro("GetPath needs a reader and a vertex name.");
+    }
+  vtkGraph* sil = info->GetSIL();
+  vtkStringArray* names = sil? vtkStringArray::SafeDownCast(
+    sil->GetVertexData()->GetAbstractArray("Names")) : 0;
+  vtkDataArray* crossEdges = sil? vtkDataArray::SafeDownCast(
+    sil->GetEdgeData()->GetAbstractArray("CrossEdges")) : 0;
+  vtkIdType numVertices = sil? sil->GetNumberOfVertices() : 0;
+
+  vtkIdType vertex = -1;
+  for (vtkIdType cc = 0; names && crossEdges && cc < numVertices; ++cc)
+    {
+    if (names->GetValue(cc) == name)
+      {
+      vertex = cc;
+      }
+    }
+
+  if (vertex >= 0)
+    {
+    // Breadth first walk of the child edges from the root, the way
+    // vtkPVSILInformation gathers subtrees.
+    vtkstd::vector<vtkIdType> parents(numVertices, -1);
+    vtkstd::vector<vtkIdType> queue;
+    queue.push_back(0);
+    parents[0] = 0;
+    vtkSmartPointer<vtkOutEdgeIterator> iter =
+      vtkSmartPointer<vtkOutEdgeIterator>::New();
+    for (size_t cc = 0; cc < queue.size() && parents[vertex] == -1; ++cc)
+      {
+      sil->GetOutEdges(queue[cc], iter);
+      while (iter->HasNext())
+        {
+        vtkOutEdgeType edge = iter->Next();
+        if (crossEdges->GetTuple1(edge.Id) == 0 && parents[edge.Target] == -1)
+          {
+          parents[edge.Target] = queue[cc];
+          queue.push_back(edge.Target);
+          }
+        }
+      }
+
+    vtkstd::vector<vtkIdType> path;
+    if (parents[vertex] != -1)
+      {
+      path.push_back(vertex);
+      while (path.back() != 0)
+        {
+        path.push_back(parents[path.back()]);
+        }
+      }
+    for (size_t cc = path.size(); cc > 0; --cc)
+      {
+      this->Internal->Result << static_cast<int>(path[cc-1]);
+      }
+    }
+
+  this->Internal->Result << vtkClientServerStream::End;
+  info->Delete();
+  return this->Internal->Result;
+}
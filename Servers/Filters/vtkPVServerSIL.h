@@ -0,0 +1,62 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVServerSIL.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkPVServerSIL - Server-side helper for vtkSMSILInformationHelper.
+// .SECTION Description
+// Gathers part of the SIL of a reader with vtkPVSILInformation and sends it
+// to the client. Used to fetch the top levels of large SILs, to expand
+// their subtrees on demand and to locate a vertex below the levels fetched.
+
+#ifndef __vtkPVServerSIL_h
+#define __vtkPVServerSIL_h
+
+#include "vtkPVServerObject.h"
+
+class vtkClientServerStream;
+class vtkAlgorithm;
+class vtkPVServerSILInternals;
+
+class VTK_EXPORT vtkPVServerSIL : public vtkPVServerObject
+{
+public:
+  static vtkPVServerSIL* New();
+  vtkTypeMacro(vtkPVServerSIL, vtkPVServerObject);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Returns the SIL of the reader below the vertex root, at most depth
+  // levels deep (-1 for the whole subtree), as serialized by
+  // vtkPVSILInformation::CopyToStream().
+  const vtkClientServerStream& GetSIL(vtkAlgorithm*, int root, int depth);
+
+  // Description:
+  // Returns the ids of the vertices on the path of child edges from the root
+  // of the SIL of the reader to the vertex with the given name (the last
+  // one with that name, as vtkSMSILModel::FindVertex() does), root first.
+  // The reply is empty if no vertex has that name.
+  const vtkClientServerStream& GetPath(vtkAlgorithm*, const char* name);
+
+protected:
+  vtkPVServerSIL();
+  ~vtkPVServerSIL();
+
+  // Internal implementation details.
+  vtkPVServerSILInternals* Internal;
+
+private:
+  vtkPVServerSIL(const vtkPVServerSIL&); // Not implemented
+  void operator=(const vtkPVServerSIL&); // Not implemented
+};
+
+#endif
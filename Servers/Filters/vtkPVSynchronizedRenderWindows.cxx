@@ -555,6 +555,15 @@ void vtkPVSynchronizedRenderWindows::ClientStartRender(vtkRenderWindow* renWin)
   // then the active window specific parameters.
   if (this->RenderEventPropagation)
     {
+    // The render must reach the server after the streams queued by an open
+    // stream transaction, which may carry the state it renders.
+    vtkRemoteConnection* rc =
+      vtkProcessModule::GetProcessModule()->GetActiveRemoteConnection();
+    if (rc)
+      {
+      rc->FlushStreams();
+      }
+
     // Tell the server-root to start rendering.
     vtkMultiProcessStream stream;
     stream << this->Internals->GetKey(renWin);
@@ -0,0 +1,387 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkProgressiveProjectedTetrahedraMapper.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkProgressiveProjectedTetrahedraMapper.h"
+
+#include "vtkCamera.h"
+#include "vtkCellData.h"
+#include "vtkMatrix4x4.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkProjectedTetrahedraMapper.h"
+#include "vtkRenderer.h"
+#include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkVolume.h"
+#include "vtkVolumeProperty.h"
+
+#include <vtkstd/vector>
+
+namespace
+{
+  // Number of values describing the view, see vtkInternals::ViewState.
+  const int VIEW_STATE_SIZE = 16 + 16 + 5;
+
+  // Maps a cell id to a pseudo-random value in [0, 2^32). A cell belongs to
+  // every level whose threshold is above its value, so levels are nested
+  // without storing a permutation of the cells.
+  inline vtkTypeUInt32 vtkCellHash(vtkIdType cellId)
+    {
+    vtkTypeUInt32 h = static_cast<vtkTypeUInt32>(cellId);
+    h ^= static_cast<vtkTypeUInt32>(
+      static_cast<vtkTypeUInt64>(cellId) >> 32);
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+    }
+}
+
+class vtkProgressiveProjectedTetrahedraMapper::vtkInternals
+{
+public:
+  struct vtkLevel
+    {
+    // Fraction of the cells in this level.
+    double Fraction;
+    vtkSmartPointer<vtkUnstructuredGrid> Data;
+    vtkSmartPointer<vtkProjectedTetrahedraMapper> Mapper;
+    vtkSmartPointer<vtkVolume> Volume;
+    vtkSmartPointer<vtkVolumeProperty> Property;
+    vtkTimeStamp PropertyTime;
+    };
+
+  vtkstd::vector<vtkLevel> Levels;
+  vtkTimeStamp LevelsTime;
+  vtkUnstructuredGrid* LevelsInput;
+  vtkIdType NumberOfCells;
+  int LevelsReductionFactor;
+  int LevelsMinimumSize;
+
+  // The full grid is rendered with its own mapper and the original volume.
+  vtkSmartPointer<vtkProjectedTetrahedraMapper> FullMapper;
+
+  // Camera, volume matrix and viewport size of the last render, and the
+  // time the data or the property last changed.
+  double ViewState[VIEW_STATE_SIZE];
+  unsigned long DataMTime;
+
+  // Average render time per cell, 0 until the first render.
+  double TimePerCell;
+
+  vtkInternals()
+    {
+    this->LevelsInput = 0;
+    this->NumberOfCells = 0;
+    this->LevelsReductionFactor = 0;
+    this->LevelsMinimumSize = 0;
+    this->DataMTime = 0;
+    this->TimePerCell = 0.0;
+    for (int cc=0; cc < VIEW_STATE_SIZE; cc++)
+      {
+      this->ViewState[cc] = 0.0;
+      }
+    this->FullMapper = vtkSmartPointer<vtkProjectedTetrahedraMapper>::New();
+    }
+
+  void GetViewState(vtkRenderer* ren, vtkVolume* vol,
+    double state[VIEW_STATE_SIZE])
+    {
+    vtkCamera* camera = ren->GetActiveCamera();
+    vtkMatrix4x4* view = camera->GetViewTransformMatrix();
+    vtkMatrix4x4* matrix = vol->GetMatrix();
+    for (int cc=0; cc < 16; cc++)
+      {
+      state[cc] = view->Element[cc/4][cc%4];
+      state[16+cc] = matrix->Element[cc/4][cc%4];
+      }
+    int* size = ren->GetSize();
+    state[32] = camera->GetViewAngle();
+    state[33] = camera->GetParallelScale();
+    state[34] = camera->GetParallelProjection();
+    state[35] = size[0];
+    state[36] = size[1];
+    }
+};
+
+vtkStandardNewMacro(vtkProgressiveProjectedTetrahedraMapper);
+//----------------------------------------------------------------------------
+vtkProgressiveProjectedTetrahedraMapper::vtkProgressiveProjectedTetrahedraMapper()
+{
+  this->TimeBudget = 1.0;
+  this->ReductionFactor = 4;
+  this->MinimumLevelSize = 50000;
+  this->NumberOfLevels = 0;
+  this->CurrentLevel = -1;
+  this->RefinementComplete = 1;
+  this->Internals = new vtkInternals;
+}
+
+//----------------------------------------------------------------------------
+vtkProgressiveProjectedTetrahedraMapper::~vtkProgressiveProjectedTetrahedraMapper()
+{
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkProgressiveProjectedTetrahedraMapper::ReleaseGraphicsResources(
+  vtkWindow* win)
+{
+  this->Internals->FullMapper->ReleaseGraphicsResources(win);
+  vtkstd::vector<vtkInternals::vtkLevel>::iterator iter;
+  for (iter = this->Internals->Levels.begin();
+    iter != this->Internals->Levels.end(); ++iter)
+    {
+    if (iter->Mapper)
+      {
+      iter->Mapper->ReleaseGraphicsResources(win);
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkProgressiveProjectedTetrahedraMapper::UpdateLevels(
+  vtkUnstructuredGrid* input)
+{
+  vtkInternals* internals = this->Internals;
+  if (internals->LevelsInput == input &&
+    internals->LevelsTime > input->GetMTime() &&
+    internals->LevelsReductionFactor == this->ReductionFactor &&
+    internals->LevelsMinimumSize == this->MinimumLevelSize)
+    {
+    return;
+    }
+
+  internals->Levels.clear();
+  internals->LevelsInput = input;
+  internals->LevelsReductionFactor = this->ReductionFactor;
+  internals->LevelsMinimumSize = this->MinimumLevelSize;
+  internals->NumberOfCells = input->GetNumberOfCells();
+
+  // Level sizes, coarsest first. The last level is the full grid.
+  vtkstd::vector<double> fractions;
+  double fraction = 1.0;
+  while (fraction*internals->NumberOfCells/this->ReductionFactor >=
+    this->MinimumLevelSize)
+    {
+    fraction /= this->ReductionFactor;
+    fractions.insert(fractions.begin(), fraction);
+    }
+  fractions.push_back(1.0);
+
+  internals->Levels.resize(fractions.size());
+  for (size_t cc=0; cc < fractions.size(); cc++)
+    {
+    internals->Levels[cc].Fraction = fractions[cc];
+    }
+  this->NumberOfLevels = static_cast<int>(fractions.size());
+  this->CurrentLevel = -1;
+  internals->LevelsTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkUnstructuredGrid* vtkProgressiveProjectedTetrahedraMapper::GetLevelData(
+  int level, vtkUnstructuredGrid* input)
+{
+  vtkInternals::vtkLevel& info = this->Internals->Levels[level];
+  if (info.Data)
+    {
+    return info.Data;
+    }
+
+  vtkTimerLog::MarkStartEvent("Extract Progressive Level");
+  vtkTypeUInt32 threshold = static_cast<vtkTypeUInt32>(
+    info.Fraction*4294967295.0);
+  vtkIdType numCells = input->GetNumberOfCells();
+
+  vtkUnstructuredGrid* output = vtkUnstructuredGrid::New();
+  output->SetPoints(input->GetPoints());
+  output->GetPointData()->ShallowCopy(input->GetPointData());
+  output->GetFieldData()->ShallowCopy(input->GetFieldData());
+  vtkIdType estimatedSize = static_cast<vtkIdType>(info.Fraction*numCells) + 1;
+  output->Allocate(estimatedSize);
+  vtkCellData* inCD = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(inCD, estimatedSize);
+
+  vtkIdType npts, *pts;
+  for (vtkIdType cellId=0; cellId < numCells; cellId++)
+    {
+    if (vtkCellHash(cellId) > threshold)
+      {
+      continue;
+      }
+    input->GetCellPoints(cellId, npts, pts);
+    vtkIdType newId = output->InsertNextCell(
+      input->GetCellType(cellId), npts, pts);
+    outCD->CopyData(inCD, cellId, newId);
+    }
+  output->Squeeze();
+
+  info.Data.TakeReference(output);
+  info.Mapper = vtkSmartPointer<vtkProjectedTetrahedraMapper>::New();
+  info.Mapper->SetInput(output);
+  info.Property = vtkSmartPointer<vtkVolumeProperty>::New();
+  info.Volume = vtkSmartPointer<vtkVolume>::New();
+  info.Volume->SetMapper(info.Mapper);
+  info.Volume->SetProperty(info.Property);
+  vtkTimerLog::MarkEndEvent("Extract Progressive Level");
+  return output;
+}
+
+//----------------------------------------------------------------------------
+int vtkProgressiveProjectedTetrahedraMapper::ChooseLevel(vtkRenderer* ren,
+  vtkVolume* vol)
+{
+  vtkInternals* internals = this->Internals;
+  int finest = this->NumberOfLevels - 1;
+
+  double viewState[VIEW_STATE_SIZE];
+  internals->GetViewState(ren, vol, viewState);
+  unsigned long dataMTime = this->GetMTime();
+  if (internals->LevelsTime.GetMTime() > dataMTime)
+    {
+    dataMTime = internals->LevelsTime.GetMTime();
+    }
+  if (vol->GetProperty()->GetMTime() > dataMTime)
+    {
+    dataMTime = vol->GetProperty()->GetMTime();
+    }
+
+  bool changed = (dataMTime != internals->DataMTime);
+  for (int cc=0; cc < VIEW_STATE_SIZE && !changed; cc++)
+    {
+    changed = (viewState[cc] != internals->ViewState[cc]);
+    }
+  for (int cc=0; cc < VIEW_STATE_SIZE; cc++)
+    {
+    internals->ViewState[cc] = viewState[cc];
+    }
+  internals->DataMTime = dataMTime;
+
+  if (!changed && this->CurrentLevel >= 0)
+    {
+    return this->CurrentLevel < finest? this->CurrentLevel + 1 : finest;
+    }
+
+  if (this->TimeBudget <= 0.0 || internals->TimePerCell <= 0.0)
+    {
+    // Nothing measured yet: start from the coarsest level so that the first
+    // image shows up quickly.
+    return this->TimeBudget <= 0.0? finest : 0;
+    }
+
+  double budget = this->TimeBudget;
+  if (vol->GetAllocatedRenderTime() > 0.0 &&
+    vol->GetAllocatedRenderTime() < budget)
+    {
+    budget = vol->GetAllocatedRenderTime();
+    }
+  int level = finest;
+  while (level > 0 && internals->TimePerCell*
+    internals->Levels[level].Fraction*internals->NumberOfCells > budget)
+    {
+    level--;
+    }
+  return level;
+}
+
+//----------------------------------------------------------------------------
+void vtkProgressiveProjectedTetrahedraMapper::Render(vtkRenderer* ren,
+  vtkVolume* vol)
+{
+  vtkUnstructuredGrid* input = this->GetInput();
+  if (!input)
+    {
+    return;
+    }
+  input->Update();
+  if (input->GetNumberOfCells() == 0)
+    {
+    return;
+    }
+
+  vtkInternals* internals = this->Internals;
+  this->UpdateLevels(input);
+  int level = this->ChooseLevel(ren, vol);
+  int finest = this->NumberOfLevels - 1;
+
+  vtkProjectedTetrahedraMapper* mapper;
+  vtkVolume* volume;
+  if (level == finest)
+    {
+    mapper = internals->FullMapper;
+    mapper->SetInput(input);
+    volume = vol;
+    }
+  else
+    {
+    this->GetLevelData(level, input);
+    vtkInternals::vtkLevel& info = internals->Levels[level];
+    mapper = info.Mapper;
+    volume = info.Volume;
+
+    // Fewer cells cover a ray: make each of them proportionally more
+    // opaque.
+    vtkVolumeProperty* property = vol->GetProperty();
+    if (property->GetMTime() > info.PropertyTime)
+      {
+      info.Property->DeepCopy(property);
+      info.Property->SetScalarOpacityUnitDistance(
+        property->GetScalarOpacityUnitDistance()*info.Fraction);
+      info.PropertyTime.Modified();
+      }
+    volume->SetUserMatrix(vol->GetMatrix());
+    }
+  mapper->SetScalarMode(this->ScalarMode);
+  if (this->ArrayAccessMode == VTK_GET_ARRAY_BY_ID)
+    {
+    mapper->SelectScalarArray(this->ArrayId);
+    }
+  else
+    {
+    mapper->SelectScalarArray(this->ArrayName);
+    }
+
+  double startTime = vtkTimerLog::GetUniversalTime();
+  mapper->Render(ren, volume);
+  double elapsed = vtkTimerLog::GetUniversalTime() - startTime;
+
+  double timePerCell = elapsed/
+    (internals->Levels[level].Fraction*internals->NumberOfCells);
+  internals->TimePerCell = (internals->TimePerCell > 0.0)?
+    0.5*(internals->TimePerCell + timePerCell) : timePerCell;
+
+  this->CurrentLevel = level;
+  this->RefinementComplete = (level == finest)? 1 : 0;
+  this->TimeToDraw = elapsed;
+  vtkTimerLog::FormatAndMarkEvent("Progressive tetrahedra level %d of %d",
+    level + 1, this->NumberOfLevels);
+}
+
+//----------------------------------------------------------------------------
+void vtkProgressiveProjectedTetrahedraMapper::PrintSelf(ostream& os,
+  vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "TimeBudget: " << this->TimeBudget << endl;
+  os << indent << "ReductionFactor: " << this->ReductionFactor << endl;
+  os << indent << "MinimumLevelSize: " << this->MinimumLevelSize << endl;
+  os << indent << "NumberOfLevels: " << this->NumberOfLevels << endl;
+  os << indent << "CurrentLevel: " << this->CurrentLevel << endl;
+  os << indent << "RefinementComplete: " << this->RefinementComplete << endl;
+}
@@ -0,0 +1,123 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkProgressiveProjectedTetrahedraMapper.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkProgressiveProjectedTetrahedraMapper - projected tetrahedra
+// volume mapper that refines over successive renders.
+// .SECTION Description
+// vtkProgressiveProjectedTetrahedraMapper renders an unstructured grid with
+// vtkProjectedTetrahedraMapper, starting from a sampled subset of the cells
+// when rendering all of them would exceed the TimeBudget.
+//
+// The cells are shuffled once per data update. Level i holds the first
+// N/ReductionFactor^(NumberOfLevels-1-i) cells of that order, so each level
+// contains the previous one and the last level is the full grid. The
+// opacity unit distance of the sampled levels is scaled by the fraction of
+// cells they hold, which keeps the expected opacity along a ray the same.
+//
+// When the view, the data or the volume property changes, the mapper starts
+// from the finest level that it expects to render within the TimeBudget,
+// based on the time per cell measured in earlier renders. Every further
+// render without changes uses the next level, until the full grid is
+// rendered. RefinementComplete tells whether the last render was exact;
+// views keep re-rendering while it is off.
+// .SECTION See Also
+// vtkProjectedTetrahedraMapper vtkSMUnstructuredGridVolumeRepresentationProxy
+
+#ifndef __vtkProgressiveProjectedTetrahedraMapper_h
+#define __vtkProgressiveProjectedTetrahedraMapper_h
+
+#include "vtkUnstructuredGridVolumeMapper.h"
+
+class vtkUnstructuredGrid;
+
+class VTK_EXPORT vtkProgressiveProjectedTetrahedraMapper :
+  public vtkUnstructuredGridVolumeMapper
+{
+public:
+  static vtkProgressiveProjectedTetrahedraMapper* New();
+  vtkTypeMacro(vtkProgressiveProjectedTetrahedraMapper,
+    vtkUnstructuredGridVolumeMapper);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Time, in seconds, a render should take. The full grid is always
+  // rendered when this is 0. Default is 1.
+  vtkSetClampMacro(TimeBudget, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(TimeBudget, double);
+
+  // Description:
+  // Ratio between the number of cells of consecutive levels. Default is 4.
+  vtkSetClampMacro(ReductionFactor, int, 2, 64);
+  vtkGetMacro(ReductionFactor, int);
+
+  // Description:
+  // Grids with fewer cells than this are always rendered in full, and the
+  // coarsest level has at least this many cells. Default is 50000.
+  vtkSetClampMacro(MinimumLevelSize, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MinimumLevelSize, int);
+
+  // Description:
+  // Levels built for the current input, and the one used by the last
+  // render.
+  vtkGetMacro(NumberOfLevels, int);
+  vtkGetMacro(CurrentLevel, int);
+
+  // Description:
+  // True when the last render used the full grid.
+  vtkGetMacro(RefinementComplete, int);
+
+//BTX
+  // Description:
+  // WARNING: INTERNAL METHOD - NOT INTENDED FOR GENERAL USE
+  virtual void Render(vtkRenderer* ren, vtkVolume* vol);
+
+  // Description:
+  // WARNING: INTERNAL METHOD - NOT INTENDED FOR GENERAL USE
+  // Release any graphics resources that are being consumed by this mapper.
+  virtual void ReleaseGraphicsResources(vtkWindow*);
+
+protected:
+  vtkProgressiveProjectedTetrahedraMapper();
+  ~vtkProgressiveProjectedTetrahedraMapper();
+
+  // Description:
+  // Plans the levels and shuffles the cells when the input changed.
+  void UpdateLevels(vtkUnstructuredGrid* input);
+
+  // Description:
+  // Returns the grid of a sampled level, extracting it on first use.
+  vtkUnstructuredGrid* GetLevelData(int level, vtkUnstructuredGrid* input);
+
+  // Description:
+  // Returns the level to render: the next one when nothing changed since
+  // the last render, or the finest one fitting the time budget otherwise.
+  int ChooseLevel(vtkRenderer* ren, vtkVolume* vol);
+
+  double TimeBudget;
+  int ReductionFactor;
+  int MinimumLevelSize;
+  int NumberOfLevels;
+  int CurrentLevel;
+  int RefinementComplete;
+
+  class vtkInternals;
+  vtkInternals* Internals;
+
+private:
+  vtkProgressiveProjectedTetrahedraMapper(const vtkProgressiveProjectedTetrahedraMapper&); // Not implemented
+  void operator=(const vtkProgressiveProjectedTetrahedraMapper&); // Not implemented
+//ETX
+};
+
+#endif
@@ -0,0 +1,1003 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkQuadricLODHierarchy.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkQuadricLODHierarchy.h"
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkMath.h"
+#include "vtkMultiThreader.h"
+#include "vtkObjectFactory.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkQuadricClustering.h"
+#include "vtkSmartPointer.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
+
+// Below this number of triangles per thread, the binning is not split.
+static const vtkIdType vtkQuadricLODHierarchyMinimumTrianglesPerThread = 65536;
+
+// Upper bound on the memory used by the per-thread accumulators.
+static const double vtkQuadricLODHierarchyAccumulatorBudget = 1024.0*1024*1024;
+
+//----------------------------------------------------------------------------
+// Result of clustering one level: the output points (picked among the input
+// points), the output triangles and, for the point and cell data, the points
+// and cells of the original input they come from.
+class vtkQuadricLODHierarchyMesh
+{
+public:
+  vtkstd::vector<double> Points;
+  vtkstd::vector<vtkIdType> Triangles;
+  vtkstd::vector<vtkIdType> PointIds;
+  vtkstd::vector<vtkIdType> CellIds;
+};
+
+//----------------------------------------------------------------------------
+// Read-only view of the data being clustered. Level 0 reads the input
+// vtkPolyData, the coarser levels read the mesh of the previous level.
+// Nothing in here touches reference counts so that it can be used from the
+// background thread.
+class vtkQuadricLODHierarchySource
+{
+public:
+  struct Segment
+    {
+    const vtkIdType* Connectivity;
+    vtkIdType NumberOfCells;
+    vtkIdType CellOffset;
+    bool Strips;
+    };
+
+  // A range of cells of one segment, processed by one thread.
+  struct Chunk
+    {
+    int Segment;
+    const vtkIdType* Connectivity;
+    vtkIdType FirstCell;
+    vtkIdType NumberOfCells;
+    };
+
+  vtkDataArray* PointArray;
+  const double* RawPoints;
+  vtkIdType NumberOfPoints;
+  vtkstd::vector<Segment> Segments;
+  const vtkIdType* PointIds;
+  const vtkIdType* CellIds;
+  double Bounds[6];
+
+  vtkQuadricLODHierarchySource()
+    {
+    this->PointArray = 0;
+    this->RawPoints = 0;
+    this->NumberOfPoints = 0;
+    this->PointIds = 0;
+    this->CellIds = 0;
+    }
+
+  void GetPoint(vtkIdType id, double x[3]) const
+    {
+    if (this->RawPoints)
+      {
+      x[0] = this->RawPoints[3*id];
+      x[1] = this->RawPoints[3*id+1];
+      x[2] = this->RawPoints[3*id+2];
+      }
+    else
+      {
+      this->PointArray->GetTuple(id, x);
+      }
+    }
+
+  vtkIdType GetNumberOfTriangles() const
+    {
+    // Exact for triangle meshes, an estimate otherwise. Only used to decide
+    // how many threads to use.
+    vtkIdType count = 0;
+    for (size_t cc = 0; cc < this->Segments.size(); cc++)
+      {
+      count += this->Segments[cc].NumberOfCells;
+      }
+    return count;
+    }
+
+  void Split(vtkIdType cellsPerChunk, vtkstd::vector<Chunk>& chunks) const
+    {
+    for (size_t cc = 0; cc < this->Segments.size(); cc++)
+      {
+      const Segment& segment = this->Segments[cc];
+      const vtkIdType* conn = segment.Connectivity;
+      for (vtkIdType cellId = 0; cellId < segment.NumberOfCells; cellId++)
+        {
+        if (cellId % cellsPerChunk == 0)
+          {
+          Chunk chunk;
+          chunk.Segment = static_cast<int>(cc);
+          chunk.Connectivity = conn;
+          chunk.FirstCell = cellId;
+          chunk.NumberOfCells = vtkstd::min(cellsPerChunk,
+            segment.NumberOfCells - cellId);
+          chunks.push_back(chunk);
+          }
+        conn += *conn + 1;
+        }
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Quadric coefficients accumulated in a bin: the symmetric matrix A (6
+// values) and the vector b (3 values) of the error x'Ax + 2b'x + c.
+#define VTK_QUADRIC_SIZE 9
+
+//----------------------------------------------------------------------------
+class vtkQuadricLODHierarchyClustering
+{
+public:
+  const vtkQuadricLODHierarchySource* Source;
+  vtkMultiThreader* Threader;
+  int Divisions[3];
+  double Origin[3];
+  double Spacing[3];
+
+  // Bin of each source point, first as a global bin index, then as an index
+  // in Bins.
+  vtkstd::vector<vtkIdType> PointBins;
+  // Global index of the occupied bins, sorted.
+  vtkstd::vector<vtkIdType> Bins;
+
+  vtkstd::vector<vtkQuadricLODHierarchySource::Chunk> Chunks;
+  vtkstd::vector<vtkstd::vector<double> > Quadrics;
+  vtkstd::vector<vtkstd::vector<vtkIdType> > ChunkTriangles;
+  vtkstd::vector<vtkstd::vector<vtkIdType> > ChunkCellIds;
+  vtkstd::vector<double> Representatives;
+  vtkstd::vector<vtkstd::vector<double> > BestDistances;
+  vtkstd::vector<vtkstd::vector<vtkIdType> > BestPoints;
+
+  int Pass;
+  int NumberOfThreads;
+
+  enum
+    {
+    BIN_POINTS,
+    COMPACT_BINS,
+    ACCUMULATE,
+    REPRESENTATIVES,
+    PICK_POINTS
+    };
+
+  void Execute(vtkQuadricLODHierarchyMesh& mesh);
+  void Run(int pass);
+  void RunPass(int thread, int numThreads);
+
+  vtkIdType BinOf(const double x[3]) const
+    {
+    int ijk[3];
+    for (int cc = 0; cc < 3; cc++)
+      {
+      ijk[cc] = this->Spacing[cc] > 0.0?
+        static_cast<int>((x[cc] - this->Origin[cc]) / this->Spacing[cc]) : 0;
+      ijk[cc] = ijk[cc] < 0? 0 :
+        (ijk[cc] >= this->Divisions[cc]? this->Divisions[cc]-1 : ijk[cc]);
+      }
+    return ijk[0] + static_cast<vtkIdType>(this->Divisions[0])*
+      (ijk[1] + static_cast<vtkIdType>(this->Divisions[1])*ijk[2]);
+    }
+
+  void AddTriangle(vtkIdType p0, vtkIdType p1, vtkIdType p2, vtkIdType cellId,
+    double* quadrics, vtkstd::vector<vtkIdType>& triangles,
+    vtkstd::vector<vtkIdType>& cellIds);
+  void ComputeRepresentative(vtkIdType bin, const double* quadric,
+    double x[3]);
+};
+
+//----------------------------------------------------------------------------
+static VTK_THREAD_RETURN_TYPE vtkQuadricLODHierarchyClusteringThread(void* arg)
+{
+  vtkMultiThreader::ThreadInfo* info =
+    static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+  vtkQuadricLODHierarchyClustering* self =
+    static_cast<vtkQuadricLODHierarchyClustering*>(info->UserData);
+  self->RunPass(info->ThreadID, info->NumberOfThreads);
+  return VTK_THREAD_RETURN_VALUE;
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODHierarchyClustering::Run(int pass)
+{
+  this->Pass = pass;
+  if (this->NumberOfThreads <= 1)
+    {
+    this->RunPass(0, 1);
+    return;
+    }
+  this->Threader->SetNumberOfThreads(this->NumberOfThreads);
+  this->Threader->SetSingleMethod(
+    ::vtkQuadricLODHierarchyClusteringThread, this);
+  this->Threader->SingleMethodExecute();
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODHierarchyClustering::AddTriangle(
+  vtkIdType p0, vtkIdType p1, vtkIdType p2, vtkIdType cellId,
+  double* quadrics, vtkstd::vector<vtkIdType>& triangles,
+  vtkstd::vector<vtkIdType>& cellIds)
+{
+  vtkIdType bins[3] = { this->PointBins[p0], this->PointBins[p1],
+    this->PointBins[p2] };
+
+  double x0[3], x1[3], x2[3];
+  this->Source->GetPoint(p0, x0);
+  this->Source->GetPoint(p1, x1);
+  this->Source->GetPoint(p2, x2);
+  double e1[3] = { x1[0]-x0[0], x1[1]-x0[1], x1[2]-x0[2] };
+  double e2[3] = { x2[0]-x0[0], x2[1]-x0[1], x2[2]-x0[2] };
+  double n[3];
+  vtkMath::Cross(e1, e2, n);
+  double length = vtkMath::Normalize(n);
+  if (length > 0.0)
+    {
+    // The plane quadric is weighted by the area of the triangle.
+    double w = 0.5*length;
+    double d = -vtkMath::Dot(n, x0);
+    double q[VTK_QUADRIC_SIZE] = {
+      w*n[0]*n[0], w*n[0]*n[1], w*n[0]*n[2],
+      w*n[1]*n[1], w*n[1]*n[2], w*n[2]*n[2],
+      w*d*n[0], w*d*n[1], w*d*n[2] };
+    for (int cc = 0; cc < 3; cc++)
+      {
+      double* binQuadric = quadrics + VTK_QUADRIC_SIZE*bins[cc];
+      for (int kk = 0; kk < VTK_QUADRIC_SIZE; kk++)
+        {
+        binQuadric[kk] += q[kk];
+        }
+      }
+    }
+
+  if (bins[0] != bins[1] && bins[1] != bins[2] && bins[0] != bins[2])
+    {
+    triangles.push_back(bins[0]);
+    triangles.push_back(bins[1]);
+    triangles.push_back(bins[2]);
+    cellIds.push_back(cellId);
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODHierarchyClustering::ComputeRepresentative(
+  vtkIdType bin, const double* q, double x[3])
+{
+  // Start at the center of the bin and move to the point minimizing the
+  // quadric error, ignoring the directions in which the quadric is
+  // (almost) flat, as vtkQuadricClustering does.
+  vtkIdType global = this->Bins[bin];
+  vtkIdType ij = static_cast<vtkIdType>(this->Divisions[0])*this->Divisions[1];
+  vtkIdType ijk[3] = { global % this->Divisions[0],
+    (global % ij) / this->Divisions[0], global / ij };
+  for (int cc = 0; cc < 3; cc++)
+    {
+    x[cc] = this->Origin[cc] + (ijk[cc] + 0.5)*this->Spacing[cc];
+    }
+
+  double a0[3] = { q[0], q[1], q[2] };
+  double a1[3] = { q[1], q[3], q[4] };
+  double a2[3] = { q[2], q[4], q[5] };
+  double* A[3] = { a0, a1, a2 };
+  double r[3];
+  for (int cc = 0; cc < 3; cc++)
+    {
+    r[cc] = -(q[6+cc] + A[cc][0]*x[0] + A[cc][1]*x[1] + A[cc][2]*x[2]);
+    }
+
+  double v0[3], v1[3], v2[3];
+  double* V[3] = { v0, v1, v2 };
+  double w[3];
+  if (!vtkMath::Jacobi(A, w, V) || w[0] <= 0.0)
+    {
+    return;
+    }
+  for (int ii = 0; ii < 3; ii++)
+    {
+    if (w[ii] < 1.0e-3*w[0])
+      {
+      continue;
+      }
+    double dot = V[0][ii]*r[0] + V[1][ii]*r[1] + V[2][ii]*r[2];
+    for (int cc = 0; cc < 3; cc++)
+      {
+      x[cc] += V[cc][ii]*dot/w[ii];
+      }
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODHierarchyClustering::RunPass(int thread, int numThreads)
+{
+  const vtkQuadricLODHierarchySource* source = this->Source;
+  vtkIdType numPts = source->NumberOfPoints;
+  vtkIdType numBins = static_cast<vtkIdType>(this->Bins.size());
+  vtkIdType begin, end, cc;
+
+  switch (this->Pass)
+    {
+  case BIN_POINTS:
+    begin = numPts*thread/numThreads;
+    end = numPts*(thread+1)/numThreads;
+    for (cc = begin; cc < end; cc++)
+      {
+      double x[3];
+      source->GetPoint(cc, x);
+      this->PointBins[cc] = this->BinOf(x);
+      }
+    break;
+
+  case COMPACT_BINS:
+    begin = numPts*thread/numThreads;
+    end = numPts*(thread+1)/numThreads;
+    for (cc = begin; cc < end; cc++)
+      {
+      this->PointBins[cc] = vtkstd::lower_bound(this->Bins.begin(),
+        this->Bins.end(), this->PointBins[cc]) - this->Bins.begin();
+      }
+    break;
+
+  case ACCUMULATE:
+    {
+    double* quadrics = &this->Quadrics[thread][0];
+    for (size_t chunkId = thread; chunkId < this->Chunks.size();
+      chunkId += numThreads)
+      {
+      const vtkQuadricLODHierarchySource::Chunk& chunk = this->Chunks[chunkId];
+      const vtkQuadricLODHierarchySource::Segment& segment =
+        source->Segments[chunk.Segment];
+      vtkstd::vector<vtkIdType>& triangles = this->ChunkTriangles[chunkId];
+      vtkstd::vector<vtkIdType>& cellIds = this->ChunkCellIds[chunkId];
+      const vtkIdType* conn = chunk.Connectivity;
+      for (vtkIdType cellId = chunk.FirstCell;
+        cellId < chunk.FirstCell + chunk.NumberOfCells; cellId++)
+        {
+        vtkIdType npts = conn[0];
+        const vtkIdType* pts = conn + 1;
+        vtkIdType sourceCellId = segment.CellOffset + cellId;
+        if (source->CellIds)
+          {
+          sourceCellId = source->CellIds[sourceCellId];
+          }
+        for (vtkIdType kk = 0; kk + 2 < npts; kk++)
+          {
+          if (!segment.Strips)
+            {
+            this->AddTriangle(pts[0], pts[kk+1], pts[kk+2], sourceCellId,
+              quadrics, triangles, cellIds);
+            }
+          else if (kk % 2 == 0)
+            {
+            this->AddTriangle(pts[kk], pts[kk+1], pts[kk+2], sourceCellId,
+              quadrics, triangles, cellIds);
+            }
+          else
+            {
+            this->AddTriangle(pts[kk+1], pts[kk], pts[kk+2], sourceCellId,
+              quadrics, triangles, cellIds);
+            }
+          }
+        conn += npts + 1;
+        }
+      }
+    }
+    break;
+
+  case REPRESENTATIVES:
+    begin = numBins*thread/numThreads;
+    end = numBins*(thread+1)/numThreads;
+    for (cc = begin; cc < end; cc++)
+      {
+      // Merge the accumulators of all the threads into the first one.
+      double* q = &this->Quadrics[0][VTK_QUADRIC_SIZE*cc];
+      for (size_t tt = 1; tt < this->Quadrics.size(); tt++)
+        {
+        const double* other = &this->Quadrics[tt][VTK_QUADRIC_SIZE*cc];
+        for (int kk = 0; kk < VTK_QUADRIC_SIZE; kk++)
+          {
+          q[kk] += other[kk];
+          }
+        }
+      this->ComputeRepresentative(cc, q, &this->Representatives[3*cc]);
+      }
+    break;
+
+  case PICK_POINTS:
+    {
+    double* best = &this->BestDistances[thread][0];
+    vtkIdType* bestPoints = &this->BestPoints[thread][0];
+    begin = numPts*thread/numThreads;
+    end = numPts*(thread+1)/numThreads;
+    for (cc = begin; cc < end; cc++)
+      {
+      double x[3];
+      source->GetPoint(cc, x);
+      vtkIdType bin = this->PointBins[cc];
+      double dist = vtkMath::Distance2BetweenPoints(x,
+        &this->Representatives[3*bin]);
+      if (bestPoints[bin] < 0 || dist < best[bin])
+        {
+        best[bin] = dist;
+        bestPoints[bin] = cc;
+        }
+      }
+    }
+    break;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODHierarchyClustering::Execute(vtkQuadricLODHierarchyMesh& mesh)
+{
+  const vtkQuadricLODHierarchySource* source = this->Source;
+  vtkIdType numPts = source->NumberOfPoints;
+  for (int cc = 0; cc < 3; cc++)
+    {
+    this->Origin[cc] = source->Bounds[2*cc];
+    this->Spacing[cc] = (source->Bounds[2*cc+1] - source->Bounds[2*cc]) /
+      this->Divisions[cc];
+    }
+
+  int maxThreads = this->Threader?
+    vtkMultiThreader::GetGlobalDefaultNumberOfThreads() : 1;
+  vtkIdType numTriangles = source->GetNumberOfTriangles();
+  this->NumberOfThreads = static_cast<int>(vtkstd::min(
+    static_cast<vtkIdType>(maxThreads),
+    numTriangles / vtkQuadricLODHierarchyMinimumTrianglesPerThread));
+  this->NumberOfThreads = vtkstd::max(this->NumberOfThreads, 1);
+
+  // ... bin the points and number the occupied bins ...
+  this->PointBins.resize(numPts);
+  this->Run(BIN_POINTS);
+  this->Bins = this->PointBins;
+  vtkstd::sort(this->Bins.begin(), this->Bins.end());
+  this->Bins.erase(vtkstd::unique(this->Bins.begin(), this->Bins.end()),
+    this->Bins.end());
+  this->Run(COMPACT_BINS);
+  vtkIdType numBins = static_cast<vtkIdType>(this->Bins.size());
+
+  // ... each thread accumulates the quadrics of its triangles in its own
+  // bins; fewer threads are used when the accumulators would be too big ...
+  double perThread = static_cast<double>(numBins)*
+    (VTK_QUADRIC_SIZE*sizeof(double) + sizeof(double) + sizeof(vtkIdType));
+  int affordable = static_cast<int>(
+    vtkQuadricLODHierarchyAccumulatorBudget / (perThread > 1.0? perThread : 1.0));
+  this->NumberOfThreads = vtkstd::max(1,
+    vtkstd::min(this->NumberOfThreads, affordable));
+
+  source->Split(vtkstd::max(static_cast<vtkIdType>(1),
+      numTriangles / (4*this->NumberOfThreads)), this->Chunks);
+  this->ChunkTriangles.resize(this->Chunks.size());
+  this->ChunkCellIds.resize(this->Chunks.size());
+  this->Quadrics.resize(this->NumberOfThreads);
+  for (int tt = 0; tt < this->NumberOfThreads; tt++)
+    {
+    this->Quadrics[tt].assign(VTK_QUADRIC_SIZE*numBins, 0.0);
+    }
+  this->Run(ACCUMULATE);
+
+  // ... merge the accumulators and place the representative points ...
+  this->Representatives.resize(3*numBins);
+  this->Run(REPRESENTATIVES);
+  this->Quadrics.clear();
+
+  // ... snap the representatives to the closest input point of their bin ...
+  this->BestDistances.resize(this->NumberOfThreads);
+  this->BestPoints.resize(this->NumberOfThreads);
+  for (int tt = 0; tt < this->NumberOfThreads; tt++)
+    {
+    this->BestDistances[tt].assign(numBins, 0.0);
+    this->BestPoints[tt].assign(numBins, -1);
+    }
+  this->Run(PICK_POINTS);
+  vtkstd::vector<vtkIdType>& picked = this->BestPoints[0];
+  for (size_t tt = 1; tt < this->BestPoints.size(); tt++)
+    {
+    for (vtkIdType bin = 0; bin < numBins; bin++)
+      {
+      vtkIdType other = this->BestPoints[tt][bin];
+      if (other >= 0 && (picked[bin] < 0 ||
+          this->BestDistances[tt][bin] < this->BestDistances[0][bin]))
+        {
+        picked[bin] = other;
+        this->BestDistances[0][bin] = this->BestDistances[tt][bin];
+        }
+      }
+    }
+
+  // ... only the bins used by the output triangles become output points ...
+  vtkstd::vector<vtkIdType> outputIds(numBins, -1);
+  mesh.Points.clear();
+  mesh.Triangles.clear();
+  mesh.PointIds.clear();
+  mesh.CellIds.clear();
+  for (size_t chunkId = 0; chunkId < this->Chunks.size(); chunkId++)
+    {
+    const vtkstd::vector<vtkIdType>& triangles = this->ChunkTriangles[chunkId];
+    for (size_t cc = 0; cc < triangles.size(); cc++)
+      {
+      vtkIdType bin = triangles[cc];
+      if (outputIds[bin] < 0)
+        {
+        outputIds[bin] = static_cast<vtkIdType>(mesh.PointIds.size());
+        vtkIdType pointId = picked[bin];
+        double x[3];
+        source->GetPoint(pointId, x);
+        mesh.Points.push_back(x[0]);
+        mesh.Points.push_back(x[1]);
+        mesh.Points.push_back(x[2]);
+        mesh.PointIds.push_back(source->PointIds?
+          source->PointIds[pointId] : pointId);
+        }
+      mesh.Triangles.push_back(outputIds[bin]);
+      }
+    mesh.CellIds.insert(mesh.CellIds.end(),
+      this->ChunkCellIds[chunkId].begin(), this->ChunkCellIds[chunkId].end());
+    }
+}
+
+//----------------------------------------------------------------------------
+class vtkQuadricLODHierarchy::vtkInternals
+{
+public:
+  typedef vtkstd::vector<vtkSmartPointer<vtkPolyData> > LevelsType;
+  // The output of each level, assembled from Meshes on demand.
+  LevelsType Levels;
+  vtkstd::vector<vtkQuadricLODHierarchyMesh> Meshes;
+
+  // What the hierarchy was built from.
+  void* Input;
+  unsigned long InputMTime;
+  unsigned long ParametersMTime;
+
+  // Threads binning the triangles.
+  vtkSmartPointer<vtkMultiThreader> Workers;
+
+  // Background build.
+  vtkSmartPointer<vtkMultiThreader> Spawner;
+  int BackgroundThreadId;
+  vtkSmartPointer<vtkPolyData> BackgroundInput;
+  vtkQuadricLODHierarchySource BackgroundSource;
+  int BackgroundDivisions[3];
+  int BackgroundNumberOfLevels;
+  vtkstd::vector<vtkQuadricLODHierarchyMesh> BackgroundMeshes;
+
+  vtkInternals()
+    {
+    this->Input = 0;
+    this->InputMTime = 0;
+    this->ParametersMTime = 0;
+    this->BackgroundThreadId = -1;
+    this->BackgroundNumberOfLevels = 0;
+    this->Workers = vtkSmartPointer<vtkMultiThreader>::New();
+    this->Spawner = vtkSmartPointer<vtkMultiThreader>::New();
+    }
+
+  // Returns false when the threaded clustering cannot handle the input, in
+  // which case vtkQuadricClustering is used.
+  static bool InitializeSource(vtkPolyData* input,
+    vtkQuadricLODHierarchySource& source)
+    {
+    if (input->GetNumberOfVerts() > 0 || input->GetNumberOfLines() > 0 ||
+      !input->GetPoints())
+      {
+      return false;
+      }
+    source.PointArray = input->GetPoints()->GetData();
+    source.RawPoints = 0;
+    source.NumberOfPoints = input->GetNumberOfPoints();
+    source.PointIds = 0;
+    source.CellIds = 0;
+    source.Segments.clear();
+    vtkQuadricLODHierarchySource::Segment segment;
+    segment.CellOffset = 0;
+    vtkCellArray* polys = input->GetPolys();
+    if (polys && polys->GetNumberOfCells() > 0)
+      {
+      segment.Connectivity = polys->GetPointer();
+      segment.NumberOfCells = polys->GetNumberOfCells();
+      segment.Strips = false;
+      source.Segments.push_back(segment);
+      segment.CellOffset += segment.NumberOfCells;
+      }
+    vtkCellArray* strips = input->GetStrips();
+    if (strips && strips->GetNumberOfCells() > 0)
+      {
+      segment.Connectivity = strips->GetPointer();
+      segment.NumberOfCells = strips->GetNumberOfCells();
+      segment.Strips = true;
+      source.Segments.push_back(segment);
+      }
+    input->GetBounds(source.Bounds);
+    return true;
+    }
+
+  // Builds all the levels from the source. Only uses Workers, so it can run
+  // in the background thread.
+  void BuildMeshes(const vtkQuadricLODHierarchySource& input,
+    const int inputDivisions[3], int numberOfLevels,
+    vtkstd::vector<vtkQuadricLODHierarchyMesh>& meshes)
+    {
+    meshes.clear();
+    meshes.reserve(numberOfLevels);
+    vtkQuadricLODHierarchySource source = input;
+    // Connectivity of the previous level, in vtkCellArray layout.
+    vtkstd::vector<vtkIdType> connectivity;
+    int divisions[3] = { inputDivisions[0], inputDivisions[1],
+      inputDivisions[2] };
+    for (int level = 0; level < numberOfLevels; level++)
+      {
+      meshes.push_back(vtkQuadricLODHierarchyMesh());
+      vtkQuadricLODHierarchyClustering clustering;
+      clustering.Source = &source;
+      clustering.Threader = this->Workers;
+      clustering.Divisions[0] = vtkstd::max(divisions[0], 1);
+      clustering.Divisions[1] = vtkstd::max(divisions[1], 1);
+      clustering.Divisions[2] = vtkstd::max(divisions[2], 1);
+      clustering.Execute(meshes.back());
+
+      if (!vtkQuadricLODHierarchy::CoarsenDivisions(divisions))
+        {
+        break;
+        }
+
+      // The next level is computed from this one.
+      const vtkQuadricLODHierarchyMesh& mesh = meshes.back();
+      vtkQuadricLODHierarchySource next;
+      next.RawPoints = mesh.Points.empty()? 0 : &mesh.Points[0];
+      next.NumberOfPoints = static_cast<vtkIdType>(mesh.PointIds.size());
+      next.PointIds = mesh.PointIds.empty()? 0 : &mesh.PointIds[0];
+      next.CellIds = mesh.CellIds.empty()? 0 : &mesh.CellIds[0];
+      vtkIdType numTriangles = static_cast<vtkIdType>(mesh.CellIds.size());
+      if (numTriangles == 0)
+        {
+        break;
+        }
+      // Triangles are stored without the cell sizes, so a connectivity
+      // array in vtkCellArray layout is rebuilt for the walk.
+      connectivity.clear();
+      connectivity.reserve(4*numTriangles);
+      for (vtkIdType cc = 0; cc < numTriangles; cc++)
+        {
+        connectivity.push_back(3);
+        connectivity.push_back(mesh.Triangles[3*cc]);
+        connectivity.push_back(mesh.Triangles[3*cc+1]);
+        connectivity.push_back(mesh.Triangles[3*cc+2]);
+        }
+      vtkQuadricLODHierarchySource::Segment segment;
+      segment.Connectivity = &connectivity[0];
+      segment.NumberOfCells = numTriangles;
+      segment.CellOffset = 0;
+      segment.Strips = false;
+      next.Segments.push_back(segment);
+      // Coarser levels keep the bounds of the input so that their bins nest.
+      for (int cc = 0; cc < 6; cc++)
+        {
+        next.Bounds[cc] = input.Bounds[cc];
+        }
+      source = next;
+      }
+    }
+
+  static VTK_THREAD_RETURN_TYPE BackgroundBuild(void* arg)
+    {
+    vtkMultiThreader::ThreadInfo* info =
+      static_cast<vtkMultiThreader::ThreadInfo*>(arg);
+    vtkInternals* self = static_cast<vtkInternals*>(info->UserData);
+    self->BuildMeshes(self->BackgroundSource, self->BackgroundDivisions,
+      self->BackgroundNumberOfLevels, self->BackgroundMeshes);
+    return VTK_THREAD_RETURN_VALUE;
+    }
+};
+
+vtkStandardNewMacro(vtkQuadricLODHierarchy);
+//----------------------------------------------------------------------------
+vtkQuadricLODHierarchy::vtkQuadricLODHierarchy()
+{
+  this->NumberOfDivisions[0] = 50;
+  this->NumberOfDivisions[1] = 50;
+  this->NumberOfDivisions[2] = 50;
+  this->NumberOfLevels = 1;
+  this->Level = 0;
+  this->Internals = new vtkInternals();
+  this->HierarchyParametersTime.Modified();
+}
+
+//----------------------------------------------------------------------------
+vtkQuadricLODHierarchy::~vtkQuadricLODHierarchy()
+{
+  this->WaitForBackgroundBuild();
+  delete this->Internals;
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODHierarchy::SetNumberOfDivisions(int x, int y, int z)
+{
+  if (this->NumberOfDivisions[0] != x || this->NumberOfDivisions[1] != y ||
+    this->NumberOfDivisions[2] != z)
+    {
+    this->NumberOfDivisions[0] = x;
+    this->NumberOfDivisions[1] = y;
+    this->NumberOfDivisions[2] = z;
+    this->HierarchyParametersTime.Modified();
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODHierarchy::SetNumberOfLevels(int levels)
+{
+  levels = levels < 1? 1 : levels;
+  if (this->NumberOfLevels != levels)
+    {
+    this->NumberOfLevels = levels;
+    this->HierarchyParametersTime.Modified();
+    this->Modified();
+    }
+}
+
+//----------------------------------------------------------------------------
+bool vtkQuadricLODHierarchy::CoarsenDivisions(int divisions[3])
+{
+  bool coarsened = false;
+  for (int cc = 0; cc < 3; cc++)
+    {
+    if (divisions[cc] > 2)
+      {
+      divisions[cc] = divisions[cc] / 2 < 2? 2 : divisions[cc] / 2;
+      coarsened = true;
+      }
+    }
+  return coarsened;
+}
+
+//----------------------------------------------------------------------------
+bool vtkQuadricLODHierarchy::IsHierarchyValid(vtkPolyData* input)
+{
+  return (this->Internals->Levels.size() > 0 &&
+    this->Internals->Input == input &&
+    this->Internals->InputMTime == input->GetMTime() &&
+    this->Internals->ParametersMTime ==
+    this->HierarchyParametersTime.GetMTime());
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODHierarchy::StartBackgroundBuild()
+{
+  this->WaitForBackgroundBuild();
+
+  vtkPolyData* input =
+    vtkPolyData::SafeDownCast(this->GetInputDataObject(0, 0));
+  if (!input || input->GetNumberOfCells() == 0 ||
+    this->IsHierarchyValid(input))
+    {
+    return;
+    }
+
+  vtkInternals* internals = this->Internals;
+  // The shallow copy keeps the arrays alive while the thread reads them.
+  // All the reference counting happens here, in the calling thread.
+  internals->BackgroundInput = vtkSmartPointer<vtkPolyData>::New();
+  internals->BackgroundInput->ShallowCopy(input);
+  if (!vtkInternals::InitializeSource(internals->BackgroundInput,
+      internals->BackgroundSource))
+    {
+    internals->BackgroundInput = 0;
+    return;
+    }
+
+  // Remember what is being built so that RequestData() can check the
+  // result still applies.
+  internals->Input = input;
+  internals->InputMTime = input->GetMTime();
+  internals->ParametersMTime = this->HierarchyParametersTime.GetMTime();
+  internals->Levels.clear();
+  internals->Meshes.clear();
+  for (int cc = 0; cc < 3; cc++)
+    {
+    internals->BackgroundDivisions[cc] = this->NumberOfDivisions[cc];
+    }
+  internals->BackgroundNumberOfLevels = this->NumberOfLevels;
+  internals->BackgroundThreadId = internals->Spawner->SpawnThread(
+    &vtkInternals::BackgroundBuild, internals);
+  if (internals->BackgroundThreadId < 0)
+    {
+    vtkErrorMacro("Failed to start the background LOD build.");
+    internals->BackgroundInput = 0;
+    internals->Input = 0;
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODHierarchy::WaitForBackgroundBuild()
+{
+  vtkInternals* internals = this->Internals;
+  if (internals->BackgroundThreadId < 0)
+    {
+    return;
+    }
+  internals->Spawner->TerminateThread(internals->BackgroundThreadId);
+  internals->BackgroundThreadId = -1;
+  internals->BackgroundInput = 0;
+
+  internals->Meshes.swap(internals->BackgroundMeshes);
+  internals->BackgroundMeshes.clear();
+  internals->Levels.clear();
+  internals->Levels.resize(internals->Meshes.size());
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODHierarchy::BuildHierarchy(vtkPolyData* input)
+{
+  vtkInternals* internals = this->Internals;
+  internals->Levels.clear();
+  internals->Meshes.clear();
+  internals->Input = input;
+  internals->InputMTime = input->GetMTime();
+  internals->ParametersMTime = this->HierarchyParametersTime.GetMTime();
+
+  vtkQuadricLODHierarchySource source;
+  if (vtkInternals::InitializeSource(input, source))
+    {
+    internals->BuildMeshes(source, this->NumberOfDivisions,
+      this->NumberOfLevels, internals->Meshes);
+    internals->Levels.resize(internals->Meshes.size());
+    return;
+    }
+
+  // Vertices and lines are not handled by the threaded clustering.
+  vtkSmartPointer<vtkPolyData> levelInput = vtkSmartPointer<vtkPolyData>::New();
+  levelInput->ShallowCopy(input);
+
+  int divisions[3] = { this->NumberOfDivisions[0],
+    this->NumberOfDivisions[1], this->NumberOfDivisions[2] };
+  for (int level = 0; level < this->NumberOfLevels; level++)
+    {
+    // Same settings as the "QuadricClustering" proxy used for LOD.
+    vtkQuadricClustering* decimator = vtkQuadricClustering::New();
+    decimator->SetNumberOfDivisions(divisions);
+    decimator->SetUseInputPoints(1);
+    decimator->SetCopyCellData(1);
+    decimator->SetUseInternalTriangles(0);
+    decimator->SetInput(levelInput);
+    decimator->Update();
+
+    vtkSmartPointer<vtkPolyData> decimated =
+      vtkSmartPointer<vtkPolyData>::New();
+    decimated->ShallowCopy(decimator->GetOutput());
+    decimator->Delete();
+    internals->Levels.push_back(decimated);
+
+    this->UpdateProgress(static_cast<double>(level+1)/this->NumberOfLevels);
+    if (!vtkQuadricLODHierarchy::CoarsenDivisions(divisions))
+      {
+      break;
+      }
+    levelInput = decimated;
+    }
+}
+
+//----------------------------------------------------------------------------
+vtkPolyData* vtkQuadricLODHierarchy::GetLevelOutput(int level,
+  vtkPolyData* input)
+{
+  vtkInternals* internals = this->Internals;
+  if (internals->Levels[level])
+    {
+    return internals->Levels[level];
+    }
+
+  const vtkQuadricLODHierarchyMesh& mesh = internals->Meshes[level];
+  vtkIdType numPts = static_cast<vtkIdType>(mesh.PointIds.size());
+  vtkIdType numTriangles = static_cast<vtkIdType>(mesh.CellIds.size());
+
+  vtkSmartPointer<vtkPolyData> output = vtkSmartPointer<vtkPolyData>::New();
+  vtkPoints* points = vtkPoints::New();
+  points->SetDataType(input->GetPoints()->GetDataType());
+  points->SetNumberOfPoints(numPts);
+  for (vtkIdType cc = 0; cc < numPts; cc++)
+    {
+    points->SetPoint(cc, &mesh.Points[3*cc]);
+    }
+  output->SetPoints(points);
+  points->Delete();
+
+  vtkIdTypeArray* connectivity = vtkIdTypeArray::New();
+  connectivity->SetNumberOfTuples(4*numTriangles);
+  vtkIdType* conn = connectivity->GetPointer(0);
+  for (vtkIdType cc = 0; cc < numTriangles; cc++)
+    {
+    conn[4*cc] = 3;
+    conn[4*cc+1] = mesh.Triangles[3*cc];
+    conn[4*cc+2] = mesh.Triangles[3*cc+1];
+    conn[4*cc+3] = mesh.Triangles[3*cc+2];
+    }
+  vtkCellArray* polys = vtkCellArray::New();
+  polys->SetCells(numTriangles, connectivity);
+  output->SetPolys(polys);
+  polys->Delete();
+  connectivity->Delete();
+
+  vtkPointData* inPD = input->GetPointData();
+  vtkPointData* outPD = output->GetPointData();
+  outPD->CopyAllocate(inPD, numPts);
+  for (vtkIdType cc = 0; cc < numPts; cc++)
+    {
+    outPD->CopyData(inPD, mesh.PointIds[cc], cc);
+    }
+
+  vtkCellData* inCD = input->GetCellData();
+  vtkCellData* outCD = output->GetCellData();
+  outCD->CopyAllocate(inCD, numTriangles);
+  for (vtkIdType cc = 0; cc < numTriangles; cc++)
+    {
+    outCD->CopyData(inCD, mesh.CellIds[cc], cc);
+    }
+
+  internals->Levels[level] = output;
+  return output;
+}
+
+//----------------------------------------------------------------------------
+int vtkQuadricLODHierarchy::RequestData(vtkInformation*,
+  vtkInformationVector** inputVector, vtkInformationVector* outputVector)
+{
+  vtkPolyData* input = vtkPolyData::GetData(inputVector[0], 0);
+  vtkPolyData* output = vtkPolyData::GetData(outputVector, 0);
+
+  // Pick up the result of the background build, if any. It is discarded
+  // below if the input changed in the meantime.
+  this->WaitForBackgroundBuild();
+
+  if (input->GetNumberOfCells() == 0)
+    {
+    this->Internals->Levels.clear();
+    this->Internals->Meshes.clear();
+    output->ShallowCopy(input);
+    return 1;
+    }
+
+  if (!this->IsHierarchyValid(input))
+    {
+    this->BuildHierarchy(input);
+    }
+
+  int level = this->Level;
+  if (level >= static_cast<int>(this->Internals->Levels.size()))
+    {
+    level = static_cast<int>(this->Internals->Levels.size()) - 1;
+    }
+  output->ShallowCopy(this->GetLevelOutput(level, input));
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+void vtkQuadricLODHierarchy::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfDivisions: " << this->NumberOfDivisions[0] << " "
+    << this->NumberOfDivisions[1] << " " << this->NumberOfDivisions[2] << endl;
+  os << indent << "NumberOfLevels: " << this->NumberOfLevels << endl;
+  os << indent << "Level: " << this->Level << endl;
+}
@@ -0,0 +1,121 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkQuadricLODHierarchy.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// .NAME vtkQuadricLODHierarchy - multi-resolution LOD built with quadric
+// clustering.
+// .SECTION Description
+// vtkQuadricLODHierarchy builds a hierarchy of NumberOfLevels decimations of
+// its input using vtkQuadricClustering. Level 0 uses NumberOfDivisions, and
+// each coarser level halves the number of divisions of the previous level and
+// is computed from it, so the whole hierarchy costs little more than the finest
+// level. The hierarchy is built once per input update; changing Level
+// afterwards only copies the already computed level to the output.
+// Polygons and triangle strips are clustered by several threads, each
+// accumulating the quadrics of its triangles in its own bins, the bins being
+// merged at the end. Inputs with vertices or lines use vtkQuadricClustering.
+// The build can also be started in the background with
+// StartBackgroundBuild() as soon as the input is available.
+// With NumberOfLevels set to 1 this filter behaves like vtkQuadricClustering
+// as configured for ParaView's LOD.
+// .SECTION See Also
+// vtkQuadricClustering vtkSMSimpleStrategy
+
+#ifndef __vtkQuadricLODHierarchy_h
+#define __vtkQuadricLODHierarchy_h
+
+#include "vtkPolyDataAlgorithm.h"
+
+class VTK_EXPORT vtkQuadricLODHierarchy : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkQuadricLODHierarchy* New();
+  vtkTypeMacro(vtkQuadricLODHierarchy, vtkPolyDataAlgorithm);
+  void PrintSelf(ostream& os, vtkIndent indent);
+
+  // Description:
+  // Number of divisions of the finest level. Default is 50 50 50.
+  // Changing it rebuilds the hierarchy.
+  void SetNumberOfDivisions(int x, int y, int z);
+  void SetNumberOfDivisions(int div[3])
+    { this->SetNumberOfDivisions(div[0], div[1], div[2]); }
+  vtkGetVector3Macro(NumberOfDivisions, int);
+
+  // Description:
+  // Number of levels in the hierarchy. Default is 1.
+  // Changing it rebuilds the hierarchy.
+  void SetNumberOfLevels(int);
+  vtkGetMacro(NumberOfLevels, int);
+
+  // Description:
+  // The level produced as the output, 0 being the finest. Values beyond the
+  // coarsest level select the coarsest level. Default is 0.
+  vtkSetClampMacro(Level, int, 0, VTK_LARGE_INTEGER);
+  vtkGetMacro(Level, int);
+
+  // Description:
+  // Starts building the hierarchy from the data currently at the input in a
+  // background thread, so that it is ready when the LOD is first needed.
+  // Does nothing if the hierarchy is already up to date. The next execution
+  // waits for the build to finish and uses it unless the input has changed
+  // in the meantime.
+  void StartBackgroundBuild();
+
+//BTX
+protected:
+  vtkQuadricLODHierarchy();
+  ~vtkQuadricLODHierarchy();
+
+  virtual int RequestData(vtkInformation*, 
+                          vtkInformationVector**, 
+                          vtkInformationVector*);
+
+  // Description:
+  // Rebuilds all the levels from the input.
+  void BuildHierarchy(vtkPolyData* input);
+
+  // Description:
+  // Returns true when the levels were built from the given input with the
+  // current parameters.
+  bool IsHierarchyValid(vtkPolyData* input);
+
+  // Description:
+  // Waits for the background build, if any, and takes its result.
+  void WaitForBackgroundBuild();
+
+  // Description:
+  // Returns the output for a level, assembling it on first use.
+  vtkPolyData* GetLevelOutput(int level, vtkPolyData* input);
+
+  // Description:
+  // Halves the divisions for the next level. Returns false when they cannot
+  // be reduced any further.
+  static bool CoarsenDivisions(int divisions[3]);
+
+  int NumberOfDivisions[3];
+  int NumberOfLevels;
+  int Level;
+
+  // Modified when a parameter affecting the levels changes.
+  vtkTimeStamp HierarchyParametersTime;
+
+private:
+  vtkQuadricLODHierarchy(const vtkQuadricLODHierarchy&); // Not implemented
+  void operator=(const vtkQuadricLODHierarchy&); // Not implemented
+
+  class vtkInternals;
+  vtkInternals* Internals;
+//ETX
+};
+
+#endif
@@ -20,6 +20,8 @@
 #include "vtkCellArray.h"
 #include "vtkIdTypeArray.h"
 #include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkIntArray.h"
 #include "vtkEquivalenceSet.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkMultiBlockDataSet.h"
@@ -32,11 +34,16 @@
 #include "vtkCompositeDataIterator.h"
 #include "vtkCompositeDataPipeline.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessControllerHelper.h"
+#include "vtkMultiProcessStream.h"
 
 #include <vtkstd/map>
+#include <vtkstd/algorithm>
 #include <vtkstd/vector>
 #include <vtkstd/string>
 
+#include <math.h>
+
 
 vtkStandardNewMacro( vtkRectilinearGridConnectivity );
 
@@ -520,6 +527,7 @@ vtkRectilinearGridConnectivity::vtkRectilinearGridConnectivity()
   this->DualGridBlocks    = NULL;
   this->NumberOfBlocks    = 0;
   this->DualGridsReady    = 0;
+  this->DistributedFragments = 0;
   this->DataBlocksTime    = -1.0;
   this->DualGridBounds[0] = 
   this->DualGridBounds[2] = 
@@ -800,6 +808,8 @@ void vtkRectilinearGridConnectivity::PrintSelf( ostream & os, vtkIndent indent )
   os << indent << "Volume Fraction Surface Value: " 
                << this->VolumeFractionSurfaceValue << "\n";
   os << indent << "Dual Grids Ready: " << this->DualGridsReady    << "\n";
+  os << indent << "Distributed Fragments: " 
+               << this->DistributedFragments << "\n";
   os << indent << "Number of Blocks: " << this->NumberOfBlocks    << "\n";
   os << indent << "Data Blocks Time: " << this->DataBlocksTime    << "\n";
   os << indent << "Dual Grid Bounds: " << this->DualGridBounds[0] << ", "
@@ -1109,6 +1119,18 @@ int vtkRectilinearGridConnectivity::RequestData( vtkInformation *,
     {
     // recGrids might be NULL and numBlcks might be zero in multi-process mode
     
+    if ( this->DistributedFragments &&
+         this->Controller->GetNumberOfProcesses() > 1 
+       )
+      {
+      // the distributed resolution is a collective operation that involves
+      // all processes, including those without any block
+      for ( i = 0; i < numParts; i ++ )
+        {
+        this->ResolveDistributedFragments( NULL, 0, theParts[i] );
+        }
+      }
+    else
     if ( this->Controller->GetLocalProcessId() &&     // a root process
          this->Controller->GetNumberOfProcesses() > 1 // multi-process
       )
@@ -1364,6 +1386,13 @@ void vtkRectilinearGridConnectivity::ExtractFragments
 
   int  procIndx = 0;
   int  numProcs = this->Controller->GetNumberOfProcesses();
+  if ( numProcs > 1 && this->DistributedFragments )
+    {
+    // resolve the inter-process fragments in place, leaving the polygons
+    // on this process
+    this->ResolveDistributedFragments( dualGrds, numBlcks, polyData );
+    }
+  else
   if ( numProcs > 1 )
     {
     if ( this->Controller->GetLocalProcessId() != 0 )
@@ -4262,6 +4291,522 @@ void vtkRectilinearGridConnectivity::GenerateOutputFromMultiProcesses
   tupleBuf = NULL;
 } 
 
+//-----------------------------------------------------------------------------
+// A boundary polygon sent to a rendezvous process for the distributed
+// resolution of inter-process fragments. A polygon is identified by the
+// quantized coordinates of its three smallest (lexicographically) points.
+struct vtkRectilinearGridConnectivityBoundaryFace
+{
+  vtkIdType  PointKeys[9];
+  vtkIdType  FragmentId;  // global fragment Id
+  vtkIdType  PolygonId;   // cell Id in the vtkPolyData of the source process
+  int        ProcessId;   // source process
+
+  bool SameFace( const vtkRectilinearGridConnectivityBoundaryFace & other ) const
+    {
+    for ( int i = 0; i < 9; i ++ )
+      {
+      if ( this->PointKeys[i] != other.PointKeys[i] )
+        {
+        return false;
+        }
+      }
+    return true;
+    }
+    
+  bool operator < ( const vtkRectilinearGridConnectivityBoundaryFace & other ) const
+    {
+    for ( int i = 0; i < 9; i ++ )
+      {
+      if ( this->PointKeys[i] != other.PointKeys[i] )
+        {
+        return this->PointKeys[i] < other.PointKeys[i];
+        }
+      }
+    return this->ProcessId < other.ProcessId;
+    }
+};
+
+//-----------------------------------------------------------------------------
+// This function determines whether a coordinate lies (within the tolerance)
+// on any of the sorted planes.
+static bool vtkRectilinearGridConnectivityOnPlanes
+  ( const vtkstd::vector< double > & planes, double coord, double tolerance )
+{
+  vtkstd::vector< double >::const_iterator  planeItr = 
+    vtkstd::lower_bound( planes.begin(), planes.end(), coord - tolerance );
+  return ( planeItr != planes.end() && *planeItr <= coord + tolerance );
+}
+
+//-----------------------------------------------------------------------------
+// Lexicographic comparison of two quantized points.
+static bool vtkRectilinearGridConnectivityPointLess
+  ( const vtkIdType * pntKey0, const vtkIdType * pntKey1 )
+{
+  for ( int i = 0; i < 3; i ++ )
+    {
+    if ( pntKey0[i] != pntKey1[i] )
+      {
+      return pntKey0[i] < pntKey1[i];
+      }
+    }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+void vtkRectilinearGridConnectivity::ResolveDistributedFragments
+  ( vtkRectilinearGrid ** dualGrds, int numBlcks, vtkPolyData * polyData )
+{
+  // the same tolerance as the one used by the point locators for merging 
+  // the points of the fragments extracted from multiple blocks
+  const double  tolerance = 0.0001;
+  
+  int           i, j, k;
+  int           numProcs = this->Controller->GetNumberOfProcesses();
+  int           procIndx = this->Controller->GetLocalProcessId();
+  int           tupleSiz = 1;
+  int           numArays = 1;
+  vtkIdType     cellIndx = 0;
+  vtkIdType     numCells = 0;
+  vtkIntArray * fragIdxs = vtkIntArray::SafeDownCast
+                           ( polyData->GetCellData()->GetArray( "FragmentId" ) );
+  if ( fragIdxs )
+    {
+    numCells = polyData->GetNumberOfCells();
+    }
+  
+  
+  // a process without any block has not obtained the names and component
+  // numbers of the integrable attributes, which are hence broadcast by the 
+  // first process that has them (the material volume comes first)
+  vtkstd::vector< vtkstd::string >  attrNams( 1, "MaterialVolume" );
+  vtkstd::vector< int >             numComps( 1, 1 );
+  int  layoutId = this->Internal->ComponentNumbersObtained ? procIndx : numProcs;
+  int  srcIndex = numProcs;
+  this->Controller->AllReduce
+        ( &layoutId, &srcIndex, 1, vtkCommunicator::MIN_OP );
+  if ( srcIndex < numProcs )
+    {
+    vtkMultiProcessStream  layout;
+    if ( procIndx == srcIndex )
+      {
+      layout << int( this->Internal->IntegrableAttributeNames.size() );
+      for ( i = 0; 
+            i < int( this->Internal->IntegrableAttributeNames.size() ); i ++ )
+        {
+        layout << this->Internal->IntegrableAttributeNames[i]
+               << this->Internal->ComponentNumbersPerArray[i];
+        }
+      }
+    this->Controller->Broadcast( layout, srcIndex );
+    
+    int  numNames = 0;
+    layout >> numNames;
+    for ( i = 0; i < numNames; i ++ )
+      {
+      vtkstd::string  attrName;
+      int             attrComp = 0;
+      layout >> attrName >> attrComp;
+      attrNams.push_back( attrName );
+      numComps.push_back( attrComp );
+      tupleSiz += attrComp;
+      }
+    numArays = int( attrNams.size() );
+    }
+  
+  
+  // number the fragments globally: this process owns the global fragment Ids
+  // in ( fragOfst[ procIndx ], fragOfst[ procIndx + 1 ] ] (the resolved set 0
+  // of the equivalence set is the dummy fragment)
+  int  numFrags = 0;
+  if ( this->EquivalenceSet && fragIdxs && this->FragmentValues )
+    {
+    numFrags = this->EquivalenceSet->GetNumberOfResolvedSets() - 1;
+    numFrags = ( numFrags < 0 ) ? 0 : numFrags;
+    }
+  vtkstd::vector< int >  fragCnts( numProcs,     0 );
+  vtkstd::vector< int >  fragOfst( numProcs + 1, 0 );
+  this->Controller->AllGather( &numFrags, &fragCnts[0], 1 );
+  for ( i = 0; i < numProcs; i ++ )
+    {
+    fragOfst[ i + 1 ] = fragOfst[i] + fragCnts[i];
+    }
+  
+  
+  // only a polygon lying on a boundary plane of a block may be shared with
+  // another process
+  vtkstd::vector< double >  bndPlans[3];
+  for ( i = 0; i < numBlcks; i ++ )
+    {
+    double * blckBnds = dualGrds[i]->GetBounds();
+    for ( j = 0; j < 3; j ++ )
+      {
+      bndPlans[j].push_back( blckBnds[   j << 1       ] );
+      bndPlans[j].push_back( blckBnds[ ( j << 1 ) + 1 ] );
+      }
+    }
+  for ( j = 0; j < 3; j ++ )
+    {
+    vtkstd::sort( bndPlans[j].begin(), bndPlans[j].end() );
+    }
+  
+  // route each boundary polygon to the rendezvous process determined by the 
+  // hash of its smallest point: 9 point keys, global fragment Id, cell Id
+  vtkstd::vector< vtkstd::vector< vtkIdType > >  outgoing( numProcs );
+  vtkstd::vector< vtkstd::vector< vtkIdType > >  incoming;
+  vtkIdType      numbPnts = 0;
+  vtkIdType    * pntIdxs  = NULL;
+  vtkIdType      pntKeys[5][3];
+  vtkIdType      tempKey[3];
+  double         pntCoord[3];
+  double         firstPnt[3];
+  vtkCellArray * polygons = polyData->GetPolys();
+  polygons->InitTraversal();
+  for ( cellIndx = 0; cellIndx < numCells && 
+                      polygons->GetNextCell( numbPnts, pntIdxs ); cellIndx ++ )
+    {
+    if ( numbPnts < 3 || numbPnts > 5 )
+      {
+      continue;
+      }
+    
+    int  onPlanes[3] = { 1, 1, 1 };
+    polyData->GetPoint( pntIdxs[0], firstPnt );
+    for ( i = 0; i < numbPnts; i ++ )
+      {
+      polyData->GetPoint( pntIdxs[i], pntCoord );
+      for ( j = 0; j < 3; j ++ )
+        {
+        onPlanes[j] = onPlanes[j] && 
+                      fabs( pntCoord[j] - firstPnt[j] ) <= tolerance;
+        pntKeys[i][j] = static_cast< vtkIdType >
+                        (  floor( pntCoord[j] / tolerance + 0.5 )  );
+        }
+      }
+      
+    int  bndFaced = 0;
+    for ( j = 0; j < 3 && !bndFaced; j ++ )
+      {
+      bndFaced = onPlanes[j] && vtkRectilinearGridConnectivityOnPlanes
+                                ( bndPlans[j], firstPnt[j], tolerance );
+      }
+    if ( !bndFaced )
+      {
+      continue;
+      }
+    
+    // sort the (at most five) quantized points and remove the duplicates
+    for ( i = 1; i < numbPnts; i ++ )
+    for ( j = i; j > 0 && vtkRectilinearGridConnectivityPointLess
+                          ( pntKeys[j], pntKeys[ j - 1 ] ); j -- )
+      {
+      memcpy( tempKey,          pntKeys[j],       sizeof( tempKey ) );
+      memcpy( pntKeys[j],       pntKeys[ j - 1 ], sizeof( tempKey ) );
+      memcpy( pntKeys[ j - 1 ], tempKey,          sizeof( tempKey ) );
+      }
+    int  numUniqs = 1;
+    for ( i = 1; i < numbPnts; i ++ )
+      {
+      if ( vtkRectilinearGridConnectivityPointLess
+           ( pntKeys[ numUniqs - 1 ], pntKeys[i] ) )
+        {
+        memcpy( pntKeys[ numUniqs ++ ], pntKeys[i], sizeof( tempKey ) );
+        }
+      }
+    if ( numUniqs < 3 )
+      {
+      continue;
+      }
+    
+    vtkTypeUInt64  hashCode = 
+      static_cast< vtkTypeUInt64 >( pntKeys[0][0] ) * 73856093 ^
+      static_cast< vtkTypeUInt64 >( pntKeys[0][1] ) * 19349663 ^
+      static_cast< vtkTypeUInt64 >( pntKeys[0][2] ) * 83492791;
+    vtkstd::vector< vtkIdType > & message = 
+      outgoing[  static_cast< int >( hashCode % numProcs )  ];
+    for ( i = 0; i < 3; i ++ )
+    for ( j = 0; j < 3; j ++ )
+      {
+      message.push_back( pntKeys[i][j] );
+      }
+    message.push_back( fragOfst[ procIndx ] + fragIdxs->GetValue( cellIndx ) );
+    message.push_back( cellIndx );
+    }
+  vtkMultiProcessControllerHelper::ExchangeAllToAll
+    ( this->Controller, outgoing, incoming, 9890850 );
+  
+  
+  // rendezvous: a face received twice is shared by two processes, in which 
+  // case both copies are masked and the two fragments are made equivalent
+  vtkstd::vector< vtkRectilinearGridConnectivityBoundaryFace >  bndFaces;
+  for ( i = 0; i < numProcs; i ++ )
+    {
+    vtkIdType * msgItems = incoming[i].empty() ? NULL : &incoming[i][0];
+    size_t      numItems = incoming[i].size() / 11;
+    for ( size_t itemIndx = 0; itemIndx < numItems; itemIndx ++, msgItems += 11 )
+      {
+      vtkRectilinearGridConnectivityBoundaryFace  bndFace;
+      memcpy( bndFace.PointKeys, msgItems, 9 * sizeof( vtkIdType ) );
+      bndFace.FragmentId = msgItems[9];
+      bndFace.PolygonId  = msgItems[10];
+      bndFace.ProcessId  = i;
+      bndFaces.push_back( bndFace );
+      }
+    incoming[i].clear();
+    }
+  vtkstd::sort( bndFaces.begin(), bndFaces.end() );
+  
+  vtkstd::vector< vtkIdType >  equivlnt;
+  for ( i = 0; i < numProcs; i ++ )
+    {
+    outgoing[i].clear();
+    }
+  for ( size_t faceIndx = 0; faceIndx + 1 < bndFaces.size(); faceIndx ++ )
+    {
+    vtkRectilinearGridConnectivityBoundaryFace & face0 = bndFaces[ faceIndx ];
+    vtkRectilinearGridConnectivityBoundaryFace & face1 = bndFaces[faceIndx+1];
+    if ( face0.SameFace( face1 ) && face0.ProcessId != face1.ProcessId )
+      {
+      equivlnt.push_back( face0.FragmentId );
+      equivlnt.push_back( face1.FragmentId );
+      outgoing[ face0.ProcessId ].push_back( face0.PolygonId );
+      outgoing[ face1.ProcessId ].push_back( face1.PolygonId );
+      faceIndx ++;
+      }
+    }
+  bndFaces.clear();
+  vtkMultiProcessControllerHelper::ExchangeAllToAll
+    ( this->Controller, outgoing, incoming, 9890851 );
+  
+  vtkstd::vector< unsigned char >  cellMask( numCells, 0 );
+  vtkIdType  numMasks = 0;
+  for ( i = 0; i < numProcs; i ++ )
+    {
+    for ( size_t itemIndx = 0; itemIndx < incoming[i].size(); itemIndx ++ )
+      {
+      numMasks += cellMask[ incoming[i][ itemIndx ] ] ? 0 : 1;
+      cellMask[ incoming[i][ itemIndx ] ] = 1;
+      }
+    }
+  
+  
+  // resolve the equivalences among the global fragment Ids
+  vtkstd::vector< int >  finalIds;
+  int  numFinal = vtkEquivalenceSet::ResolveDistributedEquivalences
+                  ( this->Controller, fragOfst, equivlnt, finalIds );
+  equivlnt.clear();
+  
+  
+  // sum the integrated attributes of the local fragments by the final Id and
+  // send them to the process owning the final Id (Id % numProcs), which sums
+  // the contributions of all processes and returns the totals
+  vtkstd::map< int, vtkstd::vector< double > >  fragVals;
+  vtkstd::map< int, vtkstd::vector< double > >  ownrVals;
+  vtkstd::map< int, vtkstd::vector< double > >::iterator  valsItr;
+  for ( i = 1; i <= numFrags; i ++ )
+    {
+    vtkstd::vector< double > & theVals = fragVals[ finalIds[i] ];
+    double * tupleVal = this->FragmentValues->GetPointer( i * tupleSiz );
+    theVals.resize( tupleSiz, 0.0 );
+    for ( k = 0; k < tupleSiz; k ++ )
+      {
+      theVals[k] += tupleVal[k];
+      }
+    }
+  
+  vtkstd::vector< vtkstd::vector< double > >  sendVals( numProcs );
+  vtkstd::vector< vtkstd::vector< double > >  recvVals;
+  for ( valsItr = fragVals.begin(); valsItr != fragVals.end(); valsItr ++ )
+    {
+    vtkstd::vector< double > & message = sendVals[ valsItr->first % numProcs ];
+    message.push_back( valsItr->first );
+    message.insert( message.end(), valsItr->second.begin(), 
+                                   valsItr->second.end() );
+    }
+  vtkMultiProcessControllerHelper::ExchangeAllToAll
+    ( this->Controller, sendVals, recvVals, 9890852 );
+    
+  for ( i = 0; i < numProcs; i ++ )
+    {
+    for ( size_t itemIndx = 0; itemIndx < recvVals[i].size(); 
+          itemIndx += tupleSiz + 1 )
+      {
+      vtkstd::vector< double > & theVals = 
+        ownrVals[  static_cast< int >( recvVals[i][ itemIndx ] )  ];
+      theVals.resize( tupleSiz, 0.0 );
+      for ( k = 0; k < tupleSiz; k ++ )
+        {
+        theVals[k] += recvVals[i][ itemIndx + 1 + k ];
+        }
+      }
+    }
+  
+  // reply with the totals in the order of the requests
+  for ( i = 0; i < numProcs; i ++ )
+    {
+    sendVals[i].clear();
+    for ( size_t itemIndx = 0; itemIndx < recvVals[i].size(); 
+          itemIndx += tupleSiz + 1 )
+      {
+      vtkstd::vector< double > & theVals = 
+        ownrVals[  static_cast< int >( recvVals[i][ itemIndx ] )  ];
+      sendVals[i].insert( sendVals[i].end(), theVals.begin(), theVals.end() );
+      }
+    }
+  vtkMultiProcessControllerHelper::ExchangeAllToAll
+    ( this->Controller, sendVals, recvVals, 9890853 );
+  
+  // fragVals was sent in increasing order of the final Id, with each owner
+  // receiving an increasing subsequence
+  vtkstd::vector< size_t >  replyPos( numProcs, 0 );
+  for ( valsItr = fragVals.begin(); valsItr != fragVals.end(); valsItr ++ )
+    {
+    int  ownrIndx = valsItr->first % numProcs;
+    memcpy( &valsItr->second[0], &recvVals[ ownrIndx ][ replyPos[ownrIndx] ],
+            tupleSiz * sizeof( double ) );
+    replyPos[ ownrIndx ] += tupleSiz;
+    }
+  sendVals.clear();
+  recvVals.clear();
+  
+  
+  // assign the final fragment Ids and integrated attributes to the polygons
+  // and remove the internal (masked) ones
+  vtkstd::vector< vtkDoubleArray * >  attrVals( numArays );
+  for ( i = 0; i < numArays; i ++ )
+    {
+    attrVals[i] = vtkDoubleArray::SafeDownCast
+                  ( polyData->GetCellData()->GetArray( attrNams[i].c_str() ) );
+    }
+    
+  for ( cellIndx = 0; cellIndx < numCells; cellIndx ++ )
+    {
+    int  localIdx = fragIdxs->GetValue( cellIndx );
+    if ( cellMask[ cellIndx ] || localIdx <= 0 || localIdx > numFrags )
+      {
+      continue;
+      }
+    
+    int  finalIdx = finalIds[ localIdx ];
+    fragIdxs->SetValue( cellIndx, finalIdx );
+    
+    double * tupleVal = &fragVals[ finalIdx ][0];
+    for ( i = 0; i < numArays; i ++ )
+      {
+      if ( attrVals[i] )
+        {
+        attrVals[i]->SetTupleValue( cellIndx, tupleVal );
+        }
+      tupleVal += numComps[i];
+      }
+    }
+  fragVals.clear();
+  
+  if ( numMasks )
+    {
+    vtkCellArray * exteriors = vtkCellArray::New();
+    vtkCellData  * extrData  = vtkCellData::New();
+    exteriors->Allocate( polygons->GetSize() );
+    extrData->CopyAllocate( polyData->GetCellData(), numCells - numMasks );
+    polygons->InitTraversal();
+    for ( cellIndx = 0; polygons->GetNextCell( numbPnts, pntIdxs ); cellIndx ++ )
+      {
+      if ( !cellMask[ cellIndx ] )
+        {
+        extrData->CopyData( polyData->GetCellData(), cellIndx,
+                            exteriors->InsertNextCell( numbPnts, pntIdxs ) );
+        }
+      }
+    polyData->SetPolys( exteriors );
+    polyData->GetCellData()->ShallowCopy( extrData );
+    polyData->Squeeze();
+    exteriors->Delete();
+    extrData->Delete();
+    exteriors = NULL;
+    extrData  = NULL;
+    }
+  cellMask.clear();
+  polygons = NULL;
+  fragIdxs = NULL;
+  
+  
+  // gather the table of per-fragment attributes to the root process, which
+  // attaches it to the field data of the output part
+  vtkstd::vector< double >  tablRows;
+  for ( valsItr = ownrVals.begin(); valsItr != ownrVals.end(); valsItr ++ )
+    {
+    tablRows.push_back( valsItr->first );
+    tablRows.insert( tablRows.end(), valsItr->second.begin(), 
+                                    valsItr->second.end() );
+    }
+  ownrVals.clear();
+  
+  if ( procIndx != 0 )
+    {
+    vtkIdType  numItems = static_cast< vtkIdType >( tablRows.size() );
+    this->Controller->Send( &numItems, 1, 0, 9890854 );
+    if ( numItems )
+      {
+      this->Controller->Send( &tablRows[0], numItems, 0, 9890855 );
+      }
+    return;
+    }
+  
+  vtkIntArray * tablIdxs = vtkIntArray::New();
+  tablIdxs->SetName( "FragmentId" );
+  tablIdxs->SetNumberOfTuples( numFinal );
+  for ( i = 0; i < numArays; i ++ )
+    {
+    attrVals[i] = vtkDoubleArray::New();
+    attrVals[i]->SetName( attrNams[i].c_str() );
+    attrVals[i]->SetNumberOfComponents( numComps[i] );
+    attrVals[i]->SetNumberOfTuples( numFinal );
+    }
+  
+  for ( int srcIndx = 0; srcIndx < numProcs; srcIndx ++ )
+    {
+    if ( srcIndx )
+      {
+      vtkIdType  numItems = 0;
+      this->Controller->Receive( &numItems, 1, srcIndx, 9890854 );
+      tablRows.resize( numItems );
+      if ( numItems )
+        {
+        this->Controller->Receive
+                          ( &tablRows[0], numItems, srcIndx, 9890855 );
+        }
+      }
+    
+    for ( size_t itemIndx = 0; itemIndx < tablRows.size(); 
+          itemIndx += tupleSiz + 1 )
+      {
+      int  finalIdx = static_cast< int >( tablRows[ itemIndx ] );
+      if ( finalIdx <= 0 || finalIdx > numFinal )
+        {
+        continue;
+        }
+      
+      double * tupleVal = &tablRows[ itemIndx + 1 ];
+      tablIdxs->SetValue( finalIdx - 1, finalIdx );
+      for ( i = 0; i < numArays; i ++ )
+        {
+        attrVals[i]->SetTupleValue( finalIdx - 1, tupleVal );
+        tupleVal += numComps[i];
+        }
+      }
+    }
+  
+  polyData->GetFieldData()->AddArray( tablIdxs );
+  tablIdxs->Delete();
+  tablIdxs = NULL;
+  for ( i = 0; i < numArays; i ++ )
+    {
+    polyData->GetFieldData()->AddArray( attrVals[i] );
+    attrVals[i]->Delete();
+    attrVals[i] = NULL;
+    }
+}
+
 //-----------------------------------------------------------------------------
 // An extended marching cubes case table for generating cube faces (either
 // truncated by iso-lines or not) in addition to iso-triangles. These two
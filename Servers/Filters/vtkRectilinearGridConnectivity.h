@@ -135,12 +135,25 @@ public:
   // Add a volume array (of any type) name to the selection list.
   void  AddVolumeArrayName( char * arayName ); 
   
+  // Description:
+  // Set / get whether fragments spanning multiple processes are resolved by
+  // means of a distributed exchange of boundary faces (1) rather than by 
+  // collecting the fragments of all processes on the root process (0, the
+  // default). In the distributed mode the exterior polygons stay on the 
+  // processes that extracted them (with global fragment Ids and integrated
+  // attributes) and only a table of per-fragment integrated attributes is
+  // gathered to the root process, attached as the field data of each part.
+  vtkSetMacro( DistributedFragments, int );
+  vtkGetMacro( DistributedFragments, int );
+  vtkBooleanMacro( DistributedFragments, int );
+  
 protected:
 
   vtkRectilinearGridConnectivity();
   ~vtkRectilinearGridConnectivity();
   
   int                         DualGridsReady;
+  int                         DistributedFragments;
   int                         NumberOfBlocks;
   double                      DataBlocksTime;
   double                      DualGridBounds[6];
@@ -431,6 +444,22 @@ protected:
   void GenerateOutputFromMultiProcesses( vtkPolyData ** procPlys, 
        int numProcs, unsigned char partIndx, vtkPolyData * polyData );
   
+  // Description:
+  // Given the vtkPolyData (polyData, possibly empty) storing the fragments 
+  // extracted by this process from a number (numBlcks) of dual blocks 
+  // (dualGrds), this function resolves the fragments across all processes 
+  // without collecting them on the root process. Each polygon lying on a 
+  // boundary plane of a block is sent, keyed by the quantized coordinates of
+  // its three smallest points, to a rendezvous process that detects the faces
+  // shared by two processes. Such internal faces are removed and the global
+  // fragment Ids attached to them are made equivalent through a distributed
+  // equivalence set. The remaining polygons are then assigned with the final
+  // fragment Ids and the integrated attributes summed over all processes,
+  // while the table of per-fragment attributes is gathered to the root 
+  // process. This function must be invoked by all processes.
+  void ResolveDistributedFragments( vtkRectilinearGrid ** dualGrds, 
+       int numBlcks, vtkPolyData * polyData );
+  
   
 private:
   vtkRectilinearGridConnectivity
@@ -40,6 +40,10 @@
 #include "vtkUnsignedShortArray.h"
 #include "vtkSmartPointer.h"
 #include "vtkMultiProcessController.h"
+#include "vtkMultiProcessControllerHelper.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/vector>
 
 vtkStandardNewMacro(vtkRedistributePolyData);
 
@@ -58,6 +62,7 @@ vtkRedistributePolyData::vtkRedistributePolyData()
   this->SetController( vtkMultiProcessController::GetGlobalController() );
 
   this->ColorProc = 0;
+  this->SpaceFillingCurve = vtkRedistributePolyData::NONE;
 }
 
 vtkRedistributePolyData::~vtkRedistributePolyData()
@@ -118,7 +123,14 @@ void vtkRedistributePolyData::Execute()
 #endif
 
   vtkCommSched localSched;
-  this->MakeSchedule ( &localSched ); 
+  if (this->SpaceFillingCurve != vtkRedistributePolyData::NONE)
+    {
+    this->MakeCurveSchedule(input, &localSched);
+    }
+  else
+    {
+    this->MakeSchedule ( &localSched ); 
+    }
   this->OrderSchedule ( &localSched);  // order schedule to avoid 
   // blocking problems later
   vtkIdType ***sendCellList = localSched.SendCellList; 
@@ -589,6 +601,7 @@ void vtkRedistributePolyData::PrintSelf(ostream& os, vtkIndent indent)
     }
 
   os << indent << "ColorProc :" << this->ColorProc  << "\n";
+  os << indent << "SpaceFillingCurve :" << this->SpaceFillingCurve << "\n";
 }
 
 
@@ -638,6 +651,435 @@ void vtkRedistributePolyData::MakeSchedule ( vtkCommSched* localSched)
   localSched->KeepCellList = NULL;
 
 }
+//*****************************************************************
+// Quantization of the centroids for the curve keys: 3 x 17 bits fit
+// exactly in the mantissa of a double, so the keys are exchanged and
+// sorted as doubles.
+#define CURVE_BITS 17
+// Every process samples its sorted keys CURVE_OVERSAMPLING times per
+// process, which bounds the imbalance of the pieces to about
+// 1/CURVE_OVERSAMPLING of a piece, as long as process 0 does not receive more
+// than about CURVE_MAX_SAMPLES samples in total.
+#define CURVE_OVERSAMPLING 16
+#define CURVE_MAX_SAMPLES (1 << 20)
+
+static double vtkRedistributePolyDataMortonKey(unsigned int coords[3])
+{
+  double key = 0.;
+  for (int bit = CURVE_BITS-1; bit >= 0; bit--)
+    {
+    for (int i = 0; i < 3; i++)
+      {
+      key = 2.*key + ((coords[i] >> bit) & 1);
+      }
+    }
+  return key;
+}
+
+//*****************************************************************
+static double vtkRedistributePolyDataHilbertKey(unsigned int coords[3])
+{
+  // ... transform the coordinates into the transposed Hilbert index
+  //   (J. Skilling, "Programming the Hilbert curve", 2004) and then
+  //   interleave its bits ...
+  unsigned int M = 1u << (CURVE_BITS-1);
+  unsigned int P, Q, t;
+  int i;
+  for (Q = M; Q > 1; Q >>= 1)
+    {
+    P = Q - 1;
+    for (i = 0; i < 3; i++)
+      {
+      if (coords[i] & Q)
+        {
+        coords[0] ^= P;
+        }
+      else
+        {
+        t = (coords[0] ^ coords[i]) & P;
+        coords[0] ^= t;
+        coords[i] ^= t;
+        }
+      }
+    }
+  for (i = 1; i < 3; i++)
+    {
+    coords[i] ^= coords[i-1];
+    }
+  t = 0;
+  for (Q = M; Q > 1; Q >>= 1)
+    {
+    if (coords[2] & Q)
+      {
+      t ^= Q - 1;
+      }
+    }
+  for (i = 0; i < 3; i++)
+    {
+    coords[i] ^= t;
+    }
+  return vtkRedistributePolyDataMortonKey(coords);
+}
+
+//*****************************************************************
+// A local cell on the curve: its key, the process it goes to and its
+// index within the cell array of its type.
+struct vtkRedistributePolyDataCurveCell
+{
+  double Key;
+  int Rank;    // 0 for the cells kept, 1 + destination otherwise
+  vtkIdType CellId;
+
+  bool operator<(const vtkRedistributePolyDataCurveCell& other) const
+    {
+    if (this->Rank != other.Rank)
+      {
+      return this->Rank < other.Rank;
+      }
+    return this->Key < other.Key;
+    }
+};
+
+//*****************************************************************
+void vtkRedistributePolyData::ComputeCurveWeights(double* weights)
+{
+  int numProcs = this->Controller->GetNumberOfProcesses();
+  for (int id = 0; id < numProcs; id++)
+    {
+    weights[id] = 1.;
+    }
+}
+
+//*****************************************************************
+void vtkRedistributePolyData::MakeCurveSchedule(vtkPolyData* input,
+                                                vtkCommSched* localSched)
+{
+//*****************************************************************
+// purpose: This routine sorts the cells along a space-filling curve,
+//          cuts the curve according to the process weights and sets
+//          up a schedule so that each process receives one piece of
+//          the curve.  The input cells are reordered so that the kept
+//          cells come first, followed by the blocks sent to each
+//          process in increasing process order.
+//
+//*****************************************************************
+
+  int myId = this->Controller->GetLocalProcessId();
+  int numProcs = this->Controller->GetNumberOfProcesses();
+  int type, id;
+  vtkIdType cellId, i;
+
+  vtkCellArray* cellArrays[NUM_CELL_TYPES];
+  cellArrays[0] = input->GetVerts();
+  cellArrays[1] = input->GetLines();
+  cellArrays[2] = input->GetPolys();
+  cellArrays[3] = input->GetStrips();
+
+  vtkIdType numCells[NUM_CELL_TYPES];
+  vtkIdType totalLocalCells = 0;
+  for (type=0; type<NUM_CELL_TYPES; type++)
+    {
+    numCells[type] = cellArrays[type] ?
+      cellArrays[type]->GetNumberOfCells() : 0;
+    totalLocalCells += numCells[type];
+    }
+
+  // ... global bounds (maxima are negated to use a single reduction) ...
+  double localBounds[6] = {VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX,
+                           VTK_DOUBLE_MAX, VTK_DOUBLE_MAX, VTK_DOUBLE_MAX};
+  if (input->GetNumberOfPoints() > 0)
+    {
+    double* bounds = input->GetBounds();
+    for (i = 0; i < 3; i++)
+      {
+      localBounds[i] = bounds[2*i];
+      localBounds[i+3] = -bounds[2*i+1];
+      }
+    }
+  double globalBounds[6];
+  this->Controller->AllReduce(localBounds, globalBounds, 6, 
+                              vtkCommunicator::MIN_OP);
+  double scale[3];
+  for (i = 0; i < 3; i++)
+    {
+    double length = -globalBounds[i+3] - globalBounds[i];
+    scale[i] = length > 0. ? ((1 << CURVE_BITS) - 1) / length : 0.;
+    }
+
+  // ... key of each cell centroid ...
+  vtkstd::vector<vtkRedistributePolyDataCurveCell> cells[NUM_CELL_TYPES];
+  vtkstd::vector<double> sortedKeys;
+  sortedKeys.reserve(totalLocalCells);
+  for (type=0; type<NUM_CELL_TYPES; type++)
+    {
+    if (!numCells[type])
+      {
+      continue;
+      }
+    cells[type].resize(numCells[type]);
+    vtkIdType npts;
+    vtkIdType* pts;
+    double pt[3];
+    cellArrays[type]->InitTraversal();
+    for (cellId = 0; cellArrays[type]->GetNextCell(npts, pts); cellId++)
+      {
+      double center[3] = {0., 0., 0.};
+      for (i = 0; i < npts; i++)
+        {
+        input->GetPoint(pts[i], pt);
+        center[0] += pt[0];
+        center[1] += pt[1];
+        center[2] += pt[2];
+        }
+      unsigned int coords[3];
+      for (i = 0; i < 3; i++)
+        {
+        double c = npts > 0 ? center[i] / npts : globalBounds[i];
+        double q = (c - globalBounds[i]) * scale[i];
+        q = q < 0. ? 0. : q;
+        q = q > ((1 << CURVE_BITS) - 1) ? ((1 << CURVE_BITS) - 1) : q;
+        coords[i] = static_cast<unsigned int>(q);
+        }
+      vtkRedistributePolyDataCurveCell& cell = cells[type][cellId];
+      cell.Key = this->SpaceFillingCurve == HILBERT ?
+        vtkRedistributePolyDataHilbertKey(coords) :
+        vtkRedistributePolyDataMortonKey(coords);
+      cell.CellId = cellId;
+      cell.Rank = 0;
+      sortedKeys.push_back(cell.Key);
+      }
+    }
+  vtkstd::sort(sortedKeys.begin(), sortedKeys.end());
+
+  // ... parallel sample sort by regular sampling: every process
+  //   sends samplesPerProcess samples of its sorted keys, weighted by
+  //   the number of cells each sample stands for, to process 0, which
+  //   cuts the merged sample and broadcasts the splitters ...
+  vtkIdType samplesPerProcess = CURVE_OVERSAMPLING * numProcs;
+  if (samplesPerProcess * numProcs > CURVE_MAX_SAMPLES)
+    {
+    samplesPerProcess = CURVE_MAX_SAMPLES / numProcs;
+    samplesPerProcess = samplesPerProcess < numProcs ? 
+      numProcs : samplesPerProcess;
+    }
+  vtkIdType numSamples = samplesPerProcess;
+  vtkstd::vector<double> localSamples(2 * numSamples, 0.);
+  if (numSamples > totalLocalCells)
+    {
+    numSamples = totalLocalCells;
+    }
+  for (i = 0; i < numSamples; i++)
+    {
+    vtkIdType begin = i * totalLocalCells / numSamples;
+    vtkIdType end = (i + 1) * totalLocalCells / numSamples;
+    localSamples[2*i] = sortedKeys[(begin + end) / 2];
+    localSamples[2*i+1] = static_cast<double>(end - begin);
+    }
+  vtkstd::vector<double>().swap(sortedKeys);
+
+  vtkstd::vector<double> allSamples;
+  if (myId == 0)
+    {
+    allSamples.resize(2 * samplesPerProcess * numProcs);
+    }
+  this->Controller->Gather(&localSamples[0],
+    myId == 0 ? &allSamples[0] : 0, 2 * samplesPerProcess, 0);
+
+  // ... ComputeCurveWeights() may communicate, so every process calls it ...
+  double* weights = new double[numProcs];
+  this->ComputeCurveWeights(weights);
+  double weightSum = 0.;
+  for (id = 0; id < numProcs; id++)
+    {
+    weightSum += weights[id];
+    }
+  if (weightSum <= 0.)
+    {
+    for (id = 0; id < numProcs; id++)
+      {
+      weights[id] = 1.;
+      }
+    weightSum = numProcs;
+    }
+
+  // ... splitters[id] is the first key of the piece of process id+1 ...
+  vtkstd::vector<double> splitters(numProcs > 1 ? numProcs - 1 : 0);
+  if (myId == 0)
+    {
+    vtkstd::vector<vtkstd::pair<double, double> > samples;
+    double totalWeight = 0.;
+    for (size_t cc = 0; cc + 1 < allSamples.size(); cc += 2)
+      {
+      // Processes with fewer cells than samples pad with empty samples.
+      if (allSamples[cc+1] > 0.)
+        {
+        samples.push_back(vtkstd::pair<double, double>(
+            allSamples[cc], allSamples[cc+1]));
+        totalWeight += allSamples[cc+1];
+        }
+      }
+    vtkstd::sort(samples.begin(), samples.end());
+
+    double target = 0.;
+    double accumulated = 0.;
+    size_t next = 0;
+    for (id = 0; id < numProcs - 1; id++)
+      {
+      target += totalWeight * weights[id] / weightSum;
+      while (next < samples.size() && 
+             accumulated + samples[next].second <= target)
+        {
+        accumulated += samples[next].second;
+        next++;
+        }
+      splitters[id] = next < samples.size() ? 
+        samples[next].first : VTK_DOUBLE_MAX;
+      }
+    }
+  delete [] weights;
+  if (numProcs > 1)
+    {
+    this->Controller->Broadcast(&splitters[0], numProcs - 1, 0);
+    }
+
+  // ... destination of each cell and number of cells per destination ...
+  vtkstd::vector<vtkstd::vector<vtkIdType> > counts(numProcs);
+  for (id = 0; id < numProcs; id++)
+    {
+    counts[id].resize(NUM_CELL_TYPES, 0);
+    }
+  for (type=0; type<NUM_CELL_TYPES; type++)
+    {
+    for (cellId = 0; cellId < numCells[type]; cellId++)
+      {
+      vtkRedistributePolyDataCurveCell& cell = cells[type][cellId];
+      int dest = static_cast<int>(vtkstd::upper_bound(splitters.begin(),
+          splitters.end(), cell.Key) - splitters.begin());
+      cell.Rank = dest == myId ? 0 : dest + 1;
+      counts[dest][type]++;
+      }
+    vtkstd::sort(cells[type].begin(), cells[type].end());
+    }
+
+  // ... tell every process how many cells of each type it receives ...
+  vtkstd::vector<vtkstd::vector<vtkIdType> > received;
+  vtkMultiProcessControllerHelper::ExchangeAllToAll(this->Controller,
+    counts, received, CURVE_COUNTS_TAG);
+
+  // ... reorder the input cells (and their cell data) ...
+  vtkCellData* inputCellData = input->GetCellData();
+  vtkCellData* orderedCellData = vtkCellData::New();
+  orderedCellData->CopyGlobalIdsOn();
+  orderedCellData->CopyAllocate(inputCellData, totalLocalCells);
+  vtkIdType cellOffset = 0;
+  vtkIdType newCellId = 0;
+  for (type=0; type<NUM_CELL_TYPES; type++)
+    {
+    if (!cellArrays[type])
+      {
+      continue;
+      }
+    vtkCellArray* ordered = vtkCellArray::New();
+    ordered->Allocate(cellArrays[type]->GetNumberOfConnectivityEntries());
+    vtkIdType* cellStart = new vtkIdType[numCells[type]];
+    vtkIdType* ptr = cellArrays[type]->GetPointer();
+    for (cellId = 0; cellId < numCells[type]; cellId++)
+      {
+      cellStart[cellId] = ptr - cellArrays[type]->GetPointer();
+      ptr += *ptr + 1;
+      }
+    for (cellId = 0; cellId < numCells[type]; cellId++)
+      {
+      vtkIdType oldId = cells[type][cellId].CellId;
+      vtkIdType* cellPtr = cellArrays[type]->GetPointer() + cellStart[oldId];
+      ordered->InsertNextCell(cellPtr[0], cellPtr + 1);
+      orderedCellData->CopyData(inputCellData, cellOffset + oldId, 
+                                newCellId++);
+      }
+    delete [] cellStart;
+    cellOffset += numCells[type];
+
+    switch (type)
+      {
+      case 0: input->SetVerts(ordered); break;
+      case 1: input->SetLines(ordered); break;
+      case 2: input->SetPolys(ordered); break;
+      case 3: input->SetStrips(ordered); break;
+      }
+    ordered->Delete();
+    }
+  inputCellData->ShallowCopy(orderedCellData);
+  orderedCellData->Delete();
+
+  // ... fill the schedule ...
+  localSched->NumberOfCells = new vtkIdType[NUM_CELL_TYPES];
+  int cntSend = 0;
+  int cntRec = 0;
+  for (id = 0; id < numProcs; id++)
+    {
+    if (id == myId)
+      {
+      continue;
+      }
+    vtkIdType numSend = 0, numRec = 0;
+    for (type=0; type<NUM_CELL_TYPES; type++)
+      {
+      numSend += counts[id][type];
+      numRec += received[id][type];
+      }
+    cntSend += numSend > 0 ? 1 : 0;
+    cntRec += numRec > 0 ? 1 : 0;
+    }
+  localSched->SendCount = cntSend;
+  localSched->ReceiveCount = cntRec;
+  localSched->SendTo = new int[cntSend];
+  localSched->ReceiveFrom = new int[cntRec];
+  localSched->SendNumber = new vtkIdType*[NUM_CELL_TYPES];
+  localSched->ReceiveNumber = new vtkIdType*[NUM_CELL_TYPES];
+  localSched->SendCellList = NULL;
+  localSched->KeepCellList = NULL;
+  for (type=0; type<NUM_CELL_TYPES; type++)
+    {
+    localSched->NumberOfCells[type] = counts[myId][type];
+    localSched->SendNumber[type] = new vtkIdType[cntSend];
+    localSched->ReceiveNumber[type] = new vtkIdType[cntRec];
+    }
+
+  cntSend = 0;
+  cntRec = 0;
+  for (id = 0; id < numProcs; id++)
+    {
+    if (id == myId)
+      {
+      continue;
+      }
+    vtkIdType numSend = 0, numRec = 0;
+    for (type=0; type<NUM_CELL_TYPES; type++)
+      {
+      numSend += counts[id][type];
+      numRec += received[id][type];
+      }
+    if (numSend > 0)
+      {
+      localSched->SendTo[cntSend] = id;
+      for (type=0; type<NUM_CELL_TYPES; type++)
+        {
+        localSched->SendNumber[type][cntSend] = counts[id][type];
+        }
+      cntSend++;
+      }
+    if (numRec > 0)
+      {
+      localSched->ReceiveFrom[cntRec] = id;
+      for (type=0; type<NUM_CELL_TYPES; type++)
+        {
+        localSched->ReceiveNumber[type][cntRec] = received[id][type];
+        }
+      cntRec++;
+      }
+    }
+}
+
 //*****************************************************************
 void vtkRedistributePolyData::OrderSchedule ( vtkCommSched* localSched)
 
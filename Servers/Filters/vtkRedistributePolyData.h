@@ -49,6 +49,31 @@ public:
   vtkSetMacro(ColorProc,int);
   void SetColorProc() { this->ColorProc = 1; };
 
+//BTX
+  enum
+  {
+    NONE = 0,
+    MORTON,
+    HILBERT
+  };
+//ETX
+
+  // Description:
+  // When set to MORTON or HILBERT, the cells are not redistributed by
+  // the schedule of the subclass but sorted along the corresponding
+  // space-filling curve through their centroids; the curve is then cut
+  // into one contiguous piece per process, sized by the process
+  // weights of the subclass.  This keeps spatially close cells on the
+  // same process.  Default is NONE.
+  vtkSetClampMacro(SpaceFillingCurve, int, NONE, HILBERT);
+  vtkGetMacro(SpaceFillingCurve, int);
+  void SetSpaceFillingCurveToNone()
+    { this->SetSpaceFillingCurve(NONE); }
+  void SetSpaceFillingCurveToMorton()
+    { this->SetSpaceFillingCurve(MORTON); }
+  void SetSpaceFillingCurveToHilbert()
+    { this->SetSpaceFillingCurve(HILBERT); }
+
   // Description:
   // These are here for ParaView compatibility. Not used.
   virtual void SetSocketController(vtkSocketController*) {};
@@ -78,7 +103,9 @@ protected:
     CELL_CNT_TAG       = 150,
     CELL_TAG           = 160,
     POINTS_SIZE_TAG    = 170,
-    POINTS_TAG         = 180
+    POINTS_TAG         = 180,
+
+    CURVE_COUNTS_TAG   = 200
   };
 
   class VTK_EXPORT vtkCommSched
@@ -108,6 +135,17 @@ protected:
   virtual void MakeSchedule (vtkCommSched*);
   void OrderSchedule (vtkCommSched*);
 
+  // Description:
+  // Builds the schedule of a space-filling curve redistribution.  The
+  // cells of the input are reordered so that the kept cells come first,
+  // followed by one block per destination.
+  void MakeCurveSchedule (vtkPolyData*, vtkCommSched*);
+
+  // Description:
+  // Fills the relative share of the curve each process gets (one value
+  // per process, on all processes).  The default gives equal shares.
+  virtual void ComputeCurveWeights (double*);
+
   void SendCellSizes (vtkIdType*, vtkIdType*, vtkPolyData*, int, 
                       vtkIdType&, vtkIdType*, vtkIdType**); 
   void CopyCells (vtkIdType*,vtkPolyData*, vtkPolyData*, vtkIdType**); 
@@ -168,6 +206,7 @@ protected:
   vtkMultiProcessController *Controller;
 
   int ColorProc; // Set to 1 to color data according to processor
+  int SpaceFillingCurve;
 
 private:
   vtkRedistributePolyData(const vtkRedistributePolyData&); // Not implemented
@@ -55,6 +55,8 @@ vtkReductionFilter::vtkReductionFilter()
   this->PostGatherHelper = 0;
   this->PassThrough = -1;
   this->GenerateProcessIds = 0;
+  this->MemoryBudget = 0;
+  this->TreeReduction = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -335,6 +337,12 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
     this->PassThrough = -1;
     }
 
+  if (this->PassThrough < 0 && (this->MemoryBudget > 0 || this->TreeReduction))
+    {
+    this->StreamingReduce(preOutput, output);
+    return;
+    }
+
   vtkstd::vector<vtkSmartPointer<vtkDataObject> > data_sets;
   if (myId == 0)
     {
@@ -382,6 +390,147 @@ void vtkReductionFilter::Reduce(vtkDataObject* input, vtkDataObject* output)
     }
 }
 
+//-----------------------------------------------------------------------------
+void vtkReductionFilter::StreamingReduce(vtkDataObject* preOutput,
+  vtkDataObject* output)
+{
+  vtkMultiProcessController* controller = this->Controller;
+  int myId = controller->GetLocalProcessId();
+  int numProcs = controller->GetNumberOfProcesses();
+
+  PiecesType pieces;
+  unsigned long pendingSize = 0;
+  if (preOutput)
+    {
+    vtkSmartPointer<vtkDataObject> ds;
+    ds.TakeReference(preOutput->NewInstance());
+    ds->ShallowCopy(preOutput);
+    this->AddPiece(pieces, ds, output, pendingSize);
+    }
+
+  // Results are received in the order of the process ids so that the
+  // reduced output is the same as the one of the non-streaming reduction.
+  bool sent = false;
+  if (this->TreeReduction)
+    {
+    for (int step = 1; step < numProcs && !sent; step <<= 1)
+      {
+      if (myId & step)
+        {
+        if (this->PostGatherHelper && pieces.size() > 1)
+          {
+          this->ReducePieces(pieces, output, pendingSize);
+          }
+        this->SendPieces(myId - step, pieces);
+        sent = true;
+        }
+      else if (myId + step < numProcs)
+        {
+        this->ReceivePieces(myId + step, pieces, output, pendingSize);
+        }
+      }
+    }
+  else if (myId == 0)
+    {
+    for (int cc = 1; cc < numProcs; ++cc)
+      {
+      this->ReceivePieces(cc, pieces, output, pendingSize);
+      }
+    }
+  else
+    {
+    this->SendPieces(0, pieces);
+    sent = true;
+    }
+
+  if (sent)
+    {
+    // Like in the non-streaming case, satellites produce their own result.
+    pieces.clear();
+    if (preOutput)
+      {
+      pieces.push_back(preOutput);
+      }
+    }
+
+  if (pieces.size() > 0)
+    {
+    this->PostProcess(output, &pieces[0],
+      static_cast<unsigned int>(pieces.size()));
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkReductionFilter::AddPiece(PiecesType& pieces, vtkDataObject* piece,
+  vtkDataObject* output, unsigned long& pendingSize)
+{
+  if (!piece)
+    {
+    return;
+    }
+
+  if (!this->PostGatherHelper)
+    {
+    // Without a PostGatherHelper the output is the first result, so the root
+    // only needs to keep that one. Other nodes forward all of them.
+    if (this->Controller->GetLocalProcessId() == 0 && pieces.size() > 0)
+      {
+      return;
+      }
+    pieces.push_back(piece);
+    return;
+    }
+
+  pieces.push_back(piece);
+  pendingSize += piece->GetActualMemorySize();
+  if (this->MemoryBudget > 0 && pieces.size() > 1 &&
+    pendingSize > static_cast<unsigned long>(this->MemoryBudget))
+    {
+    this->ReducePieces(pieces, output, pendingSize);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkReductionFilter::ReducePieces(PiecesType& pieces,
+  vtkDataObject* output, unsigned long& pendingSize)
+{
+  // Replace the pending results with their partial reduction.
+  vtkSmartPointer<vtkDataObject> partial;
+  partial.TakeReference(output->NewInstance());
+  this->PostProcess(partial, &pieces[0],
+    static_cast<unsigned int>(pieces.size()));
+  pieces.clear();
+  pieces.push_back(partial);
+  pendingSize = partial->GetActualMemorySize();
+}
+
+//-----------------------------------------------------------------------------
+void vtkReductionFilter::SendPieces(int receiver, PiecesType& pieces)
+{
+  int count = static_cast<int>(pieces.size());
+  this->Controller->Send(&count, 1, receiver,
+    vtkReductionFilter::TRANSMIT_DATA_OBJECT);
+  for (int cc = 0; cc < count; ++cc)
+    {
+    this->Send(receiver, pieces[cc]);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkReductionFilter::ReceivePieces(int sender, PiecesType& pieces,
+  vtkDataObject* output, unsigned long& pendingSize)
+{
+  int count = 0;
+  this->Controller->Receive(&count, 1, sender,
+    vtkReductionFilter::TRANSMIT_DATA_OBJECT);
+  for (int cc = 0; cc < count; ++cc)
+    {
+    vtkSmartPointer<vtkDataObject> ds;
+    ds.TakeReference(this->Receive(sender, output->GetDataObjectType()));
+    this->AddPiece(pieces, ds, output, pendingSize);
+    }
+}
+
 //-----------------------------------------------------------------------------
 void vtkReductionFilter::Send(int receiver, vtkDataObject* data)
 {
@@ -438,4 +587,6 @@ void vtkReductionFilter::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "Controller: " << this->Controller << endl;
   os << indent << "PassThrough: " << this->PassThrough << endl;
   os << indent << "GenerateProcessIds: " << this->GenerateProcessIds << endl;
+  os << indent << "MemoryBudget: " << this->MemoryBudget << endl;
+  os << indent << "TreeReduction: " << this->TreeReduction << endl;
 }
@@ -26,12 +26,23 @@
 // In addition to doing reduction the PassThrough variable lets you choose
 // to pass through the results of any one node instead of aggregating all of
 // them together.
+//
+// By default all intermediate results are held on the root node before the
+// PostGatherHelper runs. Setting a MemoryBudget and/or TreeReduction makes
+// the reduction streaming: the PostGatherHelper is run on the results
+// received so far whenever they exceed the budget, and with TreeReduction
+// results are combined along a binomial tree on their way to the root. This
+// requires a PostGatherHelper that is associative and accepts its own output
+// as an input, such as an append filter.
 
 #ifndef __vtkReductionFilter_h
 #define __vtkReductionFilter_h
 
 #include "vtkDataObjectAlgorithm.h"
 #include "vtkSmartPointer.h" // needed for vtkSmartPointer.
+//BTX
+#include <vtkstd/vector> // needed for vector.
+//ETX
 class vtkMultiProcessController;
 
 class VTK_EXPORT vtkReductionFilter : public vtkDataObjectAlgorithm
@@ -75,6 +86,25 @@ public:
   vtkSetMacro(GenerateProcessIds, int);
   vtkGetMacro(GenerateProcessIds, int);
 
+  // Description:
+  // When positive, the size (in kibibytes) that the results waiting to be
+  // reduced may reach on a node before the PostGatherHelper is run on them
+  // and the partial result received so far. This bounds the peak memory of
+  // the root to about the budget plus the largest result instead of the sum
+  // of all results. 0 (the default) gathers all results before reducing.
+  // Ignored when PassThrough is set.
+  vtkSetClampMacro(MemoryBudget, int, 0, VTK_LARGE_INTEGER);
+  vtkGetMacro(MemoryBudget, int);
+
+  // Description:
+  // When set, results are sent along a binomial tree rather than directly
+  // to the root. Nodes that have a PostGatherHelper reduce the results of
+  // their subtree before forwarding them, the others forward them as they
+  // are. Off by default. Ignored when PassThrough is set.
+  vtkSetMacro(TreeReduction, int);
+  vtkGetMacro(TreeReduction, int);
+  vtkBooleanMacro(TreeReduction, int);
+
 //BTX
   enum Tags {
     TRANSMIT_DATA_OBJECT = 23484
@@ -104,11 +134,33 @@ protected:
   void Send(int receiver, vtkDataObject*);
   vtkDataObject* Receive(int receiver, int dataobjectType);
 
+  // Streaming variant of the gather in Reduce(), used when MemoryBudget or
+  // TreeReduction is set.
+  void StreamingReduce(vtkDataObject* preOutput, vtkDataObject* output);
+
+  typedef vtkstd::vector<vtkSmartPointer<vtkDataObject> > PiecesType;
+
+  // Adds a result to the ones waiting to be reduced, reducing them when they
+  // exceed the MemoryBudget.
+  void AddPiece(PiecesType& pieces, vtkDataObject* piece,
+    vtkDataObject* output, unsigned long& pendingSize);
+
+  // Replaces the pending results with the result of the PostGatherHelper.
+  void ReducePieces(PiecesType& pieces, vtkDataObject* output,
+    unsigned long& pendingSize);
+
+  // Send/receive all the pending results of a node.
+  void SendPieces(int receiver, PiecesType& pieces);
+  void ReceivePieces(int sender, PiecesType& pieces,
+    vtkDataObject* output, unsigned long& pendingSize);
+
   vtkAlgorithm* PreGatherHelper;
   vtkAlgorithm* PostGatherHelper;
   vtkMultiProcessController* Controller;
   int PassThrough;
   int GenerateProcessIds;
+  int MemoryBudget;
+  int TreeReduction;
 
 private:
   vtkReductionFilter(const vtkReductionFilter&); // Not implemented.
@@ -83,6 +83,21 @@ void vtkWeightedRedistributePolyData::SetWeights(
     }
 }
 
+//*****************************************************************
+void vtkWeightedRedistributePolyData::ComputeCurveWeights(double* weights)
+{
+  int myId = this->Controller->GetLocalProcessId();
+  int numProcs = this->Controller->GetNumberOfProcesses();
+  if (myId == 0)
+    {
+    for (int np = 0; np < numProcs; np++)
+      {
+      weights[np] = this->Weights ? this->Weights[np] : 1.;
+      }
+    }
+  this->Controller->Broadcast(weights, numProcs, 0);
+}
+
 //*****************************************************************
 void vtkWeightedRedistributePolyData::MakeSchedule ( vtkCommSched* localSched)
 
@@ -59,6 +59,12 @@ protected:
 
 
   virtual void MakeSchedule (vtkCommSched*);
+
+  // Description:
+  // Broadcasts the weights set on process 0 so that every process
+  // cuts the space-filling curve at the same places.
+  virtual void ComputeCurveWeights (double*);
+
   float* Weights;
 
 private:
@@ -0,0 +1,146 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestDeferredStateLoading.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Saves the state of a small pipeline and loads it back with deferred loading
+// on. Checks that the proxies, their properties and their inputs are
+// restored, and that the information properties gathered in a batch match
+// the ones gathered one property at a time.
+
+#include "vtkInitializationHelper.h"
+#include "vtkProcessModule.h"
+#include "vtkPVDataInformation.h"
+#include "vtkPVOptions.h"
+#include "vtkPVXMLElement.h"
+#include "vtkSMIntVectorProperty.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMProxyManager.h"
+#include "vtkSMSourceProxy.h"
+#include "vtkSMStateLoader.h"
+#include "vtkSmartPointer.h"
+
+static void BuildPipeline(vtkIdType connectionID)
+{
+  vtkSMProxyManager* pxm = vtkSMProxyManager::GetProxyManager();
+
+  vtkSMProxy* sphere = pxm->NewProxy("sources", "SphereSource");
+  sphere->SetConnectionID(connectionID);
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(12);
+  vtkSMPropertyHelper(sphere, "PhiResolution").Set(10);
+  sphere->UpdateVTKObjects();
+  pxm->RegisterProxy("sources", "Sphere", sphere);
+  sphere->Delete();
+
+  vtkSMProxy* shrink = pxm->NewProxy("filters", "ShrinkFilter");
+  shrink->SetConnectionID(connectionID);
+  vtkSMPropertyHelper(shrink, "Input").Set(sphere);
+  vtkSMPropertyHelper(shrink, "ShrinkFactor").Set(0.25);
+  shrink->UpdateVTKObjects();
+  pxm->RegisterProxy("sources", "Shrink", shrink);
+  shrink->Delete();
+
+  vtkSMProxy* fractal = pxm->NewProxy("sources", "HierarchicalFractal");
+  fractal->SetConnectionID(connectionID);
+  vtkSMPropertyHelper(fractal, "TimeStep").Set(3);
+  fractal->UpdateVTKObjects();
+  pxm->RegisterProxy("sources", "Fractal", fractal);
+  fractal->Delete();
+}
+
+static bool CheckPipeline()
+{
+  vtkSMProxyManager* pxm = vtkSMProxyManager::GetProxyManager();
+  vtkSMSourceProxy* sphere = vtkSMSourceProxy::SafeDownCast(
+    pxm->GetProxy("sources", "Sphere"));
+  vtkSMSourceProxy* shrink = vtkSMSourceProxy::SafeDownCast(
+    pxm->GetProxy("sources", "Shrink"));
+  vtkSMSourceProxy* fractal = vtkSMSourceProxy::SafeDownCast(
+    pxm->GetProxy("sources", "Fractal"));
+  if (!sphere || !shrink || !fractal)
+    {
+    cerr << "ERROR: the proxies were not registered." << endl;
+    return false;
+    }
+
+  if (vtkSMPropertyHelper(sphere, "ThetaResolution").GetAsInt() != 12 ||
+    vtkSMPropertyHelper(sphere, "PhiResolution").GetAsInt() != 10 ||
+    vtkSMPropertyHelper(shrink, "ShrinkFactor").GetAsDouble() != 0.25 ||
+    vtkSMPropertyHelper(fractal, "TimeStep").GetAsInt() != 3)
+    {
+    cerr << "ERROR: the properties were not restored." << endl;
+    return false;
+    }
+  if (vtkSMPropertyHelper(shrink, "Input").GetAsProxy() != sphere)
+    {
+    cerr << "ERROR: the input of the shrink filter was not restored." << endl;
+    return false;
+    }
+
+  // The information property gathered in the batch must match the one
+  // gathered by itself.
+  vtkSMIntVectorProperty* rangeInfo = vtkSMIntVectorProperty::SafeDownCast(
+    fractal->GetProperty("TimeStepRangeInfo"));
+  if (!rangeInfo || rangeInfo->GetNumberOfElements() != 2)
+    {
+    cerr << "ERROR: TimeStepRangeInfo was not gathered." << endl;
+    return false;
+    }
+  int batched[2] = { rangeInfo->GetElement(0), rangeInfo->GetElement(1) };
+  fractal->UpdatePropertyInformation(rangeInfo);
+  if (rangeInfo->GetElement(0) != batched[0] ||
+    rangeInfo->GetElement(1) != batched[1])
+    {
+    cerr << "ERROR: TimeStepRangeInfo is (" << batched[0] << ", "
+      << batched[1] << ") instead of (" << rangeInfo->GetElement(0) << ", "
+      << rangeInfo->GetElement(1) << ")." << endl;
+    return false;
+    }
+
+  shrink->UpdatePipeline();
+  vtkIdType numCells = shrink->GetDataInformation(0)->GetNumberOfCells();
+  sphere->UpdatePipeline();
+  if (numCells != sphere->GetDataInformation(0)->GetNumberOfCells())
+    {
+    cerr << "ERROR: the shrink filter has " << numCells << " cells instead of "
+      << sphere->GetDataInformation(0)->GetNumberOfCells() << "." << endl;
+    return false;
+    }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  vtkPVOptions* options = vtkPVOptions::New();
+  vtkInitializationHelper::Initialize(argc, argv, options);
+  options->Delete();
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkIdType connectionID = pm->ConnectToSelf();
+  vtkSMProxyManager* pxm = vtkSMProxyManager::GetProxyManager();
+
+  BuildPipeline(connectionID);
+  vtkPVXMLElement* state = pxm->SaveState();
+  pxm->UnRegisterProxies();
+
+  vtkSmartPointer<vtkSMStateLoader> loader =
+    vtkSmartPointer<vtkSMStateLoader>::New();
+  loader->SetDeferredLoading(1);
+  pxm->LoadState(state, connectionID, loader);
+  state->Delete();
+
+  int ret = CheckPipeline()? 0 : 1;
+
+  pxm->UnRegisterProxies();
+  vtkInitializationHelper::Finalize();
+  return ret;
+}
@@ -0,0 +1,164 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestDomainLazyUpdate.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Changes the required property of a domain several times and checks that,
+// with LazyUpdate on, the domain is updated once, when it is queried, from
+// the last value of the property, and that the merged requests are counted
+// by vtkSMDomain::GetNumberOfSuppressedUpdates(). Also checks that a domain
+// with LazyUpdate off, or observed, is updated on every request.
+
+#include "vtkCallbackCommand.h"
+#include "vtkCommand.h"
+#include "vtkInitializationHelper.h"
+#include "vtkObjectFactory.h"
+#include "vtkPVOptions.h"
+#include "vtkSmartPointer.h"
+#include "vtkSMDomain.h"
+#include "vtkSMDoubleVectorProperty.h"
+
+#define NUMBER_OF_CHANGES 5
+
+//----------------------------------------------------------------------------
+// Counts its updates and keeps the value of its required property at the
+// last one.
+class vtkTestCountingDomain : public vtkSMDomain
+{
+public:
+  static vtkTestCountingDomain* New();
+  vtkTypeMacro(vtkTestCountingDomain, vtkSMDomain);
+
+  virtual int IsInDomain(vtkSMProperty*)
+    {
+    this->UpdateIfNeeded();
+    return 1;
+    }
+
+  virtual void Update(vtkSMProperty*)
+    {
+    vtkSMDoubleVectorProperty* required =
+      vtkSMDoubleVectorProperty::SafeDownCast(
+        this->GetRequiredProperty("Value"));
+    this->Value = required->GetUncheckedElement(0);
+    this->NumberOfUpdates++;
+    this->InvokeModified();
+    }
+
+  int NumberOfUpdates;
+  double Value;
+
+protected:
+  vtkTestCountingDomain()
+    {
+    this->NumberOfUpdates = 0;
+    this->Value = 0.0;
+    }
+
+private:
+  vtkTestCountingDomain(const vtkTestCountingDomain&); // Not implemented
+  void operator=(const vtkTestCountingDomain&); // Not implemented
+};
+
+vtkStandardNewMacro(vtkTestCountingDomain);
+
+//----------------------------------------------------------------------------
+// Changes the required property as a panel would, updating the dependent
+// domains after each change.
+static void ChangeRequiredProperty(vtkSMDoubleVectorProperty* required)
+{
+  for (int cc = 1; cc <= NUMBER_OF_CHANGES; ++cc)
+    {
+    required->SetUncheckedElement(0, cc);
+    required->UpdateDependentDomains();
+    }
+}
+
+//----------------------------------------------------------------------------
+static bool Check(vtkTestCountingDomain* domain, int updates,
+  vtkIdType suppressed, const char* what)
+{
+  bool ret = true;
+  if (domain->NumberOfUpdates != updates)
+    {
+    cerr << "ERROR: " << what << ": " << domain->NumberOfUpdates
+      << " updates instead of " << updates << "." << endl;
+    ret = false;
+    }
+  if (vtkSMDomain::GetNumberOfSuppressedUpdates() != suppressed)
+    {
+    cerr << "ERROR: " << what << ": "
+      << vtkSMDomain::GetNumberOfSuppressedUpdates()
+      << " suppressed updates instead of " << suppressed << "." << endl;
+    ret = false;
+    }
+  return ret;
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  vtkPVOptions* options = vtkPVOptions::New();
+  vtkInitializationHelper::Initialize(argc, argv, options);
+  options->Delete();
+
+  vtkSmartPointer<vtkSMDoubleVectorProperty> required =
+    vtkSmartPointer<vtkSMDoubleVectorProperty>::New();
+  required->SetNumberOfElements(1);
+  vtkSmartPointer<vtkSMDoubleVectorProperty> property =
+    vtkSmartPointer<vtkSMDoubleVectorProperty>::New();
+  property->SetNumberOfElements(1);
+  vtkSmartPointer<vtkTestCountingDomain> domain =
+    vtkSmartPointer<vtkTestCountingDomain>::New();
+  domain->AddRequiredProperty(required, "Value");
+  bool ret = true;
+
+  // Lazy: the requests are merged and the domain is updated on access.
+  domain->LazyUpdateOn();
+  vtkSMDomain::ResetNumberOfSuppressedUpdates();
+  ChangeRequiredProperty(required);
+  ret = Check(domain, 0, NUMBER_OF_CHANGES - 1, "Before access") && ret;
+  domain->IsInDomain(property);
+  ret = Check(domain, 1, NUMBER_OF_CHANGES - 1, "Lazy") && ret;
+  if (domain->Value != NUMBER_OF_CHANGES)
+    {
+    cerr << "ERROR: the domain was updated from the value " << domain->Value
+      << " instead of " << NUMBER_OF_CHANGES << "." << endl;
+    ret = false;
+    }
+  domain->IsInDomain(property);
+  ret = Check(domain, 1, NUMBER_OF_CHANGES - 1, "Second access") && ret;
+
+  // Not lazy: every request updates the domain.
+  domain->NumberOfUpdates = 0;
+  domain->LazyUpdateOff();
+  vtkSMDomain::ResetNumberOfSuppressedUpdates();
+  ChangeRequiredProperty(required);
+  ret = Check(domain, NUMBER_OF_CHANGES, 0, "Not lazy") && ret;
+
+  // Observed: the observer would query the domain on every change, so it
+  // is updated right away.
+  domain->NumberOfUpdates = 0;
+  domain->LazyUpdateOn();
+  vtkSMDomain::ResetNumberOfSuppressedUpdates();
+  vtkSmartPointer<vtkCallbackCommand> observer =
+    vtkSmartPointer<vtkCallbackCommand>::New();
+  domain->AddObserver(vtkCommand::DomainModifiedEvent, observer);
+  ChangeRequiredProperty(required);
+  ret = Check(domain, NUMBER_OF_CHANGES, 0, "Observed") && ret;
+
+  // The property and the domain reference each other.
+  required->RemoveAllDependents();
+
+  vtkInitializationHelper::Finalize();
+  return ret? 0 : 1;
+}
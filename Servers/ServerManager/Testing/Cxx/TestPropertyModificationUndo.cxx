@@ -0,0 +1,147 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPropertyModificationUndo.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests that undo/redo of an undo set in which a vector property with many
+// elements is modified several times restores the right values, also when
+// the property is changed outside of the undo stack in between.
+
+#include "vtkInitializationHelper.h"
+#include "vtkProcessModule.h"
+#include "vtkPVOptions.h"
+#include "vtkSMDoubleVectorProperty.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMProxy.h"
+#include "vtkSMProxyManager.h"
+#include "vtkSMUndoStack.h"
+#include "vtkSMUndoStackBuilder.h"
+#include "vtkSmartPointer.h"
+
+#define NUMBER_OF_VALUES 20
+
+static bool CheckValues(vtkSMProxy* proxy, const double* values,
+  unsigned int numValues, const char* when)
+{
+  vtkSMPropertyHelper helper(proxy, "ContourValues");
+  if (helper.GetNumberOfElements() != numValues)
+    {
+    cerr << "ERROR: " << when << ": expected " << numValues
+      << " values, got " << helper.GetNumberOfElements() << endl;
+    return false;
+    }
+  for (unsigned int cc=0; cc < numValues; ++cc)
+    {
+    if (helper.GetAsDouble(cc) != values[cc])
+      {
+      cerr << "ERROR: " << when << ": value " << cc << " is "
+        << helper.GetAsDouble(cc) << " instead of " << values[cc] << endl;
+      return false;
+      }
+    }
+  return true;
+}
+
+int main(int argc, char** argv)
+{
+  vtkPVOptions* options = vtkPVOptions::New();
+  vtkInitializationHelper::Initialize(argc, argv, options);
+  options->Delete();
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkIdType connectionID = pm->ConnectToSelf();
+
+  vtkSMProxyManager* pxm = vtkSMProxyManager::GetProxyManager();
+  vtkSMProxy* contour = pxm->NewProxy("filters", "Contour");
+  contour->SetConnectionID(connectionID);
+  pxm->RegisterProxy("sources", "Contour", contour);
+  contour->Delete();
+
+  double original[NUMBER_OF_VALUES];
+  double modified[NUMBER_OF_VALUES];
+  double rescaled[NUMBER_OF_VALUES];
+  unsigned int cc;
+  for (cc=0; cc < NUMBER_OF_VALUES; ++cc)
+    {
+    original[cc] = cc;
+    modified[cc] = (cc < 15? cc : 50.0 + cc);
+    rescaled[cc] = 1000.0 + 2.0*cc;
+    }
+
+  vtkSMDoubleVectorProperty* values = vtkSMDoubleVectorProperty::SafeDownCast(
+    contour->GetProperty("ContourValues"));
+  values->SetElements(original, NUMBER_OF_VALUES);
+  contour->UpdateVTKObjects();
+
+  vtkSmartPointer<vtkSMUndoStack> undoStack =
+    vtkSmartPointer<vtkSMUndoStack>::New();
+  vtkSmartPointer<vtkSMUndoStackBuilder> builder =
+    vtkSmartPointer<vtkSMUndoStackBuilder>::New();
+  builder->SetUndoStack(undoStack);
+  builder->SetConnectionID(connectionID);
+
+  // Modify the property several times without pushing it: change a value and
+  // revert it, then shrink the property and grow it back, partly with the
+  // values it had before it was shrunk.
+  builder->Begin("Modify ContourValues");
+  values->SetElement(3, 100.0);
+  values->SetElement(3, 3.0);
+  values->SetElements(original, 10);
+  values->SetElements(modified, NUMBER_OF_VALUES);
+  builder->EndAndPushToStack();
+
+  int ret = 0;
+  if (!CheckValues(contour, modified, NUMBER_OF_VALUES, "Modified"))
+    {
+    ret = 1;
+    }
+  for (int pass=0; pass < 2 && ret == 0; ++pass)
+    {
+    if (!undoStack->Undo() ||
+      !CheckValues(contour, original, NUMBER_OF_VALUES, "Undo"))
+      {
+      ret = 1;
+      }
+    else if (!undoStack->Redo() ||
+      !CheckValues(contour, modified, NUMBER_OF_VALUES, "Redo"))
+      {
+      ret = 1;
+      }
+    }
+
+  // Change every value outside of the undo stack (as a rescale of a lookup
+  // table would) before undoing and before redoing.
+  for (int pass=0; pass < 2 && ret == 0; ++pass)
+    {
+    values->SetElements(rescaled, NUMBER_OF_VALUES);
+    contour->UpdateVTKObjects();
+    if (!undoStack->Undo() ||
+      !CheckValues(contour, original, NUMBER_OF_VALUES, "Undo after change"))
+      {
+      ret = 1;
+      break;
+      }
+    values->SetElements(rescaled, NUMBER_OF_VALUES - 5);
+    contour->UpdateVTKObjects();
+    if (!undoStack->Redo() ||
+      !CheckValues(contour, modified, NUMBER_OF_VALUES, "Redo after change"))
+      {
+      ret = 1;
+      }
+    }
+
+  builder->SetUndoStack(0);
+  undoStack->Clear();
+  pxm->UnRegisterProxies();
+  vtkInitializationHelper::Finalize();
+  return ret;
+}
@@ -0,0 +1,372 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestSILInformation.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests the encoding of SILs sent by vtkPVSILInformation, whole and partial,
+// and that a SIL fetched level by level by vtkSMSILInformationHelper and then
+// expanded is the same as the SIL fetched whole.
+
+#include "vtkCharArray.h"
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerStream.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
+#include "vtkIdTypeArray.h"
+#include "vtkInformation.h"
+#include "vtkInformationVector.h"
+#include "vtkInitializationHelper.h"
+#include "vtkMutableDirectedGraph.h"
+#include "vtkObjectFactory.h"
+#include "vtkOutEdgeIterator.h"
+#include "vtkPolyDataAlgorithm.h"
+#include "vtkProcessModule.h"
+#include "vtkPVOptions.h"
+#include "vtkPVSILInformation.h"
+#include "vtkSmartPointer.h"
+#include "vtkSMProxy.h"
+#include "vtkSMProxyManager.h"
+#include "vtkSMSILInformationHelper.h"
+#include "vtkSMStringVectorProperty.h"
+#include "vtkStringArray.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/string>
+#include <vtkstd/vector>
+#include <vtksys/ios/sstream>
+
+//----------------------------------------------------------------------------
+// Builds a SIL like the one of the Exodus reader: the blocks, and assemblies
+// and materials grouping them through cross edges.
+static vtkGraph* NewTestSIL()
+{
+  vtkMutableDirectedGraph* sil = vtkMutableDirectedGraph::New();
+  vtkSmartPointer<vtkStringArray> names =
+    vtkSmartPointer<vtkStringArray>::New();
+  names->SetName("Names");
+  vtkSmartPointer<vtkCharArray> crossEdges =
+    vtkSmartPointer<vtkCharArray>::New();
+  crossEdges->SetName("CrossEdges");
+
+  vtkIdType root = sil->AddVertex();
+  names->InsertValue(root, "SIL");
+
+  vtkIdType blocks = sil->AddVertex();
+  names->InsertValue(blocks, "Blocks");
+  crossEdges->InsertValue(sil->AddEdge(root, blocks).Id, 0);
+  vtkIdType block[6];
+  for (int cc = 0; cc < 6; ++cc)
+    {
+    block[cc] = sil->AddVertex();
+    vtksys_ios::ostringstream name;
+    name << "Block " << cc;
+    names->InsertValue(block[cc], name.str().c_str());
+    crossEdges->InsertValue(sil->AddEdge(blocks, block[cc]).Id, 0);
+    }
+
+  // Each group lists its parent and the blocks it holds (-1 terminated).
+  const char* groupNames[] = { "Assemblies", "Assembly A", "Sub A1",
+    "Sub A2", "Assembly B", "Materials", "Steel", "Iron" };
+  int groupParents[] = { -1, 0, 1, 1, 0, -1, 5, 5 };
+  int groupBlocks[][4] = { {-1}, {-1}, {0, 1, -1}, {2, -1}, {3, 4, 5, -1},
+    {-1}, {0, 3, -1}, {1, 2, 4, -1} };
+  vtkIdType groups[8];
+  for (int cc = 0; cc < 8; ++cc)
+    {
+    groups[cc] = sil->AddVertex();
+    names->InsertValue(groups[cc], groupNames[cc]);
+    vtkIdType parent = groupParents[cc] < 0? root : groups[groupParents[cc]];
+    crossEdges->InsertValue(sil->AddEdge(parent, groups[cc]).Id, 0);
+    for (int kk = 0; groupBlocks[cc][kk] >= 0; ++kk)
+      {
+      crossEdges->InsertValue(
+        sil->AddEdge(groups[cc], block[groupBlocks[cc][kk]]).Id, 1);
+      }
+    }
+
+  sil->GetVertexData()->AddArray(names);
+  sil->GetEdgeData()->AddArray(crossEdges);
+  return sil;
+}
+
+//----------------------------------------------------------------------------
+// A source providing the test SIL in its output information, like readers
+// do.
+class vtkTestSILSource : public vtkPolyDataAlgorithm
+{
+public:
+  static vtkTestSILSource* New();
+  vtkTypeMacro(vtkTestSILSource, vtkPolyDataAlgorithm);
+
+protected:
+  vtkTestSILSource()
+    {
+    this->SetNumberOfInputPorts(0);
+    this->SIL = NewTestSIL();
+    }
+  ~vtkTestSILSource()
+    {
+    this->SIL->Delete();
+    }
+
+  virtual int RequestInformation(vtkInformation*, vtkInformationVector**,
+    vtkInformationVector* outputVector)
+    {
+    outputVector->GetInformationObject(0)->Set(vtkDataObject::SIL(),
+      this->SIL);
+    return 1;
+    }
+
+  vtkGraph* SIL;
+
+private:
+  vtkTestSILSource(const vtkTestSILSource&); // Not implemented
+  void operator=(const vtkTestSILSource&); // Not implemented
+};
+
+vtkStandardNewMacro(vtkTestSILSource);
+
+//----------------------------------------------------------------------------
+// Describes the SIL with one sorted line per vertex and edge, using the ids
+// of the vertices in the whole SIL, so that SILs built in a different order
+// can be compared. Partial SILs also list their collapsed vertices and
+// external cross edges when extras is true.
+static vtkstd::vector<vtkstd::string> DescribeSIL(vtkGraph* sil, bool extras)
+{
+  vtkstd::vector<vtkstd::string> lines;
+  if (!sil)
+    {
+    return lines;
+    }
+  vtkStringArray* names = vtkStringArray::SafeDownCast(
+    sil->GetVertexData()->GetAbstractArray("Names"));
+  vtkDataArray* crossEdges = vtkDataArray::SafeDownCast(
+    sil->GetEdgeData()->GetAbstractArray("CrossEdges"));
+  vtkIdTypeArray* silIds = vtkIdTypeArray::SafeDownCast(
+    sil->GetVertexData()->GetAbstractArray("SIL Ids"));
+  vtkUnsignedCharArray* collapsed = vtkUnsignedCharArray::SafeDownCast(
+    sil->GetVertexData()->GetAbstractArray("Collapsed"));
+  vtkIdTypeArray* external = vtkIdTypeArray::SafeDownCast(
+    sil->GetFieldData()->GetAbstractArray("External Cross Edges"));
+
+  vtkSmartPointer<vtkOutEdgeIterator> iter =
+    vtkSmartPointer<vtkOutEdgeIterator>::New();
+  for (vtkIdType cc = 0; cc < sil->GetNumberOfVertices(); ++cc)
+    {
+    vtkIdType id = silIds? silIds->GetValue(cc) : cc;
+    vtksys_ios::ostringstream vertex;
+    vertex << "vertex " << id << " " << names->GetValue(cc);
+    lines.push_back(vertex.str());
+    if (extras && collapsed && collapsed->GetValue(cc))
+      {
+      vtksys_ios::ostringstream line;
+      line << "collapsed " << id;
+      lines.push_back(line.str());
+      }
+    sil->GetOutEdges(cc, iter);
+    while (iter->HasNext())
+      {
+      vtkOutEdgeType edge = iter->Next();
+      vtksys_ios::ostringstream line;
+      line << "edge " << id << " "
+        << (silIds? silIds->GetValue(edge.Target) : edge.Target) << " "
+        << crossEdges->GetTuple1(edge.Id);
+      lines.push_back(line.str());
+      }
+    }
+  if (extras && external)
+    {
+    for (vtkIdType cc = 0; cc < external->GetNumberOfTuples(); ++cc)
+      {
+      vtkIdType vertex = external->GetValue(3*cc);
+      vtksys_ios::ostringstream line;
+      line << "external " << (silIds? silIds->GetValue(vertex) : vertex)
+        << " " << external->GetValue(3*cc+1) << " "
+        << external->GetValue(3*cc+2);
+      lines.push_back(line.str());
+      }
+    }
+  vtkstd::sort(lines.begin(), lines.end());
+  return lines;
+}
+
+//----------------------------------------------------------------------------
+static bool CompareSILs(vtkGraph* expected, vtkGraph* actual, bool extras,
+  const char* what)
+{
+  vtkstd::vector<vtkstd::string> expectedLines =
+    DescribeSIL(expected, extras);
+  vtkstd::vector<vtkstd::string> actualLines = DescribeSIL(actual, extras);
+  if (expectedLines.empty() || expectedLines != actualLines)
+    {
+    cerr << "ERROR: " << what << ": the SILs differ." << endl;
+    for (size_t cc = 0; cc < expectedLines.size(); ++cc)
+      {
+      cerr << "  expected: " << expectedLines[cc] << endl;
+      }
+    for (size_t cc = 0; cc < actualLines.size(); ++cc)
+      {
+      cerr << "  actual:   " << actualLines[cc] << endl;
+      }
+    return false;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// Gathers the SIL of the source, sends it through a stream and checks that
+// it is decoded as it was gathered.
+static bool TestRoundTrip(vtkAlgorithm* source, const char* subtreeName,
+  int depth, const char* what)
+{
+  vtkSmartPointer<vtkPVSILInformation> sent =
+    vtkSmartPointer<vtkPVSILInformation>::New();
+  sent->SetSubtreeName(subtreeName);
+  sent->SetMaximumDepth(depth);
+  sent->CopyFromObject(source);
+
+  vtkClientServerStream stream;
+  sent->CopyToStream(&stream);
+  vtkSmartPointer<vtkPVSILInformation> received =
+    vtkSmartPointer<vtkPVSILInformation>::New();
+  received->CopyFromStream(&stream);
+
+  return CompareSILs(sent->GetSIL(), received->GetSIL(), true, what);
+}
+
+//----------------------------------------------------------------------------
+static const char* TestSILSourceXML =
+  "<ServerManagerConfiguration>"
+  " <ProxyGroup name=\"test_sources\">"
+  "  <SourceProxy name=\"SILSource\" class=\"vtkPolyDataAlgorithm\">"
+  "   <StringVectorProperty name=\"BlocksInfo\" information_only=\"1\">"
+  "    <SILInformationHelper subtree=\"Blocks\"/>"
+  "   </StringVectorProperty>"
+  "   <StringVectorProperty name=\"PartialBlocksInfo\""
+  "     information_only=\"1\">"
+  "    <SILInformationHelper subtree=\"Blocks\" depth=\"1\"/>"
+  "   </StringVectorProperty>"
+  "  </SourceProxy>"
+  " </ProxyGroup>"
+  "</ServerManagerConfiguration>";
+
+//----------------------------------------------------------------------------
+// Fetches the SIL of a source on the server whole and level by level, then
+// expands the partial SIL and compares the two.
+static bool TestPartialFetch(vtkIdType connectionID)
+{
+  vtkSMProxyManager* pxm = vtkSMProxyManager::GetProxyManager();
+  if (!pxm->LoadConfigurationXML(TestSILSourceXML))
+    {
+    cerr << "ERROR: failed to load the test proxy definition." << endl;
+    return false;
+    }
+
+  // The test source is not wrapped, hand it to the interpreter directly; the
+  // interpreter takes the reference.
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkClientServerID sourceID = pm->GetUniqueID();
+  pm->GetInterpreter()->NewInstance(vtkTestSILSource::New(), sourceID);
+
+  vtkSMProxy* proxy = pxm->NewProxy("test_sources", "SILSource");
+  proxy->SetConnectionID(connectionID);
+  proxy->InitializeWithID(sourceID);
+  pxm->RegisterProxy("test_sources", "SILSource", proxy);
+  proxy->Delete();
+  proxy->UpdatePropertyInformation();
+
+  vtkSMStringVectorProperty* fullProp =
+    vtkSMStringVectorProperty::SafeDownCast(proxy->GetProperty("BlocksInfo"));
+  vtkSMStringVectorProperty* partialProp =
+    vtkSMStringVectorProperty::SafeDownCast(
+      proxy->GetProperty("PartialBlocksInfo"));
+  vtkSMSILInformationHelper* full = vtkSMSILInformationHelper::SafeDownCast(
+    fullProp->GetInformationHelper());
+  vtkSMSILInformationHelper* partial =
+    vtkSMSILInformationHelper::SafeDownCast(
+      partialProp->GetInformationHelper());
+  if (!full || !partial || !full->GetSIL() || !partial->GetSIL())
+    {
+    cerr << "ERROR: the SILs were not fetched." << endl;
+    return false;
+    }
+
+  // The array list only needs the subtree, which is always fetched whole.
+  if (fullProp->GetNumberOfElements() != 6 ||
+    partialProp->GetNumberOfElements() != fullProp->GetNumberOfElements())
+    {
+    cerr << "ERROR: the partial SIL lists "
+      << partialProp->GetNumberOfElements() << " blocks instead of "
+      << fullProp->GetNumberOfElements() << "." << endl;
+    return false;
+    }
+  for (unsigned int cc = 0; cc < fullProp->GetNumberOfElements(); ++cc)
+    {
+    if (vtkstd::string(fullProp->GetElement(cc)) !=
+      partialProp->GetElement(cc))
+      {
+      cerr << "ERROR: block " << cc << " is " << partialProp->GetElement(cc)
+        << " instead of " << fullProp->GetElement(cc) << "." << endl;
+      return false;
+      }
+    }
+
+  vtkIdType numVertices = full->GetSIL()->GetNumberOfVertices();
+  if (partial->GetSIL()->GetNumberOfVertices() >= numVertices)
+    {
+    cerr << "ERROR: the partial SIL has all the "  << numVertices
+      << " vertices." << endl;
+    return false;
+    }
+
+  // Expand one level of one collapsed vertex, then the rest.
+  vtkUnsignedCharArray* collapsed = vtkUnsignedCharArray::SafeDownCast(
+    partial->GetSIL()->GetVertexData()->GetAbstractArray("Collapsed"));
+  vtkIdType vertex = 0;
+  while (vertex < collapsed->GetNumberOfTuples() &&
+    !collapsed->GetValue(vertex))
+    {
+    ++vertex;
+    }
+  if (vertex == collapsed->GetNumberOfTuples() ||
+    partial->ExpandVertex(vertex, 1) <= 0)
+    {
+    cerr << "ERROR: failed to expand a collapsed vertex." << endl;
+    return false;
+    }
+  partial->ExpandAll();
+  return CompareSILs(full->GetSIL(), partial->GetSIL(), false,
+    "Partial fetch");
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  vtkPVOptions* options = vtkPVOptions::New();
+  vtkInitializationHelper::Initialize(argc, argv, options);
+  options->Delete();
+
+  vtkSmartPointer<vtkTestSILSource> source =
+    vtkSmartPointer<vtkTestSILSource>::New();
+  bool ret = TestRoundTrip(source, 0, -1, "Whole SIL");
+  ret = TestRoundTrip(source, 0, 1, "Top level") && ret;
+  ret = TestRoundTrip(source, "Assemblies", 1, "Subtree") && ret;
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkIdType connectionID = pm->ConnectToSelf();
+  ret = TestPartialFetch(connectionID) && ret;
+
+  vtkSMProxyManager::GetProxyManager()->UnRegisterProxies();
+  vtkInitializationHelper::Finalize();
+  return ret? 0 : 1;
+}
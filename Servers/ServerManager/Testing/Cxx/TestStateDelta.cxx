@@ -0,0 +1,241 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestStateDelta.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Saves a state, modifies the pipeline while journaling the changes as state
+// deltas, then checks that the state with the deltas applied is the state
+// saved in full. Also checks that a delta that cannot be applied leaves the
+// state unchanged and stops the replay of a journal, and that
+// LoadStateWithJournal() restores the modified pipeline.
+
+#include "vtkInitializationHelper.h"
+#include "vtkProcessModule.h"
+#include "vtkPVOptions.h"
+#include "vtkPVXMLElement.h"
+#include "vtkPVXMLParser.h"
+#include "vtkSMPropertyHelper.h"
+#include "vtkSMProxy.h"
+#include "vtkSMProxyManager.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/string>
+#include <vtkstd/vector>
+#include <vtksys/ios/sstream>
+#include <vtksys/SystemTools.hxx>
+
+#define STATE_FILE "TestStateDelta.pvsm"
+#define JOURNAL_FILE "TestStateDelta.journal"
+#define BAD_JOURNAL_FILE "TestStateDeltaBad.journal"
+
+//----------------------------------------------------------------------------
+static vtkPVXMLElement* NewState(const char* filename)
+{
+  vtkPVXMLParser* parser = vtkPVXMLParser::New();
+  parser->SetFileName(filename);
+  vtkPVXMLElement* root = 0;
+  if (parser->Parse())
+    {
+    root = parser->GetRootElement();
+    root->Register(0);
+    }
+  parser->Delete();
+  return root;
+}
+
+//----------------------------------------------------------------------------
+static vtkstd::string ToString(vtkPVXMLElement* element)
+{
+  vtksys_ios::ostringstream stream;
+  element->PrintXML(stream, vtkIndent());
+  return stream.str();
+}
+
+//----------------------------------------------------------------------------
+// The elements of the ServerManagerState, sorted, since a delta appends the
+// new proxies while a full save orders them by group and name.
+static vtkstd::vector<vtkstd::string> Describe(vtkPVXMLElement* root)
+{
+  vtkstd::vector<vtkstd::string> elements;
+  vtkPVXMLElement* smstate = root?
+    root->FindNestedElementByName("ServerManagerState") : 0;
+  for (unsigned int cc = 0; smstate &&
+    cc < smstate->GetNumberOfNestedElements(); ++cc)
+    {
+    elements.push_back(ToString(smstate->GetNestedElement(cc)));
+    }
+  vtkstd::sort(elements.begin(), elements.end());
+  return elements;
+}
+
+//----------------------------------------------------------------------------
+static bool CompareStates(vtkPVXMLElement* expected, vtkPVXMLElement* actual,
+  const char* what)
+{
+  vtkstd::vector<vtkstd::string> expectedElements = Describe(expected);
+  if (expectedElements.empty() || expectedElements != Describe(actual))
+    {
+    cerr << "ERROR: " << what << ": the states differ." << endl;
+    return false;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+static vtkSMProxy* CreateProxy(vtkIdType connectionID, const char* group,
+  const char* type, const char* name)
+{
+  vtkSMProxyManager* pxm = vtkSMProxyManager::GetProxyManager();
+  vtkSMProxy* proxy = pxm->NewProxy(group, type);
+  proxy->SetConnectionID(connectionID);
+  pxm->RegisterProxy("sources", name, proxy);
+  proxy->Delete();
+  return proxy;
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char** argv)
+{
+  vtkPVOptions* options = vtkPVOptions::New();
+  vtkInitializationHelper::Initialize(argc, argv, options);
+  options->Delete();
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkIdType connectionID = pm->ConnectToSelf();
+  vtkSMProxyManager* pxm = vtkSMProxyManager::GetProxyManager();
+  vtksys::SystemTools::RemoveFile(JOURNAL_FILE);
+  vtksys::SystemTools::RemoveFile(BAD_JOURNAL_FILE);
+
+  // Save the initial state.
+  vtkSMProxy* sphere = CreateProxy(connectionID, "sources", "SphereSource",
+    "Sphere");
+  vtkSMProxy* shrink = CreateProxy(connectionID, "filters", "ShrinkFilter",
+    "Shrink");
+  vtkSMPropertyHelper(shrink, "Input").Set(sphere);
+  shrink->UpdateVTKObjects();
+  pxm->SetStateDeltaTracking(1);
+  pxm->SaveState(STATE_FILE);
+  pxm->ResetStateDelta();
+
+  // First delta: a modified property and a new proxy.
+  vtkSMPropertyHelper(sphere, "ThetaResolution").Set(20);
+  sphere->UpdateVTKObjects();
+  CreateProxy(connectionID, "sources", "ConeSource", "Cone");
+  vtkPVXMLElement* firstState = pxm->SaveState();
+  pxm->AppendStateDelta(JOURNAL_FILE);
+  vtkPVXMLElement* firstDelta = NewState(JOURNAL_FILE);
+
+  // Second delta: another property and a removed proxy.
+  vtkSMPropertyHelper(shrink, "ShrinkFactor").Set(0.25);
+  shrink->UpdateVTKObjects();
+  pxm->UnRegisterProxy("sources", "Cone", pxm->GetProxy("sources", "Cone"));
+  vtkPVXMLElement* secondDelta = pxm->SaveStateDelta();
+  vtkPVXMLElement* fullState = pxm->SaveState();
+  ofstream journal(JOURNAL_FILE, ios::out | ios::app);
+  secondDelta->PrintXML(journal, vtkIndent());
+  journal.close();
+
+  bool ret = true;
+  if (!firstDelta || !secondDelta)
+    {
+    cerr << "ERROR: the deltas were not saved." << endl;
+    pxm->UnRegisterProxies();
+    vtkInitializationHelper::Finalize();
+    return 1;
+    }
+
+  // Replay the journal.
+  vtkPVXMLElement* state = NewState(STATE_FILE);
+  if (vtkSMProxyManager::ApplyStateJournal(state, JOURNAL_FILE) != 2)
+    {
+    cerr << "ERROR: the journal did not apply." << endl;
+    ret = false;
+    }
+  ret = CompareStates(fullState, state, "Journal") && ret;
+  state->Delete();
+
+  // Apply the deltas one by one. The second one modifies the properties of
+  // the shrink filter, then removes the cone, which is missing from the
+  // initial state: it must fail without changing the state.
+  state = NewState(STATE_FILE);
+  vtkstd::string initial = ToString(state);
+  if (vtkSMProxyManager::ApplyStateDelta(state, secondDelta) ||
+    ToString(state) != initial)
+    {
+    cerr << "ERROR: a delta that cannot be applied changed the state."
+      << endl;
+    ret = false;
+    }
+  if (!vtkSMProxyManager::ApplyStateDelta(state, firstDelta))
+    {
+    cerr << "ERROR: the first delta did not apply." << endl;
+    ret = false;
+    }
+  ret = CompareStates(firstState, state, "First delta") && ret;
+  if (!vtkSMProxyManager::ApplyStateDelta(state, secondDelta))
+    {
+    cerr << "ERROR: the second delta did not apply." << endl;
+    ret = false;
+    }
+  ret = CompareStates(fullState, state, "Second delta") && ret;
+  state->Delete();
+
+  // The replay of a journal stops at the first delta that cannot be
+  // applied, here one removing an unknown proxy.
+  vtkPVXMLElement* badDelta = vtkPVXMLElement::New();
+  badDelta->SetName("ServerManagerStateDelta");
+  vtkPVXMLElement* removed = vtkPVXMLElement::New();
+  removed->SetName("RemovedProxy");
+  removed->AddAttribute("id", "unknown");
+  badDelta->AddNestedElement(removed);
+  removed->Delete();
+  ofstream badJournal(BAD_JOURNAL_FILE, ios::out);
+  firstDelta->PrintXML(badJournal, vtkIndent());
+  badDelta->PrintXML(badJournal, vtkIndent());
+  secondDelta->PrintXML(badJournal, vtkIndent());
+  badJournal.close();
+  badDelta->Delete();
+  state = NewState(STATE_FILE);
+  if (vtkSMProxyManager::ApplyStateJournal(state, BAD_JOURNAL_FILE) != 1)
+    {
+    cerr << "ERROR: the journal did not stop at the delta that failed."
+      << endl;
+    ret = false;
+    }
+  ret = CompareStates(firstState, state, "Journal with a failure") && ret;
+  state->Delete();
+
+  // Load the state with the journal. The proxies get new ids, so only the
+  // pipeline is checked.
+  pxm->SetStateDeltaTracking(0);
+  pxm->UnRegisterProxies();
+  pxm->LoadStateWithJournal(STATE_FILE, JOURNAL_FILE);
+  sphere = pxm->GetProxy("sources", "Sphere");
+  shrink = pxm->GetProxy("sources", "Shrink");
+  if (!sphere || !shrink || pxm->GetProxy("sources", "Cone") ||
+    vtkSMPropertyHelper(sphere, "ThetaResolution").GetAsInt() != 20 ||
+    vtkSMPropertyHelper(shrink, "ShrinkFactor").GetAsDouble() != 0.25 ||
+    vtkSMPropertyHelper(shrink, "Input").GetAsProxy() != sphere)
+    {
+    cerr << "ERROR: LoadStateWithJournal did not restore the pipeline."
+      << endl;
+    ret = false;
+    }
+
+  firstDelta->Delete();
+  firstState->Delete();
+  secondDelta->Delete();
+  fullState->Delete();
+  pxm->UnRegisterProxies();
+  vtkInitializationHelper::Finalize();
+  return ret? 0 : 1;
+}
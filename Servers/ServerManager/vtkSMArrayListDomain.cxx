@@ -60,6 +60,7 @@ vtkSMArrayListDomain::vtkSMArrayListDomain()
   this->InputDomainName = 0;
   this->NoneString = 0;
   this->ALDInternals = new vtkSMArrayListDomainInternals;
+  this->LazyUpdate = 1;
 }
 
 //---------------------------------------------------------------------------
@@ -73,13 +74,22 @@ vtkSMArrayListDomain::~vtkSMArrayListDomain()
 //---------------------------------------------------------------------------
 int vtkSMArrayListDomain::IsArrayPartial(unsigned int idx)
 {
+  this->UpdateIfNeeded();
   const char* name = this->GetString(idx);
   return this->ALDInternals->PartialMap[name];
 }
 
+//---------------------------------------------------------------------------
+unsigned int vtkSMArrayListDomain::GetDefaultElement()
+{
+  this->UpdateIfNeeded();
+  return this->DefaultElement;
+}
+
 //---------------------------------------------------------------------------
 int vtkSMArrayListDomain::GetFieldAssociation(unsigned int idx)
 {
+  this->UpdateIfNeeded();
   if (this->ALDInternals->FieldAssociation.size() > idx)
     {
     return this->ALDInternals->FieldAssociation[idx];
@@ -540,6 +550,7 @@ int vtkSMArrayListDomain::ReadXMLAttributes(
 //---------------------------------------------------------------------------
 int vtkSMArrayListDomain::SetDefaultValues(vtkSMProperty* prop)
 {
+  this->UpdateIfNeeded();
   vtkSMStringVectorProperty* svp =
     vtkSMStringVectorProperty::SafeDownCast(prop);
   if (!svp)
@@ -91,7 +91,7 @@ public:
   // if the AttributeType is set to SCALARS, DefaultElement is
   // set to the index of the array that is the active scalars
   // in the dataset.
-  vtkGetMacro(DefaultElement, unsigned int);
+  unsigned int GetDefaultElement();
 
   // Description:
   // Returns true if the array with the given idx is partial
@@ -31,6 +31,7 @@ vtkStandardNewMacro(vtkSMArrayRangeDomain);
 //---------------------------------------------------------------------------
 vtkSMArrayRangeDomain::vtkSMArrayRangeDomain()
 {
+  this->LazyUpdate = 1;
 }
 
 //---------------------------------------------------------------------------
@@ -220,6 +221,7 @@ void vtkSMArrayRangeDomain::SetArrayRange(
 //---------------------------------------------------------------------------
 int vtkSMArrayRangeDomain::SetDefaultValues(vtkSMProperty* prop)
 {
+  this->UpdateIfNeeded();
   vtkSMDoubleVectorProperty* dvp = 
     vtkSMDoubleVectorProperty::SafeDownCast(prop);
   if (!dvp)
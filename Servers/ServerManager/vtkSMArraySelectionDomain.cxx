@@ -22,6 +22,7 @@ vtkStandardNewMacro(vtkSMArraySelectionDomain);
 //---------------------------------------------------------------------------
 vtkSMArraySelectionDomain::vtkSMArraySelectionDomain()
 {
+  this->LazyUpdate = 1;
 }
 
 //---------------------------------------------------------------------------
@@ -70,6 +71,7 @@ void vtkSMArraySelectionDomain::Update(vtkSMProperty* prop)
 //---------------------------------------------------------------------------
 int vtkSMArraySelectionDomain::SetDefaultValues(vtkSMProperty* prop)
 {
+  this->UpdateIfNeeded();
   vtkSMStringVectorProperty* svp = vtkSMStringVectorProperty::SafeDownCast(prop);
   if(!svp || this->GetNumberOfRequiredProperties() == 0)
     {
@@ -32,6 +32,7 @@ vtkSMBoundsDomain::vtkSMBoundsDomain()
   this->DefaultMode = vtkSMBoundsDomain::MID;
   this->InputInformation = 0;
   this->ScaleFactor = 0.1;
+  this->LazyUpdate = 1;
 }
 
 //---------------------------------------------------------------------------
@@ -282,6 +283,7 @@ void vtkSMBoundsDomain::Update(vtkSMProxyProperty *pp)
 //---------------------------------------------------------------------------
 int vtkSMBoundsDomain::SetDefaultValues(vtkSMProperty* prop)
 {
+  this->UpdateIfNeeded();
   vtkSMDoubleVectorProperty* dvp = vtkSMDoubleVectorProperty::SafeDownCast(prop);
   if (!dvp)
     {
@@ -68,6 +68,7 @@ protected:
   // overloads of UpdatePropertyInformation() call this method, so subclass can
   // override this method to perform special tasks.
   virtual void UpdatePropertyInformationInternal(vtkSMProperty*);
+  virtual bool CanBatchPropertyInformation() { return false; }
 
 private:
   vtkSMChartNamedOptionsModelProxy(const vtkSMChartNamedOptionsModelProxy&); // Not implemented
@@ -32,6 +32,7 @@ vtkSMCompositeTreeDomain::vtkSMCompositeTreeDomain()
   this->Mode = ALL;
   this->Source = 0;
   this->SourcePort = 0;
+  this->LazyUpdate = 1;
 }
 
 //----------------------------------------------------------------------------
@@ -69,9 +70,24 @@ void vtkSMCompositeTreeDomain::InvokeModifiedIfChanged()
     }
 }
 
+//---------------------------------------------------------------------------
+vtkPVDataInformation* vtkSMCompositeTreeDomain::GetInformation()
+{
+  this->UpdateIfNeeded();
+  return this->Information;
+}
+
+//---------------------------------------------------------------------------
+int vtkSMCompositeTreeDomain::GetSourcePort()
+{
+  this->UpdateIfNeeded();
+  return this->SourcePort;
+}
+
 //---------------------------------------------------------------------------
 vtkSMSourceProxy* vtkSMCompositeTreeDomain::GetSource()
 {
+  this->UpdateIfNeeded();
   return this->Source.GetPointer();
 }
 
@@ -162,6 +178,7 @@ int vtkSMCompositeTreeDomain::ReadXMLAttributes(
 //----------------------------------------------------------------------------
 int vtkSMCompositeTreeDomain::SetDefaultValues(vtkSMProperty* property)
 {
+  this->UpdateIfNeeded();
   vtkSMIntVectorProperty* ivp = vtkSMIntVectorProperty::SafeDownCast(property);
   if (ivp && this->Information && ivp->GetNumberOfElements() == 1)
     {
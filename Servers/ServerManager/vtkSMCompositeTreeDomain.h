@@ -51,7 +51,7 @@ public:
   // Description:
   // Get the vtkPVDataInformation which provides the tree structure for the
   // composite dataset.
-  vtkGetObjectMacro(Information, vtkPVDataInformation);
+  vtkPVDataInformation* GetInformation();
 
   // Description:
   // Returns the source proxy whose data information is returned by
@@ -61,7 +61,7 @@ public:
   // Description:
   // Returns the port for the source proxy from which the data information is
   // obtained by GetInformation().
-  vtkGetMacro(SourcePort, int);
+  int GetSourcePort();
 
   // Description:
   // Is the (unchecked) value of the property in the domain? Overwritten by
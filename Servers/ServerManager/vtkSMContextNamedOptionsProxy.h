@@ -102,6 +102,7 @@ protected:
   // overloads of UpdatePropertyInformation() call this method, so subclass can
   // override this method to perform special tasks.
   virtual void UpdatePropertyInformationInternal(vtkSMProperty*);
+  virtual bool CanBatchPropertyInformation() { return false; }
 
   // Description:
   // If the plot exists this will set its visibility.  If the plot does not yet
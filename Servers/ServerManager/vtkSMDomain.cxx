@@ -19,7 +19,9 @@
 #include "vtkSMProperty.h"
 #include "vtkSmartPointer.h"
 
+#include <vtkstd/algorithm>
 #include <vtkstd/map>
+#include <vtkstd/vector>
 #include "vtkStdString.h"
 
 
@@ -28,14 +30,22 @@ struct vtkSMDomainInternals
   typedef 
   vtkstd::map<vtkStdString, vtkSmartPointer<vtkSMProperty> > PropertyMap;
   PropertyMap RequiredProperties;
+
+  // Properties for which an update was requested but not done yet. NULL
+  // stands for the property the domain belongs to.
+  typedef vtkstd::vector<vtkSMProperty*> PropertyVector;
+  PropertyVector PendingUpdates;
 };
 
+static vtkIdType vtkSMDomainNumberOfSuppressedUpdates = 0;
+
 //---------------------------------------------------------------------------
 vtkSMDomain::vtkSMDomain()
 {
   this->XMLName = 0;
   this->Internals = new vtkSMDomainInternals;
   this->IsOptional = 0;
+  this->LazyUpdate = 0;
 }
 
 //---------------------------------------------------------------------------
@@ -60,6 +70,11 @@ vtkSMProperty* vtkSMDomain::GetRequiredProperty(const char* function)
 //---------------------------------------------------------------------------
 void vtkSMDomain::RemoveRequiredProperty(vtkSMProperty* prop)
 {
+  vtkSMDomainInternals::PropertyVector& pending =
+    this->Internals->PendingUpdates;
+  pending.erase(vtkstd::remove(pending.begin(), pending.end(), prop),
+    pending.end());
+
   vtkSMDomainInternals::PropertyMap::iterator iter = 
     this->Internals->RequiredProperties.begin();
 
@@ -146,6 +161,63 @@ unsigned int vtkSMDomain::GetNumberOfRequiredProperties()
   return this->Internals->RequiredProperties.size();
 }
 
+//---------------------------------------------------------------------------
+void vtkSMDomain::RequestUpdate(vtkSMProperty* prop)
+{
+  if (!this->LazyUpdate)
+    {
+    this->Update(prop);
+    return;
+    }
+
+  vtkSMDomainInternals::PropertyVector& pending =
+    this->Internals->PendingUpdates;
+  if (vtkstd::find(pending.begin(), pending.end(), prop) != pending.end())
+    {
+    vtkSMDomainNumberOfSuppressedUpdates++;
+    }
+  else
+    {
+    pending.push_back(prop);
+    }
+
+  // Observers of the domain would query it as soon as they are notified.
+  if (this->HasObserver(vtkCommand::DomainModifiedEvent))
+    {
+    this->UpdateIfNeeded();
+    }
+}
+
+//---------------------------------------------------------------------------
+void vtkSMDomain::UpdateIfNeeded()
+{
+  if (this->Internals->PendingUpdates.empty())
+    {
+    return;
+    }
+
+  // Update() may query the domain, clear the requests first.
+  vtkSMDomainInternals::PropertyVector pending;
+  pending.swap(this->Internals->PendingUpdates);
+  vtkSMDomainInternals::PropertyVector::iterator iter;
+  for (iter = pending.begin(); iter != pending.end(); ++iter)
+    {
+    this->Update(*iter);
+    }
+}
+
+//---------------------------------------------------------------------------
+vtkIdType vtkSMDomain::GetNumberOfSuppressedUpdates()
+{
+  return vtkSMDomainNumberOfSuppressedUpdates;
+}
+
+//---------------------------------------------------------------------------
+void vtkSMDomain::ResetNumberOfSuppressedUpdates()
+{
+  vtkSMDomainNumberOfSuppressedUpdates = 0;
+}
+
 //---------------------------------------------------------------------------
 void vtkSMDomain::InvokeModified()
 {
@@ -165,6 +237,7 @@ void vtkSMDomain::SaveState(vtkPVXMLElement* parent, const char* uid)
   domainElement->AddAttribute("name", this->XMLName);
   domainElement->AddAttribute("id", uid);
 
+  this->UpdateIfNeeded();
   this->ChildSaveState(domainElement);
 
   parent->AddNestedElement(domainElement);
@@ -178,4 +251,5 @@ void vtkSMDomain::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "XMLName: " << (this->XMLName ? this->XMLName : "(null)") 
      << endl;
   os << indent << "IsOptional: " << this->IsOptional << endl;
+  os << indent << "LazyUpdate: " << this->LazyUpdate << endl;
 }
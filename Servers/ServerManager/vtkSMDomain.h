@@ -20,6 +20,12 @@
 // Each domain can depend on one or more properties to compute it's
 // values. This are called "required" properties and can be set in
 // the XML configuration file.
+//
+// Domains with LazyUpdate on do not recompute when a required property
+// changes. The update request is noted and the domain is recomputed when
+// it is queried, or right away if something observes its
+// DomainModifiedEvent (e.g. a widget showing the domain). Domains computed
+// from data information, which can be expensive to gather, use it.
 // .SECTION See Also
 // vtkSMProxyGroupDomain
 
@@ -52,6 +58,30 @@ public:
   // properties. Overwritten by sub-classes.
   virtual void Update(vtkSMProperty*) {this->InvokeModified();};
 
+  // Description:
+  // Called by the properties when the domain must be updated. Calls
+  // Update() unless LazyUpdate is on, in which case the update is done by
+  // UpdateIfNeeded() when the domain is queried.
+  void RequestUpdate(vtkSMProperty*);
+
+  // Description:
+  // Performs the updates requested since the domain was last queried, if
+  // any. Query methods of domains supporting LazyUpdate call it first.
+  void UpdateIfNeeded();
+
+  // Description:
+  // When on, updates requested with RequestUpdate() are delayed until the
+  // domain is queried. On by default for domains that support it.
+  vtkSetMacro(LazyUpdate, int);
+  vtkGetMacro(LazyUpdate, int);
+  vtkBooleanMacro(LazyUpdate, int);
+
+  // Description:
+  // Number of update requests, over all domains, that were merged with an
+  // update already pending instead of recomputing the domain.
+  static vtkIdType GetNumberOfSuppressedUpdates();
+  static void ResetNumberOfSuppressedUpdates();
+
   // Description:
   // Set the value of an element of a property from the animation editor.
   virtual void SetAnimationValue(vtkSMProperty*, int, double) {}
@@ -123,6 +153,8 @@ protected:
   vtkSetMacro(IsOptional, int);
   int IsOptional;
 
+  int LazyUpdate;
+
   char* XMLName;
 
   // Description:
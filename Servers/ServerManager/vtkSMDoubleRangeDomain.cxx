@@ -53,6 +53,7 @@ vtkSMDoubleRangeDomain::~vtkSMDoubleRangeDomain()
 //---------------------------------------------------------------------------
 int vtkSMDoubleRangeDomain::IsInDomain(vtkSMProperty* property)
 {
+  this->UpdateIfNeeded();
   if (this->IsOptional)
     {
     return 1;
@@ -83,6 +84,7 @@ int vtkSMDoubleRangeDomain::IsInDomain(vtkSMProperty* property)
 //---------------------------------------------------------------------------
 int vtkSMDoubleRangeDomain::IsInDomain(unsigned int idx, double val)
 {
+  this->UpdateIfNeeded();
   // User has not put any condition so domains is always valid
   if (idx >= this->DRInternals->Entries.size())
     {
@@ -117,6 +119,7 @@ int vtkSMDoubleRangeDomain::IsInDomain(unsigned int idx, double val)
 //---------------------------------------------------------------------------
 unsigned int vtkSMDoubleRangeDomain::GetNumberOfEntries()
 {
+  this->UpdateIfNeeded();
   return this->DRInternals->Entries.size();
 }
 
@@ -129,6 +132,7 @@ void vtkSMDoubleRangeDomain::SetNumberOfEntries(unsigned int size)
 //---------------------------------------------------------------------------
 double vtkSMDoubleRangeDomain::GetMinimum(unsigned int idx, int& exists)
 {
+  this->UpdateIfNeeded();
   exists = 0;
   if (idx >= this->DRInternals->Entries.size())
     {
@@ -145,6 +149,7 @@ double vtkSMDoubleRangeDomain::GetMinimum(unsigned int idx, int& exists)
 //---------------------------------------------------------------------------
 double vtkSMDoubleRangeDomain::GetMaximum(unsigned int idx, int& exists)
 {
+  this->UpdateIfNeeded();
   exists = 0;
   if (idx >= this->DRInternals->Entries.size())
     {
@@ -161,6 +166,7 @@ double vtkSMDoubleRangeDomain::GetMaximum(unsigned int idx, int& exists)
 //---------------------------------------------------------------------------
 int vtkSMDoubleRangeDomain::GetMinimumExists(unsigned int idx)
 {
+  this->UpdateIfNeeded();
   if (idx >= this->DRInternals->Entries.size())
     {
     return 0;
@@ -171,6 +177,7 @@ int vtkSMDoubleRangeDomain::GetMinimumExists(unsigned int idx)
 //---------------------------------------------------------------------------
 int vtkSMDoubleRangeDomain::GetMaximumExists(unsigned int idx)
 {
+  this->UpdateIfNeeded();
   if (idx >= this->DRInternals->Entries.size())
     {
     return 0;
@@ -182,6 +189,7 @@ int vtkSMDoubleRangeDomain::GetMaximumExists(unsigned int idx)
 //---------------------------------------------------------------------------
 double vtkSMDoubleRangeDomain::GetMaximum(unsigned int idx)
 {
+  this->UpdateIfNeeded();
   if (!this->GetMaximumExists(idx))
     {
     return 0;
@@ -192,6 +200,7 @@ double vtkSMDoubleRangeDomain::GetMaximum(unsigned int idx)
 //---------------------------------------------------------------------------
 double vtkSMDoubleRangeDomain::GetMinimum(unsigned int idx)
 {
+  this->UpdateIfNeeded();
   if (!this->GetMinimumExists(idx))
     {
     return 0;
@@ -202,6 +211,7 @@ double vtkSMDoubleRangeDomain::GetMinimum(unsigned int idx)
 //---------------------------------------------------------------------------
 double vtkSMDoubleRangeDomain::GetResolution(unsigned int idx, int& exists)
 {
+  this->UpdateIfNeeded();
   exists = 0;
   if (idx >= this->DRInternals->Entries.size())
     {
@@ -218,6 +228,7 @@ double vtkSMDoubleRangeDomain::GetResolution(unsigned int idx, int& exists)
 //---------------------------------------------------------------------------
 int vtkSMDoubleRangeDomain::GetResolutionExists(unsigned int idx)
 {
+  this->UpdateIfNeeded();
   if (idx >= this->DRInternals->Entries.size())
     {
     return 0;
@@ -228,6 +239,7 @@ int vtkSMDoubleRangeDomain::GetResolutionExists(unsigned int idx)
 //---------------------------------------------------------------------------
 double vtkSMDoubleRangeDomain::GetResolution(unsigned int idx)
 {
+  this->UpdateIfNeeded();
   if (!this->GetResolutionExists(idx))
     {
     return 0;
@@ -470,6 +482,7 @@ void vtkSMDoubleRangeDomain::Update(vtkSMProperty* prop)
 void vtkSMDoubleRangeDomain::SetAnimationValue(vtkSMProperty *property,
                                                int idx, double value)
 {
+  this->UpdateIfNeeded();
   if (!property)
     {
     return;
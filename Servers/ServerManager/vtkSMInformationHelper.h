@@ -30,6 +30,7 @@
 #include "vtkSMObject.h"
 #include "vtkClientServerID.h" // needed for vtkClientServerID
 
+class vtkClientServerStream;
 class vtkPVXMLElement;
 class vtkSMProperty;
 
@@ -46,6 +47,21 @@ public:
   virtual void UpdateProperty(
     vtkIdType connectionId,
     int serverIds, vtkClientServerID objectId, vtkSMProperty* prop) = 0;
+
+  // Description:
+  // Helpers that fill the property with the result of a single command
+  // invoked on the root of the servers can be batched with other
+  // properties (see vtkSMProxy::UpdatePropertyInformation(vtkCollection*)).
+  // AppendRequest() appends that command to the stream and returns 1, and
+  // ProcessResult() fills the property from its result. The default
+  // implementation returns 0, in which case UpdateProperty() is used.
+  virtual int AppendRequest(vtkClientServerID vtkNotUsed(objectId),
+    vtkSMProperty* vtkNotUsed(prop), vtkClientServerStream& vtkNotUsed(str))
+    {
+    return 0;
+    }
+  virtual void ProcessResult(vtkSMProperty* vtkNotUsed(prop),
+    const vtkClientServerStream& vtkNotUsed(res)) {}
   //ETX
 
 protected:
@@ -28,6 +28,10 @@
 #include "vtkPVXMLElement.h"
 #include "vtkSMSourceProxy.h"
 
+#include <vtkstd/map>
+#include <vtkstd/utility>
+#include <vtkstd/vector>
+
 //----------------------------------------------------------------------------
 vtkStandardNewMacro(vtkSMOutputPort);
 
@@ -254,6 +258,67 @@ void vtkSMOutputPort::GatherDataInformation()
   pm->SendCleanupPendingProgress(this->ConnectionID);
 }
 
+//----------------------------------------------------------------------------
+void vtkSMOutputPort::PrefetchDataInformation(vtkCollection* ports)
+{
+  if (!ports)
+    {
+    return;
+    }
+
+  // Group the ports needing information by connection and servers, since a
+  // single request can only be sent to one place.
+  typedef vtkstd::pair<vtkIdType, vtkTypeUInt32> KeyType;
+  typedef vtkstd::map<KeyType, vtkstd::vector<vtkSMOutputPort*> > MapType;
+  MapType requests;
+
+  vtkCollectionIterator* iter = ports->NewIterator();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+    iter->GoToNextItem())
+    {
+    vtkSMOutputPort* port =
+      vtkSMOutputPort::SafeDownCast(iter->GetCurrentObject());
+    if (!port || port->DataInformationValid || port->GetID().IsNull())
+      {
+      continue;
+      }
+    if (strcmp(port->GetClassName(), "vtkSMOutputPort") != 0)
+      {
+      port->GetDataInformation();
+      continue;
+      }
+    requests[KeyType(port->ConnectionID, port->Servers)].push_back(port);
+    }
+  iter->Delete();
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  MapType::iterator it;
+  for (it = requests.begin(); it != requests.end(); ++it)
+    {
+    vtkstd::vector<vtkSMOutputPort*>& group = it->second;
+    vtkstd::vector<vtkPVInformation*> infos;
+    vtkstd::vector<vtkClientServerID> ids;
+    vtkstd::vector<vtkSMOutputPort*>::iterator portIter;
+    for (portIter = group.begin(); portIter != group.end(); ++portIter)
+      {
+      // The same port may be listed more than once.
+      if ((*portIter)->DataInformationValid)
+        {
+        continue;
+        }
+      (*portIter)->DataInformation->Initialize();
+      (*portIter)->DataInformationValid = true;
+      infos.push_back((*portIter)->DataInformation);
+      ids.push_back((*portIter)->GetID());
+      }
+
+    pm->SendPrepareProgress(it->first.first);
+    pm->GatherInformation(it->first.first, it->first.second,
+      static_cast<int>(infos.size()), &infos[0], &ids[0]);
+    pm->SendCleanupPendingProgress(it->first.first);
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMOutputPort::GatherTemporalDataInformation()
 {
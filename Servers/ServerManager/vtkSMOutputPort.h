@@ -62,6 +62,14 @@ public:
   // Mark data information as invalid.
   virtual void InvalidateDataInformation();
 
+  // Description:
+  // Gathers the data information of all the vtkSMOutputPort in the
+  // collection whose data information is not valid. The requests for ports
+  // on the same connection are sent together and answered in a single
+  // round trip, instead of one round trip per port. Subclasses that gather
+  // their information differently are updated with GetDataInformation().
+  static void PrefetchDataInformation(vtkCollection* ports);
+
   // Description:
   // Returns the index of the port the output is obtained from.
   vtkGetMacro(PortIndex, int);
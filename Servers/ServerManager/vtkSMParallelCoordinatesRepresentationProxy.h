@@ -106,6 +106,7 @@ protected:
   // overloads of UpdatePropertyInformation() call this method, so subclass can
   // override this method to perform special tasks.
   virtual void UpdatePropertyInformationInternal(vtkSMProperty*);
+  virtual bool CanBatchPropertyInformation() { return false; }
 
   vtkSMClientDeliveryRepresentationProxy* SelectionRepresentation;
 
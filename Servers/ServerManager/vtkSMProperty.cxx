@@ -202,7 +202,7 @@ void vtkSMProperty::UpdateDependentDomains()
   this->DomainIterator->Begin();
   while(!this->DomainIterator->IsAtEnd())
     {
-    this->DomainIterator->GetDomain()->Update(0);
+    this->DomainIterator->GetDomain()->RequestUpdate(0);
     this->DomainIterator->Next();
     }
 
@@ -211,7 +211,7 @@ void vtkSMProperty::UpdateDependentDomains()
     this->PInternals->Dependents.begin();
   for (; iter != this->PInternals->Dependents.end(); iter++)
     {
-    iter->GetPointer()->Update(this);
+    iter->GetPointer()->RequestUpdate(this);
     }
 }
 
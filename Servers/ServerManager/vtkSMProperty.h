@@ -150,7 +150,9 @@ public:
   // this property, a NULL is passed as the argument. This is
   // because the domain does not really "depend" on the property.
   // When calling Update() on dependent domains, the property
-  // passes itself as the argument.
+  // passes itself as the argument. Domains with LazyUpdate on
+  // delay the update until they are queried (see
+  // vtkSMDomain::RequestUpdate()).
   void UpdateDependentDomains();
 
   // Description:
@@ -19,6 +19,19 @@
 #include "vtkSMProperty.h"
 #include "vtkSMProxy.h"
 #include "vtkSMProxyLocator.h"
+#include "vtkSmartPointer.h"
+#include "vtkUndoSet.h"
+
+#include <vtkstd/algorithm>
+#include <vtkstd/map>
+#include <vtkstd/string>
+#include <vtkstd/vector>
+
+// Properties with fewer elements are saved as they are.
+#define VTK_SM_MIN_ELEMENTS_FOR_DELTA 16
+
+static vtkPVXMLElement* vtkSMPropertyModificationUndoElementNewFullValues(
+  vtkPVXMLElement* propertyElement);
 
 vtkStandardNewMacro(vtkSMPropertyModificationUndoElement);
 //-----------------------------------------------------------------------------
@@ -85,8 +98,24 @@ int vtkSMPropertyModificationUndoElement::Redo()
   int ret = 0;
   if (property)
     {
-    ret = property->LoadState(this->XMLElement->GetNestedElement(0),  
-      locator, 0);
+    vtkPVXMLElement* propertyElement = this->XMLElement->GetNestedElement(0);
+    if (propertyElement->GetAttribute("delta"))
+      {
+      // The property may have been changed outside of the undo stack since
+      // the state was saved, so the delta is not applied to its current
+      // value but to the full values saved before the modification.
+      vtkSmartPointer<vtkPVXMLElement> fullValues;
+      fullValues.TakeReference(
+        vtkSMPropertyModificationUndoElementNewFullValues(propertyElement));
+      if (!fullValues)
+        {
+        vtkErrorMacro("Failed to expand the modified values of "
+          << property_name << ". Cannot Redo.");
+        return 0;
+        }
+      return property->LoadState(fullValues, locator, 0);
+      }
+    ret = property->LoadState(propertyElement, locator, 0);
     }
   return ret;
 }
@@ -122,6 +151,245 @@ void vtkSMPropertyModificationUndoElement::ModifiedProperty(vtkSMProxy* proxy,
   pmElement->Delete();
 }
 
+//-----------------------------------------------------------------------------
+// Collects the <Element /> children of element. Returns false if element has
+// other children or if the elements are not stored in index order.
+static bool vtkSMPropertyModificationUndoElementGetValues(
+  vtkPVXMLElement* element, vtkPVXMLElement* skip,
+  vtkstd::vector<vtkSmartPointer<vtkPVXMLElement> >& values)
+{
+  unsigned int numElems = element->GetNumberOfNestedElements();
+  values.reserve(numElems);
+  for (unsigned int cc=0; cc < numElems; ++cc)
+    {
+    vtkPVXMLElement* child = element->GetNestedElement(cc);
+    if (child == skip)
+      {
+      continue;
+      }
+    int index;
+    if (!child->GetName() || strcmp(child->GetName(), "Element") != 0 ||
+      !child->GetScalarAttribute("index", &index) ||
+      index != static_cast<int>(values.size()) ||
+      !child->GetAttribute("value"))
+      {
+      return false;
+      }
+    values.push_back(child);
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// Returns a new <LastPushedValues /> element holding a copy of the new values
+// of the saved state of a vector property, or NULL if the values cannot be
+// collected.
+static vtkPVXMLElement* vtkSMPropertyModificationUndoElementNewPushedValues(
+  vtkPVXMLElement* propertyElement)
+{
+  vtkstd::vector<vtkSmartPointer<vtkPVXMLElement> > values;
+  vtkPVXMLElement* lastPushed =
+    propertyElement->FindNestedElementByName("LastPushedValues");
+  if (!lastPushed ||
+    !propertyElement->GetAttribute("number_of_elements") ||
+    !vtkSMPropertyModificationUndoElementGetValues(
+      propertyElement, lastPushed, values))
+    {
+    return 0;
+    }
+
+  vtkPVXMLElement* pushed = vtkPVXMLElement::New();
+  pushed->SetName("LastPushedValues");
+  pushed->AddAttribute("number_of_elements",
+    propertyElement->GetAttribute("number_of_elements"));
+  for (size_t cc=0; cc < values.size(); ++cc)
+    {
+    vtkPVXMLElement* element = vtkPVXMLElement::New();
+    element->SetName("Element");
+    element->AddAttribute("index", values[cc]->GetAttribute("index"));
+    element->AddAttribute("value", values[cc]->GetAttribute("value"));
+    pushed->AddNestedElement(element);
+    element->Delete();
+    }
+  return pushed;
+}
+
+//-----------------------------------------------------------------------------
+// Returns a new property element holding all the new values of a property
+// element reduced by RemoveUnchangedElements(). The values that were removed
+// are taken from its LastPushedValues. Returns NULL if the values cannot be
+// collected.
+static vtkPVXMLElement* vtkSMPropertyModificationUndoElementNewFullValues(
+  vtkPVXMLElement* propertyElement)
+{
+  vtkPVXMLElement* lastPushed =
+    propertyElement->FindNestedElementByName("LastPushedValues");
+  int numValues;
+  if (!lastPushed ||
+    !propertyElement->GetScalarAttribute("number_of_elements", &numValues) ||
+    numValues < 0)
+    {
+    return 0;
+    }
+
+  vtkstd::vector<vtkSmartPointer<vtkPVXMLElement> > oldValues;
+  if (!vtkSMPropertyModificationUndoElementGetValues(lastPushed, 0, oldValues))
+    {
+    return 0;
+    }
+  vtkstd::vector<vtkSmartPointer<vtkPVXMLElement> > values(oldValues.begin(),
+    oldValues.begin() + vtkstd::min(oldValues.size(),
+      static_cast<size_t>(numValues)));
+  values.resize(numValues);
+
+  unsigned int numElems = propertyElement->GetNumberOfNestedElements();
+  unsigned int cc;
+  for (cc=0; cc < numElems; ++cc)
+    {
+    vtkPVXMLElement* child = propertyElement->GetNestedElement(cc);
+    int index;
+    if (child == lastPushed)
+      {
+      continue;
+      }
+    if (!child->GetName() || strcmp(child->GetName(), "Element") != 0 ||
+      !child->GetScalarAttribute("index", &index) ||
+      index < 0 || index >= numValues)
+      {
+      return 0;
+      }
+    values[index] = child;
+    }
+
+  vtkPVXMLElement* fullValues = vtkPVXMLElement::New();
+  fullValues->SetName(propertyElement->GetName());
+  for (cc=0; cc < propertyElement->GetNumberOfAttributes(); ++cc)
+    {
+    if (strcmp(propertyElement->GetAttributeName(cc), "delta") != 0)
+      {
+      fullValues->AddAttribute(propertyElement->GetAttributeName(cc),
+        propertyElement->GetAttributeValue(cc));
+      }
+    }
+  for (cc=0; cc < values.size(); ++cc)
+    {
+    if (!values[cc])
+      {
+      fullValues->Delete();
+      return 0;
+      }
+    // The values still belong to the saved state.
+    fullValues->AddNestedElement(values[cc], 0);
+    }
+  return fullValues;
+}
+
+//-----------------------------------------------------------------------------
+void vtkSMPropertyModificationUndoElement::RemoveUnchangedElements(
+  vtkUndoSet* set)
+{
+  int numElems = set->GetNumberOfElements();
+
+  // The values of a property before each modification in the set. When a
+  // property is modified more than once, the values before a modification are
+  // the ones set by the previous modification, not the last pushed ones.
+  vtkstd::vector<vtkSmartPointer<vtkPVXMLElement> > previousValues(numElems);
+  vtkstd::map<vtkstd::string, vtkSmartPointer<vtkPVXMLElement> > newValues;
+  int cc;
+  for (cc=0; cc < numElems; ++cc)
+    {
+    vtkSMPropertyModificationUndoElement* elem =
+      vtkSMPropertyModificationUndoElement::SafeDownCast(set->GetElement(cc));
+    if (!elem || !elem->XMLElement ||
+      elem->XMLElement->GetNumberOfNestedElements() == 0 ||
+      !elem->XMLElement->GetAttribute("id") ||
+      !elem->XMLElement->GetAttribute("name"))
+      {
+      continue;
+      }
+    vtkstd::string key = elem->XMLElement->GetAttribute("id");
+    key += ".";
+    key += elem->XMLElement->GetAttribute("name");
+
+    vtkSmartPointer<vtkPVXMLElement>& values = newValues[key];
+    previousValues[cc] = values;
+    values.TakeReference(vtkSMPropertyModificationUndoElementNewPushedValues(
+        elem->XMLElement->GetNestedElement(0)));
+    }
+
+  for (cc=0; cc < numElems; ++cc)
+    {
+    vtkSMPropertyModificationUndoElement* elem =
+      vtkSMPropertyModificationUndoElement::SafeDownCast(set->GetElement(cc));
+    if (!elem || !elem->XMLElement ||
+      elem->XMLElement->GetNumberOfNestedElements() == 0)
+      {
+      continue;
+      }
+    vtkPVXMLElement* propertyElement = elem->XMLElement->GetNestedElement(0);
+    if (previousValues[cc])
+      {
+      vtkPVXMLElement* lastPushed =
+        propertyElement->FindNestedElementByName("LastPushedValues");
+      propertyElement->RemoveNestedElement(lastPushed);
+      propertyElement->AddNestedElement(previousValues[cc]);
+      }
+    vtkSMPropertyModificationUndoElement::RemoveUnchangedElements(
+      propertyElement);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void vtkSMPropertyModificationUndoElement::RemoveUnchangedElements(
+  vtkPVXMLElement* propertyElement)
+{
+  vtkPVXMLElement* lastPushed =
+    propertyElement->FindNestedElementByName("LastPushedValues");
+  if (!lastPushed)
+    {
+    return;
+    }
+
+  vtkstd::vector<vtkSmartPointer<vtkPVXMLElement> > newValues;
+  vtkstd::vector<vtkSmartPointer<vtkPVXMLElement> > oldValues;
+  if (!vtkSMPropertyModificationUndoElementGetValues(
+      propertyElement, lastPushed, newValues) ||
+    !vtkSMPropertyModificationUndoElementGetValues(
+      lastPushed, 0, oldValues))
+    {
+    return;
+    }
+  if (newValues.size() < VTK_SM_MIN_ELEMENTS_FOR_DELTA &&
+    oldValues.size() < VTK_SM_MIN_ELEMENTS_FOR_DELTA)
+    {
+    return;
+    }
+
+  // Only the new values are reduced. The last pushed values are kept in full
+  // so that undo does not depend on the current value of the property, which
+  // may have been changed outside of the undo stack, and so that redo can
+  // rebuild the full new values from them.
+  vtkSmartPointer<vtkPVXMLElement> lastPushedHolder = lastPushed;
+  propertyElement->RemoveAllNestedElements();
+
+  size_t common = vtkstd::min(newValues.size(), oldValues.size());
+  size_t cc;
+  for (cc=0; cc < common; ++cc)
+    {
+    if (strcmp(newValues[cc]->GetAttribute("value"),
+        oldValues[cc]->GetAttribute("value")) != 0)
+      {
+      propertyElement->AddNestedElement(newValues[cc]);
+      }
+    }
+  for (cc=common; cc < newValues.size(); ++cc)
+    {
+    propertyElement->AddNestedElement(newValues[cc]);
+    }
+  propertyElement->AddNestedElement(lastPushed);
+  propertyElement->SetAttribute("delta", "1");
+}
+
 //-----------------------------------------------------------------------------
 bool vtkSMPropertyModificationUndoElement::Merge(vtkUndoElement* 
   vtkNotUsed(new_element))
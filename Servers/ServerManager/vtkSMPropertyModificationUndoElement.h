@@ -19,12 +19,20 @@
 // The undo action sets the property to the value that was pushed on
 // to the server previous to the modification.
 // The redo action sets the property to the modified value.
+//
+// For vector properties with many elements, RemoveUnchangedElements() keeps
+// only the new values that differ from the values before the change. The
+// values before the change are always kept in full: undo loads them as they
+// are and redo fills the missing new values from them, so neither depends on
+// the current value of the property, which may have been changed outside of
+// the undo stack.
 
 #ifndef __vtkSMPropertyModificationUndoElement_h
 #define __vtkSMPropertyModificationUndoElement_h
 
 #include "vtkSMUndoElement.h"
 class vtkSMProxy;
+class vtkUndoSet;
 
 class VTK_EXPORT vtkSMPropertyModificationUndoElement : public vtkSMUndoElement
 {
@@ -57,11 +65,25 @@ public:
   // represent change to the same property.
   // Returns if the merge was successful. 
   virtual bool Merge(vtkUndoElement* vtkNotUsed(new_element));
+
+  // Description:
+  // Reduces the state of the property modification elements in the set to
+  // the elements whose value changed. When a property is modified more than
+  // once in the set, each modification is compared with the previous one
+  // instead of the last pushed values. Must be called once all the elements
+  // have been added to the set.
+  static void RemoveUnchangedElements(vtkUndoSet* set);
   
 protected:
   vtkSMPropertyModificationUndoElement();
   ~vtkSMPropertyModificationUndoElement();
 
+  // Description:
+  // Removes the new values that are the same as the last pushed values from
+  // the saved state of a vector property and marks it with a "delta"
+  // attribute.
+  static void RemoveUnchangedElements(vtkPVXMLElement* propertyElement);
+
 private:
   vtkSMPropertyModificationUndoElement(const vtkSMPropertyModificationUndoElement&); // Not implemented.
   void operator=(const vtkSMPropertyModificationUndoElement&); // Not implemented.
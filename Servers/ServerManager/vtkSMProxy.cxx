@@ -15,6 +15,8 @@
 #include "vtkSMProxy.h"
 
 #include "vtkClientServerInterpreter.h"
+#include "vtkCollection.h"
+#include "vtkCollectionIterator.h"
 #include "vtkCommand.h"
 #include "vtkDebugLeaks.h"
 #include "vtkGarbageCollector.h"
@@ -25,6 +27,7 @@
 #include "vtkPVOptions.h"
 #include "vtkPVXMLElement.h"
 #include "vtkSMDocumentation.h"
+#include "vtkSMInformationHelper.h"
 #include "vtkSMInputProperty.h"
 #include "vtkSMPropertyIterator.h"
 #include "vtkSMProxyLocator.h"
@@ -33,6 +36,7 @@
 #include "vtkSMProxyInternals.h"
 
 #include <vtkstd/algorithm>
+#include <vtkstd/map>
 #include <vtkstd/set>
 #include <vtkstd/string>
 #include <vtksys/ios/sstream>
@@ -966,6 +970,139 @@ void vtkSMProxy::UpdatePropertyInformation()
     }
 }
 
+//---------------------------------------------------------------------------
+// The information properties gathered from one server of a connection.
+struct vtkSMProxyInformationBatch
+{
+  vtkClientServerStream Requests;
+  vtkstd::vector<vtkSMProperty*> Properties;
+};
+
+//---------------------------------------------------------------------------
+void vtkSMProxy::UpdatePropertyInformation(vtkCollection* proxies)
+{
+  if (!proxies)
+    {
+    return;
+    }
+
+  vtkstd::vector<vtkSMProxy*> batched;
+  typedef vtkstd::map<vtkstd::pair<vtkIdType, int>,
+    vtkSMProxyInformationBatch> BatchesType;
+  BatchesType batches;
+
+  vtkCollectionIterator* iter = proxies->NewIterator();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+    iter->GoToNextItem())
+    {
+    vtkSMProxy* proxy = vtkSMProxy::SafeDownCast(iter->GetCurrentObject());
+    if (!proxy)
+      {
+      continue;
+      }
+    proxy->CreateVTKObjects();
+    if (!proxy->ObjectsCreated)
+      {
+      continue;
+      }
+    batched.push_back(proxy);
+
+    vtkSMProxyInternals::PropertyInfoMap::iterator it;
+    for (it = proxy->Internals->Properties.begin();
+      it != proxy->Internals->Properties.end(); ++it)
+      {
+      vtkSMProperty* prop = it->second.Property.GetPointer();
+      if (!proxy->CanBatchPropertyInformation())
+        {
+        proxy->UpdatePropertyInformationInternal(prop);
+        continue;
+        }
+      if (!prop->GetInformationOnly())
+        {
+        continue;
+        }
+      int servers = prop->GetUpdateSelf()?
+        static_cast<int>(vtkProcessModule::CLIENT) :
+        static_cast<int>(proxy->Servers);
+      vtkClientServerID objectId = prop->GetUpdateSelf()?
+        proxy->GetSelfID() : proxy->VTKObjectID;
+      vtkSMProxyInformationBatch& batch = batches[vtkstd::pair<vtkIdType, int>(
+          proxy->ConnectionID, vtkProcessModule::GetRootId(servers))];
+      if (prop->InformationHelper &&
+        prop->InformationHelper->AppendRequest(objectId, prop, batch.Requests))
+        {
+        batch.Properties.push_back(prop);
+        }
+      else
+        {
+        proxy->UpdatePropertyInformationInternal(prop);
+        }
+      }
+    }
+  iter->Delete();
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  BatchesType::iterator batchIter;
+  for (batchIter = batches.begin(); batchIter != batches.end(); ++batchIter)
+    {
+    vtkSMProxyInformationBatch& batch = batchIter->second;
+    if (batch.Properties.empty())
+      {
+      continue;
+      }
+    vtkIdType connectionId = batchIter->first.first;
+    vtkTypeUInt32 server = batchIter->first.second;
+
+    vtkClientServerStream stream;
+    vtkClientServerID batchID =
+      pm->NewStreamObject("vtkPVServerInformationBatch", stream);
+    stream << vtkClientServerStream::Invoke
+           << batchID << "SetProcessModule" << pm->GetProcessModuleID()
+           << vtkClientServerStream::End;
+    stream << vtkClientServerStream::Invoke
+           << batchID << "ProcessRequests" << batch.Requests
+           << vtkClientServerStream::End;
+    pm->SendStream(connectionId, server, stream);
+
+    // Copied since deleting the batch object resets the last result when
+    // it is processed locally.
+    vtkClientServerStream reply = pm->GetLastResult(connectionId, server);
+
+    pm->DeleteStreamObject(batchID, stream);
+    pm->SendStream(connectionId, server, stream);
+
+    for (size_t cc = 0; cc < batch.Properties.size(); ++cc)
+      {
+      vtkClientServerStream result;
+      if (!reply.GetArgument(0, static_cast<int>(cc), &result))
+        {
+        vtkGenericWarningMacro("Failed to get the information of property "
+          << batch.Properties[cc]->GetXMLName() << ".");
+        continue;
+        }
+      batch.Properties[cc]->InformationHelper->ProcessResult(
+        batch.Properties[cc], result);
+      }
+    }
+
+  // Make sure all dependent domains are updated, as
+  // UpdatePropertyInformation() does.
+  vtkstd::vector<vtkSMProxy*>::iterator proxyIter;
+  for (proxyIter = batched.begin(); proxyIter != batched.end(); ++proxyIter)
+    {
+    vtkSMProxyInternals::PropertyInfoMap::iterator it;
+    for (it = (*proxyIter)->Internals->Properties.begin();
+      it != (*proxyIter)->Internals->Properties.end(); ++it)
+      {
+      vtkSMProperty* prop = it->second.Property.GetPointer();
+      if (prop->GetInformationOnly())
+        {
+        prop->UpdateDependentDomains();
+        }
+      }
+    }
+}
+
 //---------------------------------------------------------------------------
 void vtkSMProxy::UpdatePropertyInformationInternal(vtkSMProperty* prop)
 {
@@ -1013,16 +1150,23 @@ int vtkSMProxy::ArePropertiesModified(int selfOnly /*=0*/)
 //---------------------------------------------------------------------------
 void vtkSMProxy::UpdateVTKObjects()
 {
+  // Subproxies on other servers and input proxies send their own streams.
+  // Have them all go out in a single message.
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  pm->BeginStreamTransaction(this->ConnectionID);
+
   vtkClientServerStream stream;
   this->UpdateVTKObjects(stream);
   if (stream.GetNumberOfMessages() > 0)
     {
     //cout << "Message Count: " << stream.GetNumberOfMessages() << endl;
-    vtkProcessModule::GetProcessModule()->SendStream(
+    pm->SendStream(
       this->ConnectionID,
       this->Servers,
       stream);
     }
+
+  pm->EndStreamTransaction(this->ConnectionID);
 }
 
 //---------------------------------------------------------------------------
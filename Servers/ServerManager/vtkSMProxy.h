@@ -126,6 +126,7 @@
 //BTX
 struct vtkSMProxyInternals;
 //ETX
+class vtkCollection;
 class vtkGarbageCollector;
 class vtkPVXMLElement;
 class vtkSMDocumentation;
@@ -314,6 +315,15 @@ public:
   // If the property does not belong to the proxy, the call is ignored.
   virtual void UpdatePropertyInformation(vtkSMProperty* prop);
 
+  // Description:
+  // Updates the information properties of all the proxies in the
+  // collection (not of their subproxies) like UpdatePropertyInformation()
+  // does, but with a single round trip per server: the properties whose
+  // information helper supports it (see
+  // vtkSMInformationHelper::AppendRequest()) are gathered together by a
+  // vtkPVServerInformationBatch. The others are updated one by one.
+  static void UpdatePropertyInformation(vtkCollection* proxies);
+
   // Description:
   // Marks all properties as modified.  This will cause them all to be sent
   // to be sent on the next call to UpdateVTKObjects.  This method is
@@ -767,6 +777,13 @@ protected:
   // overloads of UpdatePropertyInformation() call this method, so subclass can
   // override this method to perform special tasks.
   virtual void UpdatePropertyInformationInternal(vtkSMProperty*);
+
+  // Description:
+  // Returns false if the information properties of the proxy cannot be
+  // gathered by UpdatePropertyInformation(vtkCollection*), which bypasses
+  // UpdatePropertyInformationInternal(). Subclasses overriding the latter
+  // must return false.
+  virtual bool CanBatchPropertyInformation() { return true; }
  
   virtual int CreateSubProxiesAndProperties(vtkSMProxyManager* pm, 
     vtkPVXMLElement *element);
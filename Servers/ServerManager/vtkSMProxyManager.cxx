@@ -21,12 +21,14 @@
 #include "vtkProcessModuleConnectionManager.h"
 #include "vtkProcessModule.h"
 #include "vtkPVConfig.h" // for PARAVIEW_VERSION_*
+#include "vtkPVXMLBinaryFormat.h"
 #include "vtkPVXMLElement.h"
 #include "vtkPVXMLParser.h"
 #include "vtkSmartPointer.h"
 #include "vtkSMCompoundProxyDefinitionLoader.h"
 #include "vtkSMCompoundSourceProxy.h"
 #include "vtkSMDocumentation.h"
+#include "vtkSMOutputPort.h"
 #include "vtkSMPropertyIterator.h"
 #include "vtkSMProxyDefinitionIterator.h"
 #include "vtkSMProxy.h"
@@ -34,6 +36,7 @@
 #include "vtkSMProxyLocator.h"
 #include "vtkSMProxyProperty.h"
 #include "vtkSMReaderFactory.h"
+#include "vtkSMSourceProxy.h"
 #include "vtkSMStateLoader.h"
 #include "vtkSMUndoStack.h"
 #include "vtkSMWriterFactory.h"
@@ -72,6 +75,41 @@ public:
 
 class vtkSMProxyManagerProxySet : public vtkstd::set<vtkSMProxy*> {};
 
+//---------------------------------------------------------------------------
+// Returns if the proxies registered in the group are saved in the state.
+// Prototypes and groups starting with an underscore are not saved.
+static bool vtkSMProxyManagerIsStateGroup(const char* colname)
+{
+  const char* protstr = "_prototypes";
+  if (strlen(colname) > strlen(protstr))
+    {
+    const char* newstr = colname + strlen(colname) - strlen(protstr);
+    return strcmp(newstr, protstr) != 0;
+    }
+  return colname[0] != '_';
+}
+
+//---------------------------------------------------------------------------
+// Reads a state file, XML or binary. The caller must Delete() the element.
+static vtkPVXMLElement* vtkSMProxyManagerReadState(const char* filename)
+{
+  if (vtkPVXMLBinaryFormat::IsBinaryFile(filename))
+    {
+    return vtkPVXMLBinaryFormat::ReadFile(filename);
+    }
+
+  vtkPVXMLParser* parser = vtkPVXMLParser::New();
+  parser->SetFileName(filename);
+  parser->Parse();
+  vtkPVXMLElement* root = parser->GetRootElement();
+  if (root)
+    {
+    root->Register(0);
+    }
+  parser->Delete();
+  return root;
+}
+
 //*****************************************************************************
 class vtkSMProxyManagerObserver : public vtkCommand
 {
@@ -106,9 +144,13 @@ vtkStandardNewMacro(vtkSMProxyManager);
 vtkSMProxyManager::vtkSMProxyManager()
 {
   this->UpdateInputProxies = 0;
+  this->StateDeltaTracking = 0;
   this->Internals = new vtkSMProxyManagerInternals;
   this->Observer = vtkSMProxyManagerObserver::New();
   this->Observer->SetTarget(this);
+  // Registrations are noted for SaveStateDelta().
+  this->AddObserver(vtkCommand::RegisterEvent, this->Observer);
+  this->AddObserver(vtkCommand::UnRegisterEvent, this->Observer);
 #if 0 // for debugging
   vtkSMProxyRegObserver* obs = new vtkSMProxyRegObserver;
   this->AddObserver(vtkCommand::RegisterEvent, obs);
@@ -719,6 +761,7 @@ void vtkSMProxyManager::UnRegisterProxies()
     this->Internals->RegisteredProxyMap.begin(),
     this->Internals->RegisteredProxyMap.end());
   this->Internals->ModifiedProxies.clear();
+  this->Internals->RegistrationsModified = true;
 }
 
 //---------------------------------------------------------------------------
@@ -904,6 +947,24 @@ void vtkSMProxyManager::RegisterProxy(const char* groupname,
 
   // Note, these observer will be removed in the destructor of proxyInfo.
 
+  // Whoever is listening to the registration usually asks for the data
+  // information of every output port. Fetch it for all the ports in one
+  // request rather than one request per port. The ports are not created
+  // here, and the state loader fetches the information of all the sources
+  // it registers in one request at the end of the load.
+  vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(proxy);
+  if (source && source->GetOutputPortsCreated() &&
+    this->Internals->LoadingState == 0)
+    {
+    vtkCollection* ports = vtkCollection::New();
+    for (unsigned int cc=0; cc < source->GetNumberOfOutputPorts(); cc++)
+      {
+      ports->AddItem(source->GetOutputPort(cc));
+      }
+    vtkSMOutputPort::PrefetchDataInformation(ports);
+    ports->Delete();
+    }
+
   RegisteredProxyInformation info;
   info.Proxy = proxy;
   info.GroupName = groupname;
@@ -1070,6 +1131,7 @@ void vtkSMProxyManager::UnRegisterLink(const char* name)
 void vtkSMProxyManager::UnRegisterAllLinks()
 {
   this->Internals->RegisteredLinkMap.clear();
+  this->Internals->RegistrationsModified = true;
 }
 
 
@@ -1077,6 +1139,13 @@ void vtkSMProxyManager::UnRegisterAllLinks()
 void vtkSMProxyManager::ExecuteEvent(vtkObject* obj, unsigned long event,
   void* data)
 {
+  if (obj == this)
+    {
+    // (Un)Register events fired by this proxy manager.
+    this->Internals->RegistrationsModified = true;
+    return;
+    }
+
   vtkSMProxy* proxy = vtkSMProxy::SafeDownCast(obj);
   if (!proxy)
     {
@@ -1093,6 +1162,21 @@ void vtkSMProxyManager::ExecuteEvent(vtkObject* obj, unsigned long event,
       ModifiedPropertyInformation info;
       info.Proxy = proxy;
       info.PropertyName = reinterpret_cast<const char*>(data);
+      if (this->StateDeltaTracking)
+        {
+        // A modification without a name comes from a property of a subproxy
+        // that is not exposed.
+        vtkSMProxyManagerInternals::ModifiedProxyInfo& modified =
+          this->Internals->DeltaProxies[proxy];
+        if (info.PropertyName)
+          {
+          modified.PropertyNames.insert(info.PropertyName);
+          }
+        else
+          {
+          modified.AllProperties = true;
+          }
+        }
       if (info.PropertyName)
         {
         this->InvokeEvent(vtkCommand::PropertyModifiedEvent,
@@ -1108,6 +1192,11 @@ void vtkSMProxyManager::ExecuteEvent(vtkObject* obj, unsigned long event,
       // MarkProxyAsModified() and then UnMarkProxyAsModified() :).
       // this->MarkProxyAsModified(proxy);
 
+      if (this->StateDeltaTracking)
+        {
+        this->Internals->DeltaProxies[proxy].AllProperties = true;
+        }
+
       StateChangedInformation info;
       info.Proxy = proxy;
       info.StateChangeElement = reinterpret_cast<vtkPVXMLElement*>(data);
@@ -1155,12 +1244,12 @@ int vtkSMProxyManager::AreProxiesModified()
 void vtkSMProxyManager::LoadState(const char* filename, vtkIdType id,
   vtkSMStateLoader* loader/*=NULL*/)
 {
-  vtkPVXMLParser* parser = vtkPVXMLParser::New();
-  parser->SetFileName(filename);
-  parser->Parse();
-
-  this->LoadState(parser->GetRootElement(), id, loader);
-  parser->Delete();
+  vtkPVXMLElement* root = vtkSMProxyManagerReadState(filename);
+  if (root)
+    {
+    this->LoadState(root, id, loader);
+    root->Delete();
+    }
 }
 
 //---------------------------------------------------------------------------
@@ -1182,7 +1271,10 @@ void vtkSMProxyManager::LoadState(vtkPVXMLElement* rootElement, vtkIdType id,
     spLoader = loader;
     }
   spLoader->GetProxyLocator()->SetConnectionID(id);
-  if (spLoader->LoadState(rootElement))
+  this->Internals->LoadingState++;
+  int loaded = spLoader->LoadState(rootElement);
+  this->Internals->LoadingState--;
+  if (loaded)
     {
     LoadStateInformation info;
     info.RootElement = rootElement;
@@ -1218,6 +1310,17 @@ void vtkSMProxyManager::SaveState(const char* filename)
   rootElement->Delete();
 }
 
+//---------------------------------------------------------------------------
+void vtkSMProxyManager::SaveBinaryState(const char* filename)
+{
+  vtkPVXMLElement* rootElement = this->SaveState();
+  if (!vtkPVXMLBinaryFormat::WriteFile(rootElement, filename))
+    {
+    vtkErrorMacro("Failed to save state to " << filename);
+    }
+  rootElement->Delete();
+}
+
 //---------------------------------------------------------------------------
 vtkPVXMLElement* vtkSMProxyManager::SaveState()
 {
@@ -1319,8 +1422,7 @@ vtkPVXMLElement* vtkSMProxyManager::SaveStateInternal(vtkIdType connectionID,
   rootElement->AddAttribute("version", version_string.str().c_str());
 
 
-  vtkstd::set<vtkstd::string> seen;
-  vtkstd::set<vtkSMProxy*> visited_proxies; // set of proxies already added.
+  vtkSMProxyManagerProxySet visited_proxies; // set of proxies already added.
 
   // First save the state of all proxies
   vtkSMProxyManagerInternals::ProxyGroupType::iterator it =
@@ -1331,23 +1433,7 @@ vtkPVXMLElement* vtkSMProxyManager::SaveStateInternal(vtkIdType connectionID,
       it->second.begin();
 
     // Do not save the state of prototypes.
-    const char* protstr = "_prototypes";
-    const char* colname = it->first.c_str();
-    int do_group = 1;
-    if (strlen(colname) > strlen(protstr))
-      {
-      const char* newstr = colname + strlen(colname) -
-        strlen(protstr);
-      if (strcmp(newstr, protstr) == 0)
-        {
-        do_group = 0;
-        }
-      }
-    else if ( colname[0] == '_' )
-      {
-      do_group = 0;
-      }
-    if (!do_group)
+    if (!vtkSMProxyManagerIsStateGroup(it->first.c_str()))
       {
       continue;
       }
@@ -1386,9 +1472,18 @@ vtkPVXMLElement* vtkSMProxyManager::SaveStateInternal(vtkIdType connectionID,
       }
     }
 
+  this->SaveRegistrations(rootElement, visited_proxies, proxySet == 0);
+  return rootElement;
+}
+
+//---------------------------------------------------------------------------
+void vtkSMProxyManager::SaveRegistrations(vtkPVXMLElement* rootElement,
+  vtkSMProxyManagerProxySet& visited_proxies, int saveLinks)
+{
   // Save the proxy collections. This is done seprately because
   // one proxy can be in more than one group.
-  it = this->Internals->RegisteredProxyMap.begin();
+  vtkSMProxyManagerInternals::ProxyGroupType::iterator it =
+    this->Internals->RegisteredProxyMap.begin();
   for (; it != this->Internals->RegisteredProxyMap.end(); it++)
     {
     // Do not save the state of prototypes.
@@ -1450,7 +1545,7 @@ vtkPVXMLElement* vtkSMProxyManager::SaveStateInternal(vtkIdType connectionID,
   // TODO: Save links as per connection ID
   // TODO: What to do with links when saving state for a
   // subset of proxies?
-  if (!proxySet)
+  if (saveLinks)
     {
     vtkPVXMLElement* links = vtkPVXMLElement::New();
     links->SetName("Links");
@@ -1464,13 +1559,425 @@ vtkPVXMLElement* vtkSMProxyManager::SaveStateInternal(vtkIdType connectionID,
   this->SaveGlobalPropertiesManagers(globalProps);
   rootElement->AddNestedElement(globalProps);
   globalProps->Delete();
+}
 
-  return rootElement;
+//---------------------------------------------------------------------------
+void vtkSMProxyManager::SetStateDeltaTracking(int tracking)
+{
+  if (this->StateDeltaTracking == tracking)
+    {
+    return;
+    }
+  this->StateDeltaTracking = tracking;
+  this->ResetStateDelta();
+  this->Modified();
+}
+
+//---------------------------------------------------------------------------
+void vtkSMProxyManager::ResetStateDelta()
+{
+  this->SaveStateDeltaInternal(0);
+}
+
+//---------------------------------------------------------------------------
+vtkPVXMLElement* vtkSMProxyManager::SaveStateDelta()
+{
+  if (!this->StateDeltaTracking)
+    {
+    vtkErrorMacro("StateDeltaTracking must be on to save state deltas.");
+    return 0;
+    }
+  return this->SaveStateDeltaInternal(1);
+}
+
+//---------------------------------------------------------------------------
+vtkPVXMLElement* vtkSMProxyManager::SaveStateDeltaInternal(int saveChanges)
+{
+  vtkSMProxyManagerInternals* internals = this->Internals;
+  if (!this->StateDeltaTracking)
+    {
+    internals->DeltaProxies.clear();
+    internals->SnapshotProxyIds.clear();
+    internals->RegistrationsModified = true;
+    return 0;
+    }
+
+  vtkPVXMLElement* deltaElement = 0;
+  if (saveChanges)
+    {
+    deltaElement = vtkPVXMLElement::New();
+    deltaElement->SetName("ServerManagerStateDelta");
+    vtksys_ios::ostringstream version_string;
+    version_string << this->GetVersionMajor() << "."
+      << this->GetVersionMinor() << "." << this->GetVersionPatch();
+    deltaElement->AddAttribute("version", version_string.str().c_str());
+    }
+
+  // Walk the proxies SaveState() would save, saving the new ones and the
+  // modified ones. Without saveChanges, only the proxies in the new
+  // snapshot are noted.
+  vtkSMProxyManagerProxySet visited_proxies;
+  vtkstd::set<vtkstd::string> ids;
+  vtkSMProxyManagerInternals::ProxyGroupType::iterator it =
+    internals->RegisteredProxyMap.begin();
+  for (; it != internals->RegisteredProxyMap.end(); it++)
+    {
+    if (!vtkSMProxyManagerIsStateGroup(it->first.c_str()))
+      {
+      continue;
+      }
+    vtkSMProxyManagerProxyMapType::iterator it2 = it->second.begin();
+    for (; it2 != it->second.end(); it2++)
+      {
+      vtkSMProxyManagerProxyListType::iterator it3 = it2->second.begin();
+      for (; it3 != it2->second.end(); ++it3)
+        {
+        vtkSMProxy* proxy = it3->GetPointer()->Proxy.GetPointer();
+        if (!visited_proxies.insert(proxy).second)
+          {
+          continue;
+          }
+        const char* id = proxy->GetSelfIDAsString();
+        ids.insert(id);
+        if (!deltaElement)
+          {
+          continue;
+          }
+
+        vtkSMProxyManagerInternals::DeltaProxiesType::iterator modified =
+          internals->DeltaProxies.find(proxy);
+        if (internals->SnapshotProxyIds.find(id) ==
+          internals->SnapshotProxyIds.end() ||
+          (modified != internals->DeltaProxies.end() &&
+           modified->second.AllProperties))
+          {
+          proxy->SaveState(deltaElement);
+          }
+        else if (modified != internals->DeltaProxies.end())
+          {
+          vtkPVXMLElement* propertiesElement = vtkPVXMLElement::New();
+          propertiesElement->SetName("ProxyProperties");
+          propertiesElement->AddAttribute("id", id);
+          vtkstd::set<vtkstd::string>::iterator nameIter =
+            modified->second.PropertyNames.begin();
+          for (; nameIter != modified->second.PropertyNames.end(); ++nameIter)
+            {
+            vtkSMProperty* property = proxy->GetProperty(nameIter->c_str());
+            if (property && !property->GetIsInternal())
+              {
+              vtksys_ios::ostringstream propID;
+              propID << id << "." << nameIter->c_str() << ends;
+              property->SaveState(propertiesElement, nameIter->c_str(),
+                propID.str().c_str());
+              }
+            }
+          if (propertiesElement->GetNumberOfNestedElements() > 0)
+            {
+            deltaElement->AddNestedElement(propertiesElement);
+            }
+          propertiesElement->Delete();
+          }
+        }
+      }
+    }
+
+  vtkstd::set<vtkstd::string>::iterator idIter =
+    internals->SnapshotProxyIds.begin();
+  for (; deltaElement && idIter != internals->SnapshotProxyIds.end(); ++idIter)
+    {
+    if (ids.find(*idIter) == ids.end())
+      {
+      vtkPVXMLElement* removedElement = vtkPVXMLElement::New();
+      removedElement->SetName("RemovedProxy");
+      removedElement->AddAttribute("id", idIter->c_str());
+      deltaElement->AddNestedElement(removedElement);
+      removedElement->Delete();
+      }
+    }
+
+  if (deltaElement && internals->RegistrationsModified)
+    {
+    vtkPVXMLElement* registrations = vtkPVXMLElement::New();
+    registrations->SetName("Registrations");
+    this->SaveRegistrations(registrations, visited_proxies, 1);
+    deltaElement->AddNestedElement(registrations);
+    registrations->Delete();
+    }
+
+  internals->SnapshotProxyIds.swap(ids);
+  internals->DeltaProxies.clear();
+  internals->RegistrationsModified = false;
+  return deltaElement;
+}
+
+//---------------------------------------------------------------------------
+int vtkSMProxyManager::AppendStateDelta(const char* journalFile)
+{
+  if (!this->StateDeltaTracking)
+    {
+    vtkErrorMacro("StateDeltaTracking must be on to save state deltas.");
+    return 0;
+    }
+
+  vtkPVXMLElement* delta = this->SaveStateDelta();
+  int ret = 1;
+  if (delta->GetNumberOfNestedElements() > 0)
+    {
+    ofstream os(journalFile, ios::out | ios::app);
+    delta->PrintXML(os, vtkIndent());
+    os.flush();
+    if (!os)
+      {
+      vtkErrorMacro("Failed to append state delta to " << journalFile);
+      ret = 0;
+      }
+    }
+  delta->Delete();
+  return ret;
+}
+
+//---------------------------------------------------------------------------
+// Replaces the nested elements of element with the given name attribute by
+// those in replacements, appending the ones not present.
+static void vtkSMProxyManagerReplaceNamedElements(vtkPVXMLElement* element,
+  vtkPVXMLElement* replacements)
+{
+  vtkstd::vector<vtkSmartPointer<vtkPVXMLElement> > children;
+  vtkstd::map<vtkstd::string, size_t> byName;
+  unsigned int cc;
+  for (cc=0; cc < element->GetNumberOfNestedElements(); ++cc)
+    {
+    vtkPVXMLElement* child = element->GetNestedElement(cc);
+    const char* name = child->GetAttribute("name");
+    if (name && strcmp(child->GetName(), "Property") == 0)
+      {
+      byName[name] = children.size();
+      }
+    children.push_back(child);
+    }
+
+  for (cc=0; cc < replacements->GetNumberOfNestedElements(); ++cc)
+    {
+    vtkPVXMLElement* child = replacements->GetNestedElement(cc);
+    const char* name = child->GetAttribute("name");
+    vtkstd::map<vtkstd::string, size_t>::iterator iter =
+      name? byName.find(name) : byName.end();
+    if (iter != byName.end())
+      {
+      children[iter->second] = child;
+      }
+    else
+      {
+      children.push_back(child);
+      }
+    }
+
+  element->RemoveAllNestedElements();
+  for (size_t kk=0; kk < children.size(); ++kk)
+    {
+    element->AddNestedElement(children[kk]);
+    }
+}
+
+//---------------------------------------------------------------------------
+// Returns a new element with the name, attributes and nested elements of
+// element, so that it can be modified without changing element. The nested
+// elements are shared.
+static vtkPVXMLElement* vtkSMProxyManagerNewElementCopy(
+  vtkPVXMLElement* element)
+{
+  vtkPVXMLElement* copy = vtkPVXMLElement::New();
+  copy->SetName(element->GetName());
+  unsigned int cc;
+  for (cc=0; cc < element->GetNumberOfAttributes(); ++cc)
+    {
+    copy->AddAttribute(element->GetAttributeName(cc),
+      element->GetAttributeValue(cc));
+    }
+  for (cc=0; cc < element->GetNumberOfNestedElements(); ++cc)
+    {
+    copy->AddNestedElement(element->GetNestedElement(cc), 0);
+    }
+  return copy;
+}
+
+//---------------------------------------------------------------------------
+int vtkSMProxyManager::ApplyStateDelta(vtkPVXMLElement* state,
+  vtkPVXMLElement* delta)
+{
+  vtkPVXMLElement* smstate = state;
+  if (smstate && (!smstate->GetName() ||
+      strcmp(smstate->GetName(), "ServerManagerState") != 0))
+    {
+    smstate = smstate->FindNestedElementByName("ServerManagerState");
+    }
+  if (!smstate || !delta || !delta->GetName() ||
+    strcmp(delta->GetName(), "ServerManagerStateDelta") != 0)
+    {
+    return 0;
+    }
+
+  // Proxy elements come first in the state, followed by the others.
+  vtkstd::vector<vtkSmartPointer<vtkPVXMLElement> > proxies;
+  vtkstd::vector<vtkSmartPointer<vtkPVXMLElement> > others;
+  vtkstd::map<vtkstd::string, size_t> proxyIndex;
+  unsigned int cc;
+  for (cc=0; cc < smstate->GetNumberOfNestedElements(); ++cc)
+    {
+    vtkPVXMLElement* child = smstate->GetNestedElement(cc);
+    const char* id = child->GetAttribute("id");
+    if (id && child->GetName() && strcmp(child->GetName(), "Proxy") == 0)
+      {
+      proxyIndex[id] = proxies.size();
+      proxies.push_back(child);
+      }
+    else
+      {
+      others.push_back(child);
+      }
+    }
+
+  // The delta is applied to the lists above, the proxy elements of the state
+  // being copied before they are modified, and the state is only changed
+  // once the whole delta applied.
+  vtkPVXMLElement* registrations = 0;
+  for (cc=0; cc < delta->GetNumberOfNestedElements(); ++cc)
+    {
+    vtkPVXMLElement* child = delta->GetNestedElement(cc);
+    const char* name = child->GetName();
+    const char* id = child->GetAttribute("id");
+    if (name && strcmp(name, "Registrations") == 0)
+      {
+      registrations = child;
+      continue;
+      }
+    if (!name || !id)
+      {
+      return 0;
+      }
+    vtkstd::map<vtkstd::string, size_t>::iterator iter = proxyIndex.find(id);
+    if (strcmp(name, "Proxy") == 0)
+      {
+      if (iter != proxyIndex.end())
+        {
+        proxies[iter->second] = child;
+        }
+      else
+        {
+        proxyIndex[id] = proxies.size();
+        proxies.push_back(child);
+        }
+      }
+    else if (strcmp(name, "ProxyProperties") == 0 &&
+      iter != proxyIndex.end())
+      {
+      vtkPVXMLElement* copy =
+        vtkSMProxyManagerNewElementCopy(proxies[iter->second]);
+      vtkSMProxyManagerReplaceNamedElements(copy, child);
+      proxies[iter->second] = copy;
+      copy->Delete();
+      }
+    else if (strcmp(name, "RemovedProxy") == 0 && iter != proxyIndex.end())
+      {
+      proxies[iter->second] = 0;
+      proxyIndex.erase(iter);
+      }
+    else
+      {
+      return 0;
+      }
+    }
+
+  smstate->RemoveAllNestedElements();
+  size_t kk;
+  for (kk=0; kk < proxies.size(); ++kk)
+    {
+    if (proxies[kk])
+      {
+      smstate->AddNestedElement(proxies[kk]);
+      }
+    }
+  for (kk=0; kk < others.size(); ++kk)
+    {
+    const char* name = others[kk]->GetName();
+    if (registrations && name &&
+      (strcmp(name, "ProxyCollection") == 0 ||
+       strcmp(name, "CustomProxyDefinitions") == 0 ||
+       strcmp(name, "Links") == 0 ||
+       strcmp(name, "GlobalPropertiesManagers") == 0))
+      {
+      continue;
+      }
+    smstate->AddNestedElement(others[kk]);
+    }
+  if (registrations)
+    {
+    for (cc=0; cc < registrations->GetNumberOfNestedElements(); ++cc)
+      {
+      smstate->AddNestedElement(registrations->GetNestedElement(cc));
+      }
+    }
+  return 1;
+}
+
+//---------------------------------------------------------------------------
+int vtkSMProxyManager::ApplyStateJournal(vtkPVXMLElement* state,
+  const char* journalFile)
+{
+  ifstream is(journalFile, ios::in | ios::binary);
+  if (!is)
+    {
+    return 0;
+    }
+  vtksys_ios::ostringstream contents;
+  contents << is.rdbuf();
+  vtkstd::string journal = contents.str();
+
+  // Deltas are parsed one by one: the journal has many top level elements,
+  // and the last one may be incomplete. Each delta builds on the previous
+  // ones, so the deltas after one that cannot be applied are skipped.
+  const char* endTag = "</ServerManagerStateDelta>";
+  int count = 0;
+  vtkstd::string::size_type start = 0;
+  vtkstd::string::size_type end;
+  while ((end = journal.find(endTag, start)) != vtkstd::string::npos)
+    {
+    end += strlen(endTag);
+    vtkPVXMLParser* parser = vtkPVXMLParser::New();
+    bool applied = parser->Parse(journal.c_str() + start,
+        static_cast<unsigned int>(end - start)) &&
+      vtkSMProxyManager::ApplyStateDelta(state, parser->GetRootElement());
+    parser->Delete();
+    if (!applied)
+      {
+      vtkGenericWarningMacro("Failed to apply delta " << count + 1
+        << " of the journal " << journalFile
+        << ", the deltas after it are ignored.");
+      break;
+      }
+    count++;
+    start = end;
+    }
+  return count;
+}
+
+//---------------------------------------------------------------------------
+void vtkSMProxyManager::LoadStateWithJournal(const char* filename,
+  const char* journalFile, vtkSMStateLoader* loader/*=NULL*/)
+{
+  vtkPVXMLElement* root = vtkSMProxyManagerReadState(filename);
+  if (root)
+    {
+    vtkSMProxyManager::ApplyStateJournal(root, journalFile);
+    this->LoadState(root, loader);
+    root->Delete();
+    }
 }
 
 //---------------------------------------------------------------------------
 void vtkSMProxyManager::UnRegisterCustomProxyDefinitions()
 {
+  this->Internals->RegistrationsModified = true;
   vtkSMProxyManagerInternals::GroupMapType::iterator groupIter =
     this->Internals->GroupMap.begin();
   for ( ;groupIter != this->Internals->GroupMap.end(); ++groupIter)
@@ -1875,4 +2382,5 @@ void vtkSMProxyManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
   os << indent <<  "UpdateInputProxies: " <<  this->UpdateInputProxies << endl;
+  os << indent << "StateDeltaTracking: " << this->StateDeltaTracking << endl;
 }
@@ -24,6 +24,13 @@
 // Every proxy has a ConnectionID associated with it which indicates the
 // Server connection on which the proxy exists. Changing the ConnectionID
 // must be done immediately after the proxy is instantiated.
+//
+// When StateDeltaTracking is on, the proxy manager keeps track of the
+// proxies and properties modified since the last snapshot and
+// SaveStateDelta() saves only those. This makes frequent auto-saves cheap:
+// turn tracking on, save a full state, then append a delta to a journal
+// file with AppendStateDelta() every now and then. LoadStateWithJournal()
+// loads the full state with the journal replayed on top of it.
 // .SECTION See Also
 // vtkSMXMLParser
 
@@ -271,6 +278,8 @@ public:
   // Description:
   // Loads the state of the server manager from XML.
   // If loader is not specified, a vtkSMStateLoader instance is used.
+  // Files written by SaveBinaryState() are recognized and read with
+  // vtkPVXMLBinaryFormat.
   void LoadState(const char* filename, vtkSMStateLoader* loader=NULL);
   void LoadState(vtkPVXMLElement* rootElement, vtkSMStateLoader* loader=NULL);
 
@@ -287,6 +296,12 @@ public:
   // This saves the state of all proxies and properties.
   void SaveState(const char* filename);
 
+  // Description:
+  // Save the same state as SaveState(), in the compact binary format of
+  // vtkPVXMLBinaryFormat. It loads faster than XML for states with large
+  // property vectors.
+  void SaveBinaryState(const char* filename);
+
   // Description:
   // Saves the state of the server manager as XML, and returns the
   // vtkPVXMLElement for the root of the state.
@@ -324,6 +339,52 @@ public:
   // while reusing server side object ids.
   vtkPVXMLElement* SaveRevivalState(vtkIdType cid);
 
+  // Description:
+  // Turn on/off the tracking of changes for SaveStateDelta(). Turning it on
+  // starts a new snapshot with the current state. Off by default.
+  void SetStateDeltaTracking(int);
+  vtkGetMacro(StateDeltaTracking, int);
+  vtkBooleanMacro(StateDeltaTracking, int);
+
+  // Description:
+  // Starts a new snapshot: the next delta will only contain the changes
+  // made after this call. Call it after saving the full state that deltas
+  // are applied to.
+  void ResetStateDelta();
+
+  // Description:
+  // Saves the changes made since the last snapshot and starts a new one.
+  // Returns a <ServerManagerStateDelta /> element, with no nested elements
+  // when nothing changed. Proxies added or changed as a whole are saved
+  // completely, proxies with a few modified properties only save those.
+  // StateDeltaTracking must be on, otherwise NULL is returned. The caller
+  // must Delete() the element.
+  vtkPVXMLElement* SaveStateDelta();
+
+  // Description:
+  // Appends the delta returned by SaveStateDelta() to a journal file.
+  // Nothing is written when nothing changed. Returns 1 on success.
+  int AppendStateDelta(const char* journalFile);
+
+  // Description:
+  // Applies a delta returned by SaveStateDelta() to a state returned by
+  // SaveState() (or its ServerManagerState element). Returns 1 on success.
+  // The state is left unchanged when the delta cannot be applied.
+  static int ApplyStateDelta(vtkPVXMLElement* state, vtkPVXMLElement* delta);
+
+  // Description:
+  // Applies, in order, the deltas of a journal file written by
+  // AppendStateDelta() to a state. An incomplete delta at the end of the
+  // file, e.g. after a crash while writing it, is ignored. Applying stops at
+  // the first delta that cannot be applied, since the following ones build
+  // on it. Returns the number of deltas applied.
+  static int ApplyStateJournal(vtkPVXMLElement* state, const char* journalFile);
+
+  // Description:
+  // Loads a state file with the deltas of the journal file applied.
+  void LoadStateWithJournal(const char* filename, const char* journalFile,
+    vtkSMStateLoader* loader=NULL);
+
   // Description:
   // Given a group name, create prototypes and store them
   // in a instance group called groupName_prototypes.
@@ -543,7 +604,20 @@ protected:
   void CollectReferredProxies(vtkSMProxyManagerProxySet& setOfProxies,
     vtkSMProxy* proxy);
 
+  // Description:
+  // Saves the proxy collections for the saved proxies, the custom proxy
+  // definitions, the links (if saveLinks is set) and the global properties
+  // managers.
+  void SaveRegistrations(vtkPVXMLElement* root,
+    vtkSMProxyManagerProxySet& savedProxies, int saveLinks);
+
+  // Description:
+  // Starts a new state snapshot. If saveChanges is set, returns the changes
+  // since the last snapshot as SaveStateDelta() does.
+  vtkPVXMLElement* SaveStateDeltaInternal(int saveChanges);
+
   int UpdateInputProxies;
+  int StateDeltaTracking;
 
   vtkSMReaderFactory* ReaderFactory;
   vtkSMWriterFactory* WriterFactory;
@@ -222,6 +222,33 @@ struct vtkSMProxyManagerInternals
             GlobalPropertiesManagersType;
   GlobalPropertiesManagersType GlobalPropertiesManagers;
 
+  // Data structures to track the changes since the last state snapshot,
+  // see vtkSMProxyManager::SaveStateDelta(). Proxies with AllProperties set
+  // are saved as a whole, others only for the properties named.
+  struct ModifiedProxyInfo
+    {
+    ModifiedProxyInfo() : AllProperties(false) {}
+    bool AllProperties;
+    vtkstd::set<vtkstd::string> PropertyNames;
+    };
+  typedef vtkstd::map<vtkSMProxy*, ModifiedProxyInfo> DeltaProxiesType;
+  DeltaProxiesType DeltaProxies;
+  // Ids of the proxies saved in the last snapshot.
+  vtkstd::set<vtkstd::string> SnapshotProxyIds;
+  // Set when proxies, links, custom proxy definitions or global properties
+  // managers are registered or unregistered.
+  bool RegistrationsModified;
+
+  // Number of states being loaded. The state loader gathers the data
+  // information of the sources it registers once the state is loaded.
+  int LoadingState;
+
+  vtkSMProxyManagerInternals()
+    {
+    this->RegistrationsModified = true;
+    this->LoadingState = 0;
+    }
+
   // Helper method to retrieve the proxy element.
   vtkPVXMLElement* GetProxyElement(const char* groupName, const char* proxyName)
     {
@@ -65,6 +65,7 @@
 #include "vtkSMSelectionHelper.h"
 #include "vtkSMSourceProxy.h"
 #include "vtkSMStringVectorProperty.h"
+#include "vtkSMUnstructuredGridVolumeRepresentationProxy.h"
 #include "vtkSMUtilities.h"
 #include "vtkTimerLog.h"
 #include "vtkWindowToImageFilter.h"
@@ -97,6 +98,8 @@ inline bool SetIntVectorProperty(vtkSMProxy* proxy, const char* pname,
 vtkStandardNewMacro(vtkSMRenderViewProxy);
 
 vtkInformationKeyMacro(vtkSMRenderViewProxy, LOD_RESOLUTION, Integer);
+vtkInformationKeyMacro(vtkSMRenderViewProxy, LOD_LEVEL, Integer);
+vtkInformationKeyMacro(vtkSMRenderViewProxy, NUMBER_OF_LOD_LEVELS, Integer);
 vtkInformationKeyMacro(vtkSMRenderViewProxy, USE_COMPOSITING, Integer);
 vtkInformationKeyMacro(vtkSMRenderViewProxy, USE_LOD, Integer);
 vtkInformationKeyMacro(vtkSMRenderViewProxy, USE_ORDERED_COMPOSITING, Integer);
@@ -133,11 +136,16 @@ vtkSMRenderViewProxy::vtkSMRenderViewProxy()
   this->UseOffscreenRenderingForScreenshots = 0;
 
   this->LODThreshold = 0.0;
+  this->LODFrameTimeBudget = 0.1;
+  this->LastRenderTime = 0.0;
+  this->ProgressiveRefinementNeeded = 0;
 
   this->OpenGLExtensionsInformation = 0;
 
   this->SetUseLOD(false);
   this->SetLODResolution(50);
+  this->Information->Set(NUMBER_OF_LOD_LEVELS(), 1);
+  this->Information->Set(LOD_LEVEL(), 0);
   this->Information->Set(USE_ORDERED_COMPOSITING(), 0);
   this->Information->Set(USE_COMPOSITING(), 0);
 
@@ -511,6 +519,55 @@ int vtkSMRenderViewProxy::GetLODResolution()
   return this->Information->Get(LOD_RESOLUTION());
 }
 
+//-----------------------------------------------------------------------------
+void vtkSMRenderViewProxy::SetNumberOfLODLevels(int levels)
+{
+  levels = levels < 1? 1 : levels;
+  if (this->GetNumberOfLODLevels() != levels)
+    {
+    this->Information->Set(NUMBER_OF_LOD_LEVELS(), levels);
+    if (this->GetLODLevel() >= levels)
+      {
+      this->Information->Set(LOD_LEVEL(), levels-1);
+      }
+    }
+}
+
+//-----------------------------------------------------------------------------
+int vtkSMRenderViewProxy::GetNumberOfLODLevels()
+{
+  return this->Information->Get(NUMBER_OF_LOD_LEVELS());
+}
+
+//-----------------------------------------------------------------------------
+int vtkSMRenderViewProxy::GetLODLevel()
+{
+  return this->Information->Get(LOD_LEVEL());
+}
+
+//-----------------------------------------------------------------------------
+void vtkSMRenderViewProxy::UpdateLODLevel()
+{
+  int levels = this->GetNumberOfLODLevels();
+  if (levels <= 1 || this->LODFrameTimeBudget <= 0.0 || !this->GetUseLOD())
+    {
+    return;
+    }
+
+  // The finer level is only tried again when the render is well within the
+  // budget to avoid switching back and forth between two levels, since every
+  // switch has to deliver the new level.
+  int level = this->GetLODLevel();
+  if (this->LastRenderTime > this->LODFrameTimeBudget && level < levels-1)
+    {
+    this->Information->Set(LOD_LEVEL(), level+1);
+    }
+  else if (this->LastRenderTime < 0.5*this->LODFrameTimeBudget && level > 0)
+    {
+    this->Information->Set(LOD_LEVEL(), level-1);
+    }
+}
+
 //-----------------------------------------------------------------------------
 void vtkSMRenderViewProxy::SetUseLOD(bool use_lod)
 {
@@ -544,6 +601,7 @@ void vtkSMRenderViewProxy::BeginInteractiveRender()
   // size information.
   bool use_lod = this->GetLODDecision();
   this->SetUseLOD(use_lod);
+  this->ProgressiveRefinementNeeded = 0;
 
   if (use_lod)
     {
@@ -563,6 +621,8 @@ void vtkSMRenderViewProxy::EndInteractiveRender()
   // This is a fast operation since we directly use the client side camera.
   this->ActiveCameraProxy->UpdatePropertyInformation();
 
+  this->UpdateLODLevel();
+
   this->Superclass::EndInteractiveRender();
 }
 
@@ -582,16 +642,28 @@ void vtkSMRenderViewProxy::EndStillRender()
   // This is a fast operation since we directly use the client side camera.
   this->ActiveCameraProxy->UpdatePropertyInformation();
 
+  this->ProgressiveRefinementNeeded = 0;
+  vtkCollectionIterator* iter = this->Representations->NewIterator();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+    vtkSMUnstructuredGridVolumeRepresentationProxy* repr =
+      vtkSMUnstructuredGridVolumeRepresentationProxy::SafeDownCast(
+        iter->GetCurrentObject());
+    if (repr && repr->GetProgressiveRefinementNeeded())
+      {
+      this->ProgressiveRefinementNeeded = 1;
+      break;
+      }
+    }
+  iter->Delete();
+
   this->Superclass::EndStillRender();
 }
 
 //-----------------------------------------------------------------------------
 void vtkSMRenderViewProxy::PerformRender()
 {
-  if ( this->MeasurePolygonsPerSecond )
-    {
-    this->RenderTimer->StartTimer();
-    } 
+  this->RenderTimer->StartTimer();
 
   this->GetRenderer()->ResetCameraClippingRange();
 
@@ -608,10 +680,11 @@ void vtkSMRenderViewProxy::PerformRender()
   //vtkRenderWindow *renWindow = this->GetRenderWindow(); 
   //renWindow->Render();
 
+  this->RenderTimer->StopTimer();
+  this->LastRenderTime = this->RenderTimer->GetElapsedTime();
   if ( this->MeasurePolygonsPerSecond )
     {
-    this->RenderTimer->StopTimer();
-    this->CalculatePolygonsPerSecond(this->RenderTimer->GetElapsedTime());
+    this->CalculatePolygonsPerSecond(this->LastRenderTime);
     }
 }
 
@@ -1895,6 +1968,8 @@ void vtkSMRenderViewProxy::PrintSelf(ostream& os, vtkIndent indent)
     << this->MeasurePolygonsPerSecond << endl;
   os << indent << "UseOffscreenRenderingForScreenshots: "
     << this->UseOffscreenRenderingForScreenshots << endl;
+  os << indent << "ProgressiveRefinementNeeded: "
+    << this->ProgressiveRefinementNeeded << endl;
   os << indent << "AveragePolygonsPerSecond: " 
     << this->AveragePolygonsPerSecond << endl;
   os << indent << "MaximumPolygonsPerSecond: " 
@@ -1902,6 +1977,7 @@ void vtkSMRenderViewProxy::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "LastPolygonsPerSecond: " 
     << this->LastPolygonsPerSecond << endl;
   os << indent << "LODThreshold: " << this->LODThreshold << endl;
+  os << indent << "LODFrameTimeBudget: " << this->LODFrameTimeBudget << endl;
   if (this->OpenGLExtensionsInformation)
     {
     os << endl;
@@ -51,6 +51,8 @@ public:
   // Keys used to specify view rendering requirements.
   static vtkInformationIntegerKey* USE_LOD();
   static vtkInformationIntegerKey* LOD_RESOLUTION();
+  static vtkInformationIntegerKey* LOD_LEVEL();
+  static vtkInformationIntegerKey* NUMBER_OF_LOD_LEVELS();
   static vtkInformationIntegerKey* USE_COMPOSITING();
   static vtkInformationIntegerKey* USE_ORDERED_COMPOSITING();
   
@@ -67,6 +69,26 @@ public:
   // Get/Set the LOD Resolution.
   void SetLODResolution(int);
   int GetLODResolution();
+
+  // Description:
+  // Get/Set the number of levels in the LOD hierarchy. Level 0 is built at
+  // LODResolution and each following level halves the resolution. Default
+  // is 1 i.e. a single LOD.
+  void SetNumberOfLODLevels(int);
+  int GetNumberOfLODLevels();
+
+  // Description:
+  // Frame time (in seconds) the interactive renders should fit in when
+  // NumberOfLODLevels > 1. After each interactive render using LOD, the view
+  // moves to a coarser level if the render took longer than this budget and
+  // back to a finer one if it took less than half of it. Still renders are
+  // always full resolution. Default is 0.1.
+  vtkSetClampMacro(LODFrameTimeBudget, double, 0.0, VTK_DOUBLE_MAX);
+  vtkGetMacro(LODFrameTimeBudget, double);
+
+  // Description:
+  // Returns the LOD level currently used for interactive renders.
+  int GetLODLevel();
    
   // Description:
   // Access to the rendering-related objects for the GUI.
@@ -190,6 +212,13 @@ public:
   vtkGetMacro(MaximumPolygonsPerSecond, double);
   vtkGetMacro(AveragePolygonsPerSecond, double);
 
+  // Description:
+  // True when the last still render showed a progressively rendered
+  // representation that has not reached its full resolution yet. The GUI
+  // renders again while this is set; any interaction restarts the
+  // refinement.
+  vtkGetMacro(ProgressiveRefinementNeeded, int);
+
   // Description:
   // Checks if color depth is sufficient to support selection.
   // If not, will return 0 and any calls to SelectVisibleCells will 
@@ -358,6 +387,18 @@ protected:
   int ForceTriStripUpdate;
   int UseImmediateMode;
   double LODThreshold;
+  double LODFrameTimeBudget;
+
+  // Description:
+  // Time taken by the last PerformRender().
+  double LastRenderTime;
+
+  int ProgressiveRefinementNeeded;
+
+  // Description:
+  // Picks the LOD level for the next interactive render from the time taken
+  // by the last one.
+  void UpdateLODLevel();
 
 public:  
   // Description:
@@ -42,6 +42,8 @@ vtkSMRepresentationStrategy::vtkSMRepresentationStrategy()
   this->LODDataValid = false;
   this->LODDataSize = 0;
   this->LODResolution = 50;
+  this->NumberOfLODLevels = 1;
+  this->LODLevel = 0;
   this->LODInformationValid =false;
 
   this->DataValid = false;
@@ -397,6 +399,18 @@ void vtkSMRepresentationStrategy::ProcessViewInformation()
     this->SetLODResolution(
       this->ViewInformation->Get(vtkSMRenderViewProxy::LOD_RESOLUTION()));
     }
+
+  if (this->ViewInformation->Has(vtkSMRenderViewProxy::NUMBER_OF_LOD_LEVELS()))
+    {
+    this->SetNumberOfLODLevels(
+      this->ViewInformation->Get(vtkSMRenderViewProxy::NUMBER_OF_LOD_LEVELS()));
+    }
+
+  if (this->ViewInformation->Has(vtkSMRenderViewProxy::LOD_LEVEL()))
+    {
+    this->SetLODLevel(
+      this->ViewInformation->Get(vtkSMRenderViewProxy::LOD_LEVEL()));
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -405,6 +419,8 @@ void vtkSMRepresentationStrategy::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "EnableLOD: " << this->EnableLOD << endl;
   os << indent << "EnableCaching: " << this->EnableCaching << endl;
+  os << indent << "NumberOfLODLevels: " << this->NumberOfLODLevels << endl;
+  os << indent << "LODLevel: " << this->LODLevel << endl;
   os << indent << "KeepLODPipelineUpdated: " 
     << this->KeepLODPipelineUpdated << endl;
   os << indent << "RepresentedDataInformation: " 
@@ -272,6 +272,28 @@ protected:
       }
     }
 
+  // Description:
+  // Called when the ViewInformation is modified to set the number of levels
+  // in the LOD hierarchy and the level to use. These invalidate the LOD
+  // pipeline if the values have indeed changed. Note that changing the level
+  // does not rebuild the hierarchy, it only selects another level of it.
+  virtual void SetNumberOfLODLevels(int levels)
+    {
+    if (this->NumberOfLODLevels != levels)
+      {
+      this->NumberOfLODLevels = levels;
+      this->InvalidateLODPipeline();
+      }
+    }
+  virtual void SetLODLevel(int level)
+    {
+    if (this->LODLevel != level)
+      {
+      this->LODLevel = level;
+      this->InvalidateLODPipeline();
+      }
+    }
+
   // Description:
   // Returns true is data is valid.
   virtual bool GetDataValid()
@@ -294,6 +316,8 @@ protected:
   bool LODInformationValid;
 
   int LODResolution;
+  int NumberOfLODLevels;
+  int LODLevel;
 
   // When set to true, LODPipeline is always udpated with the full-res pipeline
   // (unless EnableLOD is false).
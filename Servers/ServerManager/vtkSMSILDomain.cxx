@@ -71,6 +71,7 @@ vtkGraph* vtkSMSILDomain::GetSIL()
     return 0;
     }
 
+  helper->ExpandAll();
   return helper->GetSIL();
 }
 
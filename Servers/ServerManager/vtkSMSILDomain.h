@@ -42,7 +42,9 @@ public:
   // Get the SIL. This does not result in the re-fetching of the SIL, it simply
   // returns the most recently fetched SIL. To re-fetch the SIL, try calling
   // UpdatePropertyInformation() on the reader proxy. That will result in
-  // requesting the vtkSMSILInformationHelper to fetch the SIL.
+  // requesting the vtkSMSILInformationHelper to fetch the SIL. When the helper
+  // fetched only the top levels of the SIL (see its depth attribute), the
+  // rest of the SIL is fetched now, so that the SIL returned is complete.
   vtkGraph* GetSIL();
 
   const char* GetSubtree();
@@ -16,14 +16,24 @@
 
 #include "vtkAdjacentVertexIterator.h"
 #include "vtkClientServerStream.h"
+#include "vtkDataSetAttributes.h"
+#include "vtkFieldData.h"
 #include "vtkGraph.h"
+#include "vtkIdTypeArray.h"
+#include "vtkMutableDirectedGraph.h"
 #include "vtkObjectFactory.h"
+#include "vtkOutEdgeIterator.h"
 #include "vtkProcessModule.h"
 #include "vtkPVSILInformation.h"
 #include "vtkPVXMLElement.h"
 #include "vtkSmartPointer.h"
 #include "vtkSMSILModel.h"
 #include "vtkSMStringVectorProperty.h"
+#include "vtkStringArray.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <vtkstd/map>
+#include <vtkstd/vector>
 
 vtkStandardNewMacro(vtkSMSILInformationHelper);
 vtkCxxSetObjectMacro(vtkSMSILInformationHelper, SIL, vtkGraph);
@@ -34,6 +44,9 @@ vtkSMSILInformationHelper::vtkSMSILInformationHelper()
   this->TimestampCommand = 0;
   this->Subtree = 0;
   this->LastUpdateTime = VTK_INT_MIN;
+  this->MaximumDepth = -1;
+  this->ConnectionID = 0;
+  this->ServerIds = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -49,6 +62,10 @@ void vtkSMSILInformationHelper::UpdateProperty(
   vtkIdType connectionId,
   int serverIds, vtkClientServerID objectId, vtkSMProperty* prop)
 {
+  this->ConnectionID = connectionId;
+  this->ServerIds = serverIds;
+  this->ObjectID = objectId;
+
   bool refetch = true;
   if (this->TimestampCommand)
     {
@@ -62,11 +79,23 @@ void vtkSMSILInformationHelper::UpdateProperty(
     return;
     }
 
-  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
-  vtkPVSILInformation* info = vtkPVSILInformation::New();
-  pm->GatherInformation(connectionId, serverIds, info, objectId);
-  this->SetSIL(info->GetSIL());
-  info->Delete();
+  if (this->MaximumDepth >= 0)
+    {
+    vtkGraph* sil = this->FetchSIL(0, this->MaximumDepth);
+    this->SetSIL(sil);
+    if (sil)
+      {
+      sil->Delete();
+      }
+    }
+  else
+    {
+    vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+    vtkPVSILInformation* info = vtkPVSILInformation::New();
+    pm->GatherInformation(connectionId, serverIds, info, objectId);
+    this->SetSIL(info->GetSIL());
+    info->Delete();
+    }
 
   // Now update the information property with the array list obtained from the
   // SIL.
@@ -145,8 +174,20 @@ void vtkSMSILInformationHelper::UpdateArrayList(vtkSMStringVectorProperty* svp)
 
   if (subTreeVertexId == -1)
     {
-    // failed to locate requested subtree.
-    return;
+    // The subtree may lie below the levels fetched.
+    subTreeVertexId = this->ExpandPath(this->Subtree);
+    if (subTreeVertexId == -1)
+      {
+      // failed to locate requested subtree.
+      return;
+      }
+    model->Initialize(this->SIL);
+    }
+
+  // All the leaves of the subtree are needed.
+  if (this->ExpandSubtree(subTreeVertexId) > 0)
+    {
+    model->Initialize(this->SIL);
     }
 
   vtkstd::set<vtkIdType> leaves;
@@ -159,6 +200,339 @@ void vtkSMSILInformationHelper::UpdateArrayList(vtkSMStringVectorProperty* svp)
     }
 }
 
+//----------------------------------------------------------------------------
+vtkGraph* vtkSMSILInformationHelper::FetchSIL(vtkIdType root, int depth)
+{
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkClientServerStream stream;
+  vtkClientServerID serverObjID =
+    pm->NewStreamObject("vtkPVServerSIL", stream);
+  stream << vtkClientServerStream::Invoke
+         << serverObjID << "SetProcessModule" << pm->GetProcessModuleID()
+         << vtkClientServerStream::End;
+  stream << vtkClientServerStream::Invoke
+         << serverObjID << "GetSIL" << this->ObjectID
+         << static_cast<int>(root) << depth
+         << vtkClientServerStream::End;
+  pm->SendStream(this->ConnectionID,
+    vtkProcessModule::GetRootId(this->ServerIds), stream);
+
+  vtkClientServerStream result;
+  int retVal = pm->GetLastResult(this->ConnectionID,
+    vtkProcessModule::GetRootId(this->ServerIds)).GetArgument(0, 0, &result);
+
+  pm->DeleteStreamObject(serverObjID, stream);
+  pm->SendStream(this->ConnectionID,
+    vtkProcessModule::GetRootId(this->ServerIds), stream);
+
+  if (!retVal)
+    {
+    vtkErrorMacro("Error getting the SIL from the server.");
+    return 0;
+    }
+
+  vtkPVSILInformation* info = vtkPVSILInformation::New();
+  info->CopyFromStream(&result);
+  vtkGraph* sil = info->GetSIL();
+  if (sil)
+    {
+    sil->Register(this);
+    }
+  info->Delete();
+
+  if (sil && !sil->GetVertexData()->GetAbstractArray("SIL Ids"))
+    {
+    // The server sends the SIL as it is when the whole SIL is requested
+    // (e.g. when expanding the root of a SIL fetched with depth 0).
+    vtkIdType numVertices = sil->GetNumberOfVertices();
+    vtkIdTypeArray* silIds = vtkIdTypeArray::New();
+    silIds->SetName("SIL Ids");
+    silIds->SetNumberOfTuples(numVertices);
+    vtkUnsignedCharArray* collapsed = vtkUnsignedCharArray::New();
+    collapsed->SetName("Collapsed");
+    collapsed->SetNumberOfTuples(numVertices);
+    for (vtkIdType cc = 0; cc < numVertices; ++cc)
+      {
+      silIds->SetValue(cc, cc);
+      collapsed->SetValue(cc, 0);
+      }
+    sil->GetVertexData()->AddArray(silIds);
+    sil->GetVertexData()->AddArray(collapsed);
+    silIds->Delete();
+    collapsed->Delete();
+    }
+  return sil;
+}
+
+//----------------------------------------------------------------------------
+bool vtkSMSILInformationHelper::FetchPath(const char* name,
+  vtkIdTypeArray* path)
+{
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkClientServerStream stream;
+  vtkClientServerID serverObjID =
+    pm->NewStreamObject("vtkPVServerSIL", stream);
+  stream << vtkClientServerStream::Invoke
+         << serverObjID << "SetProcessModule" << pm->GetProcessModuleID()
+         << vtkClientServerStream::End;
+  stream << vtkClientServerStream::Invoke
+         << serverObjID << "GetPath" << this->ObjectID << name
+         << vtkClientServerStream::End;
+  pm->SendStream(this->ConnectionID,
+    vtkProcessModule::GetRootId(this->ServerIds), stream);
+
+  vtkClientServerStream result;
+  int retVal = pm->GetLastResult(this->ConnectionID,
+    vtkProcessModule::GetRootId(this->ServerIds)).GetArgument(0, 0, &result);
+
+  pm->DeleteStreamObject(serverObjID, stream);
+  pm->SendStream(this->ConnectionID,
+    vtkProcessModule::GetRootId(this->ServerIds), stream);
+
+  if (!retVal)
+    {
+    vtkErrorMacro("Error getting the SIL path from the server.");
+    return false;
+    }
+
+  path->Initialize();
+  int numArgs = result.GetNumberOfMessages() > 0?
+    result.GetNumberOfArguments(0) : 0;
+  for (int cc = 0; cc < numArgs; ++cc)
+    {
+    int id;
+    if (!result.GetArgument(0, cc, &id))
+      {
+      vtkErrorMacro("Error parsing the SIL path.");
+      return false;
+      }
+    path->InsertNextValue(id);
+    }
+  return path->GetNumberOfTuples() > 0;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSMSILInformationHelper::ExpandPath(const char* name)
+{
+  vtkIdTypeArray* silIds = this->SIL?
+    vtkIdTypeArray::SafeDownCast(
+      this->SIL->GetVertexData()->GetAbstractArray("SIL Ids")) : 0;
+  vtkUnsignedCharArray* collapsed = this->SIL?
+    vtkUnsignedCharArray::SafeDownCast(
+      this->SIL->GetVertexData()->GetAbstractArray("Collapsed")) : 0;
+  vtkDataArray* crossEdges = this->SIL?
+    vtkDataArray::SafeDownCast(
+      this->SIL->GetEdgeData()->GetAbstractArray("CrossEdges")) : 0;
+  if (!name || !silIds || !collapsed || !crossEdges ||
+    this->SIL->GetNumberOfVertices() < 1)
+    {
+    // The whole SIL was fetched, the vertex does not exist.
+    return -1;
+    }
+
+  vtkSmartPointer<vtkIdTypeArray> path =
+    vtkSmartPointer<vtkIdTypeArray>::New();
+  if (!this->FetchPath(name, path) || silIds->GetValue(0) != path->GetValue(0))
+    {
+    return -1;
+    }
+
+  // Walk down the path, fetching the children of the collapsed vertices.
+  vtkIdType vertex = 0;
+  vtkSmartPointer<vtkOutEdgeIterator> iter =
+    vtkSmartPointer<vtkOutEdgeIterator>::New();
+  for (vtkIdType cc = 1; cc < path->GetNumberOfTuples(); ++cc)
+    {
+    if (collapsed->GetValue(vertex))
+      {
+      this->ExpandVertex(vertex, 1);
+      }
+    vtkIdType child = -1;
+    this->SIL->GetOutEdges(vertex, iter);
+    while (iter->HasNext() && child == -1)
+      {
+      vtkOutEdgeType edge = iter->Next();
+      if (crossEdges->GetTuple1(edge.Id) == 0 &&
+        silIds->GetValue(edge.Target) == path->GetValue(cc))
+        {
+        child = edge.Target;
+        }
+      }
+    if (child == -1)
+      {
+      return -1;
+      }
+    vertex = child;
+    }
+  return vertex;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSMSILInformationHelper::ExpandVertex(vtkIdType vertex, int depth)
+{
+  vtkMutableDirectedGraph* sil =
+    vtkMutableDirectedGraph::SafeDownCast(this->SIL);
+  if (!sil || vertex < 0 || vertex >= sil->GetNumberOfVertices())
+    {
+    return 0;
+    }
+  vtkStringArray* names = vtkStringArray::SafeDownCast(
+    sil->GetVertexData()->GetAbstractArray("Names"));
+  vtkIdTypeArray* silIds = vtkIdTypeArray::SafeDownCast(
+    sil->GetVertexData()->GetAbstractArray("SIL Ids"));
+  vtkUnsignedCharArray* collapsed = vtkUnsignedCharArray::SafeDownCast(
+    sil->GetVertexData()->GetAbstractArray("Collapsed"));
+  vtkDataArray* crossEdges = vtkDataArray::SafeDownCast(
+    sil->GetEdgeData()->GetAbstractArray("CrossEdges"));
+  if (!names || !silIds || !collapsed || !crossEdges ||
+    !collapsed->GetValue(vertex))
+    {
+    // Not a partially fetched SIL or nothing to fetch.
+    return 0;
+    }
+
+  vtkGraph* subtree = this->FetchSIL(silIds->GetValue(vertex), depth);
+  if (!subtree)
+    {
+    return 0;
+    }
+  vtkStringArray* subtreeNames = vtkStringArray::SafeDownCast(
+    subtree->GetVertexData()->GetAbstractArray("Names"));
+  vtkIdTypeArray* subtreeIds = vtkIdTypeArray::SafeDownCast(
+    subtree->GetVertexData()->GetAbstractArray("SIL Ids"));
+  vtkUnsignedCharArray* subtreeCollapsed = vtkUnsignedCharArray::SafeDownCast(
+    subtree->GetVertexData()->GetAbstractArray("Collapsed"));
+  vtkDataArray* subtreeCrossEdges = vtkDataArray::SafeDownCast(
+    subtree->GetEdgeData()->GetAbstractArray("CrossEdges"));
+  vtkIdType numVertices = subtree->GetNumberOfVertices();
+  if (!subtreeNames || !subtreeIds || !subtreeCollapsed ||
+    !subtreeCrossEdges || numVertices < 1)
+    {
+    subtree->Delete();
+    return 0;
+    }
+
+  // Vertices fetched before, by SIL id, to restore the cross edges between
+  // them and the new vertices.
+  vtkstd::map<vtkIdType, vtkIdType> fetched;
+  vtkIdType cc;
+  for (cc = 0; cc < sil->GetNumberOfVertices(); ++cc)
+    {
+    fetched.insert(vtkstd::pair<const vtkIdType, vtkIdType>(
+        silIds->GetValue(cc), cc));
+    }
+
+  // Vertex 0 of the subtree is the vertex expanded.
+  vtkstd::vector<vtkIdType> newIds(numVertices);
+  newIds[0] = vertex;
+  collapsed->SetValue(vertex, subtreeCollapsed->GetValue(0));
+  for (cc = 1; cc < numVertices; ++cc)
+    {
+    vtkIdType newId = sil->AddVertex();
+    newIds[cc] = newId;
+    names->InsertValue(newId, subtreeNames->GetValue(cc));
+    silIds->InsertValue(newId, subtreeIds->GetValue(cc));
+    collapsed->InsertValue(newId, subtreeCollapsed->GetValue(cc));
+    }
+
+  vtkSmartPointer<vtkOutEdgeIterator> iter =
+    vtkSmartPointer<vtkOutEdgeIterator>::New();
+  for (cc = 0; cc < numVertices; ++cc)
+    {
+    subtree->GetOutEdges(cc, iter);
+    while (iter->HasNext())
+      {
+      vtkOutEdgeType edge = iter->Next();
+      vtkEdgeType newEdge = sil->AddEdge(newIds[cc], newIds[edge.Target]);
+      crossEdges->InsertTuple1(newEdge.Id,
+        subtreeCrossEdges->GetTuple1(edge.Id));
+      }
+    }
+
+  vtkIdTypeArray* external = vtkIdTypeArray::SafeDownCast(
+    subtree->GetFieldData()->GetAbstractArray("External Cross Edges"));
+  vtkIdType numExternal = (external && external->GetNumberOfComponents() == 3)?
+    external->GetNumberOfTuples() : 0;
+  for (cc = 0; cc < numExternal; ++cc)
+    {
+    vtkIdType local = external->GetValue(3*cc);
+    vtkstd::map<vtkIdType, vtkIdType>::iterator other =
+      fetched.find(external->GetValue(3*cc+1));
+    // Edges to vertices not fetched yet are restored when those are fetched.
+    // The expanded vertex itself already has its cross edges.
+    if (local <= 0 || local >= numVertices || other == fetched.end())
+      {
+      continue;
+      }
+    vtkEdgeType newEdge = external->GetValue(3*cc+2)?
+      sil->AddEdge(other->second, newIds[local]) :
+      sil->AddEdge(newIds[local], other->second);
+    crossEdges->InsertTuple1(newEdge.Id, 1);
+    }
+  subtree->Delete();
+  sil->Modified();
+  return numVertices - 1;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSMSILInformationHelper::ExpandAll()
+{
+  if (!this->SIL || this->SIL->GetNumberOfVertices() < 1)
+    {
+    return 0;
+    }
+  return this->ExpandSubtree(0);
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkSMSILInformationHelper::ExpandSubtree(vtkIdType vertex)
+{
+  vtkUnsignedCharArray* collapsed = this->SIL?
+    vtkUnsignedCharArray::SafeDownCast(
+      this->SIL->GetVertexData()->GetAbstractArray("Collapsed")) : 0;
+  vtkDataArray* crossEdges = this->SIL?
+    vtkDataArray::SafeDownCast(
+      this->SIL->GetEdgeData()->GetAbstractArray("CrossEdges")) : 0;
+  if (!collapsed || !crossEdges)
+    {
+    return 0;
+    }
+
+  // Collect the collapsed vertices first; expanding them adds the whole
+  // subtrees below them.
+  vtkstd::vector<vtkIdType> toExpand;
+  vtkstd::vector<vtkIdType> stack;
+  stack.push_back(vertex);
+  vtkSmartPointer<vtkOutEdgeIterator> iter =
+    vtkSmartPointer<vtkOutEdgeIterator>::New();
+  while (!stack.empty())
+    {
+    vtkIdType current = stack.back();
+    stack.pop_back();
+    if (collapsed->GetValue(current))
+      {
+      toExpand.push_back(current);
+      continue;
+      }
+    this->SIL->GetOutEdges(current, iter);
+    while (iter->HasNext())
+      {
+      vtkOutEdgeType edge = iter->Next();
+      if (crossEdges->GetTuple1(edge.Id) == 0)
+        {
+        stack.push_back(edge.Target);
+        }
+      }
+    }
+
+  vtkIdType added = 0;
+  for (size_t cc = 0; cc < toExpand.size(); ++cc)
+    {
+    added += this->ExpandVertex(toExpand[cc], -1);
+    }
+  return added;
+}
+
 //----------------------------------------------------------------------------
 int vtkSMSILInformationHelper::ReadXMLAttributes(vtkSMProperty* prop,
   vtkPVXMLElement* elem)
@@ -175,6 +549,12 @@ int vtkSMSILInformationHelper::ReadXMLAttributes(vtkSMProperty* prop,
     this->SetSubtree(subtree);
     }
 
+  int depth;
+  if (elem->GetScalarAttribute("depth", &depth))
+    {
+    this->MaximumDepth = depth;
+    }
+
   return this->Superclass::ReadXMLAttributes(prop, elem);
 }
 
@@ -182,6 +562,7 @@ int vtkSMSILInformationHelper::ReadXMLAttributes(vtkSMProperty* prop,
 void vtkSMSILInformationHelper::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "MaximumDepth: " << this->MaximumDepth << endl;
 }
 
 
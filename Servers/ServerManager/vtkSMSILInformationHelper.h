@@ -18,13 +18,17 @@
 // vtkSMSILInformationHelper populates a vtkSMStringVectorProperty using
 // the list of arrays obtained via a SIL.
 //
-// The xml can has 2 attributes:
+// The xml can has 3 attributes:
 // \li subtree -- identifies the subtree in the SIL whose leaf nodes are to
 // returned as the value in the property.
 // \li timestamp_command -- specifies a method name that can be used to get the
 // last time the SIL was updated on the server. This makes it possible to avoid
 // re-fetches of the SIL when not necessary (since SIL's can be huge and
 // fetching them can be time consuming).
+// \li depth -- when set, only the top depth levels of the SIL are fetched,
+// plus the path to the subtree and the whole subtree. The other subtrees can
+// be fetched on demand with ExpandVertex(). By default the whole SIL is
+// fetched.
 //
 // Note: array status is not provided by this helper. SIL
 // does not provide information about the current selection and hence this
@@ -36,6 +40,7 @@
 #include "vtkSMInformationHelper.h"
 
 class vtkGraph;
+class vtkIdTypeArray;
 class vtkSMStringVectorProperty;
 
 class VTK_EXPORT vtkSMSILInformationHelper : public vtkSMInformationHelper
@@ -62,6 +67,24 @@ public:
   vtkGetObjectMacro(SIL, vtkGraph);
   vtkGetStringMacro(Subtree);
 
+  // Description:
+  // Number of levels of the SIL fetched by UpdateProperty(). -1 when the
+  // whole SIL is fetched.
+  vtkGetMacro(MaximumDepth, int);
+
+  // Description:
+  // Fetches the vertices below a collapsed vertex of the SIL (see
+  // vtkPVSILInformation), at most depth levels deep or the whole subtree
+  // when depth is -1, and adds them to the SIL. The cross edges between the
+  // new vertices and the vertices fetched before are restored. Returns the
+  // number of vertices added.
+  vtkIdType ExpandVertex(vtkIdType vertex, int depth);
+
+  // Description:
+  // Fetches all the collapsed vertices of the SIL, so that it is the same as
+  // a SIL fetched whole. Returns the number of vertices added.
+  vtkIdType ExpandAll();
+
 //BTX
 protected:
   vtkSMSILInformationHelper();
@@ -80,6 +103,27 @@ protected:
 
   void UpdateArrayList(vtkSMStringVectorProperty*);
 
+  // Description:
+  // Fetches the part of the SIL below the vertex root of the server's SIL,
+  // at most depth levels deep. Returns a new graph or NULL.
+  vtkGraph* FetchSIL(vtkIdType root, int depth);
+
+  // Description:
+  // Fetches the ids, in the server's SIL, of the vertices from the root to
+  // the vertex with the given name. Returns false if there is no such
+  // vertex.
+  bool FetchPath(const char* name, vtkIdTypeArray* path);
+
+  // Description:
+  // Expands the collapsed vertices on the path from the root to the vertex
+  // with the given name, one level each. Returns the vertex or -1.
+  vtkIdType ExpandPath(const char* name);
+
+  // Description:
+  // Expands all the collapsed vertices below vertex. Returns the number of
+  // vertices added.
+  vtkIdType ExpandSubtree(vtkIdType vertex);
+
   vtkSetStringMacro(TimestampCommand);
   vtkSetStringMacro(Subtree);
 
@@ -87,6 +131,12 @@ protected:
   char* Subtree;
 
   int LastUpdateTime;
+  int MaximumDepth;
+
+  // Where the SIL was last fetched from.
+  vtkIdType ConnectionID;
+  int ServerIds;
+  vtkClientServerID ObjectID;
 
   vtkGraph* SIL;
 private:
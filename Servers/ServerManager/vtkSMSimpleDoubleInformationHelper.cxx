@@ -35,33 +35,55 @@ vtkSMSimpleDoubleInformationHelper::~vtkSMSimpleDoubleInformationHelper()
 void vtkSMSimpleDoubleInformationHelper::UpdateProperty(
   vtkIdType connectionId, int serverIds, vtkClientServerID objectId, 
   vtkSMProperty* prop)
+{
+  // Invoke property's method on the root node of the server
+  vtkClientServerStream str;
+  if (!this->AppendRequest(objectId, prop, str))
+    {
+    return;
+    }
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  pm->SendStream(connectionId, vtkProcessModule::GetRootId(serverIds), str);
+
+  // Get the result
+  this->ProcessResult(prop,
+    pm->GetLastResult(connectionId, vtkProcessModule::GetRootId(serverIds)));
+}
+
+//---------------------------------------------------------------------------
+int vtkSMSimpleDoubleInformationHelper::AppendRequest(
+  vtkClientServerID objectId, vtkSMProperty* prop, vtkClientServerStream& str)
 {
   vtkSMDoubleVectorProperty* dvp = vtkSMDoubleVectorProperty::SafeDownCast(prop);
   if (!dvp)
     {
     vtkErrorMacro("A null property or a property of a different type was "
                   "passed when vtkSMDoubleVectorProperty was needed.");
-    return;
+    return 0;
     }
 
   if (!prop->GetCommand())
     {
-    return;
+    return 0;
     }
 
-  // Invoke property's method on the root node of the server
-  vtkClientServerStream str;
   str << vtkClientServerStream::Invoke 
       << objectId << prop->GetCommand()
       << vtkClientServerStream::End;
+  return 1;
+}
 
-  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
-  pm->SendStream(connectionId, vtkProcessModule::GetRootId(serverIds), str);
-
-  // Get the result
-  const vtkClientServerStream& res =     
-    pm->GetLastResult(connectionId, vtkProcessModule::GetRootId(serverIds));
-
+//---------------------------------------------------------------------------
+void vtkSMSimpleDoubleInformationHelper::ProcessResult(
+  vtkSMProperty* prop, const vtkClientServerStream& res)
+{
+  vtkSMDoubleVectorProperty* dvp =
+    vtkSMDoubleVectorProperty::SafeDownCast(prop);
+  if (!dvp)
+    {
+    return;
+    }
 
   int numMsgs = res.GetNumberOfMessages();
   if (numMsgs < 1)
@@ -133,7 +155,6 @@ void vtkSMSimpleDoubleInformationHelper::UpdateProperty(
       dvp->SetElement(i, values[i]);
       }
     }
-
 }
 
 //---------------------------------------------------------------------------
@@ -44,6 +44,14 @@ public:
   virtual void UpdateProperty(
     vtkIdType connectionId,
     int serverIds, vtkClientServerID objectId, vtkSMProperty* prop);
+
+  // Description:
+  // Appends the invocation of the command of the property to the stream,
+  // and fills the property from its result.
+  virtual int AppendRequest(vtkClientServerID objectId, vtkSMProperty* prop,
+    vtkClientServerStream& str);
+  virtual void ProcessResult(vtkSMProperty* prop,
+    const vtkClientServerStream& res);
   //ETX
 
 protected:
@@ -35,6 +35,25 @@ vtkSMSimpleIdTypeInformationHelper::~vtkSMSimpleIdTypeInformationHelper()
 void vtkSMSimpleIdTypeInformationHelper::UpdateProperty(
   vtkIdType connectionId, int serverIds, vtkClientServerID objectId, 
   vtkSMProperty* prop)
+{
+  // Invoke property's method on the root node of the server
+  vtkClientServerStream str;
+  if (!this->AppendRequest(objectId, prop, str))
+    {
+    return;
+    }
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  pm->SendStream(connectionId, vtkProcessModule::GetRootId(serverIds), str);
+
+  // Get the result
+  this->ProcessResult(prop,
+    pm->GetLastResult(connectionId, vtkProcessModule::GetRootId(serverIds)));
+}
+
+//---------------------------------------------------------------------------
+int vtkSMSimpleIdTypeInformationHelper::AppendRequest(
+  vtkClientServerID objectId, vtkSMProperty* prop, vtkClientServerStream& str)
 {
   vtkSMIdTypeVectorProperty* ivp = 
     vtkSMIdTypeVectorProperty::SafeDownCast(prop);
@@ -42,26 +61,30 @@ void vtkSMSimpleIdTypeInformationHelper::UpdateProperty(
     {
     vtkErrorMacro("A null property or a property of a different type was "
                   "passed when vtkSMIdTypeVectorProperty was needed.");
-    return;
+    return 0;
     }
 
   if (!prop->GetCommand())
     {
-    return;
+    return 0;
     }
 
-  // Invoke property's method on the root node of the server
-  vtkClientServerStream str;
   str << vtkClientServerStream::Invoke 
       << objectId << prop->GetCommand()
       << vtkClientServerStream::End;
+  return 1;
+}
 
-  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
-  pm->SendStream(connectionId, vtkProcessModule::GetRootId(serverIds), str);
-
-  // Get the result
-  const vtkClientServerStream& res = 
-    pm->GetLastResult(connectionId, vtkProcessModule::GetRootId(serverIds));
+//---------------------------------------------------------------------------
+void vtkSMSimpleIdTypeInformationHelper::ProcessResult(
+  vtkSMProperty* prop, const vtkClientServerStream& res)
+{
+  vtkSMIdTypeVectorProperty* ivp =
+    vtkSMIdTypeVectorProperty::SafeDownCast(prop);
+  if (!ivp)
+    {
+    return;
+    }
 
   int numMsgs = res.GetNumberOfMessages();
   if (numMsgs < 1)
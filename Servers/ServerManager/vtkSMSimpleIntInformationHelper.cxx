@@ -35,32 +35,54 @@ vtkSMSimpleIntInformationHelper::~vtkSMSimpleIntInformationHelper()
 void vtkSMSimpleIntInformationHelper::UpdateProperty(
   vtkIdType connectionId, int serverIds, vtkClientServerID objectId, 
   vtkSMProperty* prop)
+{
+  // Invoke property's method on the root node of the server
+  vtkClientServerStream str;
+  if (!this->AppendRequest(objectId, prop, str))
+    {
+    return;
+    }
+
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  pm->SendStream(connectionId, vtkProcessModule::GetRootId(serverIds), str);
+
+  // Get the result
+  this->ProcessResult(prop,
+    pm->GetLastResult(connectionId, vtkProcessModule::GetRootId(serverIds)));
+}
+
+//---------------------------------------------------------------------------
+int vtkSMSimpleIntInformationHelper::AppendRequest(
+  vtkClientServerID objectId, vtkSMProperty* prop, vtkClientServerStream& str)
 {
   vtkSMIntVectorProperty* ivp = vtkSMIntVectorProperty::SafeDownCast(prop);
   if (!ivp)
     {
     vtkErrorMacro("A null property or a property of a different type was "
                   "passed when vtkSMIntVectorProperty was needed.");
-    return;
+    return 0;
     }
 
   if (!prop->GetCommand())
     {
-    return;
+    return 0;
     }
 
-  // Invoke property's method on the root node of the server
-  vtkClientServerStream str;
   str << vtkClientServerStream::Invoke 
       << objectId << prop->GetCommand()
       << vtkClientServerStream::End;
+  return 1;
+}
 
-  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
-  pm->SendStream(connectionId, vtkProcessModule::GetRootId(serverIds), str);
-
-  // Get the result
-  const vtkClientServerStream& res = 
-    pm->GetLastResult(connectionId, vtkProcessModule::GetRootId(serverIds));
+//---------------------------------------------------------------------------
+void vtkSMSimpleIntInformationHelper::ProcessResult(
+  vtkSMProperty* prop, const vtkClientServerStream& res)
+{
+  vtkSMIntVectorProperty* ivp = vtkSMIntVectorProperty::SafeDownCast(prop);
+  if (!ivp)
+    {
+    return;
+    }
 
   int numMsgs = res.GetNumberOfMessages();
   if (numMsgs < 1)
@@ -20,6 +20,7 @@
 #include "vtkPVDataSizeInformation.h"
 #include "vtkSMDoubleVectorProperty.h"
 #include "vtkSMIntVectorProperty.h"
+#include "vtkSMPropertyHelper.h"
 #include "vtkSMSourceProxy.h"
 
 vtkStandardNewMacro(vtkSMSimpleStrategy);
@@ -123,6 +124,15 @@ void vtkSMSimpleStrategy::UpdatePipeline()
   this->UpdateSuppressor->InvokeCommand("ForceUpdate");
   // This is called for its side-effects; i.e. to force a PostUpdateData()
   this->UpdateSuppressor->UpdatePipeline();
+
+  // The input of the LOD pipeline is now up-to-date: get the LOD decimation
+  // going in the background on the server so that it is (mostly) done by the
+  // time the user starts interacting.
+  if (this->GetEnableLOD() && !this->GetUseLOD() && this->LODDecimator &&
+    this->LODDecimator->GetProperty("StartBackgroundBuild"))
+    {
+    this->LODDecimator->InvokeCommand("StartBackgroundBuild");
+    }
 }
 
 //----------------------------------------------------------------------------
@@ -159,6 +169,32 @@ void vtkSMSimpleStrategy::SetLODResolution(int resolution)
     }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSimpleStrategy::SetNumberOfLODLevels(int levels)
+{
+  this->Superclass::SetNumberOfLODLevels(levels);
+
+  if (this->LODDecimator &&
+    this->LODDecimator->GetProperty("NumberOfLevels"))
+    {
+    vtkSMPropertyHelper(this->LODDecimator, "NumberOfLevels").Set(
+      this->NumberOfLODLevels);
+    this->LODDecimator->UpdateVTKObjects();
+    }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSimpleStrategy::SetLODLevel(int level)
+{
+  this->Superclass::SetLODLevel(level);
+
+  if (this->LODDecimator && this->LODDecimator->GetProperty("Level"))
+    {
+    vtkSMPropertyHelper(this->LODDecimator, "Level").Set(this->LODLevel);
+    this->LODDecimator->UpdateVTKObjects();
+    }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSimpleStrategy::PrintSelf(ostream& os, vtkIndent indent)
 {
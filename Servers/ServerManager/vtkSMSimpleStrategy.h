@@ -90,6 +90,12 @@ protected:
   // has indeed changed.
   virtual void SetLODResolution(int resolution);
 
+  // Description:
+  // Overridden to pass the hierarchy settings to the LODDecimator when it
+  // supports them.
+  virtual void SetNumberOfLODLevels(int levels);
+  virtual void SetLODLevel(int level);
+
   vtkSMSourceProxy* UpdateSuppressor;
   vtkSMSourceProxy* UpdateSuppressorLOD;
   vtkSMSourceProxy* LODDecimator;
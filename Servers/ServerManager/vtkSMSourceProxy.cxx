@@ -16,6 +16,7 @@
 
 #include "vtkClientServerStream.h"
 #include "vtkCollection.h"
+#include "vtkCollectionIterator.h"
 #include "vtkCommand.h"
 #include "vtkDataSetAttributes.h"
 #include "vtkObjectFactory.h"
@@ -35,6 +36,7 @@
 #include "vtkSMProxyManager.h"
 #include "vtkSMStringVectorProperty.h"
 
+#include <vtkstd/set>
 #include <vtkstd/string>
 #include <vtkstd/vector>
 #include <vtksys/ios/sstream>
@@ -199,6 +201,94 @@ void vtkSMSourceProxy::UpdatePipelineInformation()
   this->InvokeEvent(vtkCommand::UpdateInformationEvent);
   // this->MarkModified(this);  
 }
+//---------------------------------------------------------------------------
+// Appends the subproxies of the proxy, recursively, and then the proxy, in
+// the order vtkSMProxy::UpdatePipelineInformation() visits them.
+static void vtkSMSourceProxyAddProxies(vtkSMProxy* proxy, vtkCollection* all)
+{
+  unsigned int numSubProxies = proxy->GetNumberOfSubProxies();
+  for (unsigned int cc = 0; cc < numSubProxies; ++cc)
+    {
+    vtkSMSourceProxyAddProxies(proxy->GetSubProxy(cc), all);
+    }
+  all->AddItem(proxy);
+}
+
+//---------------------------------------------------------------------------
+void vtkSMSourceProxy::UpdatePipelineInformation(vtkCollection* sources)
+{
+  if (!sources)
+    {
+    return;
+    }
+
+  vtkSmartPointer<vtkCollection> all = vtkSmartPointer<vtkCollection>::New();
+  vtkstd::vector<vtkSMSourceProxy*> proxies;
+  vtkstd::set<vtkIdType> connections;
+  vtkCollectionIterator* iter = sources->NewIterator();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+    iter->GoToNextItem())
+    {
+    vtkSMSourceProxy* source =
+      vtkSMSourceProxy::SafeDownCast(iter->GetCurrentObject());
+    if (source)
+      {
+      vtkSMSourceProxyAddProxies(source, all);
+      }
+    }
+  iter->Delete();
+
+  // Subproxies may be sources too.
+  iter = all->NewIterator();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal();
+    iter->GoToNextItem())
+    {
+    vtkSMSourceProxy* source =
+      vtkSMSourceProxy::SafeDownCast(iter->GetCurrentObject());
+    if (source)
+      {
+      proxies.push_back(source);
+      connections.insert(source->ConnectionID);
+      }
+    }
+  iter->Delete();
+
+  // Queue the UpdateInformation requests and send them together.
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkstd::set<vtkIdType>::iterator connIter;
+  for (connIter = connections.begin(); connIter != connections.end();
+    ++connIter)
+    {
+    pm->BeginStreamTransaction(*connIter);
+    }
+  vtkstd::vector<vtkSMSourceProxy*>::iterator proxyIter;
+  for (proxyIter = proxies.begin(); proxyIter != proxies.end(); ++proxyIter)
+    {
+    vtkSMSourceProxy* source = *proxyIter;
+    if (!source->GetID().IsNull())
+      {
+      vtkClientServerStream command;
+      command << vtkClientServerStream::Invoke
+        << source->GetID() << "UpdateInformation"
+        << vtkClientServerStream::End;
+      pm->SendStream(source->ConnectionID, source->Servers, command);
+      }
+    }
+  for (connIter = connections.begin(); connIter != connections.end();
+    ++connIter)
+    {
+    pm->EndStreamTransaction(*connIter);
+    }
+
+  // The pipelines are up to date, gather the information properties of all
+  // the proxies and subproxies together.
+  vtkSMProxy::UpdatePropertyInformation(all);
+  for (proxyIter = proxies.begin(); proxyIter != proxies.end(); ++proxyIter)
+    {
+    (*proxyIter)->InvokeEvent(vtkCommand::UpdateInformationEvent);
+    }
+}
+
 //---------------------------------------------------------------------------
 int vtkSMSourceProxy::ReadXMLAttributes(vtkSMProxyManager* pm, 
                                         vtkPVXMLElement* element)
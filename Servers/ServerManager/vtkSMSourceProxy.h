@@ -33,6 +33,7 @@
 #include "vtkSMProxy.h"
 #include "vtkClientServerID.h" // Needed for ClientServerID
 
+class vtkCollection;
 class vtkPVArrayInformation;
 class vtkPVDataInformation;
 class vtkPVDataSetAttributesInformation;
@@ -53,6 +54,17 @@ public:
   // Calls UpdateInformation() on all sources.
   virtual void UpdatePipelineInformation();
 
+  // Description:
+  // Calls UpdatePipelineInformation() on all the vtkSMSourceProxy in the
+  // collection. The UpdateInformation() requests of all the proxies are sent
+  // to the servers together, before the information properties of any of
+  // them are gathered, so that the servers bring all the pipelines up to
+  // date in one go instead of one proxy per round trip. The information
+  // properties of all the proxies and their subproxies are then gathered
+  // with one round trip per server (see
+  // vtkSMProxy::UpdatePropertyInformation(vtkCollection*)).
+  static void UpdatePipelineInformation(vtkCollection* sources);
+
   // Description:
   // Calls Update() on all sources. It also creates output ports if
   // they are not already created.
@@ -14,12 +14,16 @@
 =========================================================================*/
 #include "vtkSMStateLoader.h"
 
+#include "vtkCollection.h"
+#include "vtkCollectionIterator.h"
 #include "vtkObjectFactory.h"
+#include "vtkProcessModule.h"
 #include "vtkProcessModuleConnectionManager.h"
 #include "vtkPVXMLElement.h"
 #include "vtkSmartPointer.h"
 #include "vtkSMCameraLink.h"
 #include "vtkSMGlobalPropertiesManager.h"
+#include "vtkSMOutputPort.h"
 #include "vtkSMProperty.h"
 #include "vtkSMPropertyLink.h"
 #include "vtkSMProxyIterator.h"
@@ -29,6 +33,7 @@
 #include "vtkSMSourceProxy.h"
 #include "vtkSMStateVersionController.h"
 #include "vtkSMViewProxy.h"
+#include "vtkTimerLog.h"
 
 #include <vtkstd/map>
 #include <vtkstd/string>
@@ -48,14 +53,42 @@ struct vtkSMStateLoaderInternals
   typedef vtkstd::vector<vtkSMStateLoaderRegistrationInfo> VectorOfRegInfo;
   typedef vtkstd::map<int, VectorOfRegInfo> RegInfoMapType;
   RegInfoMapType RegistrationInformation;
+
+  // Output ports of the source proxies created while loading the state.
+  vtkSmartPointer<vtkCollection> OutputPorts;
+
+  // Proxies created while deferring, in creation order, with their ids.
+  typedef vtkstd::pair<int, vtkSmartPointer<vtkSMProxy> > DeferredProxyType;
+  vtkstd::vector<DeferredProxyType> DeferredProxies;
+  bool Deferring;
 };
 
+//---------------------------------------------------------------------------
+static void vtkSMStateLoaderAddOutputPorts(vtkSMSourceProxy* source,
+  vtkCollection* ports)
+{
+  source->CreateOutputPorts();
+  unsigned int numPorts = source->GetNumberOfOutputPorts();
+  for (unsigned int cc=0; cc < numPorts; cc++)
+    {
+    ports->AddItem(source->GetOutputPort(cc));
+    }
+}
+
 //---------------------------------------------------------------------------
 vtkSMStateLoader::vtkSMStateLoader()
 {
   this->Internal = new vtkSMStateLoaderInternals;
+  this->Internal->OutputPorts = vtkSmartPointer<vtkCollection>::New();
+  this->Internal->Deferring = false;
   this->ServerManagerStateElement = 0;
   this->ProxyLocator = vtkSMProxyLocator::New();
+  this->DeferredLoading = 0;
+  this->CreateProxiesTime = 0.0;
+  this->UpdatePipelineInformationTime = 0.0;
+  this->GatherInformationTime = 0.0;
+  this->RegisterProxiesTime = 0.0;
+  this->LoadStateTime = 0.0;
 }
 
 //---------------------------------------------------------------------------
@@ -152,13 +185,107 @@ void vtkSMStateLoader::CreatedNewProxy(int id, vtkSMProxy* proxy)
   // Ensure that the proxy is created before it is registered, unless we are
   // reviving the server-side server manager, which needs special handling.
   proxy->UpdateVTKObjects();
+  if (this->Internal->Deferring)
+    {
+    // LoadProxiesDeferred() updates and registers the proxy later.
+    this->Internal->DeferredProxies.push_back(
+      vtkSMStateLoaderInternals::DeferredProxyType(id, proxy));
+    return;
+    }
   if (proxy->IsA("vtkSMSourceProxy"))
     {
-    vtkSMSourceProxy::SafeDownCast(proxy)->UpdatePipelineInformation();
+    vtkSMSourceProxy* source = vtkSMSourceProxy::SafeDownCast(proxy);
+    source->UpdatePipelineInformation();
+
+    // The data information of the output ports is fetched in one request
+    // once the whole state is loaded (see LoadState()). Fetching it here
+    // would cost a round trip per source while the pipeline is only
+    // partially loaded.
+    vtkSMStateLoaderAddOutputPorts(source, this->Internal->OutputPorts);
     }
   this->RegisterProxy(id, proxy);
 }
 
+//---------------------------------------------------------------------------
+int vtkSMStateLoader::LoadProxiesDeferred()
+{
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkIdType cid = this->ProxyLocator->GetConnectionID();
+  vtkTimerLog* timer = vtkTimerLog::New();
+
+  // Create all the proxies, sending their properties in one batch.
+  vtkTimerLog::MarkStartEvent("Load State: Create Proxies");
+  timer->StartTimer();
+  pm->BeginStreamTransaction(cid);
+  this->Internal->Deferring = true;
+  vtkSMStateLoaderInternals::RegInfoMapType::iterator iter;
+  for (iter = this->Internal->RegistrationInformation.begin();
+    iter != this->Internal->RegistrationInformation.end(); ++iter)
+    {
+    this->ProxyLocator->LocateProxy(iter->first);
+    }
+  this->Internal->Deferring = false;
+  pm->EndStreamTransaction(cid);
+  timer->StopTimer();
+  this->CreateProxiesTime = timer->GetElapsedTime();
+  vtkTimerLog::MarkEndEvent("Load State: Create Proxies");
+
+  vtkstd::vector<vtkSMStateLoaderInternals::DeferredProxyType> proxies;
+  proxies.swap(this->Internal->DeferredProxies);
+  vtkSmartPointer<vtkCollection> sources =
+    vtkSmartPointer<vtkCollection>::New();
+  vtkstd::vector<vtkSMStateLoaderInternals::DeferredProxyType>::iterator
+    proxyIter;
+  for (proxyIter = proxies.begin(); proxyIter != proxies.end(); ++proxyIter)
+    {
+    if (vtkSMSourceProxy::SafeDownCast(proxyIter->second))
+      {
+      sources->AddItem(proxyIter->second);
+      }
+    }
+
+  // Update the pipeline information of all the sources together.
+  vtkTimerLog::MarkStartEvent("Load State: Update Pipeline Information");
+  timer->StartTimer();
+  vtkSMSourceProxy::UpdatePipelineInformation(sources);
+  timer->StopTimer();
+  this->UpdatePipelineInformationTime = timer->GetElapsedTime();
+  vtkTimerLog::MarkEndEvent("Load State: Update Pipeline Information");
+
+  // Gather the data information of all the output ports in one request.
+  vtkTimerLog::MarkStartEvent("Load State: Gather Information");
+  timer->StartTimer();
+  vtkSmartPointer<vtkCollection> ports =
+    vtkSmartPointer<vtkCollection>::New();
+  vtkCollectionIterator* sourceIter = sources->NewIterator();
+  for (sourceIter->InitTraversal(); !sourceIter->IsDoneWithTraversal();
+    sourceIter->GoToNextItem())
+    {
+    vtkSMStateLoaderAddOutputPorts(
+      static_cast<vtkSMSourceProxy*>(sourceIter->GetCurrentObject()), ports);
+    }
+  sourceIter->Delete();
+  vtkSMOutputPort::PrefetchDataInformation(ports);
+  timer->StopTimer();
+  this->GatherInformationTime = timer->GetElapsedTime();
+  vtkTimerLog::MarkEndEvent("Load State: Gather Information");
+
+  // Register the proxies in the order they were created, so that inputs are
+  // registered before the filters using them.
+  vtkTimerLog::MarkStartEvent("Load State: Register Proxies");
+  timer->StartTimer();
+  for (proxyIter = proxies.begin(); proxyIter != proxies.end(); ++proxyIter)
+    {
+    this->RegisterProxy(proxyIter->first, proxyIter->second);
+    }
+  timer->StopTimer();
+  this->RegisterProxiesTime = timer->GetElapsedTime();
+  vtkTimerLog::MarkEndEvent("Load State: Register Proxies");
+
+  timer->Delete();
+  return 1;
+}
+
 //---------------------------------------------------------------------------
 void vtkSMStateLoader::RegisterProxy(int id, vtkSMProxy* proxy)
 {
@@ -465,10 +592,23 @@ int vtkSMStateLoader::LoadState(vtkPVXMLElement* elem)
     return 0;
     }
 
+  this->CreateProxiesTime = 0.0;
+  this->UpdatePipelineInformationTime = 0.0;
+  this->GatherInformationTime = 0.0;
+  this->RegisterProxiesTime = 0.0;
+  vtkTimerLog* timer = vtkTimerLog::New();
+  timer->StartTimer();
+  vtkTimerLog::MarkStartEvent("Load State");
+
   this->ProxyLocator->SetDeserializer(this);
   int ret = this->LoadStateInternal(elem);
   this->ProxyLocator->SetDeserializer(0);
 
+  // Gather the data information of all the output ports created, or
+  // invalidated by the proxies loaded after them, in a single request.
+  vtkSMOutputPort::PrefetchDataInformation(this->Internal->OutputPorts);
+  this->Internal->OutputPorts->RemoveAllItems();
+
   // BUG #10650. When animation scene time ranges are read from the state, they
   // often override those that the timekeeper painstakingly computed. Here we
   // explicitly trigger the timekeeper so that the scene re-determines the
@@ -480,6 +620,10 @@ int vtkSMStateLoader::LoadState(vtkPVXMLElement* elem)
     timekeeper->GetProperty("TimestepValues")->Modified();
     }
 
+  vtkTimerLog::MarkEndEvent("Load State");
+  timer->StopTimer();
+  this->LoadStateTime = timer->GetElapsedTime();
+  timer->Delete();
   return ret;
 }
 
@@ -545,6 +689,11 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* rootElement)
       }
     }
 
+  if (this->DeferredLoading && !this->LoadProxiesDeferred())
+    {
+    return 0;
+    }
+
   for (i=0; i<numElems; i++)
     {
     vtkPVXMLElement* currentElement = rootElement->GetNestedElement(i);
@@ -579,4 +728,12 @@ int vtkSMStateLoader::LoadStateInternal(vtkPVXMLElement* rootElement)
 void vtkSMStateLoader::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "DeferredLoading: " << this->DeferredLoading << endl;
+  os << indent << "CreateProxiesTime: " << this->CreateProxiesTime << endl;
+  os << indent << "UpdatePipelineInformationTime: "
+    << this->UpdatePipelineInformationTime << endl;
+  os << indent << "GatherInformationTime: "
+    << this->GatherInformationTime << endl;
+  os << indent << "RegisterProxiesTime: " << this->RegisterProxiesTime << endl;
+  os << indent << "LoadStateTime: " << this->LoadStateTime << endl;
 }
@@ -49,6 +49,29 @@ public:
   void SetProxyLocator(vtkSMProxyLocator* loc);
   vtkGetObjectMacro(ProxyLocator, vtkSMProxyLocator);
 
+  // Description:
+  // When on, LoadState() first creates all the proxies in the state and
+  // pushes their properties to the servers in one batch. It then updates
+  // the pipeline information of all the sources together, gathers the data
+  // information of all output ports in one request, and only then registers
+  // the proxies. When off (the default), proxies are created, updated and
+  // registered one at a time, in the order they are found.
+  vtkSetMacro(DeferredLoading, int);
+  vtkGetMacro(DeferredLoading, int);
+  vtkBooleanMacro(DeferredLoading, int);
+
+  // Description:
+  // Time, in seconds, spent by the last LoadState() in each phase: creating
+  // proxies and loading their properties, updating pipeline information,
+  // gathering data information and registering proxies. The phases are
+  // interleaved when DeferredLoading is off, in which case only the total
+  // is measured. The phases are also logged with vtkTimerLog.
+  vtkGetMacro(CreateProxiesTime, double);
+  vtkGetMacro(UpdatePipelineInformationTime, double);
+  vtkGetMacro(GatherInformationTime, double);
+  vtkGetMacro(RegisterProxiesTime, double);
+  vtkGetMacro(LoadStateTime, double);
+
 protected:
   vtkSMStateLoader();
   ~vtkSMStateLoader();
@@ -116,8 +139,20 @@ protected:
   // determine what type of view needs to be created for the given class. 
   const char* GetViewXMLName(int connectionID, const char *xml_name);
 
+  // Description:
+  // Used when DeferredLoading is on. Creates all the proxies listed in
+  // proxy collections, then updates and registers them.
+  int LoadProxiesDeferred();
+
   vtkPVXMLElement* ServerManagerStateElement;
   vtkSMProxyLocator* ProxyLocator;
+
+  int DeferredLoading;
+  double CreateProxiesTime;
+  double UpdatePipelineInformationTime;
+  double GatherInformationTime;
+  double RegisterProxiesTime;
+  double LoadStateTime;
 private:
   vtkSMStateLoader(const vtkSMStateLoader&); // Not implemented
   void operator=(const vtkSMStateLoader&); // Not implemented
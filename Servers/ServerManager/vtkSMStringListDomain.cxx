@@ -44,12 +44,14 @@ vtkSMStringListDomain::~vtkSMStringListDomain()
 //---------------------------------------------------------------------------
 unsigned int vtkSMStringListDomain::GetNumberOfStrings()
 {
+  this->UpdateIfNeeded();
   return this->SLInternals->Strings.size();
 }
 
 //---------------------------------------------------------------------------
 const char* vtkSMStringListDomain::GetString(unsigned int idx)
 {
+  this->UpdateIfNeeded();
   return this->SLInternals->Strings[idx].c_str();
 }
 
@@ -95,6 +97,7 @@ void vtkSMStringListDomain::RemoveAllStrings()
 //---------------------------------------------------------------------------
 int vtkSMStringListDomain::IsInDomain(vtkSMProperty* property)
 {
+  this->UpdateIfNeeded();
   if (this->IsOptional)
     {
     return 1;
@@ -126,6 +129,7 @@ int vtkSMStringListDomain::IsInDomain(vtkSMProperty* property)
 //---------------------------------------------------------------------------
 int vtkSMStringListDomain::IsInDomain(const char* val, unsigned int& idx)
 {
+  this->UpdateIfNeeded();
   unsigned int numStrings = this->GetNumberOfStrings();
   if (numStrings == 0)
     {
@@ -249,6 +253,7 @@ int vtkSMStringListDomain::LoadState(vtkPVXMLElement* domainElement,
 void vtkSMStringListDomain::SetAnimationValue(vtkSMProperty *prop, int idx,
                                               double value)
 {
+  this->UpdateIfNeeded();
   if (!prop)
     {
     return;
@@ -265,6 +270,7 @@ void vtkSMStringListDomain::SetAnimationValue(vtkSMProperty *prop, int idx,
 //---------------------------------------------------------------------------
 int vtkSMStringListDomain::SetDefaultValues(vtkSMProperty* prop)
 {
+  this->UpdateIfNeeded();
   vtkSMStringVectorProperty* svp = 
     vtkSMStringVectorProperty::SafeDownCast(prop);
   unsigned int num_string = this->GetNumberOfStrings();
@@ -44,6 +44,7 @@ vtkSMStringListRangeDomain::~vtkSMStringListRangeDomain()
 //---------------------------------------------------------------------------
 int vtkSMStringListRangeDomain::IsInDomain(vtkSMProperty* property)
 {
+  this->UpdateIfNeeded();
   if (this->IsOptional)
     {
     return 1;
@@ -87,12 +88,14 @@ int vtkSMStringListRangeDomain::IsInDomain(vtkSMProperty* property)
 //---------------------------------------------------------------------------
 unsigned int vtkSMStringListRangeDomain::GetNumberOfStrings()
 {
+  this->UpdateIfNeeded();
   return this->SLDomain->GetNumberOfStrings();
 }
 
 //---------------------------------------------------------------------------
 const char* vtkSMStringListRangeDomain::GetString(unsigned int idx)
 {
+  this->UpdateIfNeeded();
   return this->SLDomain->GetString(idx);
 }
 
@@ -117,12 +120,14 @@ void vtkSMStringListRangeDomain::RemoveAllStrings()
 //---------------------------------------------------------------------------
 int vtkSMStringListRangeDomain::GetMinimum(unsigned int idx, int& exists)
 {
+  this->UpdateIfNeeded();
   return this->IRDomain->GetMinimum(idx, exists);
 }
 
 //---------------------------------------------------------------------------
 int vtkSMStringListRangeDomain::GetMaximum(unsigned int idx, int& exists)
 {
+  this->UpdateIfNeeded();
   return this->IRDomain->GetMaximum(idx, exists);
 }
 
@@ -245,6 +250,7 @@ void vtkSMStringListRangeDomain::ChildSaveState(vtkPVXMLElement* domainElement)
 void vtkSMStringListRangeDomain::SetAnimationValue(
   vtkSMProperty *property, int idx, double value)
 {
+  this->UpdateIfNeeded();
   if (!property)
     {
     return;
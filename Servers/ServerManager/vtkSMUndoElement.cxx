@@ -53,6 +53,13 @@ void vtkSMUndoElement::LoadStateInternal(vtkPVXMLElement* element)
   this->SetXMLElement(element);
 }
 
+//-----------------------------------------------------------------------------
+vtkIdType vtkSMUndoElement::GetMemorySize()
+{
+  return static_cast<vtkIdType>(sizeof(*this)) +
+    (this->XMLElement? this->XMLElement->GetMemorySize() : 0);
+}
+
 //-----------------------------------------------------------------------------
 void vtkSMUndoElement::PrintSelf(ostream& os, vtkIndent indent)
 {
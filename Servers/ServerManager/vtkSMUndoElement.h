@@ -45,6 +45,10 @@ public:
   // This is only valid within Undo()/Redo() calls.
   void SetProxyLocator(vtkSMProxyLocator*);
   vtkGetObjectMacro(ProxyLocator, vtkSMProxyLocator);
+
+  // Description:
+  // Returns an estimate, in bytes, of the memory used by the XML state.
+  virtual vtkIdType GetMemorySize();
 protected:
   vtkSMUndoElement();
   ~vtkSMUndoElement();
@@ -168,6 +168,13 @@ public:
     this->State = elem;
     }
 
+  // Only the client side state is held by this set.
+  virtual vtkIdType GetMemorySize()
+    {
+    return static_cast<vtkIdType>(sizeof(*this)) +
+      (this->State? this->State->GetMemorySize() : 0);
+    }
+
 protected:
   vtkSMUndoStackUndoSet() 
     {
@@ -154,6 +154,8 @@ void vtkSMUndoStackBuilder::PushToStack()
 {
   if (this->UndoSet->GetNumberOfElements() > 0 && this->UndoStack)
     {
+    vtkSMPropertyModificationUndoElement::RemoveUnchangedElements(
+      this->UndoSet);
     this->UndoStack->Push(this->ConnectionID,
       (this->Label? this->Label : "Changes"), 
       this->UndoSet);
@@ -39,6 +39,7 @@ vtkSMUniformGridVolumeRepresentationProxy::vtkSMUniformGridVolumeRepresentationP
 {
   this->VolumeFixedPointRayCastMapper = 0;
   this->VolumeGPURayCastMapper = 0;
+  this->VolumeCPURayCastMapper = 0;
   this->VolumeActor = 0;
   this->VolumeProperty = 0;
   this->ClientMapper = 0;
@@ -49,6 +50,7 @@ vtkSMUniformGridVolumeRepresentationProxy::~vtkSMUniformGridVolumeRepresentation
 {
   this->VolumeFixedPointRayCastMapper = 0;
   this->VolumeGPURayCastMapper = 0;
+  this->VolumeCPURayCastMapper = 0;
   this->VolumeActor = 0;
   this->VolumeProperty = 0;
 }
@@ -83,6 +85,7 @@ bool vtkSMUniformGridVolumeRepresentationProxy::InitializeStrategy(vtkSMViewProx
   this->Connect(this->GetInputProxy(), strategy, "Input", this->OutputPort);
   this->Connect(strategy->GetOutput(), this->VolumeFixedPointRayCastMapper);
   this->Connect(strategy->GetOutput(), this->VolumeGPURayCastMapper);
+  this->Connect(strategy->GetOutput(), this->VolumeCPURayCastMapper);
   this->Connect(strategy->GetLODOutput(), this->ClientMapper);
 
   // Creates the strategy objects.
@@ -105,6 +108,8 @@ bool vtkSMUniformGridVolumeRepresentationProxy::BeginCreateVTKObjects()
     "VolumeFixedPointRayCastMapper");
   this->VolumeGPURayCastMapper =
       this->GetSubProxy("VolumeGPURayCastMapper");
+  this->VolumeCPURayCastMapper =
+      this->GetSubProxy("VolumeCPURayCastMapper");
 
   this->VolumeActor = this->GetSubProxy("Prop3D");
   this->VolumeProperty = this->GetSubProxy("VolumeProperty");
@@ -114,6 +119,8 @@ bool vtkSMUniformGridVolumeRepresentationProxy::BeginCreateVTKObjects()
     vtkProcessModule::CLIENT | vtkProcessModule::RENDER_SERVER);
   this->VolumeGPURayCastMapper->SetServers(
     vtkProcessModule::CLIENT | vtkProcessModule::RENDER_SERVER);
+  this->VolumeCPURayCastMapper->SetServers(
+    vtkProcessModule::CLIENT | vtkProcessModule::RENDER_SERVER);
 
   this->VolumeActor->SetServers(
     vtkProcessModule::CLIENT | vtkProcessModule::RENDER_SERVER);
@@ -130,6 +137,7 @@ bool vtkSMUniformGridVolumeRepresentationProxy::EndCreateVTKObjects()
 {
   this->Connect(this->VolumeFixedPointRayCastMapper, this->VolumeActor, "Mapper");
   this->Connect(this->VolumeGPURayCastMapper, this->VolumeActor, "Mapper");
+  this->Connect(this->VolumeCPURayCastMapper, this->VolumeActor, "Mapper");
   this->Connect(this->VolumeProperty, this->VolumeActor, "Property");
 
   // This representation interprets LOD to mean client-side data. Hence, LOD
@@ -166,19 +174,25 @@ void vtkSMUniformGridVolumeRepresentationProxy::SetColorArrayName(
   vtkSMStringVectorProperty* gpu_svp = vtkSMStringVectorProperty::SafeDownCast(
     this->VolumeGPURayCastMapper->GetProperty("SelectScalarArray"));
 
+  vtkSMStringVectorProperty* cpu_svp = vtkSMStringVectorProperty::SafeDownCast(
+    this->VolumeCPURayCastMapper->GetProperty("SelectScalarArray"));
+
   if (name && name[0])
     {
     svp->SetElement(0, name);
     gpu_svp->SetElement(0, name);
+    cpu_svp->SetElement(0, name);
     }
   else
     {
     svp->SetElement(0, "");
     gpu_svp->SetElement(0, "");
+    cpu_svp->SetElement(0, "");
     }
 
   this->VolumeFixedPointRayCastMapper->UpdateVTKObjects();
   this->VolumeGPURayCastMapper->UpdateVTKObjects();
+  this->VolumeCPURayCastMapper->UpdateVTKObjects();
 }
 
 //----------------------------------------------------------------------------
@@ -191,30 +205,38 @@ void vtkSMUniformGridVolumeRepresentationProxy::SetColorAttributeType(
   vtkSMIntVectorProperty* gpu_ivp = vtkSMIntVectorProperty::SafeDownCast(
     this->VolumeGPURayCastMapper->GetProperty("ScalarMode"));
 
+  vtkSMIntVectorProperty* cpu_ivp = vtkSMIntVectorProperty::SafeDownCast(
+    this->VolumeCPURayCastMapper->GetProperty("ScalarMode"));
+
   switch (type)
     {
   case POINT_DATA:
     ivp->SetElement(0, VTK_SCALAR_MODE_USE_POINT_FIELD_DATA);
     gpu_ivp->SetElement(0, VTK_SCALAR_MODE_USE_POINT_FIELD_DATA);
+    cpu_ivp->SetElement(0, VTK_SCALAR_MODE_USE_POINT_FIELD_DATA);
     break;
 
   case CELL_DATA:
     ivp->SetElement(0, VTK_SCALAR_MODE_USE_CELL_FIELD_DATA);
     gpu_ivp->SetElement(0, VTK_SCALAR_MODE_USE_CELL_FIELD_DATA);
+    cpu_ivp->SetElement(0, VTK_SCALAR_MODE_USE_CELL_FIELD_DATA);
     break;
 
   case FIELD_DATA:
     ivp->SetElement(0, VTK_SCALAR_MODE_USE_FIELD_DATA);
     gpu_ivp->SetElement(0, VTK_SCALAR_MODE_USE_FIELD_DATA);
+    cpu_ivp->SetElement(0, VTK_SCALAR_MODE_USE_FIELD_DATA);
     break;
 
   default:
     ivp->SetElement(0,  VTK_SCALAR_MODE_DEFAULT);
     gpu_ivp->SetElement(0,  VTK_SCALAR_MODE_DEFAULT);
+    cpu_ivp->SetElement(0,  VTK_SCALAR_MODE_DEFAULT);
     }
 
   this->VolumeFixedPointRayCastMapper->UpdateVTKObjects();
   this->VolumeGPURayCastMapper->UpdateVTKObjects();
+  this->VolumeCPURayCastMapper->UpdateVTKObjects();
 }
 
 //----------------------------------------------------------------------------
@@ -316,6 +338,9 @@ void vtkSMUniformGridVolumeRepresentationProxy::SetSelectedMapperIndex(int index
     case vtkSMUniformGridVolumeRepresentationProxy::GPU_MAPPER:
       this->SetVolumeMapperToXYZ();
       break;
+    case vtkSMUniformGridVolumeRepresentationProxy::CPU_RAY_CAST_MAPPER:
+      this->SetVolumeMapperToCPURayCast();
+      break;
     default:
       vtkDebugMacro("Unknown volume mapper index " << index);
       break;
@@ -360,6 +385,25 @@ void vtkSMUniformGridVolumeRepresentationProxy::SetVolumeMapperToXYZ()
   this->UpdateVTKObjects();
 }
 
+//-----------------------------------------------------------------------------
+void vtkSMUniformGridVolumeRepresentationProxy::SetVolumeMapperToCPURayCast()
+{
+  vtkSMProxyProperty* pp;
+  pp = vtkSMProxyProperty::SafeDownCast(
+    this->VolumeActor->GetProperty("Mapper"));
+  if (!pp)
+    {
+    vtkErrorMacro("Failed to find property Mapper on VolumeActor.");
+    return;
+    }
+  if (pp->GetNumberOfProxies() != 1)
+    {
+    vtkErrorMacro("Expected one proxy in Mapper's VolumeActor.");
+    }
+  pp->SetProxy(0, this->VolumeCPURayCastMapper);
+  this->UpdateVTKObjects();
+}
+
 
 //-----------------------------------------------------------------------------
 int vtkSMUniformGridVolumeRepresentationProxy::GetVolumeMapperType()
@@ -392,6 +436,11 @@ int vtkSMUniformGridVolumeRepresentationProxy::GetVolumeMapperType()
     return vtkSMUniformGridVolumeRepresentationProxy::GPU_MAPPER;
     }
 
+  if ( !strcmp(p->GetVTKClassName(), "vtkMacrocellVolumeRayCastMapper" ) )
+    {
+    return vtkSMUniformGridVolumeRepresentationProxy::CPU_RAY_CAST_MAPPER;
+    }
+
   return vtkSMUniformGridVolumeRepresentationProxy::UNKNOWN_VOLUME_MAPPER;
 }
 
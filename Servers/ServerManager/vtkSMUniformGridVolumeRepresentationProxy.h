@@ -72,6 +72,7 @@ public:
   // mappers.
   void SetVolumeMapperToFixedPoint();
   void SetVolumeMapperToXYZ();
+  void SetVolumeMapperToCPURayCast();
 
   // Note: Do we need to have the name like this?
   // GetVolumeMapperTypeCM()? What is CM stands for.
@@ -85,6 +86,7 @@ protected:
     {
     FIXED_POINT_MAPPER,
     GPU_MAPPER,
+    CPU_RAY_CAST_MAPPER,
     UNKNOWN_VOLUME_MAPPER
     };
 
@@ -113,6 +115,7 @@ protected:
   // Structured grid volume rendering classes
   vtkSMProxy* VolumeFixedPointRayCastMapper;
   vtkSMProxy* VolumeGPURayCastMapper;
+  vtkSMProxy* VolumeCPURayCastMapper;
 
   // Common volume rendering classes
   vtkSMProxy* VolumeActor;
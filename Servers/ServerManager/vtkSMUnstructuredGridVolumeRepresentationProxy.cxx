@@ -46,6 +46,7 @@ vtkSMUnstructuredGridVolumeRepresentationProxy::vtkSMUnstructuredGridVolumeRepre
   this->VolumeHAVSMapper = 0;
   this->VolumeBunykMapper = 0;
   this->VolumeZSweepMapper = 0;
+  this->VolumeProgressiveMapper = 0;
   this->VolumeActor = 0;
   this->VolumeProperty = 0;
   this->VolumeDummyMapper = 0;
@@ -74,6 +75,7 @@ vtkSMUnstructuredGridVolumeRepresentationProxy::~vtkSMUnstructuredGridVolumeRepr
   this->VolumeHAVSMapper = 0;
   this->VolumeBunykMapper = 0;
   this->VolumeZSweepMapper = 0;
+  this->VolumeProgressiveMapper = 0;
   this->VolumeActor = 0;
   this->VolumeProperty = 0;
   this->VolumeDummyMapper = 0;
@@ -214,6 +216,7 @@ bool vtkSMUnstructuredGridVolumeRepresentationProxy::InitializeStrategy(vtkSMVie
   this->Connect(strategy->GetOutput(), this->VolumeBunykMapper);
   this->Connect(strategy->GetOutput(), this->VolumeZSweepMapper);
   this->Connect(strategy->GetOutput(), this->VolumePTMapper);
+  this->Connect(strategy->GetOutput(), this->VolumeProgressiveMapper);
   this->Connect(strategy->GetLODOutput(), this->VolumeLODMapper);
 
   this->AddStrategy(strategy);
@@ -237,6 +240,7 @@ bool vtkSMUnstructuredGridVolumeRepresentationProxy::BeginCreateVTKObjects()
   this->VolumeBunykMapper = this->GetSubProxy("VolumeBunykMapper");
   this->VolumeZSweepMapper = this->GetSubProxy("VolumeZSweepMapper");
   this->VolumeHAVSMapper = this->GetSubProxy("VolumeHAVSMapper");
+  this->VolumeProgressiveMapper = this->GetSubProxy("VolumeProgressiveMapper");
   this->VolumeActor = this->GetSubProxy("Prop3D");
   this->VolumeProperty = this->GetSubProxy("VolumeProperty");
   this->VolumeDummyMapper = this->GetSubProxy("VolumeDummyMapper");
@@ -251,6 +255,8 @@ bool vtkSMUnstructuredGridVolumeRepresentationProxy::BeginCreateVTKObjects()
     vtkProcessModule::CLIENT | vtkProcessModule::RENDER_SERVER);
   this->VolumeHAVSMapper->SetServers(
     vtkProcessModule::CLIENT | vtkProcessModule::RENDER_SERVER);
+  this->VolumeProgressiveMapper->SetServers(
+    vtkProcessModule::CLIENT | vtkProcessModule::RENDER_SERVER);
   this->VolumeActor->SetServers(
     vtkProcessModule::CLIENT | vtkProcessModule::RENDER_SERVER);
   this->VolumeProperty->SetServers(
@@ -425,6 +431,25 @@ void vtkSMUnstructuredGridVolumeRepresentationProxy::SetVolumeMapperToZSweepCM()
   this->UpdateVTKObjects();
 }
 
+//-----------------------------------------------------------------------------
+void vtkSMUnstructuredGridVolumeRepresentationProxy::SetVolumeMapperToProgressiveCM()
+{
+  vtkSMProxyProperty* pp;
+  pp = vtkSMProxyProperty::SafeDownCast(
+    this->VolumeActor->GetProperty("Mapper"));
+  if (!pp)
+    {
+    vtkErrorMacro("Failed to find property Mapper on VolumeActor.");
+    return;
+    }
+  if (pp->GetNumberOfProxies() != 1)
+    {
+    vtkErrorMacro("Expected one proxy in Mapper's VolumeActor.");
+    }
+  pp->SetProxy(0, this->VolumeProgressiveMapper);
+  this->UpdateVTKObjects();
+}
+
 //-----------------------------------------------------------------------------
 int vtkSMUnstructuredGridVolumeRepresentationProxy::GetVolumeMapperTypeCM()
 { 
@@ -464,6 +489,11 @@ int vtkSMUnstructuredGridVolumeRepresentationProxy::GetVolumeMapperTypeCM()
     {
     return vtkSMUnstructuredGridVolumeRepresentationProxy::BUNYK_RAY_CAST_VOLUME_MAPPER;
     }
+
+  if ( !strcmp(p->GetVTKClassName(), "vtkProgressiveProjectedTetrahedraMapper" ) )
+    {
+    return vtkSMUnstructuredGridVolumeRepresentationProxy::PROGRESSIVE_TETRA_VOLUME_MAPPER;
+    }
   
   return vtkSMUnstructuredGridVolumeRepresentationProxy::UNKNOWN_VOLUME_MAPPER;
 }
@@ -651,6 +681,9 @@ void vtkSMUnstructuredGridVolumeRepresentationProxy::SetSelectedMapperIndex(int
     case vtkSMUnstructuredGridVolumeRepresentationProxy::BUNYK_RAY_CAST_VOLUME_MAPPER:
       this->SetVolumeMapperToBunykCM();
       break;
+    case vtkSMUnstructuredGridVolumeRepresentationProxy::PROGRESSIVE_TETRA_VOLUME_MAPPER:
+      this->SetVolumeMapperToProgressiveCM();
+      break;
     default:
       vtkDebugMacro("Unknown volume mapper index " << index);
       break;
@@ -680,6 +713,10 @@ void vtkSMUnstructuredGridVolumeRepresentationProxy::SetSelectedMapperIndexIfSup
     {
     this->SetVolumeMapperToBunykCM();
     }
+  else if (index == vtkSMUnstructuredGridVolumeRepresentationProxy::PROGRESSIVE_TETRA_VOLUME_MAPPER)
+    {
+    this->SetVolumeMapperToProgressiveCM();
+    }
   else
     {
     vtkDebugMacro("Requested volume mapper index " << index << " is not supported.");
@@ -690,6 +727,37 @@ void vtkSMUnstructuredGridVolumeRepresentationProxy::SetSelectedMapperIndexIfSup
   this->SelectedMapperIndex = index;
 }
 
+//----------------------------------------------------------------------------
+bool vtkSMUnstructuredGridVolumeRepresentationProxy::GetProgressiveRefinementNeeded()
+{
+  if (!this->ObjectsCreated || !this->GetVisibility() ||
+    this->GetVolumeMapperTypeCM() !=
+    vtkSMUnstructuredGridVolumeRepresentationProxy::PROGRESSIVE_TETRA_VOLUME_MAPPER)
+    {
+    return false;
+    }
+
+  // The client side mapper does not render in client-server mode, ask the
+  // one on the render server.
+  vtkProcessModule* pm = vtkProcessModule::GetProcessModule();
+  vtkClientServerStream stream;
+  stream  << vtkClientServerStream::Invoke
+          << this->VolumeProgressiveMapper->GetID()
+          << "GetRefinementComplete"
+          << vtkClientServerStream::End;
+  pm->SendStream(this->ConnectionID,
+    vtkProcessModule::RENDER_SERVER_ROOT, stream);
+
+  int complete = 1;
+  if (!pm->GetLastResult(this->ConnectionID,
+      vtkProcessModule::RENDER_SERVER_ROOT).GetArgument(0, 0, &complete))
+    {
+    vtkErrorMacro("Failed to get the refinement status from the server.");
+    return false;
+    }
+  return (complete == 0);
+}
+
 //----------------------------------------------------------------------------
 void vtkSMUnstructuredGridVolumeRepresentationProxy::PrintSelf(ostream& os, vtkIndent indent)
 {
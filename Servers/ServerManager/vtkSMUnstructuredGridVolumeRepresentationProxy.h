@@ -63,12 +63,19 @@ public:
   void SetVolumeMapperToPTCM();
   void SetVolumeMapperToHAVSCM();
   void SetVolumeMapperToZSweepCM();
+  void SetVolumeMapperToProgressiveCM();
   
   // Description:
   // Convenience method for determining which
   // volume mapper is in use
   virtual int GetVolumeMapperTypeCM();
 
+  // Description:
+  // Returns true when the progressive mapper is in use and the last render
+  // on the render server did not use all the cells yet. Views render again
+  // while this is true.
+  bool GetProgressiveRefinementNeeded();
+
 //BTX
   // Volume mapper types.
   enum 
@@ -77,6 +84,7 @@ public:
     HAVS_VOLUME_MAPPER,
     ZSWEEP_VOLUME_MAPPER,
     BUNYK_RAY_CAST_VOLUME_MAPPER,
+    PROGRESSIVE_TETRA_VOLUME_MAPPER,
     UNKNOWN_VOLUME_MAPPER
   };
 //ETX
@@ -171,6 +179,7 @@ protected:
   vtkSMProxy* VolumeHAVSMapper;
   vtkSMProxy* VolumeBunykMapper;
   vtkSMProxy* VolumeZSweepMapper;
+  vtkSMProxy* VolumeProgressiveMapper;
   vtkSMProxy* VolumeDummyMapper;
   vtkSMProxy* VolumeLODMapper;
 
@@ -0,0 +1,160 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    BenchmarkDispatch.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Measures the throughput of Invoke messages processed by the
+// interpreter, with the method given by name and by method id.  The
+// methods called are wrapped by superclasses of vtkDoubleArray so the
+// dispatch walks the whole command function chain.
+//
+// Usage: vtkClientServerBenchmarkDispatch [numberOfInvokes]
+
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerStream.h"
+#include "vtkTimerLog.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+extern "C" void vtkCommonCS_Initialize(vtkClientServerInterpreter*);
+
+static const char* const BenchmarkMethods[] =
+{
+  "SetNumberOfComponents",
+  "SetNumberOfTuples",
+  "GetNumberOfTuples",
+  "Modified",
+  "GetMTime",
+  "SetName",
+  "GetDataTypeAsString",
+  "Squeeze"
+};
+static const int NumberOfBenchmarkMethods =
+  sizeof(BenchmarkMethods)/sizeof(BenchmarkMethods[0]);
+
+//----------------------------------------------------------------------------
+static void BuildStream(vtkClientServerStream& css, vtkClientServerID id,
+                        int count, bool useIds)
+{
+  css.Reset();
+  for(int i=0; i < count; ++i)
+    {
+    int m = i % NumberOfBenchmarkMethods;
+    css << vtkClientServerStream::Invoke << id;
+    if(useIds)
+      {
+      css << vtkClientServerStream::GetMethodId(BenchmarkMethods[m]);
+      }
+    else
+      {
+      css << BenchmarkMethods[m];
+      }
+    switch(m)
+      {
+      case 0: css << 1; break;
+      case 1: css << 16; break;
+      case 5: css << "benchmark"; break;
+      default: break;
+      }
+    css << vtkClientServerStream::End;
+    }
+}
+
+//----------------------------------------------------------------------------
+static bool RunBenchmark(vtkClientServerInterpreter* interp,
+                         vtkClientServerID id, int count, bool useIds,
+                         double* seconds)
+{
+  vtkClientServerStream css;
+  BuildStream(css, id, count, useIds);
+
+  vtkTimerLog* timer = vtkTimerLog::New();
+  timer->StartTimer();
+  int result = interp->ProcessStream(css);
+  timer->StopTimer();
+  *seconds = timer->GetElapsedTime();
+  timer->Delete();
+
+  if(!result)
+    {
+    cerr << "FAILED: processing the stream failed:" << endl;
+    interp->GetLastResult().Print(cerr);
+    return false;
+    }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+int main(int argc, char* argv[])
+{
+  int count = (argc > 1)? atoi(argv[1]) : 100000;
+  if(count < NumberOfBenchmarkMethods)
+    {
+    count = NumberOfBenchmarkMethods;
+    }
+
+  vtkClientServerInterpreter* interp = vtkClientServerInterpreter::New();
+  vtkCommonCS_Initialize(interp);
+
+  // The ids of the wrapped methods must resolve back to their names.
+  for(int m=0; m < NumberOfBenchmarkMethods; ++m)
+    {
+    const char* name = interp->GetMethodName(
+      vtkClientServerStream::GetMethodId(BenchmarkMethods[m]));
+    if(!name || strcmp(name, BenchmarkMethods[m]) != 0)
+      {
+      cerr << "FAILED: method id of " << BenchmarkMethods[m]
+           << " does not resolve to its name." << endl;
+      interp->Delete();
+      return 1;
+      }
+    }
+
+  vtkClientServerID id(1);
+  vtkClientServerStream css;
+  css << vtkClientServerStream::New << "vtkDoubleArray" << id
+      << vtkClientServerStream::End;
+  if(!interp->ProcessStream(css))
+    {
+    cerr << "FAILED: could not create a vtkDoubleArray." << endl;
+    interp->Delete();
+    return 1;
+    }
+
+  double byName;
+  double byId;
+  bool ok = (RunBenchmark(interp, id, count, false, &byName) &&
+             RunBenchmark(interp, id, count, true, &byId));
+  if(ok)
+    {
+    cout << "Invokes:         " << count << "\n";
+    cout << "By method name:  " << byName << " s, "
+         << (byName > 0? count/byName : 0) << " invokes/s\n";
+    cout << "By method id:    " << byId << " s, "
+         << (byId > 0? count/byId : 0) << " invokes/s\n";
+    cout << "Id invokes seen: " << interp->GetNumberOfMethodIdInvokes()
+         << endl;
+    if(interp->GetNumberOfMethodIdInvokes() != static_cast<unsigned long>(count))
+      {
+      cerr << "FAILED: the interpreter did not see the method id invokes."
+           << endl;
+      ok = false;
+      }
+    }
+
+  css.Reset();
+  css << vtkClientServerStream::Delete << id << vtkClientServerStream::End;
+  interp->ProcessStream(css);
+  interp->Delete();
+  return ok? 0 : 1;
+}
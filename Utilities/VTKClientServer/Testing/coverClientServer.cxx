@@ -1,3 +1,4 @@
+#include "vtkClientServerInterpreter.h"
 #include "vtkClientServerStream.h"
 
 template <class T>
@@ -197,10 +198,82 @@ bool do_test()
     cerr << "FAILED: (Get/Set)Data did not copy stream properly." << endl;
     return false;
     }
+
+  // Move a stream through Swap.
+  vtkClientServerStream css6;
+  css6.Swap(css5);
+  if(!do_check(css6) || css5.GetNumberOfMessages() != 0)
+    {
+    cerr << "FAILED: Swap did not move stream properly." << endl;
+    return false;
+    }
+
+  // Read a nested stream in place.
+  vtkClientServerStream css7;
+  {
+  vtkClientServerStream outer;
+  outer << vtkClientServerStream::Reply << css6
+        << vtkClientServerStream::End;
+  const unsigned char* data;
+  size_t length;
+  if(!outer.GetArgumentData(0, 0, &data, &length) ||
+     !css7.SetData(data, length))
+    {
+    cerr << "FAILED: GetArgumentData did not find the nested stream." << endl;
+    return false;
+    }
+  }
+  if(!do_check(css7))
+    {
+    cerr << "FAILED: GetArgumentData did not return the nested stream."
+         << endl;
+    return false;
+    }
   return true;
 }
 
+static int dummy_command(vtkClientServerInterpreter*, vtkObjectBase*,
+                         const char*, const vtkClientServerStream&,
+                         vtkClientServerStream&)
+{
+  return 0;
+}
+
+// Check that method ids shared by different names are not resolved.
+bool do_test_method_ids()
+{
+  // "costarring" and "liquid" have the same 32-bit FNV-1a hash.
+  static const char* const methods1[] = { "costarring", "SetValue" };
+  static const char* const methods2[] = { "liquid", "SetValue" };
+  if(vtkClientServerStream::GetMethodId("costarring") !=
+     vtkClientServerStream::GetMethodId("liquid"))
+    {
+    cerr << "FAILED: GetMethodId does not compute the FNV-1a hash." << endl;
+    return false;
+    }
+
+  vtkClientServerInterpreter* interp = vtkClientServerInterpreter::New();
+  interp->AddCommandFunction("vtkClass1", dummy_command, 0, methods1, 2);
+  interp->AddCommandFunction("vtkClass2", dummy_command, 0, methods2, 2);
+  vtkTypeUInt32 shared = vtkClientServerStream::GetMethodId("liquid");
+  vtkTypeUInt32 unique = vtkClientServerStream::GetMethodId("SetValue");
+  bool result = true;
+  if(!interp->IsMethodIdAmbiguous(shared) || interp->GetMethodName(shared))
+    {
+    cerr << "FAILED: colliding method ids are not marked ambiguous." << endl;
+    result = false;
+    }
+  if(interp->IsMethodIdAmbiguous(unique) || !interp->GetMethodName(unique) ||
+     strcmp(interp->GetMethodName(unique), "SetValue") != 0)
+    {
+    cerr << "FAILED: a method registered twice is marked ambiguous." << endl;
+    result = false;
+    }
+  interp->Delete();
+  return result;
+}
+
 int main()
 {
-  return do_test()? 0 : 1;
+  return (do_test() && do_test_method_ids())? 0 : 1;
 }
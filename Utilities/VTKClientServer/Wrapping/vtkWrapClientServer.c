@@ -284,7 +284,10 @@ void get_args(FILE *fp, int i)
     }
 }
 
-void outputFunction(FILE *fp, FileInfo *data)
+/*
+ * Returns whether the current function can be wrapped.
+ */
+int functionIsWrapped(FileInfo *data)
 {
   int i;
   int args_ok = 1;
@@ -295,7 +298,7 @@ void outputFunction(FILE *fp, FileInfo *data)
       !currentFunction->IsPublic ||
       !currentFunction->Name)
     {
-    return;
+    return 0;
     }
 
   /* check to see if we can handle the args */
@@ -367,9 +370,16 @@ void outputFunction(FILE *fp, FileInfo *data)
     }
 
   /* if the args are OK and it is not a constructor or destructor */
-  if (args_ok &&
-      strcmp(data->ClassName,currentFunction->Name) &&
-      strcmp(data->ClassName,currentFunction->Name + 1))
+  return (args_ok &&
+          strcmp(data->ClassName,currentFunction->Name) &&
+          strcmp(data->ClassName,currentFunction->Name + 1));
+}
+
+void outputFunction(FILE *fp, FileInfo *data)
+{
+  int i;
+
+  if (functionIsWrapped(data))
     {
     if(currentFunction->IsLegacy)
       {
@@ -1040,7 +1050,7 @@ int extractOtherClassesUsed(ClassInfo *data, char * classes[])
  * @param fp file to write into
  * @param data data which will be used to write into file
  */
-void output_InitFunction(FILE *fp, ClassInfo *data)
+void output_InitFunction(FILE *fp, ClassInfo *data, int numberOfMethods)
 {
   char* classes[1000];
   int totalClasses,i;
@@ -1064,15 +1074,145 @@ void output_InitFunction(FILE *fp, ClassInfo *data)
   if(data->IsConcrete)
     fprintf(fp,"    csi->AddNewInstanceFunction(\"%s\", %sClientServerNewCommand);\n",
             data->ClassName,data->ClassName);
-  fprintf(fp,"    csi->AddCommandFunction(\"%s\", %sCommand);\n",
-          data->ClassName,data->ClassName);
+  fprintf(fp,"    csi->AddCommandFunction(\"%s\", %sCommand, %sFastCommand,\n"
+          "                            %sCommandMethods, %i);\n",
+          data->ClassName,data->ClassName,data->ClassName,
+          data->ClassName,numberOfMethods);
   fprintf(fp, "    }\n}\n");
 }
 
+//--------------------------------------------------------------------------nix
+/*
+ * A wrapped function and the id of its name.  The generated command
+ * functions switch on the id so that a method call costs one hash of its
+ * name and one strcmp instead of a strcmp against every wrapped method.
+ */
+typedef struct _MethodIdEntry
+{
+  unsigned long Id;
+  int Index;
+} MethodIdEntry;
+
+/*
+ * Returns the id of a method name.  This is the 32-bit FNV-1a hash and
+ * must match vtkClientServerStream::GetMethodId.
+ */
+unsigned long methodId(const char *name)
+{
+  unsigned long hash = 2166136261UL;
+  const unsigned char *c;
+  for (c = (const unsigned char*)name; *c; ++c)
+    {
+    hash = ((hash ^ *c) * 16777619UL) & 0xFFFFFFFFUL;
+    }
+  return hash;
+}
+
+/*
+ * Orders entries by id, keeping the declaration order of overloads.
+ */
+static int methodIdEntryCmp(const void *e1, const void *e2)
+{
+  const MethodIdEntry *a = (const MethodIdEntry*)e1;
+  const MethodIdEntry *b = (const MethodIdEntry*)e2;
+  if (a->Id != b->Id)
+    {
+    return (a->Id < b->Id)? -1 : 1;
+    }
+  return a->Index - b->Index;
+}
+
+/*
+ * Writes the switch dispatching on the method id to the wrapped
+ * functions and returns the entries, sorted by id, in the given array.
+ */
+int outputMethodSwitch(FILE *fp, FileInfo *data, MethodIdEntry *entries)
+{
+  int numberOfEntries = 0;
+  int i;
+  for (i = 0; i < data->NumberOfFunctions; i++)
+    {
+    currentFunction = data->Functions + i;
+    if (functionIsWrapped(data))
+      {
+      entries[numberOfEntries].Id = methodId(currentFunction->Name);
+      entries[numberOfEntries].Index = i;
+      numberOfEntries++;
+      }
+    }
+  if (!numberOfEntries)
+    {
+    return 0;
+    }
+  qsort(entries, numberOfEntries, sizeof(MethodIdEntry), methodIdEntryCmp);
+
+  fprintf(fp,"  switch (methodId)\n    {\n");
+  for (i = 0; i < numberOfEntries; i++)
+    {
+    currentFunction = data->Functions + entries[i].Index;
+    if (i == 0 || entries[i].Id != entries[i-1].Id)
+      {
+      if (i > 0)
+        {
+        fprintf(fp,"    break;\n");
+        }
+      fprintf(fp,"    case 0x%08lXu: /* %s */\n",
+              entries[i].Id, currentFunction->Name);
+      }
+    outputFunction(fp, data);
+    }
+  fprintf(fp,"    break;\n    }\n");
+  return numberOfEntries;
+}
+
+/*
+ * Writes the table of the method names wrapped by the class.  The
+ * interpreter uses it to resolve messages carrying a method id.
+ * Returns the number of names.
+ */
+int outputMethodTable(FILE *fp, FileInfo *data, MethodIdEntry *entries,
+                      int numberOfEntries)
+{
+  int numberOfMethods = 0;
+  const char *last = 0;
+  int i;
+  fprintf(fp,
+          "\n"
+          "//-------------------------------------------------------------------------auto\n"
+          "static const char* const %sCommandMethods[] =\n"
+          "{\n", data->ClassName);
+  for (i = 0; i < numberOfEntries; i++)
+    {
+    const char *name = data->Functions[entries[i].Index].Name;
+    if (!last || strcmp(last, name))
+      {
+      fprintf(fp,"  \"%s\",\n", name);
+      numberOfMethods++;
+      last = name;
+      }
+    }
+  /* Methods handled by hand-written code in vtkParseOutput. */
+  if (!strcmp("vtkObjectBase",data->ClassName))
+    {
+    fprintf(fp,"  \"Print\",\n");
+    numberOfMethods++;
+    }
+  if (!strcmp("vtkObject",data->ClassName))
+    {
+    fprintf(fp,"  \"AddObserver\",\n");
+    numberOfMethods++;
+    }
+  fprintf(fp,"  0\n};\n");
+  return numberOfMethods;
+}
+
 /* print the parsed structures */
 void vtkParseOutput(FILE *fp, FileInfo *data)
 {
   ClassInfo *classData;
+  MethodIdEntry *entries;
+  int numberOfEntries;
+  int numberOfMethods;
   int i;
 
   fprintf(fp,"// ClientServer wrapper for %s object\n//\n",data->ClassName);
@@ -1106,8 +1246,8 @@ void vtkParseOutput(FILE *fp, FileInfo *data)
     {
       {
       fprintf(fp,
-              "int %sCommand(vtkClientServerInterpreter*, vtkObjectBase*,"
-              " const char*, const vtkClientServerStream&,"
+              "int %sFastCommand(vtkClientServerInterpreter*, vtkObjectBase*,"
+              " const char*, vtkTypeUInt32, const vtkClientServerStream&,"
               " vtkClientServerStream& resultStream);\n",
               data->SuperClasses[i]);
       }
@@ -1116,8 +1256,9 @@ void vtkParseOutput(FILE *fp, FileInfo *data)
   fprintf(fp,
           "\n"
           "int VTK_EXPORT"
-          " %sCommand(vtkClientServerInterpreter *arlu, vtkObjectBase *ob,"
-          " const char *method, const vtkClientServerStream& msg,"
+          " %sFastCommand(vtkClientServerInterpreter *arlu, vtkObjectBase *ob,"
+          " const char *method, vtkTypeUInt32 methodId,"
+          " const vtkClientServerStream& msg,"
           " vtkClientServerStream& resultStream)\n"
           "{\n",
           data->ClassName);
@@ -1150,16 +1291,14 @@ void vtkParseOutput(FILE *fp, FileInfo *data)
   /*fprintf(fp,"  vtkClientServerStream resultStream;\n");*/
 
   /* insert function handling code here */
-  for (i = 0; i < data->NumberOfFunctions; i++)
-    {
-    currentFunction = data->Functions + i;
-    outputFunction(fp, data);
-    }
+  entries = (MethodIdEntry*)malloc(sizeof(MethodIdEntry)*
+                                   (data->NumberOfFunctions+1));
+  numberOfEntries = outputMethodSwitch(fp, data, entries);
 
   /* try superclasses */
   for (i = 0; i < data->NumberOfSuperClasses; i++)
     {
-    fprintf(fp,"\n  if (%sCommand(arlu, op,method,msg,resultStream))\n",
+    fprintf(fp,"\n  if (%sFastCommand(arlu, op,method,methodId,msg,resultStream))\n",
               data->SuperClasses[i]);
     fprintf(fp,"    {\n    return 1;\n    }\n");
     }
@@ -1211,10 +1350,26 @@ void vtkParseOutput(FILE *fp, FileInfo *data)
   fprintf(fp,
           "  return 0;\n"
           "}\n");
-  
+
+  /* the plain command function hashes the name and dispatches */
+  fprintf(fp,
+          "\n"
+          "int VTK_EXPORT"
+          " %sCommand(vtkClientServerInterpreter *arlu, vtkObjectBase *ob,"
+          " const char *method, const vtkClientServerStream& msg,"
+          " vtkClientServerStream& resultStream)\n"
+          "{\n"
+          "  return %sFastCommand(arlu, ob, method,"
+          " vtkClientServerStream::GetMethodId(method), msg, resultStream);\n"
+          "}\n",
+          data->ClassName, data->ClassName);
+
+  numberOfMethods = outputMethodTable(fp, data, entries, numberOfEntries);
+  free(entries);
+
   classData = (ClassInfo*)malloc(sizeof(ClassInfo));
   getClassInfo(data,classData);
-  output_InitFunction(fp,classData);
+  output_InitFunction(fp,classData,numberOfMethods);
   free(classData);
 }
 
@@ -20,6 +20,7 @@
 #include "vtkObjectFactory.h"
 
 #include <vtkstd/map>
+#include <vtkstd/set>
 #include <vtkstd/string>
 #include <vtkstd/vector>
 #include <vtksys/ios/sstream>
@@ -27,16 +28,58 @@
 
 vtkStandardNewMacro(vtkClientServerInterpreter);
 
+//----------------------------------------------------------------------------
+struct vtkClientServerInterpreterCommandFunctions
+{
+  vtkClientServerCommandFunction Function;
+  vtkClientServerFastCommandFunction FastFunction;
+};
+
 //----------------------------------------------------------------------------
 class vtkClientServerInterpreterInternals
 {
 public:
   typedef vtkstd::map<vtkstd::string, vtkClientServerNewInstanceFunction> NewInstanceFunctionsType;
-  typedef vtkstd::map<vtkstd::string, vtkClientServerCommandFunction> ClassToFunctionMapType;
+  typedef vtkstd::map<vtkstd::string, vtkClientServerInterpreterCommandFunctions> ClassToFunctionMapType;
   typedef vtkstd::map<vtkTypeUInt32, vtkClientServerStream*> IDToMessageMapType;
+  typedef vtkstd::map<vtkTypeUInt32, const char*> MethodIdToNameMapType;
+  typedef vtkstd::set<vtkTypeUInt32> MethodIdSetType;
   NewInstanceFunctionsType NewInstanceFunctions;
   ClassToFunctionMapType ClassToFunctionMap;
   IDToMessageMapType IDToMessageMap;
+  MethodIdToNameMapType MethodIdToNameMap;
+
+  // Ids shared by methods with different names.
+  MethodIdSetType AmbiguousMethodIds;
+
+  // Small direct-mapped cache of class lookups keyed by the address of
+  // the string returned by GetClassName().  The address only selects the
+  // slot; a hit still compares the names, so classes whose name is not
+  // a string literal are handled correctly.
+  struct CacheEntry
+  {
+    const char* ClassName;
+    ClassToFunctionMapType::const_iterator Functions;
+  };
+  enum { CacheSize = 256 };
+  CacheEntry Cache[CacheSize];
+
+  vtkClientServerInterpreterInternals()
+    {
+    this->ClearCache();
+    }
+  void ClearCache()
+    {
+    for(int i=0; i < CacheSize; ++i)
+      {
+      this->Cache[i].ClassName = 0;
+      }
+    }
+  static unsigned int CacheSlot(const char* cname)
+    {
+    size_t addr = reinterpret_cast<size_t>(cname);
+    return static_cast<unsigned int>((addr >> 3) ^ (addr >> 11)) % CacheSize;
+    }
 };
 
 //----------------------------------------------------------------------------
@@ -46,6 +89,8 @@ vtkClientServerInterpreter::vtkClientServerInterpreter()
   this->LastResultMessage = new vtkClientServerStream(this);
   this->LogStream = 0;
   this->LogFileStream = 0;
+  this->NumberOfInvokes = 0;
+  this->NumberOfMethodIdInvokes = 0;
 }
 
 //----------------------------------------------------------------------------
@@ -356,12 +401,42 @@ vtkClientServerInterpreter
   // result.  Reset the result to empty before processing the message.
   this->LastResultMessage->Reset();
 
-  // Get the object and method to be invoked.
+  // Get the object and method to be invoked.  The method is either
+  // its name or the id computed by vtkClientServerStream::GetMethodId.
   vtkObjectBase* obj;
-  const char* method;
-  if(msg.GetNumberOfArguments(0) >= 2 &&
-     msg.GetArgument(0, 0, &obj) && msg.GetArgument(0, 1, &method))
+  const char* method = 0;
+  vtkTypeUInt32 methodId = 0;
+  if(msg.GetNumberOfArguments(0) >= 2 && msg.GetArgument(0, 0, &obj) &&
+     msg.GetArgumentType(0, 1) == vtkClientServerStream::uint32_value &&
+     msg.GetArgument(0, 1, &methodId))
+    {
+    ++this->NumberOfMethodIdInvokes;
+    method = this->GetMethodName(methodId);
+    if(!method)
+      {
+      vtksys_ios::ostringstream error;
+      if(this->IsMethodIdAmbiguous(methodId))
+        {
+        error << "Method id " << methodId << " is shared by several methods."
+              << "  The method must be given by name." << ends;
+        }
+      else
+        {
+        error << "Unknown method id " << methodId << "." << ends;
+        }
+      *this->LastResultMessage
+        << vtkClientServerStream::Error << error.str().c_str()
+        << vtkClientServerStream::End;
+      return 0;
+      }
+    }
+  else if(msg.GetNumberOfArguments(0) >= 2 && msg.GetArgument(0, 1, &method))
     {
+    methodId = vtkClientServerStream::GetMethodId(method);
+    }
+  if(method && msg.GetArgument(0, 0, &obj))
+    {
+    ++this->NumberOfInvokes;
     // Log the expanded form of the message.
     if(this->LogStream)
       {
@@ -371,11 +446,15 @@ vtkClientServerInterpreter
       }
 
     // Find the command function for this object's type.
-    if(vtkClientServerCommandFunction func = this->GetCommandFunction(obj))
+    vtkClientServerCommandFunction func;
+    vtkClientServerFastCommandFunction fastFunc;
+    if(this->FindCommandFunctions(obj, &func, &fastFunc))
       {
       // Try to invoke the method.  If it fails, LastResultMessage
       // will have the error message.
-      if(func(this, obj, method, msg, *this->LastResultMessage))
+      if(fastFunc?
+         fastFunc(this, obj, method, methodId, msg, *this->LastResultMessage):
+         func(this, obj, method, msg, *this->LastResultMessage))
         {
         return 1;
         }
@@ -398,7 +477,7 @@ vtkClientServerInterpreter
       << vtkClientServerStream::Error <<
         "Invalid arguments to vtkClientServerStream::Invoke.  "
         "There must be at least two arguments.  The first must be an object "
-        "and the second a string."
+        "and the second a string or a method id."
       << vtkClientServerStream::End;
     }
   return 0;
@@ -705,30 +784,98 @@ void
 vtkClientServerInterpreter
 ::AddCommandFunction(const char* cname, vtkClientServerCommandFunction func)
 {
-  this->Internal->ClassToFunctionMap[cname] = func;
+  this->AddCommandFunction(cname, func, 0, 0, 0);
 }
 
 //----------------------------------------------------------------------------
-vtkClientServerCommandFunction
-vtkClientServerInterpreter::GetCommandFunction(vtkObjectBase* obj)
+void
+vtkClientServerInterpreter
+::AddCommandFunction(const char* cname, vtkClientServerCommandFunction func,
+                     vtkClientServerFastCommandFunction fastFunc,
+                     const char* const* methods, int numberOfMethods)
 {
-  if(obj)
+  vtkClientServerInterpreterCommandFunctions& entry =
+    this->Internal->ClassToFunctionMap[cname];
+  entry.Function = func;
+  entry.FastFunction = fastFunc;
+  for(int i=0; i < numberOfMethods; ++i)
     {
-    // Lookup the function for this object's class.
-    const char* cname = obj->GetClassName();
-    vtkClientServerInterpreterInternals::ClassToFunctionMapType::iterator res;
-    res = this->Internal->ClassToFunctionMap.find(cname);
-    if(res == this->Internal->ClassToFunctionMap.end())
+    vtkTypeUInt32 methodId = vtkClientServerStream::GetMethodId(methods[i]);
+    vtkClientServerInterpreterInternals::MethodIdToNameMapType::iterator res =
+      this->Internal->MethodIdToNameMap.find(methodId);
+    if(res == this->Internal->MethodIdToNameMap.end())
       {
-      vtkErrorMacro("Cannot find command function for \"" << cname << "\".");
-      return 0;
+      this->Internal->MethodIdToNameMap.insert(
+        vtkClientServerInterpreterInternals::MethodIdToNameMapType::value_type(
+          methodId, methods[i]));
+      }
+    else if(strcmp(res->second, methods[i]) != 0)
+      {
+      // The hashes of two different names collide.  An id alone cannot
+      // tell which of the methods is meant.
+      this->Internal->AmbiguousMethodIds.insert(methodId);
       }
-    return res->second;
     }
-  else
+  this->Internal->ClearCache();
+}
+
+//----------------------------------------------------------------------------
+const char* vtkClientServerInterpreter::GetMethodName(vtkTypeUInt32 methodId)
+{
+  if(this->IsMethodIdAmbiguous(methodId))
+    {
+    return 0;
+    }
+  vtkClientServerInterpreterInternals::MethodIdToNameMapType::iterator res =
+    this->Internal->MethodIdToNameMap.find(methodId);
+  return (res == this->Internal->MethodIdToNameMap.end())? 0 : res->second;
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerInterpreter::IsMethodIdAmbiguous(vtkTypeUInt32 methodId)
+{
+  return (this->Internal->AmbiguousMethodIds.find(methodId) !=
+          this->Internal->AmbiguousMethodIds.end())? 1 : 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkClientServerInterpreter::FindCommandFunctions(
+  vtkObjectBase* obj, vtkClientServerCommandFunction* func,
+  vtkClientServerFastCommandFunction* fastFunc)
+{
+  if(!obj)
     {
     return 0;
     }
+
+  // Lookup the functions for this object's class, first in the cache.
+  const char* cname = obj->GetClassName();
+  vtkClientServerInterpreterInternals::CacheEntry& cached =
+    this->Internal->Cache[vtkClientServerInterpreterInternals::CacheSlot(cname)];
+  if(!cached.ClassName || strcmp(cached.ClassName, cname) != 0)
+    {
+    vtkClientServerInterpreterInternals::ClassToFunctionMapType::const_iterator
+      res = this->Internal->ClassToFunctionMap.find(cname);
+    if(res == this->Internal->ClassToFunctionMap.end())
+      {
+      vtkErrorMacro("Cannot find command function for \"" << cname << "\".");
+      return 0;
+      }
+    cached.ClassName = res->first.c_str();
+    cached.Functions = res;
+    }
+  *func = cached.Functions->second.Function;
+  *fastFunc = cached.Functions->second.FastFunction;
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+vtkClientServerCommandFunction
+vtkClientServerInterpreter::GetCommandFunction(vtkObjectBase* obj)
+{
+  vtkClientServerCommandFunction func;
+  vtkClientServerFastCommandFunction fastFunc;
+  return this->FindCommandFunctions(obj, &func, &fastFunc)? func : 0;
 }
 
 void
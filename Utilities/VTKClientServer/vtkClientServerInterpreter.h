@@ -41,6 +41,19 @@ typedef int (*vtkClientServerCommandFunction)(vtkClientServerInterpreter*,
                                               const vtkClientServerStream& msg,
                                               vtkClientServerStream& result);
 
+// Description:
+// The type of a fast-path command function.  It is the same as a
+// command function but also receives the method id computed by
+// vtkClientServerStream::GetMethodId for the method name, which lets
+// the generated code dispatch with a switch instead of comparing the
+// name with every wrapped method.
+typedef int (*vtkClientServerFastCommandFunction)(vtkClientServerInterpreter*,
+                                                  vtkObjectBase* ptr,
+                                                  const char* method,
+                                                  vtkTypeUInt32 methodId,
+                                                  const vtkClientServerStream& msg,
+                                                  vtkClientServerStream& result);
+
 // Description:
 // The type of a new-instance function.
 typedef vtkObjectBase* (*vtkClientServerNewInstanceFunction)();
@@ -116,10 +129,39 @@ public:
   void AddCommandFunction(const char* cname,
                           vtkClientServerCommandFunction func);
 
+  // Description:
+  // Add the command functions for a class along with the names of the
+  // methods it wraps.  The names are used to resolve Invoke messages
+  // carrying a method id instead of a method name.  The table must
+  // stay valid for the life of the interpreter.
+  void AddCommandFunction(const char* cname,
+                          vtkClientServerCommandFunction func,
+                          vtkClientServerFastCommandFunction fastFunc,
+                          const char* const* methods, int numberOfMethods);
+
   // Description:
   // Get the command function for an object's class.
   vtkClientServerCommandFunction GetCommandFunction(vtkObjectBase* obj);
 
+  // Description:
+  // Get the name of the method with the given id, or NULL if no
+  // registered class wraps a method with that id or if the id is
+  // ambiguous.
+  const char* GetMethodName(vtkTypeUInt32 methodId);
+
+  // Description:
+  // Returns 1 if methods with different names registered with
+  // AddCommandFunction have the given id.  Invoke messages carrying such
+  // an id are rejected; senders sharing the wrapping tables can check it
+  // and send the method name instead.
+  int IsMethodIdAmbiguous(vtkTypeUInt32 methodId);
+
+  // Description:
+  // Number of Invoke messages processed and how many of them carried a
+  // method id instead of a method name.
+  vtkGetMacro(NumberOfInvokes, unsigned long);
+  vtkGetMacro(NumberOfMethodIdInvokes, unsigned long);
+
   // Description:
   // Add a function used to create new objects.
   void AddNewInstanceFunction(const char*cname,
@@ -168,6 +210,15 @@ protected:
   // Load a module dynamically given the full path to it.
   int LoadInternal(const char* moduleName, const char* fullPath);
 
+  // Find the command functions for an object's class.  Returns 0 if
+  // the class has no command function.
+  int FindCommandFunctions(vtkObjectBase* obj,
+                           vtkClientServerCommandFunction* func,
+                           vtkClientServerFastCommandFunction* fastFunc);
+
+  unsigned long NumberOfInvokes;
+  unsigned long NumberOfMethodIdInvokes;
+
 private:
 
   // Message containing the result of the last command.
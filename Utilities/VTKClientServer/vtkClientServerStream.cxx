@@ -15,9 +15,11 @@
 #include "vtkClientServerStream.h"
 
 #include "vtkByteSwap.h"
+#include "vtkCriticalSection.h"
 #include "vtkSmartPointer.h"
 #include "vtkTypeTraits.h"
 
+#include <vtkstd/algorithm>
 #include <vtkstd/string>
 #include <vtkstd/vector>
 #include <vtksys/ios/sstream>
@@ -73,17 +75,9 @@ VTK_CLIENT_SERVER_TYPE_TRAIT(vtkTypeFloat64, float64);
 #undef VTK_CLIENT_SERVER_TYPE_TRAIT
 
 //----------------------------------------------------------------------------
-// Internal implementation data.
-class vtkClientServerStreamInternals
+// Storage of a stream.  Kept separate so that it can be recycled.
+struct vtkClientServerStreamBuffers
 {
-public:
-  vtkClientServerStreamInternals(vtkObjectBase* owner): Objects(owner) {}
-  vtkClientServerStreamInternals(const vtkClientServerStreamInternals& r,
-                                 vtkObjectBase* owner):
-    Data(r.Data), ValueOffsets(r.ValueOffsets),
-    MessageIndexes(r.MessageIndexes), Objects(r.Objects, owner),
-    StartIndex(r.StartIndex), Invalid(r.Invalid), String(r.String) {}
-
   // Actual binary data in the stream.
   typedef vtkstd::vector<unsigned char> DataType;
   DataType Data;
@@ -97,6 +91,123 @@ public:
   typedef vtkstd::vector<ValueOffsetsType::size_type> MessageIndexesType;
   MessageIndexesType MessageIndexes;
 
+  void Swap(vtkClientServerStreamBuffers& r)
+    {
+    this->Data.swap(r.Data);
+    this->ValueOffsets.swap(r.ValueOffsets);
+    this->MessageIndexes.swap(r.MessageIndexes);
+    }
+
+  void Clear()
+    {
+    this->Data.clear();
+    this->ValueOffsets.clear();
+    this->MessageIndexes.clear();
+    }
+
+  // Make room for the given number of bytes in one reallocation.
+  void ReserveData(size_t extra)
+    {
+    size_t needed = this->Data.size() + extra;
+    if(needed > this->Data.capacity())
+      {
+      size_t doubled = 2*this->Data.capacity();
+      this->Data.reserve(needed > doubled? needed : doubled);
+      }
+    }
+};
+
+//----------------------------------------------------------------------------
+// Buffers of destroyed streams, handed to new streams so that the many
+// short-lived streams built per property push or per RMI do not
+// allocate.  Buffers grown beyond MaximumCapacity are freed instead.
+class vtkClientServerStreamBufferPool
+{
+public:
+  enum { MaximumNumberOfBuffers = 16 };
+  enum { MaximumCapacity = 65536 };
+
+  vtkClientServerStreamBufferPool(): NumberOfBuffers(0)
+    {
+    vtkClientServerStreamBufferPool::Available = 1;
+    }
+  ~vtkClientServerStreamBufferPool()
+    {
+    // Streams destroyed after this point do not use the pool.
+    vtkClientServerStreamBufferPool::Available = 0;
+    }
+
+  // Give pooled storage, if any, to the given empty buffers.
+  void Acquire(vtkClientServerStreamBuffers& buffers)
+    {
+    if(!vtkClientServerStreamBufferPool::Available)
+      {
+      return;
+      }
+    this->Lock.Lock();
+    if(this->NumberOfBuffers > 0)
+      {
+      buffers.Swap(this->Buffers[--this->NumberOfBuffers]);
+      }
+    this->Lock.Unlock();
+    }
+
+  // Take the storage of the given buffers if it is worth keeping.
+  void Release(vtkClientServerStreamBuffers& buffers)
+    {
+    if(!vtkClientServerStreamBufferPool::Available ||
+       buffers.Data.capacity() == 0 ||
+       buffers.Data.capacity() > MaximumCapacity)
+      {
+      return;
+      }
+    buffers.Clear();
+    this->Lock.Lock();
+    if(this->NumberOfBuffers < MaximumNumberOfBuffers)
+      {
+      this->Buffers[this->NumberOfBuffers++].Swap(buffers);
+      }
+    this->Lock.Unlock();
+    }
+
+  // Plain int so that it is valid before construction and after
+  // destruction of the pool.
+  static int Available;
+
+private:
+  vtkSimpleCriticalSection Lock;
+  vtkClientServerStreamBuffers Buffers[MaximumNumberOfBuffers];
+  int NumberOfBuffers;
+};
+
+int vtkClientServerStreamBufferPool::Available;
+static vtkClientServerStreamBufferPool vtkClientServerStreamPool;
+
+//----------------------------------------------------------------------------
+// Internal implementation data.
+class vtkClientServerStreamInternals: public vtkClientServerStreamBuffers
+{
+public:
+  vtkClientServerStreamInternals(vtkObjectBase* owner): Objects(owner)
+    {
+    vtkClientServerStreamPool.Acquire(*this);
+    }
+  vtkClientServerStreamInternals(const vtkClientServerStreamInternals& r,
+                                 vtkObjectBase* owner):
+    Objects(r.Objects, owner),
+    StartIndex(r.StartIndex), Invalid(r.Invalid), String(r.String)
+    {
+    vtkClientServerStreamPool.Acquire(*this);
+    this->Data.assign(r.Data.begin(), r.Data.end());
+    this->ValueOffsets.assign(r.ValueOffsets.begin(), r.ValueOffsets.end());
+    this->MessageIndexes.assign(r.MessageIndexes.begin(),
+                                r.MessageIndexes.end());
+    }
+  ~vtkClientServerStreamInternals()
+    {
+    vtkClientServerStreamPool.Release(*this);
+    }
+
   // Hold references to vtkObjectBase instances stored in the stream.
   // The object that owns this stream is passed as the argument to
   // Register/UnRegister for objects stored in the stream because the
@@ -187,7 +298,6 @@ vtkClientServerStream::vtkClientServerStream(vtkObjectBase* owner)
 {
   // Initialize the internal representation of the stream.
   this->Internal = new vtkClientServerStreamInternals(owner);
-  this->Reserve(1024);
   this->Reset();
 }
 
@@ -219,6 +329,38 @@ void vtkClientServerStream::Copy(const vtkClientServerStream* source)
   *this = *source;
 }
 
+//----------------------------------------------------------------------------
+void vtkClientServerStream::Swap(vtkClientServerStream& that)
+{
+  if(this == &that)
+    {
+    return;
+    }
+  vtkClientServerStreamInternals* a = this->Internal;
+  vtkClientServerStreamInternals* b = that.Internal;
+  a->vtkClientServerStreamBuffers::Swap(*b);
+  vtkstd::swap(a->StartIndex, b->StartIndex);
+  vtkstd::swap(a->Invalid, b->Invalid);
+
+  // Each stream keeps its owner.  Move the object references over to
+  // the owner of the stream now holding them.
+  if(a->Objects.Owner != b->Objects.Owner)
+    {
+    vtkClientServerStreamInternals::ObjectsType::Superclass::iterator i;
+    for(i = a->Objects.begin(); i != a->Objects.end(); ++i)
+      {
+      if(b->Objects.Owner) { (*i)->Register(b->Objects.Owner); }
+      if(a->Objects.Owner) { (*i)->UnRegister(a->Objects.Owner); }
+      }
+    for(i = b->Objects.begin(); i != b->Objects.end(); ++i)
+      {
+      if(a->Objects.Owner) { (*i)->Register(a->Objects.Owner); }
+      if(b->Objects.Owner) { (*i)->UnRegister(b->Objects.Owner); }
+      }
+    }
+  a->Objects.Superclass::swap(b->Objects);
+}
+
 //----------------------------------------------------------------------------
 vtkClientServerStream&
 vtkClientServerStream::Write(const void* data, size_t length)
@@ -235,9 +377,10 @@ vtkClientServerStream::Write(const void* data, size_t length)
     return *this;
     }
 
-  // Copy the value into the data.
-  this->Internal->Data.resize(this->Internal->Data.size() + length);
-  memcpy(&*(this->Internal->Data.end() - length), data, length);
+  // Copy the value into the data without first zero-filling it.
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  this->Internal->Data.insert(this->Internal->Data.end(),
+                              bytes, bytes + length);
   return *this;
 }
 
@@ -250,13 +393,18 @@ void vtkClientServerStream::Reserve(size_t size)
 //----------------------------------------------------------------------------
 void vtkClientServerStream::Reset()
 {
-  // Empty the entire stream.
-  vtkClientServerStreamInternals::DataType().swap(this->Internal->Data);
-  
-  this->Internal->ValueOffsets.erase(this->Internal->ValueOffsets.begin(),
-                                     this->Internal->ValueOffsets.end());
-  this->Internal->MessageIndexes.erase(this->Internal->MessageIndexes.begin(),
-                                       this->Internal->MessageIndexes.end());
+  // Empty the entire stream.  Storage is kept for reuse unless it grew
+  // large.
+  if(this->Internal->Data.capacity() >
+     vtkClientServerStreamBufferPool::MaximumCapacity)
+    {
+    vtkClientServerStreamInternals::DataType().swap(this->Internal->Data);
+    vtkClientServerStreamInternals::ValueOffsetsType().swap(
+      this->Internal->ValueOffsets);
+    vtkClientServerStreamInternals::MessageIndexesType().swap(
+      this->Internal->MessageIndexes);
+    }
+  this->Internal->vtkClientServerStreamBuffers::Clear();
   this->Internal->Objects.Clear();
 
   // No message has yet been started.
@@ -365,7 +513,9 @@ vtkClientServerStream::operator << (vtkClientServerStream::Argument a)
 vtkClientServerStream&
 vtkClientServerStream::operator << (vtkClientServerStream::Array a)
 {
-  // Store the array type, then length, then data.
+  // Store the array type, then length, then data.  Grow the storage
+  // once for the whole array.
+  this->Internal->ReserveData(2*sizeof(vtkTypeUInt32) + a.Size + 1);
   *this << a.Type;
   this->Write(&a.Length, sizeof(a.Length));
   this->Write(a.Data, a.Size);
@@ -390,6 +540,7 @@ vtkClientServerStream::operator << (const vtkClientServerStream& css)
      css.GetData(&data, &length))
     {
     // Store the stream_value type, then length, then data.
+    this->Internal->ReserveData(2*sizeof(vtkTypeUInt32) + length);
     *this << vtkClientServerStream::stream_value;
     vtkTypeUInt32 size = static_cast<vtkTypeUInt32>(length);
     this->Write(&size, sizeof(size));
@@ -1084,6 +1235,29 @@ int vtkClientServerStream::GetArgument(int message, int argument,
   return 0;
 }
 
+//----------------------------------------------------------------------------
+int vtkClientServerStream::GetArgumentData(int message, int argument,
+                                           const unsigned char** data,
+                                           size_t* length) const
+{
+  // Get a pointer to the type/value pair in the stream.
+  if(const unsigned char* value = this->GetValue(message, 1+argument))
+    {
+    vtkTypeUInt32 tp;
+    memcpy(&tp, value, sizeof(tp));
+    if(static_cast<vtkClientServerStream::Types>(tp) ==
+       vtkClientServerStream::stream_value)
+      {
+      vtkTypeUInt32 len;
+      memcpy(&len, value+sizeof(tp), sizeof(len));
+      *data = value + sizeof(tp) + sizeof(len);
+      *length = static_cast<size_t>(len);
+      return 1;
+      }
+    }
+  return 0;
+}
+
 //----------------------------------------------------------------------------
 int vtkClientServerStream::GetArgument(int message, int argument,
                                        vtkClientServerID* value) const
@@ -1898,6 +2072,19 @@ vtkClientServerStream::GetCommandFromString(const char* begin,
   return vtkClientServerStream::EndOfCommands;
 }
 
+//----------------------------------------------------------------------------
+vtkTypeUInt32 vtkClientServerStream::GetMethodId(const char* name)
+{
+  // 32-bit FNV-1a.  This must match vtkWrapClientServer.c.
+  vtkTypeUInt32 hash = 2166136261u;
+  for(const unsigned char* c = reinterpret_cast<const unsigned char*>(name);
+      c && *c; ++c)
+    {
+    hash = (hash ^ *c) * 16777619u;
+    }
+  return hash;
+}
+
 //----------------------------------------------------------------------------
 void vtkClientServerStream::Print(ostream& os) const
 {
@@ -86,6 +86,12 @@ public:
   // Copy the stream contents from another stream.
   void Copy(const vtkClientServerStream* source);
 
+  // Description:
+  // Exchange the contents of two streams without copying them.  Use it
+  // to move a stream into another one, e.g. a queue.  Each stream keeps
+  // its owner; object references are moved to the new owner.
+  void Swap(vtkClientServerStream& that);
+
   //--------------------------------------------------------------------------
   // Stream reading methods:
 
@@ -186,6 +192,16 @@ public:
   vtkClientServerStream::Argument GetArgument(int message,
                                               int argument) const;
 
+  // Description:
+  // Get a pointer to the data of a nested stream argument and its
+  // length without copying it.  The values are suitable for passing to
+  // another stream's SetData method or to
+  // vtkClientServerInterpreter::ProcessStream, but are invalidated
+  // when any further writing to this stream is done.  Returns whether
+  // the argument is a stream_value.
+  int GetArgumentData(int message, int argument,
+                      const unsigned char** data, size_t* length) const;
+
   // Description:
   // Get a pointer to the stream data and its length.  The values are
   // suitable for passing to another stream's SetData method, but are
@@ -299,6 +315,20 @@ public:
   static
   vtkClientServerStream::Commands GetCommandFromString(const char* name);
 
+  // Description:
+  // Get the id of a method name.  An Invoke message may carry the id
+  // as a uint32 argument in place of the method name, which saves the
+  // server from hashing the name:
+  //   css << vtkClientServerStream::Invoke << id
+  //       << vtkClientServerStream::GetMethodId("SetRadius") << 0.5
+  //       << vtkClientServerStream::End;
+  // The id is the 32-bit FNV-1a hash of the name.  It is the same in
+  // every process and is also computed by the wrapper generator.
+  // Different names may have the same id; the interpreter rejects
+  // messages carrying such an id (see
+  // vtkClientServerInterpreter::IsMethodIdAmbiguous).
+  static vtkTypeUInt32 GetMethodId(const char* name);
+
   // Description:
   // Print the contents of the stream in a human-readable form.
   void Print(ostream&) const;
@@ -1860,14 +1860,18 @@ def SaveState(filename):
     pm = ProxyManager()
     pm.SaveState(filename)
 
-def LoadState(filename, connection=None):
+def LoadState(filename, connection=None, deferred=False):
     """Given a state filename and an optional connection, loads the server
-    manager state."""
+    manager state. When deferred is true, all the proxies are created before
+    the pipeline information of any of them is updated, which saves round
+    trips to remote servers."""
     if not connection:
         connection = ActiveConnection
     if not connection:
         raise RuntimeError, "Cannot load state without a connection"
     loader = vtkSMPQStateLoader()
+    if deferred:
+        loader.SetDeferredLoading(1)
     pm = ProxyManager()
     pm.LoadState(filename, ActiveConnection.ID, loader)
     views = GetRenderViews()